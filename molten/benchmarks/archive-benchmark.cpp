@@ -0,0 +1,326 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../engine/core/assets/asset-archive.h"
+#include "../engine/core/jobs/job-system.h"
+#include "../engine/core/utils/lz4-block.h"
+
+#include "benchmarks.h"
+
+namespace fs = std::filesystem;
+
+enum class Content
+{
+    Random,
+    LowEntropy,
+    Runs
+};
+
+static const char* s_ContentNames[] = { "random", "low-entropy", "runs" };
+
+static std::vector<uint8_t> MakeContent(Content content, size_t size, std::mt19937& rng)
+{
+    std::vector<uint8_t> data(size);
+    
+    switch (content)
+    {
+        case Content::Random:
+            for (uint8_t& byte : data) byte = static_cast<uint8_t>(rng());
+            break;
+        
+        // Four symbols, so there are many short matches and few long ones.
+        case Content::LowEntropy:
+            for (uint8_t& byte : data) byte = static_cast<uint8_t>('a' + rng() % 4);
+            break;
+        
+        // Runs from one byte to well past the 15 that fits in a token.
+        case Content::Runs:
+            for (size_t i = 0; i < size;)
+            {
+                size_t run = std::min<size_t>(1 + rng() % 600, size - i);
+                std::memset(data.data() + i, static_cast<int>(rng() & 0xff), run);
+                i += run;
+            }
+            break;
+    }
+    
+    return data;
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compresses and decompresses every kind of content at sizes around the
+// codec's edges: empty, shorter than a match can start in, and large.
+static bool CheckRoundTrips(size_t maxSize, std::mt19937& rng)
+{
+    const size_t sizes[] = { 0, 1, 5, 12, 13, 64, 255, 4096, 65535, 65536, 65537, 1000003, maxSize };
+    
+    bool matches = true;
+    
+    std::printf("%-12s %10s %8s %14s %14s\n", "content", "bytes", "ratio", "compress MB/s", "decompress MB/s");
+    
+    for (int c = 0; c < 3; c++)
+    {
+        for (size_t size : sizes)
+        {
+            if (size > maxSize) continue;
+            
+            std::vector<uint8_t> input = MakeContent(static_cast<Content>(c), size, rng);
+            
+            // One spare byte, so a decoder writing past outputSize can't go unnoticed.
+            std::vector<uint8_t> compressed(GetLZ4CompressBound(size));
+            std::vector<uint8_t> output(size + 1, 0xcd);
+            
+            auto start = std::chrono::steady_clock::now();
+            size_t compressedSize = CompressLZ4(input.data(), size, compressed.data(), compressed.size());
+            double compressMs = ElapsedMs(start);
+            
+            start = std::chrono::steady_clock::now();
+            bool decoded = compressedSize > 0 && DecompressLZ4(compressed.data(), compressedSize, output.data(), size);
+            double decompressMs = ElapsedMs(start);
+            
+            bool ok = decoded && std::memcmp(input.data(), output.data(), size) == 0 && output[size] == 0xcd;
+            
+            // The block has to decode to exactly the size it was made from.
+            if (ok && size > 0) ok = !DecompressLZ4(compressed.data(), compressedSize, output.data(), size - 1);
+            if (ok) ok = !DecompressLZ4(compressed.data(), compressedSize, output.data(), size + 1);
+            
+            // An output one byte too small has to be refused, not overrun.
+            if (ok && compressedSize > 1)
+            {
+                std::vector<uint8_t> tight(compressedSize - 1);
+                ok = CompressLZ4(input.data(), size, tight.data(), tight.size()) == 0;
+            }
+            
+            matches = matches && ok;
+            
+            if (size < 65536 && ok) continue;
+            
+            double megabytes = size / (1024.0 * 1024.0);
+            
+            std::printf("%-12s %10zu %8.3f %14.0f %14.0f%s\n", s_ContentNames[c], size,
+                        size ? double(compressedSize) / size : 0.0,
+                        compressMs > 0.0 ? megabytes / (compressMs / 1000.0) : 0.0,
+                        decompressMs > 0.0 ? megabytes / (decompressMs / 1000.0) : 0.0,
+                        ok ? "" : "  ROUND TRIP FAILED");
+        }
+    }
+    
+    return matches;
+}
+
+static bool WriteFile(const fs::path& path, const std::vector<uint8_t>& data)
+{
+    FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (!file) return false;
+    
+    bool written = data.empty() || std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    
+    return std::fclose(file) == 0 && written;
+}
+
+static bool Equals(const AssetData& data, const std::vector<uint8_t>& expected)
+{
+    return data.GetSize() == expected.size() && (expected.empty() || std::memcmp(data.GetData(), expected.data(), expected.size()) == 0);
+}
+
+// Packs a directory of nested files, reads every entry back from the
+// archive, then mounts it and looks entries up through a symlinked root.
+static bool CheckArchive(const fs::path& directory, int fileCount, size_t maxSize, std::mt19937& rng)
+{
+    fs::path root = directory / "assets";
+    fs::path archivePath = directory / "assets.mpak";
+    
+    std::vector<PackInput> inputs;
+    std::vector<std::vector<uint8_t>> contents;
+    
+    size_t totalSize = 0;
+    
+    for (int i = 0; i < fileCount; i++)
+    {
+        // Every fourth file is a cooked texture, which has to be stored raw.
+        std::string name = "level" + std::to_string(i % 5) + "/group" + std::to_string(i % 3) + "/file" + std::to_string(i) +
+                           (i % 4 == 0 ? ".mtex" : ".bin");
+        
+        size_t size = i % 7 == 0 ? 0 : rng() % (std::min<size_t>(maxSize, 1 << 20) + 1);
+        contents.push_back(MakeContent(static_cast<Content>(i % 3), size, rng));
+        
+        fs::path sourcePath = root / name;
+        
+        std::error_code error;
+        fs::create_directories(sourcePath.parent_path(), error);
+        
+        if (!WriteFile(sourcePath, contents.back()))
+        {
+            std::printf("archive: could not write %s\n", sourcePath.string().c_str());
+            return false;
+        }
+        
+        inputs.push_back({ name, sourcePath.string() });
+        totalSize += size;
+    }
+    
+    JobSystem jobs;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    if (!AssetArchive::Pack(inputs, archivePath.string().c_str(), PackOptions(), &jobs))
+    {
+        std::printf("archive: packing failed\n");
+        return false;
+    }
+    
+    double packMs = ElapsedMs(start);
+    
+    AssetArchive archive;
+    
+    if (!archive.Open(archivePath.string().c_str(), root.string().c_str()) || archive.GetEntryCount() != inputs.size())
+    {
+        std::printf("archive: could not open the packed archive, or it lost entries\n");
+        return false;
+    }
+    
+    bool matches = true;
+    uint32_t compressedCount = 0;
+    
+    start = std::chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const AssetEntry* entry = archive.Find(inputs[i].name);
+        AssetData data;
+        
+        bool ok = entry && archive.GetName(*entry) == inputs[i].name && archive.Read(*entry, data) && Equals(data, contents[i]);
+        
+        if (ok && entry->compression == static_cast<uint32_t>(AssetCompression::LZ4))
+        {
+            compressedCount++;
+            ok = inputs[i].name.ends_with(".bin");
+        }
+        
+        if (!ok) std::printf("archive: %s did not read back\n", inputs[i].name.c_str());
+        
+        matches = matches && ok;
+    }
+    
+    double readMs = ElapsedMs(start);
+    
+    matches = matches && !archive.Find("level0/missing.bin");
+    
+    std::printf("packed %d files (%zu bytes, %u compressed) in %.3f ms, read back in %.3f ms (%.0f MB/s)\n", fileCount, totalSize,
+                compressedCount, packMs, readMs, readMs > 0.0 ? totalSize / (1024.0 * 1024.0) / (readMs / 1000.0) : 0.0);
+    
+    // Paths through a link to the root name the same entries as direct ones.
+    fs::path link = directory / "linked";
+    
+    std::error_code error;
+    fs::create_directory_symlink(root, link, error);
+    
+    if (!AssetArchive::Mount(archivePath.string().c_str(), root.string().c_str()))
+    {
+        std::printf("archive: mounting failed\n");
+        return false;
+    }
+    
+    // The loose files go, so only the archive can answer.
+    fs::remove_all(root / "level0", error);
+    
+    bool linked = fs::is_symlink(link, error);
+    
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        AssetData data;
+        
+        bool ok = AssetArchive::Contains((root / ".." / "assets" / inputs[i].name).string()) &&
+                  AssetArchive::Load((root / inputs[i].name).string(), data) && Equals(data, contents[i]);
+        
+        if (linked)
+        {
+            AssetData linkedData;
+            ok = ok && AssetArchive::Contains((link / inputs[i].name).string()) &&
+                 AssetArchive::Load((link / inputs[i].name).string(), linkedData) && Equals(linkedData, contents[i]);
+        }
+        
+        if (!ok) std::printf("archive: %s did not load from the mounted archive\n", inputs[i].name.c_str());
+        
+        matches = matches && ok;
+    }
+    
+    matches = matches && !AssetArchive::Contains((directory / "assets.mpak").string());
+    
+    if (!linked) std::printf("archive: no symlinks here, linked lookups skipped\n");
+    
+    AssetArchive::UnmountAll();
+    
+    return matches;
+}
+
+// Round-trips the LZ4 codec over random, low entropy and run-heavy data,
+// then packs a temporary directory and reads every entry back.
+int RunArchiveBenchmark(int argc, char** argv)
+{
+    size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16 << 20;
+    int fileCount = argc > 2 ? std::atoi(argv[2]) : 200;
+    
+    if (maxSize == 0 || fileCount <= 0)
+    {
+        std::printf("archive: max-size and files must be positive\n");
+        return 1;
+    }
+    
+    std::mt19937 rng(1234);
+    
+    std::printf("archive: buffers up to %zu bytes, %d files\n", maxSize, fileCount);
+    
+    bool codecMatches = CheckRoundTrips(maxSize, rng);
+    
+    std::error_code error;
+    fs::path directory = fs::temp_directory_path(error) / ("molten-archive-" + std::to_string(std::random_device()()));
+    
+    if (error || !fs::create_directories(directory, error))
+    {
+        std::printf("archive: could not create a temporary directory\n");
+        return 1;
+    }
+    
+    bool archiveMatches = CheckArchive(directory, fileCount, maxSize, rng);
+    
+    fs::remove_all(directory, error);
+    
+    std::printf("%s\n", codecMatches ? "round trips match" : "ROUND TRIPS DIFFER");
+    std::printf("%s\n", archiveMatches ? "archive entries match" : "ARCHIVE ENTRIES DIFFER");
+    
+    return codecMatches && archiveMatches ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../engine/core/renderer/sprite-store.h"
+#include "../engine/core/renderer/sprite-batch-2D.h"
+#include "../engine/core/renderer/quad-kernel.h"
+#include "../engine/core/jobs/job-system.h"
+#include "../engine/core/utils/profiler.h"
+
+#include "benchmarks.h"
+
+// Rewrites every slot of a batch with 1..N worker threads and reports the
+// throughput of each, checking that every thread count produces the same bytes.
+int RunBatchBenchmark(int argc, char** argv)
+{
+    size_t spriteCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : std::thread::hardware_concurrency();
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 50;
+    
+    if (spriteCount == 0 || maxThreads == 0 || iterations <= 0)
+    {
+        std::printf("batch: sprites, threads and iterations must be positive\n");
+        return 1;
+    }
+    
+    SpriteStore sprites;
+    
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> size(4.0f, 64.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    
+    for (size_t i = 0; i < spriteCount; i++)
+    {
+        // Half the sprites are unrotated, like a typical scene.
+        float rotation = (i % 2 == 0) ? 0.0f : angle(rng);
+        sprites.Create({ position(rng), position(rng) }, { size(rng), size(rng) }, rotation, { 1.0f, 1.0f, 1.0f, 1.0f });
+    }
+    
+    SpriteBatch2D batch;
+    batch.Resize(spriteCount);
+    
+    std::vector<unsigned char> reference;
+    double singleThreadMs = 0.0;
+    
+    std::printf("batch: %zu sprites, %s kernel, %d iterations\n", spriteCount,
+                QuadKernel::GetPathName(QuadKernel::GetPath()), iterations);
+    std::printf("%8s %12s %14s %10s %9s\n", "threads", "ms/frame", "Msprites/s", "GB/s", "speedup");
+    
+    for (unsigned int threads = 1; threads <= maxThreads; threads++)
+    {
+        JobSystem jobs(threads);
+        
+        // Warm up caches, page in the arena and wake the workers.
+        batch.WriteSprites(sprites, 0, spriteCount, &jobs);
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        for (int i = 0; i < iterations; i++)
+        {
+            batch.WriteSprites(sprites, 0, spriteCount, &jobs);
+            batch.ClearDirtyRanges();
+            PROFILE_FRAME();
+        }
+        
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+        if (threads == 1) singleThreadMs = ms;
+        
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(batch.GetVertices());
+        
+        bool identical = true;
+        
+        if (reference.empty()) reference.assign(bytes, bytes + batch.GetByteSize());
+        else identical = std::memcmp(reference.data(), bytes, reference.size()) == 0;
+        
+        std::printf("%8u %12.3f %14.2f %10.2f %8.2fx%s\n", threads, ms,
+                    spriteCount / (ms * 1000.0),
+                    batch.GetByteSize() / (ms * 1.0e6),
+                    singleThreadMs / ms,
+                    identical ? "" : "  OUTPUT DIFFERS");
+        
+        if (!identical) return 1;
+    }
+    
+    return 0;
+}
@@ -20,19 +20,21 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include "matrix.h"
-
-simd::float4x4 Ortho(float left, float right, float bottom, float top)
-{
-    float rl = right - left;
-    float tb = top - bottom;
-    float tx = -(right + left) / rl;
-    float ty = -(top + bottom) / tb;
-
-    return simd::float4x4(
-      simd::float4{2.0f / rl, 0.0f,       0.0f, 0.0f}, // Column 0
-      simd::float4{0.0f,       2.0f / tb, 0.0f, 0.0f}, // Column 1
-      simd::float4{0.0f,       0.0f,       1.0f, 0.0f}, // Column 2
-      simd::float4{tx,         ty,         0.0f, 1.0f}  // Column 3
-    );
-}
+#pragma once
+
+// Each benchmark parses its own arguments (argv[0] is the benchmark name)
+// and returns a process exit code.
+
+int RunBatchBenchmark(int argc, char** argv);
+
+int RunPhysicsBenchmark(int argc, char** argv);
+
+int RunMathsBenchmark(int argc, char** argv);
+
+int RunTransformsBenchmark(int argc, char** argv);
+
+int RunFramesBenchmark(int argc, char** argv);
+
+int RunArchiveBenchmark(int argc, char** argv);
+
+int RunEcsBenchmark(int argc, char** argv);
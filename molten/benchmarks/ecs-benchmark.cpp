@@ -0,0 +1,338 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../engine/core/ecs/command-buffer.h"
+#include "../engine/core/ecs/query.h"
+#include "../engine/core/ecs/world.h"
+#include "../engine/core/jobs/job-system.h"
+
+#include "benchmarks.h"
+
+struct Position { float x, y; };
+struct Velocity { float x, y; };
+struct Health { int32_t value; };
+
+// Not trivially copyable, so moves between archetypes go through relocate.
+struct Name { std::string value; };
+
+// What the world should hold for each entity index.
+struct Expected
+{
+    Entity entity;
+    bool alive = false;
+    
+    Position position = {};
+    
+    bool hasVelocity = false;
+    Velocity velocity = {};
+    
+    bool hasHealth = false;
+    Health health = {};
+    
+    bool hasName = false;
+    std::string name;
+};
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Half move, a third have health; every combination of the two shows up.
+static void Spawn(World& world, std::vector<Expected>& expected, uint32_t seed)
+{
+    Position position = { static_cast<float>(seed % 1000), static_cast<float>(seed / 1000 % 1000) };
+    Velocity velocity = { 0.25f * (seed % 7), -0.5f * (seed % 5) };
+    Health health = { 100 + static_cast<int32_t>(seed % 50) };
+    
+    bool moves = seed % 2 == 0;
+    bool living = seed % 3 == 0;
+    
+    Entity entity;
+    
+    if (moves && living) entity = world.Create(position, velocity, health);
+    else if (moves) entity = world.Create(position, velocity);
+    else if (living) entity = world.Create(position, health);
+    else entity = world.Create(position);
+    
+    if (entity.index >= expected.size()) expected.resize(entity.index + 1);
+    
+    Expected& record = expected[entity.index];
+    record = Expected();
+    record.entity = entity;
+    record.alive = true;
+    record.position = position;
+    record.hasVelocity = moves;
+    record.velocity = velocity;
+    record.hasHealth = living;
+    record.health = health;
+}
+
+static bool CheckEntities(const World& world, const std::vector<Expected>& expected, const std::vector<Entity>& destroyed)
+{
+    size_t alive = 0;
+    
+    for (const Expected& record : expected)
+    {
+        if (!record.alive) continue;
+        
+        alive++;
+        Entity entity = record.entity;
+        
+        if (!world.IsAlive(entity) || !world.Has<Position>(entity) || world.Has<Velocity>(entity) != record.hasVelocity ||
+            world.Has<Health>(entity) != record.hasHealth || world.Has<Name>(entity) != record.hasName) return false;
+        
+        const Position* position = world.Get<Position>(entity);
+        if (position->x != record.position.x || position->y != record.position.y) return false;
+        
+        if (record.hasVelocity && (world.Get<Velocity>(entity)->x != record.velocity.x || world.Get<Velocity>(entity)->y != record.velocity.y)) return false;
+        if (record.hasHealth && world.Get<Health>(entity)->value != record.health.value) return false;
+        if (record.hasName && world.Get<Name>(entity)->value != record.name) return false;
+    }
+    
+    // Handles of destroyed entities must not reach whatever reused their index.
+    for (Entity entity : destroyed)
+        if (world.IsAlive(entity)) return false;
+    
+    return alive == world.GetEntityCount();
+}
+
+// Integrates, checks which chunks report changes, and churns entities
+// through command buffers and direct structural changes, comparing the
+// world against a plain copy of what it should hold.
+int RunEcsBenchmark(int argc, char** argv)
+{
+    size_t entityCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 20;
+    
+    if (entityCount == 0 || frames <= 0)
+    {
+        std::printf("ecs: entities and frames must be positive\n");
+        return 1;
+    }
+    
+    JobSystem jobs;
+    World world;
+    
+    std::vector<Expected> expected;
+    std::vector<Entity> destroyed;
+    
+    std::mt19937 rng(1234);
+    uint32_t nextSeed = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < entityCount; i++)
+        Spawn(world, expected, nextSeed++);
+    
+    double createMs = ElapsedMs(start);
+    
+    Query<Position, const Velocity> moving(world);
+    Query<const Position> positions(world);
+    Query<const Velocity> velocities(world);
+    Query<const Health> healths(world);
+    
+    CommandBuffer commands;
+    
+    double integrateMs = 0.0, commandsMs = 0.0, churnMs = 0.0;
+    
+    bool recordsMatch = world.Validate();
+    bool versionsMatch = true;
+    
+    for (int frame = 0; frame < frames; frame++)
+    {
+        uint32_t before = world.AdvanceVersion();
+        
+        start = std::chrono::steady_clock::now();
+        
+        moving.ParallelEach(&jobs, [](Position& position, const Velocity& velocity)
+        {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        });
+        
+        integrateMs += ElapsedMs(start);
+        
+        for (Expected& record : expected)
+        {
+            if (!record.alive || !record.hasVelocity) continue;
+            
+            record.position.x += record.velocity.x;
+            record.position.y += record.velocity.y;
+        }
+        
+        // Positions changed exactly where something moved; read-only columns never did.
+        positions.EachChunk([&](const ChunkView<const Position>& view)
+        {
+            versionsMatch = versionsMatch && view.HasChanged<Position>(before) == world.Has<Velocity>(view.GetEntities()[0]);
+        });
+        
+        velocities.EachChunk([&](const ChunkView<const Velocity>& view) { versionsMatch = versionsMatch && !view.HasChanged<Velocity>(before); });
+        healths.EachChunk([&](const ChunkView<const Health>& view) { versionsMatch = versionsMatch && !view.HasChanged<Health>(before); });
+        
+        // A mutable Get marks its chunk, a const one doesn't.
+        uint32_t beforeWrite = world.AdvanceVersion();
+        
+        Entity written, read;
+        
+        for (size_t i = (frame * 7919) % expected.size(), seen = 0; seen < expected.size() && !read.IsValid(); i = (i + 1) % expected.size(), seen++)
+        {
+            if (!expected[i].alive || !expected[i].hasHealth) continue;
+            
+            if (!written.IsValid()) written = expected[i].entity;
+            else read = expected[i].entity;
+        }
+        
+        if (written.IsValid())
+        {
+            world.Get<Health>(written)->value--;
+            expected[written.index].health.value--;
+        }
+        
+        if (read.IsValid()) std::as_const(world).Get<Health>(read);
+        
+        size_t changedChunks = 0;
+        bool foundWritten = false;
+        
+        healths.EachChunk([&](const ChunkView<const Health>& view)
+        {
+            if (!view.HasChanged<Health>(beforeWrite)) return;
+            
+            changedChunks++;
+            
+            for (size_t row = 0; row < view.Size(); row++)
+                foundWritten = foundWritten || view.GetEntities()[row] == written;
+        });
+        
+        versionsMatch = versionsMatch && (written.IsValid() ? changedChunks == 1 && foundWritten : changedChunks == 0);
+        
+        // Structural changes recorded from worker threads, applied after.
+        start = std::chrono::steady_clock::now();
+        
+        healths.ParallelEach(&jobs, [&](Entity entity, const Health&)
+        {
+            switch ((entity.index + frame) % 32)
+            {
+                case 0: commands.Destroy(entity); break;
+                case 1: commands.Remove<Health>(entity); break;
+                case 2: commands.Add(entity, Velocity{ 1.0f, 1.0f }); break;
+                case 3: commands.Add(entity, Name{ "unit " + std::to_string(entity.index) }); break;
+            }
+        });
+        
+        commands.Playback(world);
+        
+        commandsMs += ElapsedMs(start);
+        
+        size_t destroyedCount = 0;
+        
+        for (Expected& record : expected)
+        {
+            if (!record.alive || !record.hasHealth) continue;
+            
+            switch ((record.entity.index + frame) % 32)
+            {
+                case 0:
+                    record.alive = false;
+                    destroyed.push_back(record.entity);
+                    destroyedCount++;
+                    break;
+                case 1:
+                    record.hasHealth = false;
+                    break;
+                case 2:
+                    record.hasVelocity = true;
+                    record.velocity = { 1.0f, 1.0f };
+                    break;
+                case 3:
+                    record.hasName = true;
+                    record.name = "unit " + std::to_string(record.entity.index);
+                    break;
+            }
+        }
+        
+        // Direct changes on random entities, then refill what was destroyed.
+        std::vector<uint32_t> picks(entityCount / 50);
+        for (uint32_t& pick : picks) pick = rng() % expected.size();
+        
+        start = std::chrono::steady_clock::now();
+        
+        for (size_t i = 0; i < picks.size(); i++)
+        {
+            Expected& record = expected[picks[i]];
+            if (!record.alive) continue;
+            
+            switch (i % 4)
+            {
+                case 0:
+                    world.Destroy(record.entity);
+                    record.alive = false;
+                    destroyed.push_back(record.entity);
+                    destroyedCount++;
+                    break;
+                case 1:
+                    world.Remove<Velocity>(record.entity);
+                    record.hasVelocity = false;
+                    break;
+                case 2:
+                    world.Add<Health>(record.entity, 50);
+                    record.hasHealth = true;
+                    record.health.value = 50;
+                    break;
+                case 3:
+                    world.Remove<Name>(record.entity);
+                    record.hasName = false;
+                    break;
+            }
+        }
+        
+        for (size_t i = 0; i < destroyedCount; i++)
+            Spawn(world, expected, nextSeed++);
+        
+        churnMs += ElapsedMs(start);
+        
+        recordsMatch = recordsMatch && world.Validate();
+    }
+    
+    recordsMatch = recordsMatch && CheckEntities(world, expected, destroyed) && positions.Count() == world.GetEntityCount();
+    
+    std::printf("ecs: %zu entities, %zu archetypes, %d frames\n", world.GetEntityCount(), world.GetArchetypeCount(), frames);
+    std::printf("%-20s %10s\n", "phase", "ms");
+    std::printf("%-20s %10.3f\n", "create", createMs);
+    std::printf("%-20s %10.3f\n", "integrate/frame", integrateMs / frames);
+    std::printf("%-20s %10.3f\n", "commands/frame", commandsMs / frames);
+    std::printf("%-20s %10.3f\n", "churn/frame", churnMs / frames);
+    
+    std::printf("%s, %s\n", recordsMatch ? "records match" : "RECORDS DIFFER", versionsMatch ? "versions match" : "VERSIONS DIFFER");
+    
+    world.Clear();
+    
+    return recordsMatch && versionsMatch ? 0 : 1;
+}
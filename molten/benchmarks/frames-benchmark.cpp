@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../engine/core/renderer/headless-render-device.h"
+#include "../engine/core/renderer/renderer-2D.h"
+
+#include "benchmarks.h"
+
+// Bytes the last frame bound as its batch, or nullptr if it bound none.
+static const uint8_t* FindBoundBatch(const HeadlessRenderDevice& device)
+{
+    for (const RenderCommand& command : device.GetCommands())
+    {
+        if (command.type != RenderCommandType::SetVertexBuffer || command.index != 0) continue;
+        
+        const std::vector<uint8_t>* contents = device.GetBufferContents(BufferHandle{ command.handle });
+        return contents ? contents->data() + command.first : nullptr;
+    }
+    
+    return nullptr;
+}
+
+// Renders with every frame slot kept in flight, completing the oldest frame
+// only once the ring is full, as a GPU running behind would. Each frame moves
+// a different share of the sprites, so a slice coming back around has to
+// catch up on what changed while it was in flight; its bytes are checked
+// against the CPU batch and its slot against the frame number.
+int RunFramesBenchmark(int argc, char** argv)
+{
+    size_t spriteCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    uint32_t framesInFlight = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 3;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 100;
+    
+    if (spriteCount == 0 || framesInFlight == 0 || framesInFlight > FrameSync::MaxFramesInFlight || frames <= 0)
+    {
+        std::printf("frames: sprites and frames must be positive, frames in flight 1 to %u\n", FrameSync::MaxFramesInFlight);
+        return 1;
+    }
+    
+    HeadlessRenderDevice device(true, framesInFlight);
+    device.SetManualCompletion(true);
+    
+    Renderer2D renderer(&device, 1280, 720);
+    
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> x(0.0f, 1280.0f);
+    std::uniform_real_distribution<float> y(0.0f, 720.0f);
+    
+    std::vector<SpriteHandle> handles;
+    
+    for (size_t i = 0; i < spriteCount; i++)
+        handles.push_back(renderer.CreateSprite({ x(rng), y(rng) }, { 16.0f, 16.0f }));
+    
+    // Moves every Stride-th sprite, starting at a different one each frame.
+    static constexpr size_t Stride = 7;
+    
+    int wrongSlots = 0;
+    int staleSlices = 0;
+    
+    device.ResetStats();
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (size_t i = frame % Stride; i < handles.size(); i += Stride)
+            renderer.GetSprites().SetPosition(handles[i], { x(rng), y(rng) });
+        
+        if (device.GetUncompletedFrames() == framesInFlight) device.CompleteFrame();
+        
+        device.ClearCommands();
+        renderer.PrepareRenderingData();
+        renderer.IssueRenderCall();
+        
+        if (device.GetFrameSlot() != frame % framesInFlight || device.GetUncompletedFrames() > framesInFlight) wrongSlots++;
+        
+        const SpriteBatch2D& batch = renderer.GetBatch();
+        const uint8_t* bound = FindBoundBatch(device);
+        
+        if (!bound || std::memcmp(bound, batch.GetData(), batch.GetByteSize()) != 0) staleSlices++;
+    }
+    
+    auto end = std::chrono::steady_clock::now();
+    
+    double ms = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+    double uploaded = static_cast<double>(device.GetStats().bytesUploaded) / frames;
+    
+    // Cleanup waits for every frame to finish.
+    while (device.CompleteFrame()) {}
+    renderer.Cleanup();
+    
+    bool valid = wrongSlots == 0 && staleSlices == 0;
+    
+    std::printf("frames: %zu sprites, %u frames in flight, %d frames\n", spriteCount, framesInFlight, frames);
+    std::printf("%.3f ms/frame, %.1f KB uploaded/frame\n", ms, uploaded / 1024.0);
+    
+    if (valid) std::printf("slots rotate and slices match\n");
+    else std::printf("SLICES DIFFER: %d wrong slots, %d stale slices\n", wrongSlots, staleSlices);
+    
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstring>
+
+#include "../engine/core/utils/logger.h"
+#include "../engine/core/utils/profiler.h"
+
+#include "benchmarks.h"
+
+struct BenchmarkEntry
+{
+    const char* name;
+    const char* usage;
+    int (*run)(int argc, char** argv);
+};
+
+static const BenchmarkEntry s_Benchmarks[] =
+{
+    { "batch", "batch [sprites=100000] [max-threads=hardware] [iterations=50]", RunBatchBenchmark },
+    { "physics", "physics [bodies=10000] [max-threads=hardware] [steps=300]", RunPhysicsBenchmark },
+    { "maths", "maths [count=1000000] [iterations=50]", RunMathsBenchmark },
+    { "transforms", "transforms [ships=100] [parts=300] [frames=100]", RunTransformsBenchmark },
+    { "frames", "frames [sprites=10000] [frames-in-flight=3] [frames=100]", RunFramesBenchmark },
+    { "archive", "archive [max-size=16777216] [files=200]", RunArchiveBenchmark },
+    { "ecs", "ecs [entities=200000] [frames=20]", RunEcsBenchmark },
+};
+
+int main(int argc, char** argv)
+{
+    Logger::Init();
+    PROFILE_THREAD("Main");
+    
+    // --trace <file> records the whole run with the profiler.
+    const char* tracePath = nullptr;
+    
+    if (argc >= 3 && std::strcmp(argv[1], "--trace") == 0)
+    {
+        tracePath = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    
+    if (argc >= 2)
+    {
+        for (const BenchmarkEntry& entry : s_Benchmarks)
+        {
+            if (std::strcmp(argv[1], entry.name) != 0) continue;
+            
+            if (tracePath) Profiler::StartCapture();
+            
+            int result = entry.run(argc - 1, argv + 1);
+            
+            if (tracePath && !Profiler::WriteChromeTrace(tracePath)) result = 1;
+            
+            return result;
+        }
+    }
+    
+    std::printf("usage: molten.bench [--trace <file>] <benchmark> [args]\n");
+    
+    for (const BenchmarkEntry& entry : s_Benchmarks)
+        std::printf("  %s\n", entry.usage);
+    
+    return 1;
+}
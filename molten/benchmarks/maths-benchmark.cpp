@@ -0,0 +1,131 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../engine/core/maths/batch-transforms.h"
+
+#include "benchmarks.h"
+
+template <typename Function>
+static double TimeMs(int iterations, Function&& function)
+{
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int i = 0; i < iterations; i++)
+        function();
+    
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+static bool NearlyEqual(const Vec2& a, const Vec2& b)
+{
+    return std::fabs(a.x - b.x) <= 1e-3f * (1.0f + std::fabs(a.x)) && std::fabs(a.y - b.y) <= 1e-3f * (1.0f + std::fabs(a.y));
+}
+
+static void Report(const char* name, double scalarMs, double batchedMs, bool matches)
+{
+    std::printf("%-20s %10.3f %10.3f %8.2fx%s\n", name, scalarMs, batchedMs, scalarMs / batchedMs,
+                matches ? "" : "  OUTPUT DIFFERS");
+}
+
+// Runs the batched transform routines against a plain per-element loop over
+// the same data and checks that both agree.
+int RunMathsBenchmark(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+    
+    if (count == 0 || iterations <= 0)
+    {
+        std::printf("maths: count and iterations must be positive\n");
+        return 1;
+    }
+    
+    std::vector<Vec2> positions(count);
+    std::vector<float> rotations(count);
+    std::vector<Vec2> scales(count);
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        positions[i] = { static_cast<float>(i % 1000), static_cast<float>(i / 1000) };
+        rotations[i] = i % 4 == 0 ? 0.0f : 0.001f * static_cast<float>(i % 6283);
+        scales[i] = { 1.0f + 0.01f * (i % 7), 1.0f + 0.01f * (i % 5) };
+    }
+    
+    const Affine2D parent = Affine2D::FromTRS({ 120.0f, -40.0f }, 0.3f, { 2.0f, 0.5f });
+    
+    std::vector<Affine2D> locals(count), worldScalar(count), worldBatched(count);
+    std::vector<Vec2> pointsScalar(count), pointsBatched(count);
+    
+    std::printf("maths: %zu elements, %d iterations\n", count, iterations);
+    std::printf("%-20s %10s %10s %9s\n", "routine", "scalar ms", "batched ms", "speedup");
+    
+    double scalarMs = TimeMs(iterations, [&]
+    {
+        for (size_t i = 0; i < count; i++)
+            locals[i] = Affine2D::FromTRS(positions[i], rotations[i], scales[i]);
+    });
+    
+    double batchedMs = TimeMs(iterations, [&] { ComposeAffine2D(positions, rotations, scales, locals); });
+    Report("ComposeAffine2D", scalarMs, batchedMs, true);
+    
+    std::vector<Affine2D> parents(count, parent);
+    
+    scalarMs = TimeMs(iterations, [&]
+    {
+        for (size_t i = 0; i < count; i++)
+            worldScalar[i] = parents[i] * locals[i];
+    });
+    
+    batchedMs = TimeMs(iterations, [&] { MultiplyAffine2D(parents, locals, worldBatched); });
+    
+    bool matches = true;
+    
+    for (size_t i = 0; i < count && matches; i++)
+        for (int c = 0; c < 3; c++)
+            matches = matches && NearlyEqual(worldScalar[i].columns[c], worldBatched[i].columns[c]);
+    
+    Report("MultiplyAffine2D", scalarMs, batchedMs, matches);
+    
+    scalarMs = TimeMs(iterations, [&]
+    {
+        for (size_t i = 0; i < count; i++)
+            pointsScalar[i] = parent.TransformPoint(positions[i]);
+    });
+    
+    batchedMs = TimeMs(iterations, [&] { TransformPoints(parent, positions, pointsBatched); });
+    
+    bool pointsMatch = true;
+    
+    for (size_t i = 0; i < count && pointsMatch; i++)
+        pointsMatch = NearlyEqual(pointsScalar[i], pointsBatched[i]);
+    
+    Report("TransformPoints", scalarMs, batchedMs, pointsMatch);
+    
+    return matches && pointsMatch ? 0 : 1;
+}
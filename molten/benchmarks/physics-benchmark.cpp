@@ -0,0 +1,201 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../engine/core/physics/physics-world-2D.h"
+#include "../engine/core/jobs/job-system.h"
+#include "../engine/core/utils/profiler.h"
+
+#include "benchmarks.h"
+
+// Bins separated by walls, so the piles form islands the solver can spread
+// across workers.
+static constexpr int BinCount = 16;
+static constexpr float BinWidth = 400.0f;
+static constexpr float BodySpacing = 25.0f;
+
+static void BuildScene(PhysicsWorld2D& world, size_t bodyCount, std::vector<BodyHandle>& bodies)
+{
+    BodyDesc wall;
+    wall.type = BodyType::Static;
+    
+    float width = BinCount * BinWidth;
+    size_t perBin = (bodyCount + BinCount - 1) / BinCount;
+    int columns = static_cast<int>(BinWidth / BodySpacing) - 1;
+    float height = (perBin / columns + 2) * BodySpacing + 100.0f;
+    
+    wall.position = { 0.5f * width, -20.0f };
+    world.CreateBox(wall, { 0.5f * width + 20.0f, 20.0f });
+    
+    for (int bin = 0; bin <= BinCount; bin++)
+    {
+        wall.position = { bin * BinWidth, 0.5f * height };
+        world.CreateBox(wall, { 5.0f, 0.5f * height });
+    }
+    
+    Vec2 hexagon[6];
+    
+    for (int i = 0; i < 6; i++)
+        hexagon[i] = { 12.0f * std::cos(i * 1.0472f), 12.0f * std::sin(i * 1.0472f) };
+    
+    for (size_t i = 0; i < bodyCount; i++)
+    {
+        size_t bin = i % BinCount;
+        size_t slot = i / BinCount;
+        
+        BodyDesc body;
+        body.position = { bin * BinWidth + 20.0f + (slot % columns) * BodySpacing + (slot / columns % 2) * 4.0f,
+                          30.0f + (slot / columns) * BodySpacing };
+        body.rotation = 0.1f * (i % 7);
+        
+        if (i % 3 == 0) bodies.push_back(world.CreateCircle(body, 10.0f));
+        else if (i % 3 == 1) bodies.push_back(world.CreateBox(body, { 10.0f, 10.0f }));
+        else bodies.push_back(world.CreatePolygon(body, hexagon, 6));
+    }
+}
+
+static uint64_t Checksum(const PhysicsWorld2D& world)
+{
+    uint64_t hash = 1469598103934665603ull;
+    
+    const float* columns[3] = { world.GetPositionsX(), world.GetPositionsY(), world.GetRotations() };
+    
+    for (const float* column : columns)
+    {
+        for (size_t i = 0; i < world.Size(); i++)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &column[i], sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+    }
+    
+    return hash;
+}
+
+// Removes the bottom row of every settled pile at once. Everything left
+// rested on it, directly or through the bodies above, so one step later
+// nothing may still be asleep.
+static bool CheckRemovalWakes(PhysicsWorld2D& world, std::vector<BodyHandle>& bodies)
+{
+    size_t sleeping = 0;
+    
+    for (BodyHandle body : bodies)
+        sleeping += !world.IsAwake(body);
+    
+    std::vector<BodyHandle> remaining;
+    size_t removed = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (BodyHandle body : bodies)
+    {
+        if (world.GetPosition(body).y < 2.0f * BodySpacing) { world.Destroy(body); removed++; }
+        else remaining.push_back(body);
+    }
+    
+    auto removedAt = std::chrono::steady_clock::now();
+    
+    world.Step(1.0f / 60.0f);
+    
+    auto end = std::chrono::steady_clock::now();
+    
+    size_t asleep = 0;
+    
+    for (BodyHandle body : remaining)
+        asleep += !world.IsAwake(body);
+    
+    std::printf("removed %zu of %zu bodies (%zu asleep) in %.3f ms, stepped in %.3f ms, %s\n", removed, bodies.size(), sleeping,
+                std::chrono::duration<double, std::milli>(removedAt - start).count(),
+                std::chrono::duration<double, std::milli>(end - removedAt).count(),
+                asleep == 0 ? "everything above woke" : "BODIES LEFT FLOATING");
+    
+    return asleep == 0;
+}
+
+// Drops mixed shapes into walled bins and steps the same scene with 1..N
+// worker threads, checking that every thread count ends in the same state,
+// then that removing bodies wakes what rested on them.
+int RunPhysicsBenchmark(int argc, char** argv)
+{
+    size_t bodyCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : std::thread::hardware_concurrency();
+    int steps = argc > 3 ? std::atoi(argv[3]) : 300;
+    
+    if (bodyCount == 0 || maxThreads == 0 || steps <= 0)
+    {
+        std::printf("physics: bodies, threads and steps must be positive\n");
+        return 1;
+    }
+    
+    std::printf("physics: %zu bodies in %d bins, %d steps of 1/60 s\n", bodyCount, BinCount, steps);
+    std::printf("%8s %10s %10s %9s %9s %9s\n", "threads", "ms/step", "contacts", "islands", "awake", "speedup");
+    
+    uint64_t reference = 0;
+    double singleThreadMs = 0.0;
+    
+    for (unsigned int threads = 1; threads <= maxThreads; threads++)
+    {
+        JobSystem jobs(threads);
+        
+        PhysicsWorld2D world;
+        world.SetJobSystem(&jobs);
+        
+        std::vector<BodyHandle> bodies;
+        BuildScene(world, bodyCount, bodies);
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        for (int i = 0; i < steps; i++)
+        {
+            world.Step(1.0f / 60.0f);
+            PROFILE_FRAME();
+        }
+        
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / steps;
+        if (threads == 1) singleThreadMs = ms;
+        
+        uint64_t checksum = Checksum(world);
+        if (threads == 1) reference = checksum;
+        
+        const PhysicsStats& stats = world.GetStats();
+        
+        std::printf("%8u %10.3f %10zu %9zu %9zu %8.2fx%s\n", threads, ms, stats.contacts, stats.islands,
+                    stats.awakeBodies, singleThreadMs / ms,
+                    checksum == reference ? "" : "  OUTPUT DIFFERS");
+        
+        if (checksum != reference) return 1;
+        
+        if (threads == maxThreads && !CheckRemovalWakes(world, bodies)) return 1;
+    }
+    
+    return 0;
+}
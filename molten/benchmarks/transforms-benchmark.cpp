@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../engine/core/renderer/transform-hierarchy-2D.h"
+
+#include "benchmarks.h"
+
+// Each ship is a hull with parts attached in short chains (turret, barrel,
+// muzzle), every node driving its own sprite.
+static constexpr int ChainLength = 3;
+
+static void BuildShips(TransformHierarchy2D& transforms, SpriteStore& sprites, size_t shipCount, size_t partsPerShip,
+                       std::vector<TransformHandle>& roots)
+{
+    for (size_t ship = 0; ship < shipCount; ship++)
+    {
+        Vec2 position = { static_cast<float>(ship % 32) * 500.0f, static_cast<float>(ship / 32) * 500.0f };
+        
+        TransformHandle root = transforms.Create(TransformHandle(), position, 0.1f * (ship % 5));
+        transforms.AttachSprite(root, sprites.Create(position, { 200.0f, 80.0f }, 0.0f, { 1.0f, 1.0f, 1.0f, 1.0f }), { 200.0f, 80.0f });
+        roots.push_back(root);
+        
+        TransformHandle parent = root;
+        
+        for (size_t part = 0; part < partsPerShip; part++)
+        {
+            if (part % ChainLength == 0) parent = root;
+            
+            float angle = 0.37f * static_cast<float>(part);
+            Vec2 offset = { 60.0f * std::cos(angle), 30.0f * std::sin(angle) };
+            
+            TransformHandle node = transforms.Create(parent, offset, 0.05f * (part % 9), { 0.9f, 0.9f });
+            transforms.AttachSprite(node, sprites.Create({ 0.0f, 0.0f }, { 10.0f, 10.0f }, 0.0f, { 1.0f, 1.0f, 1.0f, 1.0f }), { 10.0f, 10.0f });
+            parent = node;
+        }
+    }
+}
+
+// World transform by walking the parent chain, as a reference for the cached ones.
+static Affine2D ComputeWorld(const TransformHierarchy2D& transforms, TransformHandle handle)
+{
+    Affine2D world;
+    
+    for (; handle.IsValid(); handle = transforms.GetParent(handle))
+        world = Affine2D::FromTRS(transforms.GetPosition(handle), transforms.GetRotation(handle), transforms.GetScale(handle)) * world;
+    
+    return world;
+}
+
+static bool CheckWorlds(const TransformHierarchy2D& transforms)
+{
+    const uint32_t* parents = transforms.GetParents();
+    const uint32_t* subtreeSizes = transforms.GetSubtreeSizes();
+    
+    for (uint32_t i = 0; i < transforms.Size(); i++)
+    {
+        // Depth-first: parents first, subtrees contiguous and inside their parent's.
+        if (parents[i] != TransformHierarchy2D::InvalidIndex &&
+            (parents[i] >= i || i + subtreeSizes[i] > parents[i] + subtreeSizes[parents[i]])) return false;
+        
+        Affine2D expected = ComputeWorld(transforms, transforms.HandleAt(i));
+        Affine2D actual = transforms.GetWorlds()[i];
+        
+        for (int c = 0; c < 3; c++)
+        {
+            Vec2 difference = expected.columns[c] - actual.columns[c];
+            if (std::fabs(difference.x) > 1e-2f || std::fabs(difference.y) > 1e-2f) return false;
+        }
+    }
+    
+    return true;
+}
+
+// Moves a growing share of the ships each frame and reports what Update
+// recomputes, then reparents and destroys nodes and checks every cached
+// world transform against its parent chain.
+int RunTransformsBenchmark(int argc, char** argv)
+{
+    size_t shipCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+    size_t partsPerShip = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 100;
+    
+    if (shipCount == 0 || frames <= 0)
+    {
+        std::printf("transforms: ships and frames must be positive\n");
+        return 1;
+    }
+    
+    TransformHierarchy2D transforms;
+    SpriteStore sprites;
+    std::vector<TransformHandle> roots;
+    
+    BuildShips(transforms, sprites, shipCount, partsPerShip, roots);
+    transforms.Update(&sprites);
+    sprites.ClearDirty();
+    
+    std::printf("transforms: %zu ships of %zu parts, %zu nodes, %d frames\n", shipCount, partsPerShip, transforms.Size(), frames);
+    std::printf("%8s %10s %10s %12s\n", "moving", "ms/frame", "updated", "ns/node");
+    
+    for (size_t moving : { size_t(0), size_t(1), shipCount / 10, shipCount })
+    {
+        if (moving > shipCount) continue;
+        
+        size_t updated = 0;
+        auto start = std::chrono::steady_clock::now();
+        
+        for (int frame = 0; frame < frames; frame++)
+        {
+            for (size_t ship = 0; ship < moving; ship++)
+            {
+                transforms.Move(roots[ship], { 1.0f, 0.5f });
+                transforms.Rotate(roots[ship], 0.01f);
+            }
+            
+            transforms.Update(&sprites);
+            updated += transforms.GetUpdatedCount();
+            sprites.ClearDirty();
+        }
+        
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+        double perFrame = static_cast<double>(updated) / frames;
+        
+        std::printf("%8zu %10.3f %10.0f %12.1f\n", moving, ms, perFrame, perFrame > 0.0 ? ms * 1e6 / perFrame : 0.0);
+    }
+    
+    // Dock some ships onto their neighbours, sink a few and bolt a part onto
+    // the first one, which inserts in the middle of the columns.
+    for (size_t i = 1; i < roots.size(); i += 7)
+        transforms.SetParent(roots[i], roots[i - 1]);
+    
+    for (size_t i = 2; i < roots.size(); i += 11)
+        transforms.Destroy(roots[i]);
+    
+    transforms.Create(roots[0], { 5.0f, 5.0f }, 0.2f);
+    
+    transforms.Update(&sprites);
+    
+    bool valid = CheckWorlds(transforms);
+    std::printf("after reparenting and destroying: %zu nodes, %s\n", transforms.Size(), valid ? "worlds match" : "WORLDS DIFFER");
+    
+    return valid ? 0 : 1;
+}
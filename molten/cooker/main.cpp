@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "../engine/core/utils/logger.h"
+#include "../engine/core/jobs/job-system.h"
+#include "../engine/core/renderer/cooked-texture.h"
+#include "../engine/core/renderer/texture-atlas.h"
+
+namespace fs = std::filesystem;
+
+struct CookJob
+{
+    fs::path source;
+    fs::path output;
+};
+
+static bool IsSourceImage(const fs::path& path)
+{
+    std::string extension = path.extension().string();
+    
+    for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+}
+
+static bool IsUpToDate(const CookJob& job)
+{
+    std::error_code error;
+    
+    auto outputTime = fs::last_write_time(job.output, error);
+    if (error) return false;
+    
+    return fs::last_write_time(job.source, error) <= outputTime && !error;
+}
+
+static void PrintUsage()
+{
+    std::printf("usage: molten.cook [options] <image or directory>...\n");
+    std::printf("  Cooks images into .mtex files next to them, or under -o keeping\n");
+    std::printf("  their layout relative to the directory they were found in.\n");
+    std::printf("  -o <dir>    output directory\n");
+    std::printf("  --bc1       BC1 compression, 1-bit alpha\n");
+    std::printf("  --bc3       BC3 compression, full alpha\n");
+    std::printf("  --no-mips   only the top level\n");
+    std::printf("  --linear    filter mips as data rather than sRGB color\n");
+    std::printf("  --no-flip   keep the image's row order\n");
+    std::printf("  --force     cook even if the output is newer than the source\n");
+    std::printf("  --atlas <file>  bake every image into one atlas file instead,\n");
+    std::printf("                  keyed by path relative to the root\n");
+    std::printf("  -C <dir>    root the game runs from, the working directory by default\n");
+}
+
+int main(int argc, char** argv)
+{
+    Logger::Init();
+    
+    CookOptions options;
+    fs::path outputDirectory;
+    fs::path atlasPath;
+    fs::path root;
+    bool force = false;
+    
+    std::vector<CookJob> jobs;
+    
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputDirectory = argv[++i];
+        else if (std::strcmp(argv[i], "--bc1") == 0) options.format = TextureFormat::BC1RGBA;
+        else if (std::strcmp(argv[i], "--bc3") == 0) options.format = TextureFormat::BC3RGBA;
+        else if (std::strcmp(argv[i], "--no-mips") == 0) options.mipmaps = false;
+        else if (std::strcmp(argv[i], "--linear") == 0) options.mipFilter.gammaCorrect = false;
+        else if (std::strcmp(argv[i], "--no-flip") == 0) options.flipVertically = false;
+        else if (std::strcmp(argv[i], "--force") == 0) force = true;
+        else if (std::strcmp(argv[i], "--atlas") == 0 && i + 1 < argc) atlasPath = argv[++i];
+        else if (std::strcmp(argv[i], "-C") == 0 && i + 1 < argc) root = argv[++i];
+        else if (argv[i][0] == '-') { PrintUsage(); return 1; }
+        else
+        {
+            fs::path input = argv[i];
+            std::error_code error;
+            
+            auto addJob = [&](const fs::path& source, const fs::path& base)
+            {
+                fs::path output = outputDirectory.empty() ? source : outputDirectory / fs::relative(source, base, error);
+                output.replace_extension(CookedTexture::Extension);
+                
+                jobs.push_back({ source, output });
+            };
+            
+            if (fs::is_directory(input, error))
+            {
+                for (const auto& entry : fs::recursive_directory_iterator(input, error))
+                    if (entry.is_regular_file() && IsSourceImage(entry.path())) addJob(entry.path(), input);
+            }
+            else if (fs::is_regular_file(input, error))
+            {
+                addJob(input, input.has_parent_path() ? input.parent_path() : fs::path("."));
+            }
+            else
+            {
+                std::fprintf(stderr, "No such file or directory: %s\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+    
+    if (jobs.empty()) { PrintUsage(); return 1; }
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    if (!atlasPath.empty())
+    {
+        std::vector<std::string> sources;
+        for (const CookJob& job : jobs) sources.push_back(job.source.string());
+        
+        std::string rootString = root.string();
+        
+        if (!TextureAtlas::Bake(sources, atlasPath.string().c_str(), 2048, 2, 1, root.empty() ? nullptr : rootString.c_str())) return 1;
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("baked %zu images into %s in %.2f s\n", sources.size(), atlasPath.string().c_str(), seconds);
+        
+        return 0;
+    }
+    
+    std::atomic<uint32_t> cooked{0}, skipped{0}, failed{0};
+    
+    JobSystem jobSystem;
+    
+    // One image per chunk; sizes vary too much for larger grains to balance.
+    jobSystem.ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const CookJob& job = jobs[i];
+            
+            if (!force && IsUpToDate(job)) { skipped++; continue; }
+            
+            std::error_code error;
+            fs::create_directories(job.output.parent_path(), error);
+            
+            if (CookedTexture::Cook(job.source.string().c_str(), job.output.string().c_str(), options)) cooked++;
+            else failed++;
+        }
+    });
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::printf("cooked %u, up to date %u, failed %u in %.2f s\n", cooked.load(), skipped.load(), failed.load(), seconds);
+    
+    return failed > 0 ? 1 : 0;
+}
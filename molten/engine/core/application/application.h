@@ -28,9 +28,18 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "frame-loop.h"
+
 class Window;
+class RenderDevice;
 class Renderer2D;
 class Game;
+class JobSystem;
+class World;
+class SpriteSystem;
+class PhysicsWorld2D;
 
 class Application
 {
@@ -38,14 +47,65 @@ private:
     
     Window* m_Window;
     Game* m_Game;
+    RenderDevice* m_RenderDevice;
     Renderer2D* m_Renderer;
+    JobSystem* m_JobSystem;
+    World* m_World;
+    SpriteSystem* m_SpriteSystem;
+    PhysicsWorld2D* m_Physics;
+    
+    LoopSettings m_Settings;
+    FixedStepClock m_Clock;
+    FramePacer m_Pacer;
+    
+    bool m_QuitRequested = false;
+    bool m_TraceWritten = false;
+    
+    // One tick of simulation: the game's fixed update, then physics.
+    void Tick(float dt);
+    
+    // Everything after the ticks of a frame: sprite sync, batch, submit.
+    void Render();
+    
+    void RunWindowed();
+    
+    void RunHeadless();
+    
+    // Marks the frame for the profiler and writes the trace once the
+    // capture is over.
+    void EndFrame();
     
 public:
     
-    explicit Application(unsigned int width, unsigned int height, const char* title, Game* game);
+    // Headless settings skip the window and Metal entirely; the renderer
+    // draws into a device that keeps nothing.
+    explicit Application(unsigned int width, unsigned int height, const char* title, Game* game,
+                         const LoopSettings& settings = LoopSettings());
     
     inline Renderer2D* GetRenderer2D() const { return m_Renderer; }
     
+    inline RenderDevice* GetRenderDevice() const { return m_RenderDevice; }
+    
+    inline JobSystem* GetJobSystem() const { return m_JobSystem; }
+    
+    inline World* GetWorld() const { return m_World; }
+    
+    inline PhysicsWorld2D* GetPhysics() const { return m_Physics; }
+    
+    inline const LoopSettings& GetLoopSettings() const { return m_Settings; }
+    
+    // Ticks run so far; the simulation time is this times the tick duration.
+    inline uint64_t GetTick() const { return m_Clock.GetTick(); }
+    
+    inline float GetTickDuration() const { return m_Clock.GetTickDuration(); }
+    
+    // How far the current frame is between the last tick and the next, for
+    // drawing state that only changes on ticks. Always 1 headless.
+    inline float GetInterpolationAlpha() const { return m_Settings.headless ? 1.0f : m_Clock.GetAlpha(); }
+    
+    // Ends Run after the current frame.
+    inline void Quit() { m_QuitRequested = true; }
+    
     void Run();
     
     ~Application();
@@ -22,7 +22,10 @@
 
 #include "application.h"
 
-#include <simd/simd.h>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <filesystem>
 
 #include <GLFW/glfw3.h>
 
@@ -30,43 +33,178 @@
 #include "../utils/logger.h"
 
 #include "../utils/log-macros.h"
+#include "../utils/profiler.h"
 
 #include "../renderer/renderer-2D.h"
+#include "../renderer/metal-render-device.h"
+#include "../renderer/headless-render-device.h"
+#include "../jobs/job-system.h"
+#include "../ecs/world.h"
+#include "../ecs/sprite-system.h"
+#include "../physics/physics-world-2D.h"
+#include "../assets/asset-loader.h"
+#include "../assets/asset-archive.h"
 
 #include "game.h"
 
 #include "input.h"
 
-Application::Application(unsigned int width, unsigned int height, const char* title, Game* game)
-: m_Window(new Window(width, height, title)), m_Game(game)
+static std::string GetPipelineCachePath()
 {
-    Input::Initialize(m_Window->GetInternalWindow());
+    const char* home = std::getenv("HOME");
     
+    return std::string(home ? home : ".") + "/Library/Caches/molten/pipelines.metallib";
+}
+
+Application::Application(unsigned int width, unsigned int height, const char* title, Game* game, const LoopSettings& settings)
+: m_Window(nullptr), m_Game(game), m_Settings(settings), m_Clock(settings.tickRate, settings.maxTicksPerFrame)
+{
     Logger::Init();
     
-    m_Renderer = new Renderer2D(m_Window);
+    PROFILE_THREAD("Main");
+    
+    if (m_Settings.profileTracePath)
+    {
+        if (!MOLTEN_PROFILE) LOG_CORE_WARN("Profiling is compiled out; {} will be empty.", m_Settings.profileTracePath);
+        
+        Profiler::StartCapture(m_Settings.profileFrameCount);
+    }
+    
+    // Development runs have no archive and read loose files.
+    std::error_code error;
+    if (m_Settings.assetArchivePath && std::filesystem::exists(m_Settings.assetArchivePath, error))
+        AssetArchive::Mount(m_Settings.assetArchivePath);
+    
+    m_JobSystem = new JobSystem();
+    AssetLoader::Initialize(m_JobSystem);
+    
+    if (m_Settings.headless)
+    {
+        // Nothing reads the commands back, so don't keep them.
+        m_RenderDevice = new HeadlessRenderDevice(false);
+    }
+    else
+    {
+        m_Window = new Window(width, height, title);
+        m_Window->SetVSync(m_Settings.vsync);
+        
+        Input::Initialize(m_Window->GetInternalWindow());
+        
+        m_RenderDevice = new MetalRenderDevice(m_Window);
+        m_RenderDevice->OpenPipelineCache(GetPipelineCachePath().c_str());
+    }
+    
+    m_Renderer = new Renderer2D(m_RenderDevice, width, height);
+    m_Renderer->SetJobSystem(m_JobSystem);
+    
+    m_World = new World();
+    m_SpriteSystem = new SpriteSystem(*m_World, m_Renderer);
+    
+    m_Physics = new PhysicsWorld2D();
+    m_Physics->SetJobSystem(m_JobSystem);
+    m_Physics->SetSprites(&m_Renderer->GetSprites());
+    m_Physics->SetFixedTimestep(m_Clock.GetTickDuration());
+    
+    m_Pacer.SetFrameRateLimit(m_Settings.headless ? 0.0f : m_Settings.frameRateLimit);
+    
+    if (m_Settings.replayInputPath) Input::StartReplay(m_Settings.replayInputPath);
+    if (m_Settings.recordInputPath) Input::StartRecording(m_Settings.recordInputPath, m_Settings.tickRate);
     
     if (m_Game) m_Game->SetApplication(this);
     if (m_Game) m_Game->OnStart();
     
+    m_SpriteSystem->Update();
+    m_Renderer->PrepareRenderingData();
+}
+
+void Application::Tick(float dt)
+{
+    PROFILE_SCOPE("Application::Tick");
+    
+    if (m_Game)
+    {
+        PROFILE_SCOPE("Game::OnFixedUpdate");
+        m_Game->OnFixedUpdate(dt);
+    }
+    
+    m_Physics->Step(dt);
+}
+
+void Application::Render()
+{
+    PROFILE_SCOPE("Application::Render");
+    
+    // Bodies and entities write their sprites first, so the frame shows
+    // this frame's state instead of the last one's.
+    m_Physics->WriteSprites(GetInterpolationAlpha());
+    m_SpriteSystem->Update();
     m_Renderer->PrepareRenderingData();
+    m_Renderer->IssueRenderCall();
 }
 
 void Application::Run()
 {
-    double lastTime = glfwGetTime();
+    if (m_Settings.headless) RunHeadless();
+    else RunWindowed();
+    
+    if (m_Game) m_Game->OnShutdown();
+    
+    // Runs that end before the capture does still get their trace.
+    if (m_Settings.profileTracePath && !m_TraceWritten)
+    {
+        Profiler::StopCapture();
+        m_TraceWritten = Profiler::WriteChromeTrace(m_Settings.profileTracePath);
+    }
+}
+
+void Application::EndFrame()
+{
+    PROFILE_FRAME();
     
-    while (m_Window->isOpen())
+    if (m_Settings.profileTracePath && !m_TraceWritten && !Profiler::IsCapturing())
+        m_TraceWritten = Profiler::WriteChromeTrace(m_Settings.profileTracePath);
+}
+
+void Application::RunWindowed()
+{
+    auto lastTime = std::chrono::steady_clock::now();
+    
+    while (m_Window->isOpen() && !m_QuitRequested)
     {
-        m_Window->HandleInputEvents();
-        m_Renderer->PrepareRenderingData();
+        {
+            PROFILE_SCOPE("Application::PollInput");
+            
+            m_Window->HandleInputEvents();
+        }
+        
+        {
+            PROFILE_SCOPE("Application::MainThreadJobs");
+            
+            m_JobSystem->RunMainThreadJobs();
+            AssetLoader::Update();
+        }
         
-        double currentTime = glfwGetTime();
-        float deltaTime = static_cast<float>(currentTime - lastTime);
+        auto currentTime = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(currentTime - lastTime).count();
         lastTime = currentTime;
-
+        
+        uint64_t firstTick = m_Clock.GetTick();
+        int ticks = m_Clock.Advance(elapsed);
+        
+        // Input is latched per tick, as a headless replay applies it.
+        for (int i = 0; i < ticks; i++)
+        {
+            Input::Update(firstTick + i);
+            Tick(m_Clock.GetTickDuration());
+        }
+        
+        Input::LatchFrame();
+        
         if (m_Game)
-            m_Game->OnUpdate(deltaTime);
+        {
+            PROFILE_SCOPE("Game::OnUpdate");
+            m_Game->OnUpdate(static_cast<float>(elapsed));
+        }
         
         @autoreleasepool
         {
@@ -78,24 +216,101 @@ void Application::Run()
                 m_Window->SetWidth(width);
                 m_Window->SetHeight(height);
                 
-                //TODO: update renderer proj matrix.
                 m_Renderer->UpdateProjMatrix(width, height);
             }
             
-            m_Renderer->IssueRenderCall();
+            Render();
+        }
+        
+        {
+            PROFILE_SCOPE("FramePacer::Wait");
+            m_Pacer.Wait();
         }
+        
+        EndFrame();
     }
+}
+
+void Application::RunHeadless()
+{
+    LOG_CORE_INFO("Running headless at {} ticks per simulated second", m_Settings.tickRate);
     
-    if (m_Game) m_Game->OnShutdown();
+    auto start = std::chrono::steady_clock::now();
+    
+    // Simulated time only: each iteration is exactly one tick, however long
+    // it took, so a run gives the same result on any machine.
+    while (!m_QuitRequested && (m_Settings.headlessTickLimit == 0 || m_Clock.GetTick() < m_Settings.headlessTickLimit))
+    {
+        if (m_Settings.headlessTickLimit == 0 && Input::IsReplayFinished()) break;
+        
+        {
+            PROFILE_SCOPE("Application::MainThreadJobs");
+            
+            m_JobSystem->RunMainThreadJobs();
+            AssetLoader::Update();
+        }
+        
+        uint64_t tick = m_Clock.GetTick();
+        m_Clock.Advance(m_Clock.GetTickDuration());
+        
+        float dt = m_Clock.GetTickDuration();
+        
+        Input::Update(tick);
+        Tick(dt);
+        Input::LatchFrame();
+        
+        if (m_Game)
+        {
+            PROFILE_SCOPE("Game::OnUpdate");
+            m_Game->OnUpdate(dt);
+        }
+        
+        if (m_Settings.headlessRendering)
+        {
+            @autoreleasepool
+            {
+                Render();
+            }
+        }
+        
+        EndFrame();
+    }
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    LOG_CORE_INFO("Headless run: {} ticks in {:.3f} s ({:.0f} ticks/s)", m_Clock.GetTick(), seconds,
+                  seconds > 0.0 ? m_Clock.GetTick() / seconds : 0.0);
 }
 
 Application::~Application()
 {
-    if(m_Window) delete m_Window;
-
+    Input::StopRecording();
+    Input::StopReplay();
+    
+    // Before the job system goes, since decodes may still be running on it.
+    AssetLoader::Shutdown();
+    
+    // Bodies and entities go first; their renderer sprites are released by Cleanup.
+    if(m_Physics) delete m_Physics;
+    if(m_SpriteSystem) delete m_SpriteSystem;
+    if(m_World) delete m_World;
+    
     if(m_Renderer)
     {
         m_Renderer->Cleanup();
         delete m_Renderer;
     }
+    
+    if(m_RenderDevice)
+    {
+        m_RenderDevice->SavePipelineCache();
+        delete m_RenderDevice;
+    }
+    
+    if(m_JobSystem) delete m_JobSystem;
+    
+    if(m_Window) delete m_Window;
+    
+    // Last, since textures may still point into the mapping until here.
+    AssetArchive::UnmountAll();
 }
@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "frame-loop.h"
+
+#include <thread>
+
+#include "../utils/log-macros.h"
+
+// Sleeps wake up late by about this much, so the end of a wait is spun.
+static constexpr std::chrono::microseconds SpinWindow(1500);
+
+FixedStepClock::FixedStepClock(float tickRate, int maxTicksPerFrame)
+{
+    if (tickRate <= 0.0f)
+    {
+        LOG_CORE_WARN("Tick rate must be positive, got {}; using 60", tickRate);
+        tickRate = 60.0f;
+    }
+    
+    m_TickDuration = 1.0 / tickRate;
+    m_MaxTicksPerFrame = maxTicksPerFrame > 0 ? maxTicksPerFrame : 1;
+}
+
+int FixedStepClock::Advance(double elapsed)
+{
+    if (elapsed > MaxFrameTime) elapsed = MaxFrameTime;
+    if (elapsed > 0.0) m_Accumulator += elapsed;
+    
+    int ticks = 0;
+    
+    while (m_Accumulator >= m_TickDuration && ticks < m_MaxTicksPerFrame)
+    {
+        m_Accumulator -= m_TickDuration;
+        ticks++;
+    }
+    
+    // Falling behind: keep only the fraction of a tick so alpha stays valid.
+    if (m_Accumulator >= m_TickDuration)
+        m_Accumulator -= m_TickDuration * static_cast<double>(static_cast<uint64_t>(m_Accumulator / m_TickDuration));
+    
+    m_Tick += ticks;
+    
+    return ticks;
+}
+
+void FramePacer::SetFrameRateLimit(float framesPerSecond)
+{
+    if (framesPerSecond <= 0.0f)
+    {
+        m_FrameDuration = Clock::duration::zero();
+        return;
+    }
+    
+    m_FrameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+    m_NextFrame = Clock::now() + m_FrameDuration;
+}
+
+void FramePacer::Wait()
+{
+    if (m_FrameDuration == Clock::duration::zero()) return;
+    
+    Clock::time_point now = Clock::now();
+    
+    if (m_NextFrame - now > SpinWindow)
+        std::this_thread::sleep_for(m_NextFrame - now - SpinWindow);
+    
+    while (Clock::now() < m_NextFrame)
+        std::this_thread::yield();
+    
+    // Late frames restart the schedule instead of rushing to catch up.
+    now = Clock::now();
+    m_NextFrame += m_FrameDuration;
+    if (m_NextFrame < now) m_NextFrame = now + m_FrameDuration;
+}
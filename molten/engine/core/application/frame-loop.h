@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+struct LoopSettings
+{
+    // Simulation ticks per second. Game::OnFixedUpdate and physics always
+    // advance by exactly one tick.
+    float tickRate = 60.0f;
+    
+    // Ticks run in one frame at most. When the simulation can't keep up,
+    // the rest of the time is dropped rather than piling up.
+    int maxTicksPerFrame = 8;
+    
+    // Frames per second when positive; otherwise vsync, or nothing, paces
+    // the loop.
+    float frameRateLimit = 0.0f;
+    
+    bool vsync = true;
+    
+    // No window and no wall clock: every loop iteration is one tick of
+    // simulated time, as fast as the machine goes. Runs are reproducible,
+    // for simulations and benchmarks on build servers.
+    bool headless = false;
+    
+    // Headless runs stop after this many ticks; 0 runs until Quit.
+    uint64_t headlessTickLimit = 0;
+    
+    // Headless runs still build and submit every frame, to a device that
+    // draws nothing, unless this is off.
+    bool headlessRendering = true;
+    
+    // Input events are written to this file as they're applied.
+    const char* recordInputPath = nullptr;
+    
+    // Input comes from this recording instead of the keyboard. A headless
+    // run without a tick limit stops when the recording ends.
+    const char* replayInputPath = nullptr;
+    
+    // Assets under the working directory are read from this archive (see
+    // AssetArchive) when it exists, and from loose files otherwise.
+    const char* assetArchivePath = nullptr;
+    
+    // The built-in profiler captures the first profileFrameCount frames (0
+    // for the whole run) and writes them here as a Chrome trace. Builds
+    // without MOLTEN_PROFILE write an empty one.
+    const char* profileTracePath = nullptr;
+    uint32_t profileFrameCount = 300;
+};
+
+// Turns variable frame times into a whole number of fixed ticks, keeping
+// the remainder for the next frame and for interpolating between ticks.
+class FixedStepClock
+{
+private:
+    
+    double m_TickDuration = 1.0 / 60.0;
+    double m_Accumulator = 0.0;
+    
+    int m_MaxTicksPerFrame = 8;
+    
+    uint64_t m_Tick = 0;
+    
+public:
+    
+    // A frame longer than this counts as this long, e.g. after a breakpoint.
+    static constexpr double MaxFrameTime = 0.25;
+    
+    explicit FixedStepClock(float tickRate = 60.0f, int maxTicksPerFrame = 8);
+    
+    // Adds the time a frame took and returns how many ticks to run for it.
+    int Advance(double elapsed);
+    
+    // How far between the last tick and the next one the frame is, 0 to 1.
+    inline float GetAlpha() const { return static_cast<float>(m_Accumulator / m_TickDuration); }
+    
+    inline float GetTickDuration() const { return static_cast<float>(m_TickDuration); }
+    
+    // Ticks run since the start.
+    inline uint64_t GetTick() const { return m_Tick; }
+};
+
+// Holds frames to a maximum rate. Sleeps for most of the wait and spins the
+// end of it, since sleeps overshoot by up to a millisecond or two.
+class FramePacer
+{
+private:
+    
+    using Clock = std::chrono::steady_clock;
+    
+    Clock::duration m_FrameDuration = Clock::duration::zero();
+    Clock::time_point m_NextFrame;
+    
+public:
+    
+    // 0 or less turns pacing off.
+    void SetFrameRateLimit(float framesPerSecond);
+    
+    // Blocks until the next frame is due.
+    void Wait();
+};
@@ -30,3 +30,21 @@ Renderer2D* Game::GetRenderer() const
     CORE_ASSERT(m_Application, "Game has no Application instance");
     return m_Application ? m_Application->GetRenderer2D() : nullptr;
 }
+
+JobSystem* Game::GetJobSystem() const
+{
+    CORE_ASSERT(m_Application, "Game has no Application instance");
+    return m_Application ? m_Application->GetJobSystem() : nullptr;
+}
+
+World* Game::GetWorld() const
+{
+    CORE_ASSERT(m_Application, "Game has no Application instance");
+    return m_Application ? m_Application->GetWorld() : nullptr;
+}
+
+PhysicsWorld2D* Game::GetPhysics() const
+{
+    CORE_ASSERT(m_Application, "Game has no Application instance");
+    return m_Application ? m_Application->GetPhysics() : nullptr;
+}
@@ -22,6 +22,9 @@
 
 class Application;
 class Renderer2D;
+class JobSystem;
+class World;
+class PhysicsWorld2D;
 
 #pragma once
 
@@ -38,10 +41,21 @@ public:
     
     Renderer2D* GetRenderer() const;
     
+    JobSystem* GetJobSystem() const;
+    
+    World* GetWorld() const;
+    
+    PhysicsWorld2D* GetPhysics() const;
+    
     // Called once at startup
     virtual void OnStart() = 0;
     
-    // Called every frame, dt in seconds
+    // Called at the fixed tick rate, before physics steps, dt is one tick in
+    // seconds. Simulation belongs here so it runs the same at any frame rate.
+    virtual void OnFixedUpdate(float /*dt*/) {}
+    
+    // Called every frame after the ticks, dt in seconds; headless, once per
+    // tick with the tick's dt
     virtual void OnUpdate(float dt) = 0;
     
     // Called before shutdown
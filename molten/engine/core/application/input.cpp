@@ -22,19 +22,46 @@
 
 #include "input.h"
 
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
 #include <GLFW/glfw3.h>
 
 #include "../utils/log-macros.h"
 
-int Input::MapKeycodeToGLFW(Keycode key)
+// Recording file: this header, then one RecordedEvent per applied event.
+struct RecordingHeader
 {
-    return static_cast<int>(key);
-}
+    char magic[4];
+    uint32_t version;
+    float tickRate;
+    uint32_t eventSize;
+    
+    // Last tick of the run, written when recording stops.
+    uint64_t length;
+};
+
+static constexpr char RecordingMagic[4] = { 'M', 'I', 'N', 'P' };
+static constexpr uint32_t RecordingVersion = 2;
+
+static const std::chrono::steady_clock::time_point s_StartTime = std::chrono::steady_clock::now();
 
 GLFWwindow* Input::s_Window = nullptr;
-std::unordered_map<int, bool> Input::s_KeysDown;
-std::unordered_map<int, bool> Input::s_KeysUp;
-std::unordered_map<int, bool> Input::s_KeysHeld;
+Input::KeySet Input::s_KeysDown;
+Input::KeySet Input::s_KeysUp;
+Input::KeySet Input::s_KeysHeld;
+Input::KeySet Input::s_FrameDown;
+Input::KeySet Input::s_FrameUp;
+SpscQueue<InputEvent> Input::s_Events;
+std::atomic<uint32_t> Input::s_DroppedEvents = 0;
+FILE* Input::s_RecordFile = nullptr;
+uint64_t Input::s_RecordTick = 0;
+bool Input::s_Replaying = false;
+std::vector<Input::RecordedEvent> Input::s_Replay;
+size_t Input::s_ReplayNext = 0;
+uint64_t Input::s_ReplayTick = 0;
+uint64_t Input::s_ReplayLength = 0;
 
 void Input::Initialize(GLFWwindow* window)
 {
@@ -42,44 +69,189 @@ void Input::Initialize(GLFWwindow* window)
     glfwSetKeyCallback(window, KeyCallback);
 }
 
+double Input::GetTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - s_StartTime).count();
+}
+
 void Input::KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
-    if (action == GLFW_PRESS)
+    if (action == GLFW_PRESS) PushEvent(static_cast<Keycode>(key), KeyAction::Press);
+    else if (action == GLFW_RELEASE) PushEvent(static_cast<Keycode>(key), KeyAction::Release);
+}
+
+bool Input::PushEvent(Keycode key, KeyAction action)
+{
+    if (s_Events.Push({ GetTime(), static_cast<int32_t>(key), action })) return true;
+    
+    // Reported from Update, on the main thread.
+    s_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Input::Apply(int32_t key, KeyAction action)
+{
+    if (key < 0 || key >= KeyCount) return;
+    
+    if (action == KeyAction::Press)
     {
-        s_KeysDown[key] = true;
-        s_KeysHeld[key] = true;
+        s_KeysDown.set(key);
+        s_KeysHeld.set(key);
     }
-    else if (action == GLFW_RELEASE)
+    else
     {
-        s_KeysUp[key] = true;
-        s_KeysHeld[key] = false;
+        s_KeysUp.set(key);
+        s_KeysHeld.reset(key);
     }
 }
 
-void Input::Update()
+void Input::Update(uint64_t tick)
 {
-    // Clear keys down/up at the start of each frame
-    s_KeysDown.clear();
-    s_KeysUp.clear();
+    // Down and up only last one tick
+    s_KeysDown.reset();
+    s_KeysUp.reset();
+    
+    if (uint32_t dropped = s_DroppedEvents.exchange(0, std::memory_order_relaxed))
+        LOG_CORE_WARN("Input queue full, {} events dropped", dropped);
+    
+    InputEvent event;
+    
+    if (s_Replaying)
+    {
+        // Live input is thrown away so it can't change the run.
+        while (s_Events.Pop(event)) {}
+        
+        s_ReplayTick = tick;
+        
+        while (s_ReplayNext < s_Replay.size() && s_Replay[s_ReplayNext].tick <= tick)
+        {
+            const RecordedEvent& recorded = s_Replay[s_ReplayNext++];
+            Apply(recorded.key, static_cast<KeyAction>(recorded.action));
+        }
+        
+        s_FrameDown |= s_KeysDown;
+        s_FrameUp |= s_KeysUp;
+        
+        return;
+    }
+    
+    while (s_Events.Pop(event))
+    {
+        Apply(event.key, event.action);
+        
+        if (s_RecordFile && event.key >= 0 && event.key < KeyCount)
+        {
+            RecordedEvent recorded = { static_cast<uint32_t>(tick), static_cast<float>(event.time),
+                                       static_cast<int16_t>(event.key), static_cast<uint8_t>(event.action), 0 };
+            std::fwrite(&recorded, sizeof(recorded), 1, s_RecordFile);
+        }
+    }
+    
+    s_FrameDown |= s_KeysDown;
+    s_FrameUp |= s_KeysUp;
+    
+    s_RecordTick = tick;
+}
+
+void Input::LatchFrame()
+{
+    s_KeysDown = s_FrameDown;
+    s_KeysUp = s_FrameUp;
+    
+    s_FrameDown.reset();
+    s_FrameUp.reset();
+}
+
+bool Input::StartRecording(const char* path, float tickRate)
+{
+    StopRecording();
+    
+    s_RecordFile = std::fopen(path, "wb");
+    
+    if (!s_RecordFile)
+    {
+        LOG_CORE_ERROR("Could not open input recording {} for writing", path);
+        return false;
+    }
+    
+    RecordingHeader header;
+    std::memcpy(header.magic, RecordingMagic, sizeof(header.magic));
+    header.version = RecordingVersion;
+    header.tickRate = tickRate;
+    header.eventSize = sizeof(RecordedEvent);
+    header.length = 0;
+    
+    std::fwrite(&header, sizeof(header), 1, s_RecordFile);
+    s_RecordTick = 0;
+    
+    LOG_CORE_INFO("Recording input to {}", path);
+    
+    return true;
 }
 
-bool Input::GetKeyDown(Keycode key)
+void Input::StopRecording()
 {
-    int glfwKey = MapKeycodeToGLFW(key);
-    if (glfwKey == -1) return false;
-    return s_KeysDown[glfwKey];
+    if (!s_RecordFile) return;
+    
+    // Events only mark changes, so the length has to be stored to know how
+    // long the run went on after the last one.
+    uint64_t length = s_RecordTick;
+    std::fseek(s_RecordFile, offsetof(RecordingHeader, length), SEEK_SET);
+    std::fwrite(&length, sizeof(length), 1, s_RecordFile);
+    
+    std::fclose(s_RecordFile);
+    s_RecordFile = nullptr;
 }
 
-bool Input::GetKeyUp(Keycode key)
+bool Input::StartReplay(const char* path)
 {
-    int glfwKey = MapKeycodeToGLFW(key);
-    if (glfwKey == -1) return false;
-    return s_KeysUp[glfwKey];
+    StopReplay();
+    
+    FILE* file = std::fopen(path, "rb");
+    
+    if (!file)
+    {
+        LOG_CORE_ERROR("Could not open input recording {}", path);
+        return false;
+    }
+    
+    RecordingHeader header;
+    
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, RecordingMagic, sizeof(header.magic)) != 0 ||
+        header.version != RecordingVersion || header.eventSize != sizeof(RecordedEvent))
+    {
+        LOG_CORE_ERROR("{} is not an input recording this version can read", path);
+        std::fclose(file);
+        return false;
+    }
+    
+    RecordedEvent recorded;
+    
+    while (std::fread(&recorded, sizeof(recorded), 1, file) == 1)
+        s_Replay.push_back(recorded);
+    
+    std::fclose(file);
+    
+    s_Replaying = true;
+    s_ReplayNext = 0;
+    s_ReplayTick = 0;
+    s_ReplayLength = header.length;
+    
+    s_KeysDown.reset();
+    s_KeysUp.reset();
+    s_KeysHeld.reset();
+    s_FrameDown.reset();
+    s_FrameUp.reset();
+    
+    LOG_CORE_INFO("Replaying {} input events over {} ticks from {}", s_Replay.size(), s_ReplayLength, path);
+    
+    return true;
 }
 
-bool Input::GetKeyHeld(Keycode key)
+void Input::StopReplay()
 {
-    int glfwKey = MapKeycodeToGLFW(key);
-    if (glfwKey == -1) return false;
-    return s_KeysHeld[glfwKey];
+    s_Replaying = false;
+    s_Replay.clear();
+    s_ReplayNext = 0;
+    s_ReplayLength = 0;
 }
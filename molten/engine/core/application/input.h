@@ -24,30 +24,123 @@
 
 #include "keycode.h"
 
-#include <unordered_map>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "../utils/spsc-queue.h"
 
 class GLFWwindow;
 
+enum class KeyAction : uint8_t
+{
+    Press,
+    Release
+};
+
+// A key change, stamped in seconds since Input was initialized.
+struct InputEvent
+{
+    double time;
+    int32_t key;
+    KeyAction action;
+};
+
 class Input
 {
 public:
+    // Key codes are below this; it covers every GLFW key.
+    static constexpr int KeyCount = 512;
+    
     static void Initialize(GLFWwindow* window);
+    
+    // To be called before every fixed tick, with the tick about to run.
+    // Applies the events queued since the last call, or, when replaying, the
+    // recorded events up to that tick. Events that arrive during a frame
+    // which runs no tick wait for the next one, so each is seen by exactly
+    // one fixed update, live and in a replay.
+    static void Update(uint64_t tick);
+    
+    // To be called once per frame, after its ticks and before the variable
+    // update: down and up then cover every tick the frame ran, and are empty
+    // when it ran none, so a press is never missed or repeated there.
+    static void LatchFrame();
+    
+    // Queues a key change as if the platform reported it. Safe from one
+    // producer thread at a time while the main thread updates.
+    static bool PushEvent(Keycode key, KeyAction action);
+    
+    // Writes every event applied from now on to a binary file, stamped with
+    // the tick it was applied at.
+    static bool StartRecording(const char* path, float tickRate);
+    static void StopRecording();
+    inline static bool IsRecording() { return s_RecordFile != nullptr; }
+    
+    // Feeds a recording back in place of live input; GLFW is not needed.
+    // Applying the same events at the same ticks reproduces the run.
+    static bool StartReplay(const char* path);
+    static void StopReplay();
+    inline static bool IsReplaying() { return s_Replaying; }
+    
+    // Past the last recorded tick.
+    inline static bool IsReplayFinished() { return s_Replaying && s_ReplayTick >= s_ReplayLength; }
+    
+    inline static uint64_t GetReplayLength() { return s_ReplayLength; }
 
-    static void Update(); // To be called every frame
-
-    static bool GetKeyDown(Keycode key);
-    static bool GetKeyUp(Keycode key);
-    static bool GetKeyHeld(Keycode key);
+    // Pressed or released this tick (this frame after LatchFrame), and
+    // currently down.
+    inline static bool GetKeyDown(Keycode key) { return Lookup(s_KeysDown, key); }
+    inline static bool GetKeyUp(Keycode key) { return Lookup(s_KeysUp, key); }
+    inline static bool GetKeyHeld(Keycode key) { return Lookup(s_KeysHeld, key); }
 
 private:
+    using KeySet = std::bitset<KeyCount>;
+    
+    // Recorded events: the tick they were applied at and the change.
+    struct RecordedEvent
+    {
+        uint32_t tick;
+        float time;
+        int16_t key;
+        uint8_t action;
+        uint8_t reserved;
+    };
+    
     static GLFWwindow* s_Window;
 
-    // Key states tracked per frame
-    static std::unordered_map<int, bool> s_KeysDown;
-    static std::unordered_map<int, bool> s_KeysUp;
-    static std::unordered_map<int, bool> s_KeysHeld;
+    // Key states, one bit per key code
+    static KeySet s_KeysDown;
+    static KeySet s_KeysUp;
+    static KeySet s_KeysHeld;
+    
+    // Down and up gathered over the ticks of the current frame
+    static KeySet s_FrameDown;
+    static KeySet s_FrameUp;
+    
+    static SpscQueue<InputEvent> s_Events;
+    static std::atomic<uint32_t> s_DroppedEvents;
+    
+    static FILE* s_RecordFile;
+    static uint64_t s_RecordTick;
+    
+    static bool s_Replaying;
+    static std::vector<RecordedEvent> s_Replay;
+    static size_t s_ReplayNext;
+    static uint64_t s_ReplayTick;
+    static uint64_t s_ReplayLength;
+    
+    // Unknown and out of range keys read as up, without branching.
+    inline static bool Lookup(const KeySet& keys, Keycode key)
+    {
+        uint32_t index = static_cast<uint32_t>(key);
+        return keys[index & (KeyCount - 1)] & (index < KeyCount);
+    }
+    
+    static void Apply(int32_t key, KeyAction action);
     
-    static int MapKeycodeToGLFW(Keycode key);
+    static double GetTime();
 
     // Internal callback from GLFW
     static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
@@ -26,7 +26,6 @@
 
 class GLFWwindow;
 
-namespace MTL { class Device; }
 namespace CA { class MetalLayer; }
 
 class Window
@@ -41,7 +40,6 @@ private:
     GLFWwindow* m_InternalWindow;
     NSWindow* m_MetalWindow;
     
-    MTL::Device* m_MetalDevice;
     CA::MetalLayer* m_MetalLayer;
     
     static void frameBufferSizeCallback(GLFWwindow *window, int width, int height);
@@ -58,6 +56,9 @@ public:
     
     void Close();
     
+    // Off, frames are presented as soon as they're done, tearing included.
+    void SetVSync(bool enabled);
+    
     inline unsigned int GetWidth() const { return m_Width; }
     
     inline unsigned int GetHeight() const { return m_Height; }
@@ -70,11 +71,7 @@ public:
     
     inline NSWindow* GetMetalWindow() const { return m_MetalWindow; }
     
-    inline MTL::Device* GetMetalDevice() const { return m_MetalDevice; }
-    
     inline CA::MetalLayer* GetMetalLayer() const { return m_MetalLayer; }
 
-    inline void SetMetalDevice(MTL::Device* device) { m_MetalDevice = device; }
-
     inline void SetMetalLayer(CA::MetalLayer* layer) { m_MetalLayer = layer; }
 };
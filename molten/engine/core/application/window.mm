@@ -90,13 +90,6 @@ bool Window::InitGlfw()
         return false;
     }
     
-    m_MetalDevice = MTL::CreateSystemDefaultDevice();
-    if (!m_MetalDevice)
-    {
-        CORE_ASSERT(false, "Failed to create Metal device.");
-        return false;
-    }
-    
     m_MetalLayer = CA::MetalLayer::layer();
     if (!m_MetalLayer)
     {
@@ -104,7 +97,7 @@ bool Window::InitGlfw()
         return false;
     }
     
-    m_MetalLayer->setDevice(m_MetalDevice);
+    // The device is attached by MetalRenderDevice.
     m_MetalLayer->setPixelFormat(MTL::PixelFormat::PixelFormatBGRA8Unorm);
     m_MetalLayer->setDrawableSize(CGSizeMake(width, height));
     
@@ -125,7 +118,11 @@ bool Window::isOpen()
 void Window::HandleInputEvents()
 {
     glfwPollEvents();
-    Input::Update();
+}
+
+void Window::SetVSync(bool enabled)
+{
+    if (m_MetalLayer) m_MetalLayer->setDisplaySyncEnabled(enabled);
 }
 
 void Window::Close()
@@ -0,0 +1,485 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "asset-archive.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+
+#include "../jobs/job-system.h"
+#include "../utils/lz4-block.h"
+#include "../utils/log-macros.h"
+
+namespace fs = std::filesystem;
+
+static constexpr char ArchiveMagic[4] = { 'M', 'P', 'A', 'K' };
+static constexpr uint32_t ArchiveVersion = 1;
+
+// Entry data starts on this boundary, like the pixels of a cooked texture,
+// so a cooked texture stored raw keeps its alignment inside the archive.
+static constexpr uint64_t EntryAlignment = 64;
+
+// Inputs read and compressed together when packing in parallel.
+static constexpr size_t PackBatchSize = 64;
+
+struct ArchiveHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t tocOffset;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+};
+
+std::shared_mutex AssetArchive::s_Mutex;
+std::vector<std::unique_ptr<AssetArchive>> AssetArchive::s_Mounted;
+
+AssetData::AssetData(AssetData&& other) noexcept
+: m_File(std::move(other.m_File)), m_Buffer(std::move(other.m_Buffer)), m_Data(other.m_Data), m_Size(other.m_Size)
+{
+    other.m_Data = nullptr;
+    other.m_Size = 0;
+}
+
+AssetData& AssetData::operator=(AssetData&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_File = std::move(other.m_File);
+        m_Buffer = std::move(other.m_Buffer);
+        m_Data = other.m_Data;
+        m_Size = other.m_Size;
+        
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+    }
+    
+    return *this;
+}
+
+bool AssetData::OpenFile(const char* path)
+{
+    m_Buffer.clear();
+    m_Data = nullptr;
+    m_Size = 0;
+    
+    if (!m_File.Open(path)) return false;
+    
+    m_Data = m_File.GetData();
+    m_Size = m_File.GetSize();
+    
+    return true;
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint64_t AssetArchive::HashName(std::string_view name)
+{
+    // FNV-1a, 64 bit.
+    uint64_t hash = 14695981039346656037ull;
+    
+    for (char c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    
+    return hash;
+}
+
+// Roots and looked up paths resolve the same way, symlinks included, so
+// either can be reached through a link. Paths that can't be resolved fall
+// back to their normalized absolute form; empty if even that fails.
+static fs::path Canonicalize(const fs::path& path)
+{
+    std::error_code error;
+    
+    fs::path canonical = fs::weakly_canonical(path, error);
+    if (!error) return canonical;
+    
+    fs::path absolute = fs::absolute(path, error);
+    return error ? fs::path() : absolute.lexically_normal();
+}
+
+bool AssetArchive::Open(const char* path, const char* root)
+{
+    if (!m_File.Open(path))
+    {
+        LOG_CORE_ERROR("Failed to open asset archive: {}", path);
+        return false;
+    }
+    
+    ArchiveHeader header;
+    
+    if (m_File.GetSize() < sizeof(header))
+    {
+        LOG_CORE_ERROR("Asset archive is truncated: {}", path);
+        m_File.Close();
+        return false;
+    }
+    
+    std::memcpy(&header, m_File.GetData(), sizeof(header));
+    
+    uint64_t size = m_File.GetSize();
+    uint64_t tocSize = uint64_t(header.entryCount) * sizeof(AssetEntry);
+    
+    if (std::memcmp(header.magic, ArchiveMagic, sizeof(header.magic)) != 0 || header.version != ArchiveVersion)
+    {
+        LOG_CORE_ERROR("Not an asset archive, or from another version: {}", path);
+        m_File.Close();
+        return false;
+    }
+    
+    if (header.tocOffset % alignof(AssetEntry) != 0 || header.tocOffset > size || tocSize > size - header.tocOffset ||
+        header.namesOffset > size || header.namesSize > size - header.namesOffset)
+    {
+        LOG_CORE_ERROR("Asset archive is truncated: {}", path);
+        m_File.Close();
+        return false;
+    }
+    
+    m_Entries = reinterpret_cast<const AssetEntry*>(m_File.GetData() + header.tocOffset);
+    m_EntryCount = header.entryCount;
+    m_Names = reinterpret_cast<const char*>(m_File.GetData() + header.namesOffset);
+    m_NamesSize = header.namesSize;
+    
+    // The table is used in place; only the entries actually read are checked.
+    m_File.Prefetch(header.tocOffset, tocSize);
+    
+    std::error_code error;
+    fs::path rootPath = root ? fs::path(root) : fs::current_path(error);
+    
+    m_Root = Canonicalize(rootPath).string();
+    
+    return true;
+}
+
+const AssetEntry* AssetArchive::Find(std::string_view name) const
+{
+    uint64_t hash = HashName(name);
+    
+    const AssetEntry* end = m_Entries + m_EntryCount;
+    const AssetEntry* entry = std::lower_bound(m_Entries, end, hash, [](const AssetEntry& entry, uint64_t hash)
+    {
+        return entry.nameHash < hash;
+    });
+    
+    // Names with the same hash sit next to each other.
+    for (; entry != end && entry->nameHash == hash; entry++)
+    {
+        if (entry->nameOffset > m_NamesSize || entry->nameLength > m_NamesSize - entry->nameOffset) return nullptr;
+        
+        if (GetName(*entry) == name) return entry;
+    }
+    
+    return nullptr;
+}
+
+bool AssetArchive::Read(const AssetEntry& entry, AssetData& out) const
+{
+    out.m_File.Close();
+    out.m_Buffer.clear();
+    out.m_Data = nullptr;
+    out.m_Size = 0;
+    
+    if (entry.offset > m_File.GetSize() || entry.storedSize > m_File.GetSize() - entry.offset)
+    {
+        LOG_CORE_ERROR("Asset archive entry out of range: {}", GetName(entry));
+        return false;
+    }
+    
+    std::span<const uint8_t> stored = GetStored(entry);
+    
+    switch (static_cast<AssetCompression>(entry.compression))
+    {
+        case AssetCompression::None:
+            
+            if (entry.size != entry.storedSize) break;
+            
+            out.m_Data = stored.data();
+            out.m_Size = stored.size();
+            
+            return true;
+            
+        case AssetCompression::LZ4:
+            
+            out.m_Buffer.resize(static_cast<size_t>(entry.size));
+            
+            if (!DecompressLZ4(stored.data(), stored.size(), out.m_Buffer.data(), out.m_Buffer.size()))
+            {
+                out.m_Buffer.clear();
+                break;
+            }
+            
+            out.m_Data = out.m_Buffer.data();
+            out.m_Size = out.m_Buffer.size();
+            
+            return true;
+    }
+    
+    LOG_CORE_ERROR("Corrupt asset archive entry: {}", GetName(entry));
+    return false;
+}
+
+std::string AssetArchive::GetEntryName(const fs::path& canonical) const
+{
+    if (canonical.empty()) return std::string();
+    
+    fs::path relative = canonical.lexically_relative(m_Root);
+    
+    if (relative.empty() || *relative.begin() == "..") return std::string();
+    
+    return relative.generic_string();
+}
+
+static bool IsRawExtension(const std::string& name, const PackOptions& options)
+{
+    std::string extension = fs::path(name).extension().string();
+    
+    for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    
+    return std::find(options.rawExtensions.begin(), options.rawExtensions.end(), extension) != options.rawExtensions.end();
+}
+
+struct PackedEntry
+{
+    AssetData source;
+    std::vector<uint8_t> compressed;
+    bool ok = false;
+};
+
+static void PrepareEntry(const PackInput& input, const PackOptions& options, PackedEntry& packed)
+{
+    if (!packed.source.OpenFile(input.sourcePath.c_str()))
+    {
+        // Mapping refuses empty files, which are still valid entries.
+        std::error_code error;
+        packed.ok = fs::is_regular_file(input.sourcePath, error) && fs::file_size(input.sourcePath, error) == 0 && !error;
+        
+        if (!packed.ok) LOG_CORE_ERROR("Failed to read {}", input.sourcePath);
+        return;
+    }
+    
+    packed.ok = true;
+    
+    size_t size = packed.source.GetSize();
+    
+    if (!options.compress || IsRawExtension(input.name, options)) return;
+    
+    packed.compressed.resize(GetLZ4CompressBound(size));
+    
+    size_t compressed = CompressLZ4(packed.source.GetData(), size, packed.compressed.data(), packed.compressed.size());
+    
+    if (compressed == 0 || compressed > size - static_cast<size_t>(size * options.minSavings)) packed.compressed.clear();
+    else packed.compressed.resize(compressed);
+}
+
+bool AssetArchive::Pack(const std::vector<PackInput>& inputs, const char* outputPath, const PackOptions& options, JobSystem* jobSystem)
+{
+    std::vector<uint32_t> order(inputs.size());
+    std::vector<uint64_t> hashes(inputs.size());
+    
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        order[i] = static_cast<uint32_t>(i);
+        hashes[i] = HashName(inputs[i].name);
+    }
+    
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+    {
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : inputs[a].name < inputs[b].name;
+    });
+    
+    std::vector<AssetEntry> entries(inputs.size());
+    std::string names;
+    
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const std::string& name = inputs[order[i]].name;
+        
+        if (i > 0 && name == inputs[order[i - 1]].name)
+        {
+            LOG_CORE_ERROR("Asset archive input listed twice: {}", name);
+            return false;
+        }
+        
+        AssetEntry& entry = entries[i];
+        entry = {};
+        entry.nameHash = hashes[order[i]];
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(name.size());
+        
+        names += name;
+    }
+    
+    FILE* file = std::fopen(outputPath, "wb");
+    if (!file) { LOG_CORE_ERROR("Failed to open asset archive for writing: {}", outputPath); return false; }
+    
+    static const uint8_t padding[EntryAlignment] = {};
+    
+    ArchiveHeader header = {};
+    
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t offset = sizeof(header);
+    
+    auto pad = [&](uint64_t alignment)
+    {
+        uint64_t aligned = AlignUp(offset, alignment);
+        
+        ok = ok && std::fwrite(padding, 1, aligned - offset, file) == aligned - offset;
+        offset = aligned;
+    };
+    
+    std::vector<PackedEntry> batch;
+    
+    for (size_t first = 0; ok && first < order.size(); first += PackBatchSize)
+    {
+        size_t count = std::min(PackBatchSize, order.size() - first);
+        
+        batch.clear();
+        batch.resize(count);
+        
+        auto prepare = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++) PrepareEntry(inputs[order[first + i]], options, batch[i]);
+        };
+        
+        if (jobSystem) jobSystem->ParallelFor(count, 1, prepare);
+        else prepare(0, count);
+        
+        for (size_t i = 0; ok && i < count; i++)
+        {
+            PackedEntry& packed = batch[i];
+            AssetEntry& entry = entries[first + i];
+            
+            if (!packed.ok) { ok = false; break; }
+            
+            bool compressed = !packed.compressed.empty();
+            
+            const uint8_t* data = compressed ? packed.compressed.data() : packed.source.GetData();
+            size_t size = compressed ? packed.compressed.size() : packed.source.GetSize();
+            
+            pad(EntryAlignment);
+            
+            entry.offset = offset;
+            entry.storedSize = size;
+            entry.size = packed.source.GetSize();
+            entry.compression = static_cast<uint32_t>(compressed ? AssetCompression::LZ4 : AssetCompression::None);
+            
+            ok = ok && (size == 0 || std::fwrite(data, 1, size, file) == size);
+            offset += size;
+        }
+    }
+    
+    pad(alignof(AssetEntry));
+    
+    header.tocOffset = offset;
+    ok = ok && (entries.empty() || std::fwrite(entries.data(), sizeof(AssetEntry), entries.size(), file) == entries.size());
+    offset += entries.size() * sizeof(AssetEntry);
+    
+    header.namesOffset = offset;
+    header.namesSize = names.size();
+    ok = ok && (names.empty() || std::fwrite(names.data(), 1, names.size(), file) == names.size());
+    
+    // The header goes last, so an interrupted pack never looks valid.
+    std::memcpy(header.magic, ArchiveMagic, sizeof(header.magic));
+    header.version = ArchiveVersion;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    
+    if (!ok) LOG_CORE_ERROR("Failed to write asset archive: {}", outputPath);
+    
+    return ok;
+}
+
+bool AssetArchive::Mount(const char* path, const char* root)
+{
+    auto archive = std::make_unique<AssetArchive>();
+    if (!archive->Open(path, root)) return false;
+    
+    LOG_CORE_INFO("Mounted {} ({} assets)", path, archive->GetEntryCount());
+    
+    std::unique_lock<std::shared_mutex> lock(s_Mutex);
+    s_Mounted.push_back(std::move(archive));
+    
+    return true;
+}
+
+void AssetArchive::UnmountAll()
+{
+    std::unique_lock<std::shared_mutex> lock(s_Mutex);
+    s_Mounted.clear();
+}
+
+bool AssetArchive::HasMounted()
+{
+    std::shared_lock<std::shared_mutex> lock(s_Mutex);
+    
+    return !s_Mounted.empty();
+}
+
+bool AssetArchive::Load(const std::string& path, AssetData& out)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(s_Mutex);
+        
+        // Resolved once, and only when there are archives to look in.
+        fs::path canonical = s_Mounted.empty() ? fs::path() : Canonicalize(path);
+        
+        for (auto it = s_Mounted.rbegin(); it != s_Mounted.rend(); ++it)
+        {
+            std::string name = (*it)->GetEntryName(canonical);
+            if (name.empty()) continue;
+            
+            if (const AssetEntry* entry = (*it)->Find(name)) return (*it)->Read(*entry, out);
+        }
+    }
+    
+    return out.OpenFile(path.c_str());
+}
+
+bool AssetArchive::Contains(const std::string& path)
+{
+    std::shared_lock<std::shared_mutex> lock(s_Mutex);
+    
+    fs::path canonical = s_Mounted.empty() ? fs::path() : Canonicalize(path);
+    
+    for (const auto& archive : s_Mounted)
+    {
+        std::string name = archive->GetEntryName(canonical);
+        
+        if (!name.empty() && archive->Find(name)) return true;
+    }
+    
+    return false;
+}
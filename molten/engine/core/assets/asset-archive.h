@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../utils/mapped-file.h"
+
+class JobSystem;
+
+enum class AssetCompression : uint32_t
+{
+    None,
+    LZ4
+};
+
+// One record of an archive's table of contents, read in place from the
+// mapping. Records are sorted by name hash.
+struct AssetEntry
+{
+    uint64_t nameHash;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t size;
+    
+    uint32_t compression;
+    uint32_t reserved;
+};
+
+// The bytes of one asset. Entries stored raw, and loose files, are views of
+// a mapping with nothing copied; compressed entries are decompressed into a
+// buffer the object owns.
+class AssetData
+{
+private:
+    
+    MappedFile m_File;
+    std::vector<uint8_t> m_Buffer;
+    
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    
+    friend class AssetArchive;
+    
+public:
+    
+    AssetData() = default;
+    
+    AssetData(const AssetData&) = delete;
+    AssetData& operator=(const AssetData&) = delete;
+    
+    AssetData(AssetData&& other) noexcept;
+    AssetData& operator=(AssetData&& other) noexcept;
+    
+    // Maps a file on disk; fails quietly if it doesn't exist.
+    bool OpenFile(const char* path);
+    
+    // Starts reading mapped bytes in ahead of use.
+    void Prefetch() const { if (m_Buffer.empty()) MappedFile::Prefetch(m_Data, m_Size); }
+    
+    inline bool IsEmpty() const { return m_Data == nullptr; }
+    
+    inline const uint8_t* GetData() const { return m_Data; }
+    inline size_t GetSize() const { return m_Size; }
+    inline std::span<const uint8_t> GetSpan() const { return { m_Data, m_Size }; }
+};
+
+struct PackOptions
+{
+    bool compress = true;
+    
+    // Compressed entries are kept only if they are at least this much smaller.
+    float minSavings = 0.125f;
+    
+    // Extensions always stored raw, so they can be used straight from the
+    // mapping; cooked textures are uploaded from there.
+    std::vector<std::string> rawExtensions = { ".mtex" };
+};
+
+struct PackInput
+{
+    // Path inside the archive, relative to the packed root, with forward slashes.
+    std::string name;
+    
+    std::string sourcePath;
+};
+
+// A pack file (.mpak) of many assets, mapped whole at mount so loading an
+// asset is a table lookup rather than an open and a read. Every entry starts
+// on a 64 byte boundary. The table of contents is sorted by a 64 bit hash of
+// the entry name and searched in place, without being parsed or copied.
+//
+// Mounted archives stand in for a directory on disk: paths under it are
+// looked up in the archives first and read from loose files only when no
+// archive has them, so development builds run without packing anything.
+class AssetArchive
+{
+private:
+    
+    MappedFile m_File;
+    
+    const AssetEntry* m_Entries = nullptr;
+    uint32_t m_EntryCount = 0;
+    
+    const char* m_Names = nullptr;
+    uint64_t m_NamesSize = 0;
+    
+    // Absolute and canonical; entry names are relative to it.
+    std::string m_Root;
+    
+    static std::shared_mutex s_Mutex;
+    static std::vector<std::unique_ptr<AssetArchive>> s_Mounted;
+    
+    // The name a canonical path has inside this archive, or empty if it
+    // isn't under the root.
+    std::string GetEntryName(const std::filesystem::path& canonical) const;
+    
+public:
+    
+    static constexpr const char* Extension = ".mpak";
+    
+    AssetArchive() = default;
+    
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+    
+    // Entry names resolve against root, the working directory by default.
+    bool Open(const char* path, const char* root = nullptr);
+    
+    static uint64_t HashName(std::string_view name);
+    
+    const AssetEntry* Find(std::string_view name) const;
+    
+    inline std::string_view GetName(const AssetEntry& entry) const { return { m_Names + entry.nameOffset, entry.nameLength }; }
+    
+    // The entry's bytes as stored, straight from the mapping: compressed
+    // unless the entry is raw.
+    inline std::span<const uint8_t> GetStored(const AssetEntry& entry) const
+    {
+        return { m_File.GetData() + entry.offset, static_cast<size_t>(entry.storedSize) };
+    }
+    
+    // A view of raw entries, a decompressed copy of the others.
+    bool Read(const AssetEntry& entry, AssetData& out) const;
+    
+    inline uint32_t GetEntryCount() const { return m_EntryCount; }
+    inline const AssetEntry& GetEntry(uint32_t index) const { return m_Entries[index]; }
+    
+    // Writes the inputs to a new archive. With a job system, entries are
+    // read and compressed in parallel a batch at a time.
+    static bool Pack(const std::vector<PackInput>& inputs, const char* outputPath,
+                     const PackOptions& options = PackOptions(), JobSystem* jobSystem = nullptr);
+    
+    // Adds an archive to the ones every load looks in; later mounts win.
+    // Mount at startup: archives stay mapped, and the views they hand out
+    // valid, until UnmountAll.
+    static bool Mount(const char* path, const char* root = nullptr);
+    
+    static void UnmountAll();
+    
+    static bool HasMounted();
+    
+    // Reads the asset at path from the mounted archives, or from the loose
+    // file if none of them has it.
+    static bool Load(const std::string& path, AssetData& out);
+    
+    // True if a mounted archive has the path; loose files aren't looked at.
+    static bool Contains(const std::string& path);
+};
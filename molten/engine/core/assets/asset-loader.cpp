@@ -0,0 +1,429 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "asset-loader.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "../jobs/job-system.h"
+#include "../renderer/texture-2D.h"
+#include "../renderer/cooked-texture.h"
+#include "../renderer/texture-cache.h"
+
+struct TextureRequest
+{
+    std::string path;
+    ImageLoadOptions options;
+    
+    // Kept alive until the image is handed over, even if every user let go.
+    std::shared_ptr<Texture2D> texture;
+    
+    std::atomic<LoadState> state{LoadState::Queued};
+    
+    // Guarded by AssetLoader::s_Mutex.
+    uint8_t priority = 0;
+    
+    // Decoded or mapped, waiting for AssetLoader::Update.
+    Image* image = nullptr;
+    CookedTexture* cooked = nullptr;
+    
+    ~TextureRequest() { delete image; delete cooked; }
+};
+
+bool AssetLoader::s_Initialized = false;
+
+JobSystem* AssetLoader::s_JobSystem = nullptr;
+JobCounter* AssetLoader::s_Jobs = nullptr;
+uint32_t AssetLoader::s_MaxJobs = 0;
+uint32_t AssetLoader::s_RunningJobs = 0;
+
+std::mutex AssetLoader::s_Mutex;
+
+std::vector<AssetLoader::QueueEntry> AssetLoader::s_Queue;
+uint64_t AssetLoader::s_NextSequence = 0;
+
+std::unordered_map<std::string, std::weak_ptr<TextureRequest>> AssetLoader::s_InFlight;
+
+std::vector<std::shared_ptr<TextureRequest>> AssetLoader::s_Decoded;
+
+std::atomic<size_t> AssetLoader::s_Pending{0};
+size_t AssetLoader::s_UploadBudget = AssetLoader::DefaultUploadBudget;
+
+LoadState TextureLoadHandle::GetState() const
+{
+    return m_Request ? m_Request->state.load(std::memory_order_acquire) : LoadState::Failed;
+}
+
+bool TextureLoadHandle::IsDone() const
+{
+    LoadState state = GetState();
+    
+    return state != LoadState::Queued && state != LoadState::Decoding;
+}
+
+std::shared_ptr<Texture2D> TextureLoadHandle::GetTexture() const
+{
+    return m_Request ? m_Request->texture : nullptr;
+}
+
+void TextureLoadHandle::SetPriority(LoadPriority priority)
+{
+    if (!m_Request) return;
+    
+    std::lock_guard<std::mutex> lock(AssetLoader::s_Mutex);
+    
+    uint8_t value = static_cast<uint8_t>(priority);
+    
+    if (m_Request->state.load(std::memory_order_acquire) != LoadState::Queued || m_Request->priority == value) return;
+    
+    m_Request->priority = value;
+    AssetLoader::Push(m_Request);
+}
+
+void TextureLoadHandle::Cancel()
+{
+    if (!m_Request) return;
+    
+    LoadState state = m_Request->state.load(std::memory_order_acquire);
+    
+    while (state == LoadState::Queued || state == LoadState::Decoding)
+    {
+        if (m_Request->state.compare_exchange_weak(state, LoadState::Cancelled, std::memory_order_acq_rel))
+        {
+            AssetLoader::s_Pending.fetch_sub(1, std::memory_order_acq_rel);
+            
+            std::lock_guard<std::mutex> lock(AssetLoader::s_Mutex);
+            AssetLoader::Forget(m_Request);
+            return;
+        }
+    }
+}
+
+void AssetLoader::Initialize(JobSystem* jobSystem)
+{
+    if (s_Initialized) return;
+    
+    s_JobSystem = jobSystem;
+    s_Jobs = new JobCounter();
+    
+    // Leave the main thread out; it only decodes when it has to wait anyway.
+    unsigned int workers = jobSystem ? jobSystem->GetWorkerCount() : 0;
+    s_MaxJobs = workers > 1 ? workers - 1 : 0;
+    s_RunningJobs = 0;
+    
+    s_Initialized = true;
+}
+
+void AssetLoader::Shutdown()
+{
+    if (!s_Initialized) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        for (QueueEntry& entry : s_Queue)
+        {
+            LoadState expected = LoadState::Queued;
+            
+            if (entry.request->state.compare_exchange_strong(expected, LoadState::Cancelled, std::memory_order_acq_rel))
+                s_Pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        
+        s_Queue.clear();
+    }
+    
+    // Running jobs find the queue empty and stop after their current image.
+    if (s_JobSystem) s_JobSystem->Wait(*s_Jobs);
+    
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    
+    s_Decoded.clear();
+    s_InFlight.clear();
+    s_Pending.store(0, std::memory_order_release);
+    
+    delete s_Jobs;
+    
+    s_Jobs = nullptr;
+    s_JobSystem = nullptr;
+    s_Initialized = false;
+}
+
+TextureLoadHandle AssetLoader::LoadTexture(const char* filepath, LoadPriority priority, const ImageLoadOptions& options)
+{
+    // Not running, e.g. in tools: load on the spot.
+    if (!s_Initialized)
+    {
+        std::shared_ptr<Texture2D> texture = TextureCache::Load(filepath);
+        if (!texture) return TextureLoadHandle();
+        
+        auto request = std::make_shared<TextureRequest>();
+        request->path = texture->GetFilepath();
+        request->texture = texture;
+        request->state.store(texture->GetState() == TextureState::Ready ? LoadState::Ready : LoadState::Failed);
+        
+        return TextureLoadHandle(request);
+    }
+    
+    bool created = false;
+    
+    std::shared_ptr<Texture2D> texture = TextureCache::FindOrCreatePending(filepath, created);
+    if (!texture) return TextureLoadHandle();
+    
+    auto request = std::make_shared<TextureRequest>();
+    request->path = texture->GetFilepath();
+    request->options = options;
+    request->texture = texture;
+    request->priority = static_cast<uint8_t>(priority);
+    
+    // Loaded before, synchronously or by an earlier request.
+    if (!texture->IsLoading())
+    {
+        request->state.store(texture->GetState() == TextureState::Ready ? LoadState::Ready : LoadState::Failed);
+        return TextureLoadHandle(request);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        // Join the request already loading this texture, raising its priority if needed.
+        auto it = created ? s_InFlight.end() : s_InFlight.find(request->path);
+        if (it != s_InFlight.end())
+        {
+            auto existing = it->second.lock();
+            
+            if (existing && existing->texture == texture)
+            {
+                if (existing->state.load(std::memory_order_acquire) == LoadState::Queued && existing->priority < request->priority)
+                {
+                    existing->priority = request->priority;
+                    Push(existing);
+                }
+                
+                return TextureLoadHandle(existing);
+            }
+        }
+        
+        // Either the first load of the path or one that was cancelled before.
+        s_InFlight[request->path] = request;
+        s_Pending.fetch_add(1, std::memory_order_acq_rel);
+        
+        Push(request);
+    }
+    
+    ScheduleJobs();
+    
+    return TextureLoadHandle(request);
+}
+
+bool AssetLoader::IsLessUrgent(const QueueEntry& a, const QueueEntry& b)
+{
+    return a.priority != b.priority ? a.priority < b.priority : a.sequence > b.sequence;
+}
+
+void AssetLoader::Push(const std::shared_ptr<TextureRequest>& request)
+{
+    s_Queue.push_back({ request->priority, s_NextSequence++, request });
+    
+    std::push_heap(s_Queue.begin(), s_Queue.end(), &AssetLoader::IsLessUrgent);
+}
+
+std::shared_ptr<TextureRequest> AssetLoader::Pop()
+{
+    while (!s_Queue.empty())
+    {
+        std::pop_heap(s_Queue.begin(), s_Queue.end(), &AssetLoader::IsLessUrgent);
+        
+        QueueEntry entry = std::move(s_Queue.back());
+        s_Queue.pop_back();
+        
+        // Superseded by a later push with another priority.
+        if (entry.priority != entry.request->priority) continue;
+        
+        LoadState expected = LoadState::Queued;
+        
+        if (entry.request->state.compare_exchange_strong(expected, LoadState::Decoding, std::memory_order_acq_rel))
+            return entry.request;
+    }
+    
+    return nullptr;
+}
+
+bool AssetLoader::DecodeNext()
+{
+    std::shared_ptr<TextureRequest> request;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        request = Pop();
+    }
+    
+    if (!request) return false;
+    
+    // A cooked file only needs mapping; have its pages read in before the upload.
+    CookedTexture* cooked = CookedTexture::OpenForSource(request->path, request->options);
+    Image* image = nullptr;
+    
+    if (cooked) cooked->Prefetch();
+    else image = new Image(request->path.c_str(), request->options);
+    
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    
+    // If it was cancelled meanwhile, HandOver drops it.
+    request->image = image;
+    request->cooked = cooked;
+    s_Decoded.push_back(std::move(request));
+    
+    return true;
+}
+
+void AssetLoader::ScheduleJobs()
+{
+    if (!s_JobSystem) return;
+    
+    uint32_t start = 0;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        while (s_RunningJobs + start < s_MaxJobs && start < s_Queue.size()) start++;
+        
+        s_RunningJobs += start;
+    }
+    
+    for (uint32_t i = 0; i < start; i++)
+        s_JobSystem->Schedule(&AssetLoader::RunJob, s_Jobs);
+}
+
+void AssetLoader::RunJob()
+{
+    DecodeNext();
+    
+    bool more;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        more = !s_Queue.empty();
+        if (!more) s_RunningJobs--;
+    }
+    
+    // One image per job, so frame work scheduled meanwhile doesn't queue
+    // behind a whole level's worth of decoding.
+    if (more) s_JobSystem->Schedule(&AssetLoader::RunJob, s_Jobs);
+}
+
+void AssetLoader::Forget(const std::shared_ptr<TextureRequest>& request)
+{
+    auto it = s_InFlight.find(request->path);
+    
+    if (it != s_InFlight.end() && it->second.lock() == request) s_InFlight.erase(it);
+}
+
+void AssetLoader::Update()
+{
+    if (!s_Initialized) return;
+    
+    if (s_MaxJobs == 0) DecodeNext();
+    
+    HandOver(s_UploadBudget);
+}
+
+void AssetLoader::HandOver(size_t budget)
+{
+    std::vector<std::shared_ptr<TextureRequest>> ready;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        size_t count = 0;
+        size_t bytes = 0;
+        
+        while (count < s_Decoded.size() && (count == 0 || budget == 0 || bytes < budget))
+        {
+            const TextureRequest& request = *s_Decoded[count];
+            
+            if (request.state.load(std::memory_order_acquire) != LoadState::Cancelled)
+                bytes += request.cooked ? request.cooked->GetDataSize() : static_cast<size_t>(request.image->GetWidth()) * request.image->GetHeight() * 4;
+            
+            count++;
+        }
+        
+        ready.assign(std::make_move_iterator(s_Decoded.begin()), std::make_move_iterator(s_Decoded.begin() + count));
+        s_Decoded.erase(s_Decoded.begin(), s_Decoded.begin() + count);
+    }
+    
+    for (const auto& request : ready)
+    {
+        if (request->state.load(std::memory_order_acquire) == LoadState::Cancelled) continue;
+        
+        bool valid = request->cooked || request->image->IsValid();
+        
+        if (request->cooked) request->texture->SetCooked(request->cooked);
+        else request->texture->SetImage(request->image);
+        
+        request->image = nullptr;
+        request->cooked = nullptr;
+        
+        // A Cancel that raced with this already settled the request.
+        LoadState expected = LoadState::Decoding;
+        
+        if (request->state.compare_exchange_strong(expected, valid ? LoadState::Ready : LoadState::Failed, std::memory_order_acq_rel))
+        {
+            s_Pending.fetch_sub(1, std::memory_order_acq_rel);
+            
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            Forget(request);
+        }
+    }
+}
+
+void AssetLoader::Wait(const TextureLoadHandle& handle)
+{
+    if (!s_Initialized || !handle.IsValid()) return;
+    
+    TextureLoadHandle(handle.m_Request).SetPriority(LoadPriority::Immediate);
+    
+    while (!handle.IsDone())
+    {
+        if (!DecodeNext()) std::this_thread::yield();
+        
+        HandOver(0);
+    }
+}
+
+void AssetLoader::Flush()
+{
+    if (!s_Initialized) return;
+    
+    while (GetPendingCount() > 0)
+    {
+        if (!DecodeNext()) std::this_thread::yield();
+        
+        HandOver(0);
+    }
+}
+
+size_t AssetLoader::GetPendingCount()
+{
+    return s_Pending.load(std::memory_order_acquire);
+}
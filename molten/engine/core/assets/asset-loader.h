@@ -0,0 +1,190 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/image.h"
+
+class Texture2D;
+class JobSystem;
+class JobCounter;
+
+// Higher priorities are decoded first; requests of the same priority run in
+// the order they were made.
+enum class LoadPriority : uint8_t
+{
+    Background,
+    Normal,
+    High,
+    Immediate
+};
+
+enum class LoadState : uint8_t
+{
+    Queued,
+    Decoding,
+    Ready,
+    Failed,
+    Cancelled
+};
+
+struct TextureRequest;
+
+// Returned by AssetLoader::LoadTexture right away. Every caller loading the
+// same path while it is in flight shares one request.
+class TextureLoadHandle
+{
+private:
+    
+    std::shared_ptr<TextureRequest> m_Request;
+    
+    friend class AssetLoader;
+    
+    explicit TextureLoadHandle(std::shared_ptr<TextureRequest> request) : m_Request(std::move(request)) {}
+    
+public:
+    
+    TextureLoadHandle() = default;
+    
+    bool IsValid() const { return m_Request != nullptr; }
+    
+    LoadState GetState() const;
+    
+    // Ready, failed or cancelled.
+    bool IsDone() const;
+    
+    // Available immediately; it stays pending, and draws as a placeholder,
+    // until the loader hands it its image.
+    std::shared_ptr<Texture2D> GetTexture() const;
+    
+    // Moves a queued request up or down the queue.
+    void SetPriority(LoadPriority priority);
+    
+    // Drops the load for every handle sharing it. A queued request is never
+    // decoded; one being decoded is discarded when it finishes. The texture
+    // stays pending until someone loads its path again.
+    void Cancel();
+};
+
+// Decodes textures on the job system's workers so level loads don't stall
+// the frame; textures with a cooked file are only mapped there instead.
+// Decoded images are handed to their textures by Update on the main thread,
+// a few megabytes per frame, and renderers upload them from there. Without
+// worker threads Update decodes one request per call.
+class AssetLoader
+{
+public:
+    
+    static constexpr size_t DefaultUploadBudget = 16 * 1024 * 1024;
+    
+    static void Initialize(JobSystem* jobSystem);
+    
+    // Cancels whatever is queued and waits for the decodes in flight.
+    static void Shutdown();
+    
+    inline static bool IsInitialized() { return s_Initialized; }
+    
+    // Returns at once with the path's texture, pending until Update hands it
+    // its image. Before Initialize it loads synchronously instead. Call it
+    // from the main thread.
+    static TextureLoadHandle LoadTexture(const char* filepath, LoadPriority priority = LoadPriority::Normal,
+                                         const ImageLoadOptions& options = ImageLoadOptions());
+    
+    // To be called once per frame on the main thread. Hands finished images
+    // to their textures until the frame's upload budget is spent; at least
+    // one goes through per call.
+    static void Update();
+    
+    // Decoded bytes handed over per Update; 0 means no limit.
+    inline static void SetUploadBudget(size_t bytes) { s_UploadBudget = bytes; }
+    
+    // Blocks the main thread, helping to decode, until the request is done.
+    static void Wait(const TextureLoadHandle& handle);
+    
+    // Blocks until every request made so far is done, e.g. behind a loading screen.
+    static void Flush();
+    
+    // Requests queued, decoding or waiting to be handed over.
+    static size_t GetPendingCount();
+    
+private:
+    
+    struct QueueEntry
+    {
+        uint8_t priority;
+        uint64_t sequence;
+        std::shared_ptr<TextureRequest> request;
+    };
+    
+    static bool s_Initialized;
+    
+    static JobSystem* s_JobSystem;
+    static JobCounter* s_Jobs;
+    static uint32_t s_MaxJobs;
+    static uint32_t s_RunningJobs;
+    
+    static std::mutex s_Mutex;
+    
+    // Binary heap on (priority, sequence). Changing a request's priority
+    // pushes it again; entries that no longer match are skipped on pop.
+    static std::vector<QueueEntry> s_Queue;
+    static uint64_t s_NextSequence;
+    
+    static std::unordered_map<std::string, std::weak_ptr<TextureRequest>> s_InFlight;
+    
+    // Decoded in the order they finished, waiting for Update.
+    static std::vector<std::shared_ptr<TextureRequest>> s_Decoded;
+    
+    static std::atomic<size_t> s_Pending;
+    static size_t s_UploadBudget;
+    
+    friend class TextureLoadHandle;
+    
+    static bool IsLessUrgent(const QueueEntry& a, const QueueEntry& b);
+    
+    // Both expect s_Mutex to be held.
+    static void Push(const std::shared_ptr<TextureRequest>& request);
+    static std::shared_ptr<TextureRequest> Pop();
+    
+    // Pops the most urgent queued request and decodes it on the calling
+    // thread. Returns false if there was nothing to decode.
+    static bool DecodeNext();
+    
+    // Starts decode jobs while there are idle slots and queued requests.
+    static void ScheduleJobs();
+    
+    static void RunJob();
+    
+    // Removes a request that reached its final state from the in-flight table.
+    static void Forget(const std::shared_ptr<TextureRequest>& request);
+    
+    static void HandOver(size_t budget);
+};
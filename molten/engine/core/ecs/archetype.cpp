@@ -0,0 +1,179 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "archetype.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+static inline size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+Archetype::Archetype(const ComponentMask& mask)
+: m_Mask(mask)
+{
+    for (uint32_t i = 0; i < MaxComponentTypes; i++)
+        m_Columns[i] = -1;
+    
+    for (ComponentId id = 0; id < MaxComponentTypes; id++)
+    {
+        if (!mask.test(id)) continue;
+        
+        m_Columns[id] = static_cast<int16_t>(m_Components.size());
+        m_Components.push_back(id);
+        m_Infos.push_back(&ComponentRegistry::GetInfo(id));
+    }
+    
+    m_Offsets.resize(m_Components.size());
+    
+    size_t bytesPerEntity = sizeof(Entity);
+    
+    for (const ComponentInfo* info : m_Infos)
+        bytesPerEntity += info->size;
+    
+    // Start from the unpadded estimate and back off until the padding fits.
+    uint32_t capacity = static_cast<uint32_t>(ChunkSize / bytesPerEntity);
+    if (capacity == 0) capacity = 1;
+    
+    while (capacity > 1 && ComputeLayout(capacity) > ChunkSize)
+        capacity--;
+    
+    m_Capacity = capacity;
+    
+    // Oversized components get a bigger chunk holding a single entity.
+    m_ChunkBytes = AlignUp(std::max(ComputeLayout(capacity), ChunkSize), ColumnAlignment);
+}
+
+size_t Archetype::ComputeLayout(uint32_t capacity)
+{
+    size_t offset = capacity * sizeof(Entity);
+    
+    for (size_t i = 0; i < m_Infos.size(); i++)
+    {
+        offset = AlignUp(offset, std::max(m_Infos[i]->alignment, ColumnAlignment));
+        m_Offsets[i] = offset;
+        offset += m_Infos[i]->size * capacity;
+    }
+    
+    return offset;
+}
+
+Chunk* Archetype::AllocateChunk()
+{
+    Chunk* chunk = new Chunk();
+    chunk->data = static_cast<uint8_t*>(::operator new(m_ChunkBytes, std::align_val_t(ColumnAlignment)));
+    chunk->versions.assign(m_Components.size(), 0);
+    
+    return chunk;
+}
+
+void Archetype::FreeChunk(Chunk* chunk)
+{
+    ::operator delete(chunk->data, std::align_val_t(ColumnAlignment));
+    delete chunk;
+}
+
+void Archetype::Allocate(Entity entity, uint32_t version, uint32_t& chunk, uint32_t& row)
+{
+    if (m_Chunks.empty() || m_Chunks.back()->count == m_Capacity)
+        m_Chunks.push_back(AllocateChunk());
+    
+    Chunk& last = *m_Chunks.back();
+    
+    chunk = static_cast<uint32_t>(m_Chunks.size() - 1);
+    row = last.count++;
+    
+    GetEntities(last)[row] = entity;
+    
+    for (uint32_t& columnVersion : last.versions)
+        columnVersion = version;
+    
+    m_EntityCount++;
+}
+
+Entity Archetype::Remove(uint32_t chunk, uint32_t row, uint32_t version)
+{
+    Chunk& hole = *m_Chunks[chunk];
+    Chunk& last = *m_Chunks.back();
+    
+    uint32_t lastRow = last.count - 1;
+    Entity moved;
+    
+    if (&hole != &last || row != lastRow)
+    {
+        moved = GetEntities(last)[lastRow];
+        GetEntities(hole)[row] = moved;
+        
+        for (size_t i = 0; i < m_Components.size(); i++)
+        {
+            const ComponentInfo& info = *m_Infos[i];
+            
+            uint8_t* dst = hole.data + m_Offsets[i] + row * info.size;
+            uint8_t* src = last.data + m_Offsets[i] + lastRow * info.size;
+            
+            if (info.relocate) info.relocate(dst, src);
+            else std::memcpy(dst, src, info.size);
+        }
+        
+        for (uint32_t& columnVersion : hole.versions)
+            columnVersion = version;
+    }
+    
+    last.count--;
+    m_EntityCount--;
+    
+    if (last.count == 0)
+    {
+        FreeChunk(m_Chunks.back());
+        m_Chunks.pop_back();
+    }
+    
+    return moved;
+}
+
+void Archetype::Clear()
+{
+    for (Chunk* chunk : m_Chunks)
+    {
+        for (size_t i = 0; i < m_Components.size(); i++)
+        {
+            const ComponentInfo& info = *m_Infos[i];
+            if (!info.destroy) continue;
+            
+            for (uint32_t row = 0; row < chunk->count; row++)
+                info.destroy(chunk->data + m_Offsets[i] + row * info.size);
+        }
+        
+        FreeChunk(chunk);
+    }
+    
+    m_Chunks.clear();
+    m_EntityCount = 0;
+}
+
+Archetype::~Archetype()
+{
+    Clear();
+}
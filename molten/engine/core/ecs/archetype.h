@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+#include "entity.h"
+#include "component.h"
+
+// Fixed-size block of entities sharing one archetype. The entity array comes
+// first, then one contiguous array per component, each starting on a cache
+// line.
+struct Chunk
+{
+    uint8_t* data = nullptr;
+    uint32_t count = 0;
+    
+    // World version of the last write to each column, see World::GetVersion.
+    std::vector<uint32_t> versions;
+};
+
+// Every entity with exactly the same set of components. Chunks are kept
+// full except the last one: removing an entity moves the archetype's last
+// entity into the hole, so iteration never skips rows.
+class Archetype
+{
+private:
+    
+    friend class World;
+    
+    ComponentMask m_Mask;
+    
+    // Ascending component ids; column i stores m_Components[i].
+    std::vector<ComponentId> m_Components;
+    std::vector<const ComponentInfo*> m_Infos;
+    std::vector<size_t> m_Offsets;
+    
+    // Column of each component id, or -1.
+    int16_t m_Columns[MaxComponentTypes];
+    
+    uint32_t m_Capacity = 0;
+    size_t m_ChunkBytes = 0;
+    
+    std::vector<Chunk*> m_Chunks;
+    size_t m_EntityCount = 0;
+    
+    // Archetypes one component away, filled in as entities move.
+    std::unordered_map<ComponentId, Archetype*> m_AddEdges;
+    std::unordered_map<ComponentId, Archetype*> m_RemoveEdges;
+    
+    size_t ComputeLayout(uint32_t capacity);
+    
+    Chunk* AllocateChunk();
+    
+    void FreeChunk(Chunk* chunk);
+    
+public:
+    
+    static constexpr size_t ChunkSize = 16 * 1024;
+    static constexpr size_t ColumnAlignment = 64;
+    
+    explicit Archetype(const ComponentMask& mask);
+    
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+    
+    // Appends an entity whose components are left uninitialized; the caller
+    // constructs them in place.
+    void Allocate(Entity entity, uint32_t version, uint32_t& chunk, uint32_t& row);
+    
+    // Fills the hole at chunk/row with the last entity and returns the
+    // entity that moved, or an invalid one. Components at chunk/row must
+    // already be destroyed or moved out.
+    Entity Remove(uint32_t chunk, uint32_t row, uint32_t version);
+    
+    // Destroys every component of every entity and frees the chunks.
+    void Clear();
+    
+    inline int32_t GetColumn(ComponentId id) const { return m_Columns[id]; }
+    
+    inline void* GetColumnData(const Chunk& chunk, uint32_t column) const { return chunk.data + m_Offsets[column]; }
+    
+    inline void* GetComponent(uint32_t chunk, uint32_t row, uint32_t column) const
+    {
+        return m_Chunks[chunk]->data + m_Offsets[column] + row * m_Infos[column]->size;
+    }
+    
+    inline Entity* GetEntities(const Chunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data); }
+    
+    inline const ComponentMask& GetMask() const { return m_Mask; }
+    inline const std::vector<ComponentId>& GetComponents() const { return m_Components; }
+    inline const ComponentInfo& GetInfo(uint32_t column) const { return *m_Infos[column]; }
+    
+    inline size_t GetChunkCount() const { return m_Chunks.size(); }
+    inline Chunk& GetChunk(size_t index) const { return *m_Chunks[index]; }
+    
+    inline uint32_t GetCapacity() const { return m_Capacity; }
+    inline size_t GetEntityCount() const { return m_EntityCount; }
+    
+    ~Archetype();
+};
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "command-buffer.h"
+
+void* CommandBuffer::AllocateValue(size_t size, size_t alignment)
+{
+    // Values that could never share a block get their own allocation.
+    if (size + alignment > BlockSize)
+    {
+        m_LargeValues.push_back(std::make_unique<uint8_t[]>(size + alignment));
+        
+        uintptr_t address = reinterpret_cast<uintptr_t>(m_LargeValues.back().get());
+        return reinterpret_cast<void*>((address + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    }
+    
+    uintptr_t address = 0;
+    
+    if (m_BlockOffset < BlockSize)
+    {
+        uintptr_t base = reinterpret_cast<uintptr_t>(m_Blocks.back().get());
+        address = (base + m_BlockOffset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        
+        if (address + size > base + BlockSize) address = 0;
+    }
+    
+    if (address == 0)
+    {
+        m_Blocks.push_back(std::make_unique<uint8_t[]>(BlockSize));
+        
+        uintptr_t base = reinterpret_cast<uintptr_t>(m_Blocks.back().get());
+        address = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+    
+    m_BlockOffset = address + size - reinterpret_cast<uintptr_t>(m_Blocks.back().get());
+    return reinterpret_cast<void*>(address);
+}
+
+void CommandBuffer::Push(const Command& command)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Commands.push_back(command);
+}
+
+Entity CommandBuffer::Create()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    
+    Entity placeholder = { m_PendingCount++, Entity::PendingGeneration };
+    
+    Command command;
+    command.type = CommandType::Create;
+    command.entity = placeholder;
+    m_Commands.push_back(command);
+    
+    return placeholder;
+}
+
+void CommandBuffer::Destroy(Entity entity)
+{
+    Command command;
+    command.type = CommandType::Destroy;
+    command.entity = entity;
+    
+    Push(command);
+}
+
+Entity CommandBuffer::Resolve(Entity entity) const
+{
+    if (entity.generation != Entity::PendingGeneration) return entity;
+    
+    return entity.index < m_Created.size() ? m_Created[entity.index] : Entity();
+}
+
+void CommandBuffer::Playback(World& world)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    
+    m_Created.assign(m_PendingCount, Entity());
+    
+    for (Command& command : m_Commands)
+    {
+        Entity entity = Resolve(command.entity);
+        
+        switch (command.type)
+        {
+            case CommandType::Create:
+                m_Created[command.entity.index] = world.Create();
+                break;
+                
+            case CommandType::Destroy:
+                world.Destroy(entity);
+                break;
+                
+            case CommandType::Add:
+                if (world.IsAlive(entity)) command.apply(world, entity, command.value);
+                break;
+                
+            case CommandType::Remove:
+                world.RemoveRaw(entity, command.component);
+                break;
+        }
+    }
+    
+    Reset();
+}
+
+void CommandBuffer::Reset()
+{
+    for (Command& command : m_Commands)
+        if (command.value) command.destroy(command.value);
+    
+    m_Commands.clear();
+    m_Created.clear();
+    m_PendingCount = 0;
+    
+    // Keep the first block for the next frame's commands.
+    if (m_Blocks.size() > 1) m_Blocks.resize(1);
+    
+    m_LargeValues.clear();
+    m_BlockOffset = 0;
+    
+    if (m_Blocks.empty()) m_BlockOffset = BlockSize;
+}
+
+bool CommandBuffer::IsEmpty()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Commands.empty();
+}
+
+CommandBuffer::~CommandBuffer()
+{
+    Reset();
+}
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "entity.h"
+#include "component.h"
+#include "world.h"
+
+// Structural changes recorded while a query is iterating and applied later
+// with Playback. Recording is thread-safe, so parallel queries can share one
+// buffer; commands from one thread keep their order.
+//
+// Create returns a placeholder entity that later commands in the same
+// buffer may refer to; it becomes a real entity during Playback.
+class CommandBuffer
+{
+private:
+    
+    enum class CommandType : uint8_t
+    {
+        Create,
+        Destroy,
+        Add,
+        Remove
+    };
+    
+    struct Command
+    {
+        CommandType type;
+        Entity entity;
+        ComponentId component = 0;
+        
+        // Add only: the value, living in the arena, and how to use it.
+        void* value = nullptr;
+        void (*apply)(World&, Entity, void*) = nullptr;
+        void (*destroy)(void*) = nullptr;
+    };
+    
+    static constexpr size_t BlockSize = 64 * 1024;
+    
+    std::mutex m_Mutex;
+    
+    std::vector<Command> m_Commands;
+    
+    // Values are placement-new'd into fixed blocks, so they never move.
+    std::vector<std::unique_ptr<uint8_t[]>> m_Blocks;
+    std::vector<std::unique_ptr<uint8_t[]>> m_LargeValues;
+    size_t m_BlockOffset = BlockSize;
+    
+    uint32_t m_PendingCount = 0;
+    std::vector<Entity> m_Created;
+    
+    void* AllocateValue(size_t size, size_t alignment);
+    
+    void Push(const Command& command);
+    
+    Entity Resolve(Entity entity) const;
+    
+    void Reset();
+    
+public:
+    
+    CommandBuffer() = default;
+    
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    
+    Entity Create();
+    
+    void Destroy(Entity entity);
+    
+    template<typename T>
+    void Add(Entity entity, T&& value)
+    {
+        using Type = std::remove_cv_t<std::remove_reference_t<T>>;
+        
+        Command command;
+        command.type = CommandType::Add;
+        command.entity = entity;
+        command.component = ComponentRegistry::GetId<Type>();
+        command.apply = [](World& world, Entity target, void* object) { world.Add<Type>(target, std::move(*static_cast<Type*>(object))); };
+        command.destroy = [](void* object) { static_cast<Type*>(object)->~Type(); };
+        
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        
+        command.value = new (AllocateValue(sizeof(Type), alignof(Type))) Type(std::forward<T>(value));
+        m_Commands.push_back(command);
+    }
+    
+    template<typename T>
+    void Remove(Entity entity)
+    {
+        Command command;
+        command.type = CommandType::Remove;
+        command.entity = entity;
+        command.component = ComponentRegistry::GetId<T>();
+        
+        Push(command);
+    }
+    
+    // Applies every command in recording order, then empties the buffer.
+    // Commands on entities that died in the meantime are skipped. Nothing
+    // may record into this buffer until it returns.
+    void Playback(World& world);
+    
+    bool IsEmpty();
+    
+    ~CommandBuffer();
+};
@@ -0,0 +1,51 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "component.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#include "../utils/log-macros.h"
+
+ComponentInfo ComponentRegistry::s_Infos[MaxComponentTypes];
+
+static std::atomic<uint32_t> s_ComponentCount{0};
+
+ComponentId ComponentRegistry::Register(const ComponentInfo& info)
+{
+    ComponentId id = s_ComponentCount.fetch_add(1, std::memory_order_relaxed);
+    
+    if (id >= MaxComponentTypes)
+    {
+        LOG_CORE_CRITICAL("Too many component types, raise MaxComponentTypes ({})", MaxComponentTypes);
+        std::abort();
+    }
+    
+    s_Infos[id] = info;
+    return id;
+}
+
+uint32_t ComponentRegistry::GetCount()
+{
+    return s_ComponentCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+using ComponentId = uint32_t;
+
+static constexpr uint32_t MaxComponentTypes = 128;
+
+// One bit per component type; an archetype is identified by its mask.
+using ComponentMask = std::bitset<MaxComponentTypes>;
+
+// What an archetype needs to know to store a component type it never sees
+// as a C++ type. Null functions mean the type is trivial and bytes can be
+// copied instead.
+struct ComponentInfo
+{
+    size_t size = 0;
+    size_t alignment = 0;
+    
+    // Move-constructs from src into dst, then destroys src.
+    void (*relocate)(void* dst, void* src) = nullptr;
+    void (*destroy)(void* object) = nullptr;
+};
+
+// Hands out a dense id per component type the first time it is used.
+class ComponentRegistry
+{
+private:
+    
+    static ComponentInfo s_Infos[MaxComponentTypes];
+    
+    static ComponentId Register(const ComponentInfo& info);
+    
+    template<typename T>
+    static ComponentInfo MakeInfo()
+    {
+        ComponentInfo info;
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            info.relocate = [](void* dst, void* src)
+            {
+                new (dst) T(std::move(*static_cast<T*>(src)));
+                static_cast<T*>(src)->~T();
+            };
+        }
+        
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            info.destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+        
+        return info;
+    }
+    
+public:
+    
+    template<typename T>
+    static ComponentId GetId()
+    {
+        using Type = std::remove_cv_t<std::remove_reference_t<T>>;
+        
+        // const T and T must share one id, so only the plain type registers.
+        if constexpr (!std::is_same_v<T, Type>)
+        {
+            return GetId<Type>();
+        }
+        else
+        {
+            static_assert(std::is_move_constructible_v<Type>, "Components must be move constructible");
+            
+            // Thread-safe: local statics are initialized exactly once.
+            static const ComponentId id = Register(MakeInfo<Type>());
+            return id;
+        }
+    }
+    
+    static const ComponentInfo& GetInfo(ComponentId id) { return s_Infos[id]; }
+    
+    static uint32_t GetCount();
+};
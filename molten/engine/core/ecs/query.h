@@ -0,0 +1,300 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "world.h"
+#include "../jobs/job-system.h"
+
+// Position of T among Ts, ignoring const.
+template<typename T, typename... Ts>
+struct ComponentIndex;
+
+template<typename T, typename First, typename... Rest>
+struct ComponentIndex<T, First, Rest...>
+{
+    static constexpr size_t value = std::is_same_v<std::remove_cv_t<T>, std::remove_cv_t<First>> ? 0 : 1 + ComponentIndex<T, Rest...>::value;
+};
+
+template<typename T>
+struct ComponentIndex<T>
+{
+    static constexpr size_t value = 0;
+};
+
+// The component arrays of one chunk, as declared by the query: const
+// components are read-only, the others were marked changed when the view
+// was made.
+template<typename... Ts>
+class ChunkView
+{
+private:
+    
+    const Archetype* m_Archetype = nullptr;
+    const Chunk* m_Chunk = nullptr;
+    std::array<void*, sizeof...(Ts)> m_Columns = {};
+    std::array<int32_t, sizeof...(Ts)> m_ColumnIndices = {};
+    
+public:
+    
+    ChunkView(const Archetype* archetype, const Chunk* chunk, const std::array<void*, sizeof...(Ts)>& columns,
+              const std::array<int32_t, sizeof...(Ts)>& columnIndices)
+    : m_Archetype(archetype), m_Chunk(chunk), m_Columns(columns), m_ColumnIndices(columnIndices) {}
+    
+    template<typename T>
+    auto Get() const
+    {
+        constexpr size_t index = ComponentIndex<T, Ts...>::value;
+        static_assert(index < sizeof...(Ts), "Component isn't part of the query");
+        
+        return static_cast<std::tuple_element_t<index, std::tuple<Ts...>>*>(m_Columns[index]);
+    }
+    
+    inline const Entity* GetEntities() const { return m_Archetype->GetEntities(*m_Chunk); }
+    
+    inline size_t Size() const { return m_Chunk->count; }
+    
+    // Whether the component was written in this chunk after the version,
+    // e.g. one returned by World::AdvanceVersion.
+    template<typename T>
+    bool HasChanged(uint32_t version) const
+    {
+        constexpr size_t index = ComponentIndex<T, Ts...>::value;
+        static_assert(index < sizeof...(Ts), "Component isn't part of the query");
+        
+        return m_Chunk->versions[m_ColumnIndices[index]] > version;
+    }
+};
+
+// Typed view of every entity that has all of Ts (plus With, minus Without).
+// Matching archetypes are cached and topped up as the world creates new
+// ones, so building a query once and reusing it is cheap.
+//
+//     Query<Transform2D, const Velocity> query(world);
+//     query.Each([&](Transform2D& transform, const Velocity& velocity) { ... });
+//
+// Declaring a component const keeps the query from marking it changed.
+template<typename... Ts>
+class Query
+{
+private:
+    
+    using View = ChunkView<Ts...>;
+    
+    World* m_World;
+    
+    ComponentMask m_All;
+    ComponentMask m_None;
+    
+    std::array<ComponentId, sizeof...(Ts)> m_Ids;
+    
+    std::vector<Archetype*> m_Matches;
+    size_t m_Scanned = 0;
+    
+    // Chunks of the current parallel run.
+    std::vector<std::pair<Archetype*, uint32_t>> m_Work;
+    
+    void Refresh()
+    {
+        const std::vector<Archetype*>& archetypes = m_World->m_Archetypes;
+        
+        for (; m_Scanned < archetypes.size(); m_Scanned++)
+        {
+            const ComponentMask& mask = archetypes[m_Scanned]->GetMask();
+            
+            if ((mask & m_All) == m_All && (mask & m_None).none())
+                m_Matches.push_back(archetypes[m_Scanned]);
+        }
+    }
+    
+    void Reset()
+    {
+        m_Matches.clear();
+        m_Scanned = 0;
+    }
+    
+    View MakeView(Archetype* archetype, Chunk& chunk, uint32_t version) const
+    {
+        std::array<void*, sizeof...(Ts)> columns;
+        std::array<int32_t, sizeof...(Ts)> columnIndices;
+        
+        size_t i = 0;
+        
+        auto bind = [&](auto* tag)
+        {
+            using T = std::remove_pointer_t<decltype(tag)>;
+            
+            int32_t column = archetype->GetColumn(m_Ids[i]);
+            
+            columnIndices[i] = column;
+            columns[i] = archetype->GetColumnData(chunk, static_cast<uint32_t>(column));
+            
+            if constexpr (!std::is_const_v<T>)
+                chunk.versions[column] = version;
+            
+            i++;
+        };
+        
+        (bind(static_cast<Ts*>(nullptr)), ...);
+        
+        return View(archetype, &chunk, columns, columnIndices);
+    }
+    
+    template<typename F>
+    static void EachInView(const View& view, F& function)
+    {
+        std::tuple<Ts*...> columns(view.template Get<Ts>()...);
+        const Entity* entities = view.GetEntities();
+        size_t count = view.Size();
+        
+        std::apply([&](Ts*... arrays)
+        {
+            for (size_t row = 0; row < count; row++)
+            {
+                if constexpr (std::is_invocable_v<F&, Entity, Ts&...>)
+                    function(entities[row], arrays[row]...);
+                else
+                    function(arrays[row]...);
+            }
+        }, columns);
+    }
+    
+    // Chunks can't be added or removed while this runs.
+    template<typename F>
+    void Iterate(F&& function)
+    {
+        Refresh();
+        
+        m_World->m_Iterating++;
+        
+        uint32_t version = m_World->m_Version;
+        
+        for (Archetype* archetype : m_Matches)
+            for (size_t c = 0; c < archetype->GetChunkCount(); c++)
+                function(MakeView(archetype, archetype->GetChunk(c), version));
+        
+        m_World->m_Iterating--;
+    }
+    
+    template<typename F>
+    void IterateParallel(JobSystem* jobs, F&& function)
+    {
+        if (!jobs) { Iterate(function); return; }
+        
+        Refresh();
+        
+        m_Work.clear();
+        
+        for (Archetype* archetype : m_Matches)
+            for (size_t c = 0; c < archetype->GetChunkCount(); c++)
+                m_Work.emplace_back(archetype, static_cast<uint32_t>(c));
+        
+        m_World->m_Iterating++;
+        
+        uint32_t version = m_World->m_Version;
+        
+        // Each job touches its own chunks, version stamps included.
+        jobs->ParallelFor(m_Work.size(), 0, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                function(MakeView(m_Work[i].first, m_Work[i].first->GetChunk(m_Work[i].second), version));
+        });
+        
+        m_World->m_Iterating--;
+    }
+    
+public:
+    
+    explicit Query(World& world)
+    : m_World(&world), m_Ids{ComponentRegistry::GetId<Ts>()...}
+    {
+        for (ComponentId id : m_Ids)
+            m_All.set(id);
+    }
+    
+    // Also requires T, without accessing it.
+    template<typename T>
+    Query& With()
+    {
+        m_All.set(ComponentRegistry::GetId<T>());
+        Reset();
+        return *this;
+    }
+    
+    // Skips entities that have T.
+    template<typename T>
+    Query& Without()
+    {
+        m_None.set(ComponentRegistry::GetId<T>());
+        Reset();
+        return *this;
+    }
+    
+    size_t Count()
+    {
+        Refresh();
+        
+        size_t count = 0;
+        
+        for (const Archetype* archetype : m_Matches)
+            count += archetype->GetEntityCount();
+        
+        return count;
+    }
+    
+    // function(ChunkView<Ts...>&) once per chunk.
+    template<typename F>
+    void EachChunk(F&& function)
+    {
+        Iterate([&](View view) { function(view); });
+    }
+    
+    // function(Entity, Ts&...) or function(Ts&...) once per entity.
+    template<typename F>
+    void Each(F&& function)
+    {
+        Iterate([&](const View& view) { EachInView(view, function); });
+    }
+    
+    // Like EachChunk and Each, with chunks spread over the job system's
+    // workers. The function runs concurrently, so it may only write to the
+    // components it was given; record structural changes in a CommandBuffer.
+    template<typename F>
+    void ParallelEachChunk(JobSystem* jobs, F&& function)
+    {
+        IterateParallel(jobs, [&](View view) { function(view); });
+    }
+    
+    template<typename F>
+    void ParallelEach(JobSystem* jobs, F&& function)
+    {
+        IterateParallel(jobs, [&](const View& view) { EachInView(view, function); });
+    }
+};
@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <cstdint>
+
+#include "../maths/vector.h"
+#include "../renderer/sprite-store.h"
+
+class Texture2D;
+
+// Sprite2D's data as components. Entities with both are drawn by
+// Renderer2D once SpriteSystem has linked them to the renderer.
+
+struct Transform2D
+{
+    Vec2 position = {0.0f, 0.0f};
+    float rotation = 0.0f;
+};
+
+struct SpriteComponent
+{
+    Vec2 size = {100.0f, 100.0f};
+    Vec4 color = {1.0f, 1.0f, 1.0f, 1.0f};
+    std::shared_ptr<Texture2D> texture;
+    
+    int16_t layer = 0;
+    float depth = 0.0f;
+    BlendMode blendMode = BlendMode::Opaque;
+};
+
+// Added by SpriteSystem: the renderer sprite mirroring the entity.
+struct SpriteLink
+{
+    SpriteHandle handle;
+};
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sprite-system.h"
+
+#include "../renderer/renderer-2D.h"
+#include "../renderer/texture-2D.h"
+#include "../utils/profiler.h"
+
+SpriteSystem::SpriteSystem(World& world, Renderer2D* renderer)
+: m_World(world), m_Renderer(renderer), m_Linked(world), m_Unlinked(world), m_WithoutTransform(world), m_WithoutSprite(world)
+{
+    m_Unlinked.Without<SpriteLink>();
+    m_WithoutTransform.Without<Transform2D>();
+    m_WithoutSprite.Without<SpriteComponent>();
+    
+    m_World.SetOnRemove<SpriteLink>([renderer](Entity, SpriteLink& link) { renderer->DestroySprite(link.handle); });
+}
+
+void SpriteSystem::Update()
+{
+    PROFILE_SCOPE("SpriteSystem::Update");
+    
+    SpriteStore& sprites = m_Renderer->GetSprites();
+    
+    m_Linked.EachChunk([&](auto& view)
+    {
+        bool transformChanged = view.template HasChanged<Transform2D>(m_LastVersion);
+        bool spriteChanged = view.template HasChanged<SpriteComponent>(m_LastVersion);
+        
+        if (!transformChanged && !spriteChanged) return;
+        
+        const Transform2D* transforms = view.template Get<const Transform2D>();
+        const SpriteComponent* components = view.template Get<const SpriteComponent>();
+        const SpriteLink* links = view.template Get<const SpriteLink>();
+        
+        for (size_t i = 0; i < view.Size(); i++)
+        {
+            SpriteHandle handle = links[i].handle;
+            
+            uint32_t index = sprites.IndexOf(handle);
+            if (index == SpriteStore::InvalidIndex) continue;
+            
+            // Only write what differs: every setter marks the sprite dirty,
+            // and some of them make the renderer re-sort.
+            if (transformChanged)
+            {
+                const Transform2D& transform = transforms[i];
+                
+                if (sprites.GetPositionsX()[index] != transform.position.x || sprites.GetPositionsY()[index] != transform.position.y)
+                    sprites.SetPosition(handle, transform.position);
+                
+                if (sprites.GetRotations()[index] != transform.rotation)
+                    sprites.SetRotation(handle, transform.rotation);
+            }
+            
+            if (spriteChanged)
+            {
+                const SpriteComponent& sprite = components[i];
+                
+                if (sprites.GetSizesX()[index] != sprite.size.x || sprites.GetSizesY()[index] != sprite.size.y)
+                    sprites.SetSize(handle, sprite.size);
+                
+                const Vec4& color = sprites.GetColors()[index];
+                
+                if (color.x != sprite.color.x || color.y != sprite.color.y || color.z != sprite.color.z || color.w != sprite.color.w)
+                    sprites.SetColor(handle, sprite.color);
+                
+                if (sprites.GetTextures()[index] != sprite.texture)
+                    sprites.SetTexture(handle, sprite.texture);
+                
+                if (sprites.GetLayers()[index] != sprite.layer) sprites.SetLayer(handle, sprite.layer);
+                if (sprites.GetDepths()[index] != sprite.depth) sprites.SetDepth(handle, sprite.depth);
+                if (sprites.GetBlendModes()[index] != sprite.blendMode) sprites.SetBlendMode(handle, sprite.blendMode);
+            }
+        }
+    });
+    
+    m_Unlinked.Each([&](Entity entity, const Transform2D& transform, const SpriteComponent& sprite)
+    {
+        SpriteHandle handle = m_Renderer->CreateSprite(transform.position, sprite.size, transform.rotation, sprite.color, sprite.texture);
+        
+        sprites.SetLayer(handle, sprite.layer);
+        sprites.SetDepth(handle, sprite.depth);
+        sprites.SetBlendMode(handle, sprite.blendMode);
+        
+        m_Commands.Add(entity, SpriteLink{handle});
+    });
+    
+    // Removing the link runs the hook, which destroys the renderer sprite.
+    m_WithoutTransform.Each([&](Entity entity, const SpriteLink&) { m_Commands.Remove<SpriteLink>(entity); });
+    m_WithoutSprite.Each([&](Entity entity, const SpriteLink&) { m_Commands.Remove<SpriteLink>(entity); });
+    
+    m_Commands.Playback(m_World);
+    
+    // Writes from here on, including by systems running later this frame,
+    // are picked up by the next Update.
+    m_LastVersion = m_World.AdvanceVersion();
+}
+
+SpriteSystem::~SpriteSystem()
+{
+    m_World.SetOnRemove<SpriteLink>(nullptr);
+}
@@ -0,0 +1,66 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+#include "world.h"
+#include "query.h"
+#include "command-buffer.h"
+#include "sprite-components.h"
+
+class Renderer2D;
+
+// Keeps Renderer2D's sprite store in step with the world. Entities with a
+// Transform2D and a SpriteComponent get a renderer sprite (and a SpriteLink)
+// on the next Update; after that only chunks whose components were written
+// since the previous Update are copied, so static entities cost nothing.
+// Destroying the entity, or removing either component, destroys the sprite.
+class SpriteSystem
+{
+private:
+    
+    World& m_World;
+    Renderer2D* m_Renderer;
+    
+    Query<const Transform2D, const SpriteComponent, const SpriteLink> m_Linked;
+    Query<const Transform2D, const SpriteComponent> m_Unlinked;
+    Query<const SpriteLink> m_WithoutTransform;
+    Query<const SpriteLink> m_WithoutSprite;
+    
+    CommandBuffer m_Commands;
+    
+    uint32_t m_LastVersion = 0;
+    
+public:
+    
+    SpriteSystem(World& world, Renderer2D* renderer);
+    
+    SpriteSystem(const SpriteSystem&) = delete;
+    SpriteSystem& operator=(const SpriteSystem&) = delete;
+    
+    // Run once per frame, before Renderer2D::PrepareRenderingData.
+    void Update();
+    
+    ~SpriteSystem();
+};
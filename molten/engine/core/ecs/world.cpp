@@ -0,0 +1,344 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "world.h"
+
+#include <cstring>
+
+#include "../utils/log-macros.h"
+
+World::World()
+{
+    GetArchetype(ComponentMask());
+}
+
+Archetype* World::GetArchetype(const ComponentMask& mask)
+{
+    auto it = m_ArchetypeMap.find(mask);
+    if (it != m_ArchetypeMap.end()) return it->second.get();
+    
+    std::unique_ptr<Archetype> archetype = std::make_unique<Archetype>(mask);
+    Archetype* result = archetype.get();
+    
+    m_ArchetypeMap.emplace(mask, std::move(archetype));
+    m_Archetypes.push_back(result);
+    
+    return result;
+}
+
+const World::EntityRecord* World::Find(Entity entity) const
+{
+    if (entity.index >= m_Entities.size()) return nullptr;
+    
+    const EntityRecord& record = m_Entities[entity.index];
+    if (record.generation != entity.generation || !record.archetype) return nullptr;
+    
+    return &record;
+}
+
+void World::CheckStructuralChange() const
+{
+    CORE_ASSERT(m_Iterating == 0, "Structural change while a query is iterating, use a CommandBuffer");
+}
+
+Entity World::CreateRaw(const ComponentMask& mask, size_t componentCount)
+{
+    CheckStructuralChange();
+    
+    if (mask.count() != componentCount)
+    {
+        LOG_CORE_ERROR("World::Create given the same component type twice");
+        return Entity();
+    }
+    
+    uint32_t index;
+    
+    if (!m_FreeEntities.empty())
+    {
+        index = m_FreeEntities.back();
+        m_FreeEntities.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Entities.size());
+        m_Entities.emplace_back();
+    }
+    
+    EntityRecord& record = m_Entities[index];
+    Entity entity = { index, record.generation };
+    
+    record.archetype = GetArchetype(mask);
+    record.archetype->Allocate(entity, m_Version, record.chunk, record.row);
+    
+    m_EntityCount++;
+    return entity;
+}
+
+void World::DestroyComponents(Entity entity, const EntityRecord& record)
+{
+    Archetype& archetype = *record.archetype;
+    
+    // Hooks count as iteration, so they can't move the entity under us.
+    m_Iterating++;
+    
+    for (size_t column = 0; column < archetype.m_Components.size(); column++)
+    {
+        void* component = archetype.GetComponent(record.chunk, record.row, static_cast<uint32_t>(column));
+        
+        if (m_RemoveHooks[archetype.m_Components[column]])
+            m_RemoveHooks[archetype.m_Components[column]](entity, component);
+        
+        if (archetype.GetInfo(static_cast<uint32_t>(column)).destroy)
+            archetype.GetInfo(static_cast<uint32_t>(column)).destroy(component);
+    }
+    
+    m_Iterating--;
+}
+
+void World::Destroy(Entity entity)
+{
+    CheckStructuralChange();
+    
+    if (!Find(entity)) return;
+    
+    EntityRecord& record = m_Entities[entity.index];
+    
+    DestroyComponents(entity, record);
+    
+    Entity moved = record.archetype->Remove(record.chunk, record.row, m_Version);
+    
+    if (moved.IsValid())
+    {
+        m_Entities[moved.index].chunk = record.chunk;
+        m_Entities[moved.index].row = record.row;
+    }
+    
+    record.archetype = nullptr;
+    
+    if (++record.generation == Entity::PendingGeneration) record.generation = 1;
+    
+    m_FreeEntities.push_back(entity.index);
+    m_EntityCount--;
+}
+
+void World::Clear()
+{
+    CheckStructuralChange();
+    
+    // Hooks first, while every component is still in place.
+    m_Iterating++;
+    
+    for (Archetype* archetype : m_Archetypes)
+    {
+        for (size_t column = 0; column < archetype->m_Components.size(); column++)
+        {
+            const std::function<void(Entity, void*)>& hook = m_RemoveHooks[archetype->m_Components[column]];
+            if (!hook) continue;
+            
+            size_t size = archetype->GetInfo(static_cast<uint32_t>(column)).size;
+            
+            for (size_t c = 0; c < archetype->GetChunkCount(); c++)
+            {
+                Chunk& chunk = archetype->GetChunk(c);
+                uint8_t* data = static_cast<uint8_t*>(archetype->GetColumnData(chunk, static_cast<uint32_t>(column)));
+                
+                for (uint32_t row = 0; row < chunk.count; row++)
+                    hook(archetype->GetEntities(chunk)[row], data + row * size);
+            }
+        }
+    }
+    
+    m_Iterating--;
+    
+    for (Archetype* archetype : m_Archetypes)
+        archetype->Clear();
+    
+    m_FreeEntities.clear();
+    
+    for (uint32_t index = 0; index < m_Entities.size(); index++)
+    {
+        EntityRecord& record = m_Entities[index];
+        
+        if (record.archetype && ++record.generation == Entity::PendingGeneration) record.generation = 1;
+        record.archetype = nullptr;
+        
+        m_FreeEntities.push_back(static_cast<uint32_t>(m_Entities.size() - 1 - index));
+    }
+    
+    m_EntityCount = 0;
+}
+
+void World::MoveEntity(Entity entity, EntityRecord& record, Archetype* target)
+{
+    Archetype* source = record.archetype;
+    
+    uint32_t chunk, row;
+    target->Allocate(entity, m_Version, chunk, row);
+    
+    for (size_t column = 0; column < source->m_Components.size(); column++)
+    {
+        int32_t targetColumn = target->GetColumn(source->m_Components[column]);
+        if (targetColumn < 0) continue;
+        
+        const ComponentInfo& info = source->GetInfo(static_cast<uint32_t>(column));
+        
+        void* src = source->GetComponent(record.chunk, record.row, static_cast<uint32_t>(column));
+        void* dst = target->GetComponent(chunk, row, static_cast<uint32_t>(targetColumn));
+        
+        if (info.relocate) info.relocate(dst, src);
+        else std::memcpy(dst, src, info.size);
+    }
+    
+    Entity moved = source->Remove(record.chunk, record.row, m_Version);
+    
+    if (moved.IsValid())
+    {
+        m_Entities[moved.index].chunk = record.chunk;
+        m_Entities[moved.index].row = record.row;
+    }
+    
+    record.archetype = target;
+    record.chunk = chunk;
+    record.row = row;
+}
+
+void* World::GetRaw(Entity entity, ComponentId id, bool write) const
+{
+    const EntityRecord* record = Find(entity);
+    if (!record) return nullptr;
+    
+    int32_t column = record->archetype->GetColumn(id);
+    if (column < 0) return nullptr;
+    
+    if (write) record->archetype->GetChunk(record->chunk).versions[column] = m_Version;
+    
+    return record->archetype->GetComponent(record->chunk, record->row, static_cast<uint32_t>(column));
+}
+
+void* World::AddRaw(Entity entity, ComponentId id, bool& existed)
+{
+    if (!Find(entity)) return nullptr;
+    
+    EntityRecord& record = m_Entities[entity.index];
+    
+    existed = record.archetype->GetColumn(id) >= 0;
+    if (existed) return GetRaw(entity, id, true);
+    
+    CheckStructuralChange();
+    
+    Archetype* source = record.archetype;
+    Archetype*& target = source->m_AddEdges[id];
+    
+    if (!target)
+    {
+        ComponentMask mask = source->GetMask();
+        mask.set(id);
+        target = GetArchetype(mask);
+    }
+    
+    MoveEntity(entity, record, target);
+    
+    return target->GetComponent(record.chunk, record.row, static_cast<uint32_t>(target->GetColumn(id)));
+}
+
+bool World::RemoveRaw(Entity entity, ComponentId id)
+{
+    if (!Find(entity)) return false;
+    
+    EntityRecord& record = m_Entities[entity.index];
+    
+    int32_t column = record.archetype->GetColumn(id);
+    if (column < 0) return false;
+    
+    CheckStructuralChange();
+    
+    void* component = record.archetype->GetComponent(record.chunk, record.row, static_cast<uint32_t>(column));
+    
+    if (m_RemoveHooks[id])
+    {
+        m_Iterating++;
+        m_RemoveHooks[id](entity, component);
+        m_Iterating--;
+    }
+    
+    if (record.archetype->GetInfo(static_cast<uint32_t>(column)).destroy)
+        record.archetype->GetInfo(static_cast<uint32_t>(column)).destroy(component);
+    
+    Archetype* source = record.archetype;
+    Archetype*& target = source->m_RemoveEdges[id];
+    
+    if (!target)
+    {
+        ComponentMask mask = source->GetMask();
+        mask.reset(id);
+        target = GetArchetype(mask);
+    }
+    
+    MoveEntity(entity, record, target);
+    return true;
+}
+
+bool World::Validate() const
+{
+    size_t rows = 0;
+    
+    for (const Archetype* archetype : m_Archetypes)
+    {
+        size_t count = 0;
+        
+        for (size_t c = 0; c < archetype->GetChunkCount(); c++)
+        {
+            const Chunk& chunk = archetype->GetChunk(c);
+            
+            // Only the last chunk may be partly full, and none empty.
+            bool last = c + 1 == archetype->GetChunkCount();
+            if (chunk.count == 0 || chunk.count > archetype->GetCapacity() || (!last && chunk.count != archetype->GetCapacity())) return false;
+            
+            const Entity* entities = archetype->GetEntities(chunk);
+            
+            for (uint32_t row = 0; row < chunk.count; row++)
+            {
+                const EntityRecord* record = Find(entities[row]);
+                if (!record || record->archetype != archetype || record->chunk != c || record->row != row) return false;
+            }
+            
+            count += chunk.count;
+        }
+        
+        if (count != archetype->GetEntityCount()) return false;
+        rows += count;
+    }
+    
+    // Each row matched a distinct live record, so equal counts mean every
+    // live record was matched.
+    size_t live = 0;
+    
+    for (const EntityRecord& record : m_Entities)
+        if (record.archetype) live++;
+    
+    return rows == live && live == m_EntityCount && live + m_FreeEntities.size() == m_Entities.size();
+}
+
+// Components are destroyed with their archetypes. Remove hooks don't run,
+// since whatever they release may already be gone; call Clear first if
+// they should.
+World::~World() = default;
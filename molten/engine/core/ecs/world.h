@@ -0,0 +1,209 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "entity.h"
+#include "component.h"
+#include "archetype.h"
+
+template<typename... Ts>
+class Query;
+
+// Entities and their components, grouped by archetype into chunks so that a
+// query walks plain arrays. Adding or removing components moves an entity
+// to another archetype; pointers to components are only valid until the
+// next structural change.
+//
+// Structural changes (Create, Destroy, Add, Remove) are not allowed while a
+// query is iterating; record them in a CommandBuffer instead.
+class World
+{
+private:
+    
+    template<typename... Ts>
+    friend class Query;
+    
+    friend class CommandBuffer;
+    
+    struct EntityRecord
+    {
+        uint32_t generation = 1;
+        Archetype* archetype = nullptr;
+        uint32_t chunk = 0;
+        uint32_t row = 0;
+    };
+    
+    std::vector<EntityRecord> m_Entities;
+    std::vector<uint32_t> m_FreeEntities;
+    size_t m_EntityCount = 0;
+    
+    // Archetypes are never destroyed, so queries can cache them.
+    std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_ArchetypeMap;
+    std::vector<Archetype*> m_Archetypes;
+    
+    std::function<void(Entity, void*)> m_RemoveHooks[MaxComponentTypes];
+    
+    uint32_t m_Version = 1;
+    int m_Iterating = 0;
+    
+    Archetype* GetArchetype(const ComponentMask& mask);
+    
+    const EntityRecord* Find(Entity entity) const;
+    
+    void CheckStructuralChange() const;
+    
+    // Moves an entity to another archetype, relocating the components both
+    // share. Components only the source has must already be destroyed.
+    void MoveEntity(Entity entity, EntityRecord& record, Archetype* target);
+    
+    void DestroyComponents(Entity entity, const EntityRecord& record);
+    
+    Entity CreateRaw(const ComponentMask& mask, size_t componentCount);
+    
+    void* GetRaw(Entity entity, ComponentId id, bool write) const;
+    
+    // Storage for a component the entity doesn't have yet, or the existing
+    // component (existed is set) if it does.
+    void* AddRaw(Entity entity, ComponentId id, bool& existed);
+    
+    bool RemoveRaw(Entity entity, ComponentId id);
+    
+    template<typename T>
+    void Construct(Entity entity, T&& component)
+    {
+        using Type = std::remove_cv_t<std::remove_reference_t<T>>;
+        new (GetRaw(entity, ComponentRegistry::GetId<Type>(), false)) Type(std::forward<T>(component));
+    }
+    
+public:
+    
+    World();
+    
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    
+    // Creates an entity with the given components, e.g.
+    // world.Create(Transform2D{...}, SpriteComponent{...}).
+    template<typename... Ts>
+    Entity Create(Ts&&... components)
+    {
+        ComponentMask mask;
+        (mask.set(ComponentRegistry::GetId<Ts>()), ...);
+        
+        Entity entity = CreateRaw(mask, sizeof...(Ts));
+        if (!entity.IsValid()) return entity;
+        
+        (Construct(entity, std::forward<Ts>(components)), ...);
+        return entity;
+    }
+    
+    void Destroy(Entity entity);
+    
+    // Destroys every entity; archetypes and their ids are kept.
+    void Clear();
+    
+    inline bool IsAlive(Entity entity) const { return Find(entity) != nullptr; }
+    
+    // Adds the component, or assigns it if the entity already has one.
+    template<typename T, typename... Args>
+    T* Add(Entity entity, Args&&... args)
+    {
+        bool existed = false;
+        void* storage = AddRaw(entity, ComponentRegistry::GetId<T>(), existed);
+        if (!storage) return nullptr;
+        
+        if (existed)
+        {
+            *static_cast<T*>(storage) = T{std::forward<Args>(args)...};
+            return static_cast<T*>(storage);
+        }
+        
+        return new (storage) T{std::forward<Args>(args)...};
+    }
+    
+    template<typename T>
+    bool Remove(Entity entity) { return RemoveRaw(entity, ComponentRegistry::GetId<T>()); }
+    
+    template<typename T>
+    bool Has(Entity entity) const
+    {
+        const EntityRecord* record = Find(entity);
+        return record && record->archetype->GetColumn(ComponentRegistry::GetId<T>()) >= 0;
+    }
+    
+    // Null if the entity is dead or lacks the component. The mutable version
+    // marks the component changed; use the const one to only read.
+    template<typename T>
+    T* Get(Entity entity) { return static_cast<T*>(GetRaw(entity, ComponentRegistry::GetId<T>(), true)); }
+    
+    template<typename T>
+    const T* Get(Entity entity) const
+    {
+        return static_cast<const T*>(GetRaw(entity, ComponentRegistry::GetId<T>(), false));
+    }
+    
+    // Called with the component right before it is removed or its entity is
+    // destroyed, e.g. to release what it refers to outside the world. Hooks
+    // can't make structural changes.
+    template<typename T>
+    void SetOnRemove(std::function<void(Entity, T&)> hook)
+    {
+        ComponentId id = ComponentRegistry::GetId<T>();
+        
+        if (!hook) { m_RemoveHooks[id] = nullptr; return; }
+        
+        m_RemoveHooks[id] = [hook = std::move(hook)](Entity entity, void* component) { hook(entity, *static_cast<T*>(component)); };
+    }
+    
+    // Every write through a mutable query or Get stamps the component's
+    // chunk column with the current version.
+    inline uint32_t GetVersion() const { return m_Version; }
+    
+    // Returns the current version and starts a new one. A system that keeps
+    // the returned value and later checks for versions above it sees exactly
+    // the writes made after this call.
+    inline uint32_t AdvanceVersion() { return m_Version++; }
+    
+    inline bool IsIterating() const { return m_Iterating > 0; }
+    
+    inline size_t GetEntityCount() const { return m_EntityCount; }
+    
+    inline size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+    
+    // Checks that every live entity's record points at the chunk row that
+    // holds it and that chunks hold nothing else. Walks the whole world;
+    // for tests and benchmarks.
+    bool Validate() const;
+    
+    ~World();
+};
@@ -0,0 +1,337 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "job-system.h"
+
+#include <algorithm>
+#include <string>
+
+#include "../utils/log-macros.h"
+#include "../utils/profiler.h"
+
+namespace
+{
+    thread_local JobSystem* t_JobSystem = nullptr;
+    thread_local int t_WorkerIndex = -1;
+    thread_local uint32_t t_StealSeed = 0x9E3779B9u;
+    
+    uint32_t NextStealVictim()
+    {
+        // xorshift32, only has to spread thieves across victims.
+        t_StealSeed ^= t_StealSeed << 13;
+        t_StealSeed ^= t_StealSeed >> 17;
+        t_StealSeed ^= t_StealSeed << 5;
+        return t_StealSeed;
+    }
+}
+
+JobCounter::~JobCounter()
+{
+    // The last Finish may still hold the lock right after the final decrement.
+    std::lock_guard<std::mutex> lock(m_Mutex);
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+: m_MainThreadId(std::this_thread::get_id())
+{
+    if (workerCount == 0) workerCount = std::max(1u, std::thread::hardware_concurrency());
+    
+    for (unsigned int i = 0; i < workerCount; i++)
+        m_Workers.push_back(std::make_unique<Worker>());
+    
+    t_JobSystem = this;
+    t_WorkerIndex = 0;
+    
+    for (unsigned int i = 1; i < workerCount; i++)
+        m_Workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    
+    LOG_CORE_INFO("Job system running on {} threads", workerCount);
+}
+
+int JobSystem::GetCurrentWorkerIndex() const
+{
+    return t_JobSystem == this ? t_WorkerIndex : -1;
+}
+
+size_t JobSystem::GetDefaultGrainSize(size_t count) const
+{
+    // A few chunks per worker leaves room for stealing to even out the load.
+    return std::max<size_t>(1, count / (m_Workers.size() * 4));
+}
+
+void JobSystem::WorkerLoop(unsigned int index)
+{
+    t_JobSystem = this;
+    t_WorkerIndex = static_cast<int>(index);
+    t_StealSeed ^= index * 0x85EBCA6Bu;
+    
+    PROFILE_THREAD(("Worker " + std::to_string(index)).c_str());
+    
+    while (m_Running.load(std::memory_order_acquire))
+    {
+        if (Job* job = FindJob(static_cast<int>(index)))
+        {
+            Execute(job);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        
+        m_SleepingWorkers.fetch_add(1);
+        m_WakeCondition.wait(lock, [this] { return m_QueuedJobs.load() > 0 || !m_Running.load(); });
+        m_SleepingWorkers.fetch_sub(1);
+    }
+}
+
+void JobSystem::Schedule(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+{
+    Enqueue(new Job{ std::move(function), counter, false }, dependency);
+}
+
+void JobSystem::ScheduleOnMainThread(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+{
+    Enqueue(new Job{ std::move(function), counter, true }, dependency);
+}
+
+void JobSystem::ScheduleParallelFor(size_t count, size_t grainSize, std::function<void(size_t, size_t)> function, JobCounter* counter)
+{
+    if (count == 0) return;
+    
+    if (grainSize == 0) grainSize = GetDefaultGrainSize(count);
+    
+    auto shared = std::make_shared<std::function<void(size_t, size_t)>>(std::move(function));
+    
+    for (size_t begin = 0; begin < count; begin += grainSize)
+    {
+        size_t end = std::min(count, begin + grainSize);
+        Schedule([shared, begin, end] { (*shared)(begin, end); }, counter);
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function)
+{
+    if (count == 0) return;
+    
+    if (grainSize == 0) grainSize = GetDefaultGrainSize(count);
+    
+    if (grainSize >= count)
+    {
+        function(0, count);
+        return;
+    }
+    
+    JobCounter counter;
+    
+    for (size_t begin = grainSize; begin < count; begin += grainSize)
+    {
+        size_t end = std::min(count, begin + grainSize);
+        Schedule([&function, begin, end] { function(begin, end); }, &counter);
+    }
+    
+    // The caller takes the first chunk instead of idling.
+    function(0, grainSize);
+    
+    Wait(counter);
+}
+
+void JobSystem::Enqueue(Job* job, JobCounter* dependency)
+{
+    if (job->counter) job->counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+    
+    if (dependency)
+    {
+        std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+        
+        if (dependency->m_Pending.load(std::memory_order_acquire) != 0)
+        {
+            dependency->m_Waiting.push_back(job);
+            return;
+        }
+    }
+    
+    Submit(job);
+}
+
+void JobSystem::Submit(Job* job)
+{
+    if (job->mainThreadOnly)
+    {
+        std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+        m_MainThreadQueue.push_back(job);
+        m_MainThreadJobCount.fetch_add(1);
+        return;
+    }
+    
+    m_QueuedJobs.fetch_add(1);
+    
+    int index = GetCurrentWorkerIndex();
+    
+    if (index < 0 || !m_Workers[index]->deque.Push(job))
+    {
+        std::lock_guard<std::mutex> lock(m_GlobalMutex);
+        m_GlobalQueue.push_back(job);
+        m_GlobalJobCount.fetch_add(1);
+    }
+    
+    // Paired with the sleeping count a worker publishes before it waits, so
+    // either it sees the new job or this sees it asleep.
+    if (m_SleepingWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_WakeCondition.notify_one();
+    }
+}
+
+Job* JobSystem::FindJob(int workerIndex)
+{
+    if (workerIndex >= 0)
+    {
+        if (Job* job = m_Workers[workerIndex]->deque.Pop())
+        {
+            m_QueuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+    
+    if (m_GlobalJobCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_GlobalMutex);
+        
+        if (!m_GlobalQueue.empty())
+        {
+            Job* job = m_GlobalQueue.front();
+            m_GlobalQueue.pop_front();
+            m_GlobalJobCount.fetch_sub(1);
+            m_QueuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+    
+    size_t workerCount = m_Workers.size();
+    size_t start = NextStealVictim() % workerCount;
+    
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        size_t victim = (start + i) % workerCount;
+        if (static_cast<int>(victim) == workerIndex) continue;
+        
+        if (Job* job = m_Workers[victim]->deque.Steal())
+        {
+            m_QueuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+    
+    return nullptr;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    {
+        PROFILE_SCOPE("Job");
+        job->function();
+    }
+    
+    JobCounter* counter = job->counter;
+    delete job;
+    
+    Finish(counter);
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+    if (!counter) return;
+    
+    std::vector<Job*> ready;
+    
+    {
+        std::lock_guard<std::mutex> lock(counter->m_Mutex);
+        
+        if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            ready.swap(counter->m_Waiting);
+    }
+    
+    for (Job* job : ready)
+        Submit(job);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    PROFILE_SCOPE("JobSystem::Wait");
+    
+    int index = GetCurrentWorkerIndex();
+    bool mainThread = IsMainThread();
+    
+    while (!counter.IsDone())
+    {
+        if (mainThread && m_MainThreadJobCount.load() > 0)
+        {
+            RunMainThreadJobs();
+            continue;
+        }
+        
+        if (Job* job = FindJob(index))
+        {
+            Execute(job);
+            continue;
+        }
+        
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::RunMainThreadJobs()
+{
+    if (!IsMainThread() || m_MainThreadJobCount.load() == 0) return;
+    
+    std::vector<Job*> jobs;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+        jobs.swap(m_MainThreadQueue);
+        m_MainThreadJobCount.fetch_sub(static_cast<uint32_t>(jobs.size()));
+    }
+    
+    for (Job* job : jobs)
+        Execute(job);
+}
+
+JobSystem::~JobSystem()
+{
+    m_Running.store(false, std::memory_order_release);
+    
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_WakeCondition.notify_all();
+    }
+    
+    for (auto& worker : m_Workers)
+        if (worker->thread.joinable()) worker->thread.join();
+    
+    // Jobs still queued run now so their counters and captures settle.
+    while (Job* job = FindJob(0))
+        Execute(job);
+    
+    RunMainThreadJobs();
+    
+    if (t_JobSystem == this) t_JobSystem = nullptr;
+}
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <deque>
+
+#include "work-stealing-deque.h"
+
+class JobSystem;
+
+struct Job;
+
+// Number of jobs still to finish in a group. Jobs can wait on a counter
+// (JobSystem::Wait) or be scheduled to start only once it reaches zero.
+// A counter must outlive the jobs attached to it.
+class JobCounter
+{
+private:
+    
+    friend class JobSystem;
+    
+    std::atomic<uint32_t> m_Pending{0};
+    
+    // Guards m_Waiting and the final decrement, so the counter can be
+    // destroyed as soon as a waiter sees zero.
+    std::mutex m_Mutex;
+    std::vector<Job*> m_Waiting;
+    
+public:
+    
+    JobCounter() = default;
+    
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+    
+    inline bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    
+    inline uint32_t GetPending() const { return m_Pending.load(std::memory_order_acquire); }
+    
+    ~JobCounter();
+};
+
+struct Job
+{
+    std::function<void()> function;
+    JobCounter* counter = nullptr;
+    bool mainThreadOnly = false;
+};
+
+// Engine-wide worker pool. Every worker owns a work-stealing deque: jobs it
+// schedules go to its own deque, and idle workers steal from the others. The
+// thread that created the system is worker 0 and runs jobs while it waits.
+// Main-thread-only jobs are queued separately and run by that thread.
+class JobSystem
+{
+private:
+    
+    struct Worker
+    {
+        WorkStealingDeque<Job> deque;
+        std::thread thread;
+    };
+    
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    
+    std::thread::id m_MainThreadId;
+    
+    // Jobs scheduled from threads the system doesn't own.
+    std::mutex m_GlobalMutex;
+    std::deque<Job*> m_GlobalQueue;
+    std::atomic<uint32_t> m_GlobalJobCount{0};
+    
+    std::mutex m_MainThreadMutex;
+    std::vector<Job*> m_MainThreadQueue;
+    std::atomic<uint32_t> m_MainThreadJobCount{0};
+    
+    std::atomic<bool> m_Running{true};
+    std::atomic<int64_t> m_QueuedJobs{0};
+    
+    std::mutex m_SleepMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<uint32_t> m_SleepingWorkers{0};
+    
+    void WorkerLoop(unsigned int index);
+    
+    void Submit(Job* job);
+    
+    Job* FindJob(int workerIndex);
+    
+    void Execute(Job* job);
+    
+    void Finish(JobCounter* counter);
+    
+    void Enqueue(Job* job, JobCounter* dependency);
+    
+    int GetCurrentWorkerIndex() const;
+    
+    size_t GetDefaultGrainSize(size_t count) const;
+    
+public:
+    
+    // workerCount includes the main thread; 0 picks one per hardware thread.
+    explicit JobSystem(unsigned int workerCount = 0);
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    // Runs the function on any worker. If dependency is given, the job only
+    // starts once that counter reaches zero.
+    void Schedule(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+    
+    // Runs the function on the main thread, from RunMainThreadJobs or Wait.
+    void ScheduleOnMainThread(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+    
+    // Splits [0, count) into chunks of grainSize (0 picks one) and calls
+    // function(begin, end) for each chunk on the workers.
+    void ScheduleParallelFor(size_t count, size_t grainSize, std::function<void(size_t, size_t)> function, JobCounter* counter);
+    
+    // Blocking version of ScheduleParallelFor; the calling thread helps.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+    
+    // Runs other jobs until the counter reaches zero.
+    void Wait(JobCounter& counter);
+    
+    // Called by the main thread once per frame.
+    void RunMainThreadJobs();
+    
+    bool IsMainThread() const { return std::this_thread::get_id() == m_MainThreadId; }
+    
+    // Number of threads running jobs, including the main thread.
+    unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+    
+    ~JobSystem();
+};
@@ -0,0 +1,111 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Chase-Lev work-stealing deque of fixed capacity. The owning thread pushes
+// and pops at the bottom; any other thread may steal from the top.
+template <typename T, size_t Capacity = 4096>
+class WorkStealingDeque
+{
+private:
+    
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+    static constexpr int64_t Mask = static_cast<int64_t>(Capacity) - 1;
+    
+    alignas(64) std::atomic<int64_t> m_Top{0};
+    alignas(64) std::atomic<int64_t> m_Bottom{0};
+    
+    std::atomic<T*> m_Items[Capacity] = {};
+    
+public:
+    
+    // Owner only. Fails when the deque is full.
+    bool Push(T* item)
+    {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        
+        if (bottom - top >= static_cast<int64_t>(Capacity)) return false;
+        
+        m_Items[bottom & Mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        
+        return true;
+    }
+    
+    // Owner only. Returns the most recently pushed item, or nullptr.
+    T* Pop()
+    {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+        
+        if (top > bottom)
+        {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        
+        T* item = m_Items[bottom & Mask].load(std::memory_order_relaxed);
+        
+        // Last item: race the thieves for it.
+        if (top == bottom)
+        {
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        
+        return item;
+    }
+    
+    // Any thread. Returns the oldest item, or nullptr if empty or lost a race.
+    T* Steal()
+    {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        
+        if (top >= bottom) return nullptr;
+        
+        T* item = m_Items[top & Mask].load(std::memory_order_relaxed);
+        
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        
+        return item;
+    }
+    
+    bool IsEmpty() const
+    {
+        return m_Bottom.load(std::memory_order_acquire) <= m_Top.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// 2D affine transform, the 2x3 matrix [a c tx; b d ty] stored as three
+// column Vec2s. This is what a sprite's position, rotation and scale boil
+// down to, at half the size of a Mat4. The first two columns share a 16-byte
+// lane so batched code loads the linear part in one go.
+
+#pragma once
+
+#include <cmath>
+
+#include "matrix.h"
+
+struct alignas(16) Affine2D
+{
+    Vec2 columns[3];
+    
+    constexpr Affine2D() : columns{ { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f } } {}
+    constexpr Affine2D(const Vec2& xAxis, const Vec2& yAxis, const Vec2& translation) : columns{ xAxis, yAxis, translation } {}
+    
+    static constexpr Affine2D Identity() { return {}; }
+    
+    // Scale, then rotate (counter-clockwise, radians), then translate.
+    static constexpr Affine2D FromTRS(const Vec2& position, float sinAngle, float cosAngle, const Vec2& scale)
+    {
+        return { { cosAngle * scale.x, sinAngle * scale.x }, { -sinAngle * scale.y, cosAngle * scale.y }, position };
+    }
+    
+    static inline Affine2D FromTRS(const Vec2& position, float rotation, const Vec2& scale)
+    {
+        return FromTRS(position, std::sin(rotation), std::cos(rotation), scale);
+    }
+    
+    constexpr Vec2 TransformPoint(const Vec2& p) const { return columns[0] * p.x + columns[1] * p.y + columns[2]; }
+    constexpr Vec2 TransformVector(const Vec2& v) const { return columns[0] * v.x + columns[1] * v.y; }
+    
+    constexpr Vec2 GetTranslation() const { return columns[2]; }
+};
+
+static_assert(sizeof(Affine2D) == 32 && alignof(Affine2D) == 16, "Affine2D keeps its linear part in one 16-byte lane");
+
+// Applies b first, then a.
+constexpr Affine2D operator*(const Affine2D& a, const Affine2D& b)
+{
+    return { a.TransformVector(b.columns[0]), a.TransformVector(b.columns[1]), a.TransformPoint(b.columns[2]) };
+}
+
+constexpr bool operator==(const Affine2D& a, const Affine2D& b)
+{
+    return a.columns[0] == b.columns[0] && a.columns[1] == b.columns[1] && a.columns[2] == b.columns[2];
+}
+
+constexpr bool operator!=(const Affine2D& a, const Affine2D& b) { return !(a == b); }
+
+constexpr float Determinant(const Affine2D& m) { return Cross(m.columns[0], m.columns[1]); }
+
+// Singular transforms come back as zero.
+constexpr Affine2D Inverse(const Affine2D& m)
+{
+    float det = Determinant(m);
+    if (det == 0.0f) return { Vec2(), Vec2(), Vec2() };
+    
+    float inv = 1.0f / det;
+    Vec2 x = Vec2{ m.columns[1].y, -m.columns[0].y } * inv;
+    Vec2 y = Vec2{ -m.columns[1].x, m.columns[0].x } * inv;
+    Vec2 t = -(x * m.columns[2].x + y * m.columns[2].y);
+    
+    return { x, y, t };
+}
+
+// Splits the transform into translation, rotation (radians) and scale, the
+// inverse of FromTRS. Shear, which a rotated child of a non-uniformly scaled
+// parent picks up, has no slot and is dropped. A mirrored transform comes
+// back with a negative y scale.
+inline void Decompose(const Affine2D& m, Vec2& position, float& rotation, Vec2& scale)
+{
+    float scaleX = Length(m.columns[0]);
+    
+    position = m.columns[2];
+    rotation = std::atan2(m.columns[0].y, m.columns[0].x);
+    scale = { scaleX, scaleX > 0.0f ? Determinant(m) / scaleX : Length(m.columns[1]) };
+}
+
+// Embeds the transform in the z = 0 plane for the shaders' float4x4.
+constexpr Mat4 ToMat4(const Affine2D& m)
+{
+    return {
+        { m.columns[0], Vec2{ 0.0f, 0.0f } },
+        { m.columns[1], Vec2{ 0.0f, 0.0f } },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { m.columns[2], Vec2{ 0.0f, 1.0f } },
+    };
+}
@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Transforms over whole arrays, for the loops that push every sprite or
+// vertex through the same maths. Output spans must be at least as long as
+// the inputs. Out-of-place only: in and out may not overlap partially, but
+// may be the same span.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "affine-2D.h"
+#include "matrix.h"
+
+// Two points per register: (x0, y0, x1, y1) splits into (x0, x0, x1, x1) and
+// (y0, y0, y1, y1), which multiply the linear part (a, b, a, b), (c, d, c, d).
+MATHS_INLINE void TransformPoints(const Affine2D& m, std::span<const Vec2> points, std::span<Vec2> out)
+{
+    assert(out.size() >= points.size());
+    
+    const SIMDFloat4 linear = SIMDFloat4::Load(&m.columns[0].x);
+    const SIMDFloat4 xAxis = linear.DuplicateLow();
+    const SIMDFloat4 yAxis = linear.DuplicateHigh();
+    const SIMDFloat4 translation = SIMDFloat4::Set(m.columns[2].x, m.columns[2].y, m.columns[2].x, m.columns[2].y);
+    
+    const size_t count = points.size();
+    size_t i = 0;
+    
+    for (; i + 2 <= count; i += 2)
+    {
+        SIMDFloat4 p = SIMDFloat4::LoadUnaligned(&points[i].x);
+        SIMDFloat4 r = SIMDFloat4::MulAdd(xAxis, p.DuplicateEven(), translation);
+        SIMDFloat4::MulAdd(yAxis, p.DuplicateOdd(), r).StoreUnaligned(&out[i].x);
+    }
+    
+    if (i < count) out[i] = m.TransformPoint(points[i]);
+}
+
+// As TransformPoints, without the translation: directions and extents.
+MATHS_INLINE void TransformVectors(const Affine2D& m, std::span<const Vec2> vectors, std::span<Vec2> out)
+{
+    assert(out.size() >= vectors.size());
+    
+    const SIMDFloat4 linear = SIMDFloat4::Load(&m.columns[0].x);
+    const SIMDFloat4 xAxis = linear.DuplicateLow();
+    const SIMDFloat4 yAxis = linear.DuplicateHigh();
+    
+    const size_t count = vectors.size();
+    size_t i = 0;
+    
+    for (; i + 2 <= count; i += 2)
+    {
+        SIMDFloat4 v = SIMDFloat4::LoadUnaligned(&vectors[i].x);
+        SIMDFloat4::MulAdd(yAxis, v.DuplicateOdd(), xAxis * v.DuplicateEven()).StoreUnaligned(&out[i].x);
+    }
+    
+    if (i < count) out[i] = m.TransformVector(vectors[i]);
+}
+
+MATHS_INLINE void TransformPoints(const Mat4& m, std::span<const Vec4> points, std::span<Vec4> out)
+{
+    assert(out.size() >= points.size());
+    
+    const SIMDFloat4 c0 = m.columns[0].Load();
+    const SIMDFloat4 c1 = m.columns[1].Load();
+    const SIMDFloat4 c2 = m.columns[2].Load();
+    const SIMDFloat4 c3 = m.columns[3].Load();
+    
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        const SIMDFloat4 p = points[i].Load();
+        
+        SIMDFloat4 r = c0 * p.Splat<0>();
+        r = SIMDFloat4::MulAdd(c1, p.Splat<1>(), r);
+        r = SIMDFloat4::MulAdd(c2, p.Splat<2>(), r);
+        r = SIMDFloat4::MulAdd(c3, p.Splat<3>(), r);
+        r.Store(&out[i].x);
+    }
+}
+
+// out[i] = parents[i] * locals[i]. The linear parts multiply in one register:
+// (a, b, a, b) * (e, e, g, g) + (c, d, c, d) * (f, f, h, h).
+MATHS_INLINE void MultiplyAffine2D(std::span<const Affine2D> parents, std::span<const Affine2D> locals, std::span<Affine2D> out)
+{
+    assert(locals.size() == parents.size() && out.size() >= parents.size());
+    
+    for (size_t i = 0; i < parents.size(); i++)
+    {
+        const Affine2D& parent = parents[i];
+        const Affine2D& local = locals[i];
+        
+        const SIMDFloat4 p = SIMDFloat4::Load(&parent.columns[0].x);
+        const SIMDFloat4 l = SIMDFloat4::Load(&local.columns[0].x);
+        
+        // Read before the store in case out aliases one of the inputs.
+        const Vec2 translation = parent.TransformPoint(local.columns[2]);
+        
+        SIMDFloat4::MulAdd(p.DuplicateHigh(), l.DuplicateOdd(), p.DuplicateLow() * l.DuplicateEven()).Store(&out[i].columns[0].x);
+        out[i].columns[2] = translation;
+    }
+}
+
+// Builds transforms from structure-of-arrays position, rotation (radians) and
+// scale. Unrotated entries skip the trig.
+inline void ComposeAffine2D(std::span<const Vec2> positions, std::span<const float> rotations, std::span<const Vec2> scales,
+                            std::span<Affine2D> out)
+{
+    assert(rotations.size() == positions.size() && scales.size() == positions.size() && out.size() >= positions.size());
+    
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        const float rotation = rotations[i];
+        
+        if (rotation == 0.0f) out[i] = Affine2D::FromTRS(positions[i], 0.0f, 1.0f, scales[i]);
+        else out[i] = Affine2D::FromTRS(positions[i], std::sin(rotation), std::cos(rotation), scales[i]);
+    }
+}
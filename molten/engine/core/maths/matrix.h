@@ -20,6 +20,208 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <simd/simd.h>
+// Column-major matrices matching Metal's float3x3 and float4x4. Mat4 products
+// run on SIMDFloat4; Mat3 only shows up in setup code and stays scalar.
 
-simd::float4x4 Ortho(float left, float right, float bottom, float top);
+#pragma once
+
+#include <cmath>
+
+#include "vector.h"
+
+struct alignas(16) Mat3
+{
+    Vec3 columns[3];
+    
+    // Zero, like the simd types this replaced; use Identity() for identity.
+    constexpr Mat3() : columns{} {}
+    constexpr Mat3(const Vec3& c0, const Vec3& c1, const Vec3& c2) : columns{ c0, c1, c2 } {}
+    
+    static constexpr Mat3 Identity() { return { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }; }
+    
+    constexpr Vec3& operator[](int i) { return columns[i]; }
+    constexpr const Vec3& operator[](int i) const { return columns[i]; }
+};
+
+struct alignas(16) Mat4
+{
+    Vec4 columns[4];
+    
+    constexpr Mat4() : columns{} {}
+    constexpr Mat4(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) : columns{ c0, c1, c2, c3 } {}
+    
+    static constexpr Mat4 Identity()
+    {
+        return { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+    }
+    
+    static constexpr Mat4 Translation(const Vec3& t)
+    {
+        return { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { t, 1.0f } };
+    }
+    
+    static constexpr Mat4 Scale(const Vec3& s)
+    {
+        return { { s.x, 0.0f, 0.0f, 0.0f }, { 0.0f, s.y, 0.0f, 0.0f }, { 0.0f, 0.0f, s.z, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+    }
+    
+    static inline Mat4 RotationZ(float angle)
+    {
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        return { { c, s, 0.0f, 0.0f }, { -s, c, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+    }
+    
+    constexpr Vec4& operator[](int i) { return columns[i]; }
+    constexpr const Vec4& operator[](int i) const { return columns[i]; }
+};
+
+static_assert(sizeof(Mat3) == 48 && alignof(Mat3) == 16, "Mat3 must match Metal's float3x3");
+static_assert(sizeof(Mat4) == 64 && alignof(Mat4) == 16, "Mat4 must match Metal's float4x4");
+
+// Mat3
+
+constexpr Vec3 operator*(const Mat3& m, const Vec3& v)
+{
+    return m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z;
+}
+
+constexpr Mat3 operator*(const Mat3& a, const Mat3& b)
+{
+    return { a * b.columns[0], a * b.columns[1], a * b.columns[2] };
+}
+
+constexpr Mat3 Transpose(const Mat3& m)
+{
+    return { { m[0].x, m[1].x, m[2].x }, { m[0].y, m[1].y, m[2].y }, { m[0].z, m[1].z, m[2].z } };
+}
+
+constexpr float Determinant(const Mat3& m)
+{
+    return Dot(m[0], Cross(m[1], m[2]));
+}
+
+// Singular matrices come back as zero.
+constexpr Mat3 Inverse(const Mat3& m)
+{
+    float det = Determinant(m);
+    if (det == 0.0f) return Mat3();
+    
+    // Rows of the inverse are the cross products of the columns.
+    Mat3 rows = { Cross(m[1], m[2]), Cross(m[2], m[0]), Cross(m[0], m[1]) };
+    Mat3 inverse = Transpose(rows);
+    float invDet = 1.0f / det;
+    
+    for (Vec3& column : inverse.columns) column *= invDet;
+    return inverse;
+}
+
+// Mat4
+
+MATHS_INLINE constexpr Vec4 operator*(const Mat4& m, const Vec4& v)
+{
+    if (std::is_constant_evaluated())
+        return m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z + m.columns[3] * v.w;
+    
+    SIMDFloat4 r = m.columns[0].Load() * SIMDFloat4::Set(v.x);
+    r = SIMDFloat4::MulAdd(m.columns[1].Load(), SIMDFloat4::Set(v.y), r);
+    r = SIMDFloat4::MulAdd(m.columns[2].Load(), SIMDFloat4::Set(v.z), r);
+    r = SIMDFloat4::MulAdd(m.columns[3].Load(), SIMDFloat4::Set(v.w), r);
+    return Vec4::Store(r);
+}
+
+MATHS_INLINE constexpr Mat4 operator*(const Mat4& a, const Mat4& b)
+{
+    if (std::is_constant_evaluated())
+        return { a * b.columns[0], a * b.columns[1], a * b.columns[2], a * b.columns[3] };
+    
+    const SIMDFloat4 a0 = a.columns[0].Load();
+    const SIMDFloat4 a1 = a.columns[1].Load();
+    const SIMDFloat4 a2 = a.columns[2].Load();
+    const SIMDFloat4 a3 = a.columns[3].Load();
+    
+    Mat4 result;
+    
+    for (int i = 0; i < 4; i++)
+    {
+        const SIMDFloat4 bi = b.columns[i].Load();
+        
+        SIMDFloat4 r = a0 * bi.Splat<0>();
+        r = SIMDFloat4::MulAdd(a1, bi.Splat<1>(), r);
+        r = SIMDFloat4::MulAdd(a2, bi.Splat<2>(), r);
+        r = SIMDFloat4::MulAdd(a3, bi.Splat<3>(), r);
+        r.Store(&result.columns[i].x);
+    }
+    
+    return result;
+}
+
+constexpr Mat4 Transpose(const Mat4& m)
+{
+    return { { m[0].x, m[1].x, m[2].x, m[3].x }, { m[0].y, m[1].y, m[2].y, m[3].y },
+             { m[0].z, m[1].z, m[2].z, m[3].z }, { m[0].w, m[1].w, m[2].w, m[3].w } };
+}
+
+// General inverse by cofactors. Singular matrices come back as zero.
+constexpr Mat4 Inverse(const Mat4& m)
+{
+    const Vec4& a = m[0];
+    const Vec4& b = m[1];
+    const Vec4& c = m[2];
+    const Vec4& d = m[3];
+    
+    // 2x2 minors of the top two rows (s) and the bottom two (t).
+    float s0 = a.x * b.y - b.x * a.y;
+    float s1 = a.x * c.y - c.x * a.y;
+    float s2 = a.x * d.y - d.x * a.y;
+    float s3 = b.x * c.y - c.x * b.y;
+    float s4 = b.x * d.y - d.x * b.y;
+    float s5 = c.x * d.y - d.x * c.y;
+    
+    float t0 = a.z * b.w - b.z * a.w;
+    float t1 = a.z * c.w - c.z * a.w;
+    float t2 = a.z * d.w - d.z * a.w;
+    float t3 = b.z * c.w - c.z * b.w;
+    float t4 = b.z * d.w - d.z * b.w;
+    float t5 = c.z * d.w - d.z * c.w;
+    
+    float det = s0 * t5 - s1 * t4 + s2 * t3 + s3 * t2 - s4 * t1 + s5 * t0;
+    if (det == 0.0f) return Mat4();
+    
+    float inv = 1.0f / det;
+    
+    return {
+        { ( b.y * t5 - c.y * t4 + d.y * t3) * inv,
+          (-a.y * t5 + c.y * t2 - d.y * t1) * inv,
+          ( a.y * t4 - b.y * t2 + d.y * t0) * inv,
+          (-a.y * t3 + b.y * t1 - c.y * t0) * inv },
+        { (-b.x * t5 + c.x * t4 - d.x * t3) * inv,
+          ( a.x * t5 - c.x * t2 + d.x * t1) * inv,
+          (-a.x * t4 + b.x * t2 - d.x * t0) * inv,
+          ( a.x * t3 - b.x * t1 + c.x * t0) * inv },
+        { ( b.w * s5 - c.w * s4 + d.w * s3) * inv,
+          (-a.w * s5 + c.w * s2 - d.w * s1) * inv,
+          ( a.w * s4 - b.w * s2 + d.w * s0) * inv,
+          (-a.w * s3 + b.w * s1 - c.w * s0) * inv },
+        { (-b.z * s5 + c.z * s4 - d.z * s3) * inv,
+          ( a.z * s5 - c.z * s2 + d.z * s1) * inv,
+          (-a.z * s4 + b.z * s2 - d.z * s0) * inv,
+          ( a.z * s3 - b.z * s1 + c.z * s0) * inv },
+    };
+}
+
+// Orthographic projection onto Metal's clip space (z in [0, 1] passes through).
+constexpr Mat4 Ortho(float left, float right, float bottom, float top)
+{
+    float rl = right - left;
+    float tb = top - bottom;
+    float tx = -(right + left) / rl;
+    float ty = -(top + bottom) / tb;
+    
+    return {
+        { 2.0f / rl, 0.0f,      0.0f, 0.0f }, // Column 0
+        { 0.0f,      2.0f / tb, 0.0f, 0.0f }, // Column 1
+        { 0.0f,      0.0f,      1.0f, 0.0f }, // Column 2
+        { tx,        ty,        0.0f, 1.0f }  // Column 3
+    };
+}
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Unit quaternion for 3D rotations, (x, y, z) the vector part and w the
+// scalar. Laid out like a Vec4 so it can go straight into a GPU buffer.
+
+#pragma once
+
+#include <cmath>
+
+#include "matrix.h"
+
+struct alignas(16) Quat
+{
+    float x, y, z, w;
+    
+    constexpr Quat() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+    constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    
+    static constexpr Quat Identity() { return {}; }
+    
+    // axis must be normalized.
+    static inline Quat FromAxisAngle(const Vec3& axis, float angle)
+    {
+        float s = std::sin(angle * 0.5f);
+        return { axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f) };
+    }
+    
+    constexpr Vec4 AsVec4() const { return { x, y, z, w }; }
+};
+
+static_assert(sizeof(Quat) == 16 && alignof(Quat) == 16, "Quat must match Metal's float4");
+
+// Applies b first, then a.
+constexpr Quat operator*(const Quat& a, const Quat& b)
+{
+    return {
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+    };
+}
+
+constexpr bool operator==(const Quat& a, const Quat& b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+constexpr bool operator!=(const Quat& a, const Quat& b) { return !(a == b); }
+
+constexpr float Dot(const Quat& a, const Quat& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+// The inverse, for unit quaternions.
+constexpr Quat Conjugate(const Quat& q) { return { -q.x, -q.y, -q.z, q.w }; }
+
+inline Quat Normalize(const Quat& q)
+{
+    float length = std::sqrt(Dot(q, q));
+    if (length <= 0.0f) return Quat();
+    
+    float inv = 1.0f / length;
+    return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+}
+
+// v + 2w(u x v) + 2u x (u x v), cheaper than q * v * q^-1.
+constexpr Vec3 Rotate(const Quat& q, const Vec3& v)
+{
+    Vec3 u = { q.x, q.y, q.z };
+    Vec3 t = Cross(u, v) * 2.0f;
+    return v + t * q.w + Cross(u, t);
+}
+
+// Normalized linear interpolation along the shorter arc. Not constant speed,
+// but close enough for small steps and much cheaper than Slerp.
+inline Quat Nlerp(const Quat& a, const Quat& b, float t)
+{
+    float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+    float s = 1.0f - t;
+    
+    return Normalize(Quat{ a.x * s + b.x * t * sign, a.y * s + b.y * t * sign, a.z * s + b.z * t * sign, a.w * s + b.w * t * sign });
+}
+
+inline Quat Slerp(const Quat& a, const Quat& b, float t)
+{
+    float cosTheta = Dot(a, b);
+    float sign = 1.0f;
+    
+    if (cosTheta < 0.0f)
+    {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+    
+    // Nearly parallel: sin(theta) underflows, and the arc is straight anyway.
+    if (cosTheta > 0.9995f) return Nlerp(a, b, t);
+    
+    float theta = std::acos(cosTheta);
+    float invSin = 1.0f / std::sin(theta);
+    float wa = std::sin((1.0f - t) * theta) * invSin;
+    float wb = std::sin(t * theta) * invSin * sign;
+    
+    return { a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb };
+}
+
+constexpr Mat3 ToMat3(const Quat& q)
+{
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    
+    return {
+        { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),        2.0f * (xz - wy) },
+        { 2.0f * (xy - wz),        1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) },
+        { 2.0f * (xz + wy),        2.0f * (yz - wx),        1.0f - 2.0f * (xx + yy) },
+    };
+}
+
+constexpr Mat4 ToMat4(const Quat& q)
+{
+    Mat3 r = ToMat3(q);
+    return { { r[0], 0.0f }, { r[1], 0.0f }, { r[2], 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+}
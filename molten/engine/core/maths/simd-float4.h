@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Four-lane float register the maths types use for their vector paths: SSE2
+// on x86, NEON on ARM, plain arrays elsewhere. Same shape as the quad
+// kernel's lane types.
+//
+// Everything here and in the types built on it is forced inline. Headers in
+// this folder are included from translation units compiled for AVX2, and an
+// out-of-line copy emitted there could be the one the linker keeps for
+// every caller.
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define MOLTEN_MATHS_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MOLTEN_MATHS_NEON 1
+#endif
+
+#define MATHS_INLINE inline __attribute__((always_inline))
+
+struct SIMDFloat4
+{
+#if MOLTEN_MATHS_SSE
+    __m128 v;
+    
+    // p must be 16-byte aligned.
+    static MATHS_INLINE SIMDFloat4 Load(const float* p) { return { _mm_load_ps(p) }; }
+    static MATHS_INLINE SIMDFloat4 LoadUnaligned(const float* p) { return { _mm_loadu_ps(p) }; }
+    static MATHS_INLINE SIMDFloat4 Set(float x) { return { _mm_set1_ps(x) }; }
+    static MATHS_INLINE SIMDFloat4 Set(float x, float y, float z, float w) { return { _mm_setr_ps(x, y, z, w) }; }
+    
+    MATHS_INLINE void Store(float* p) const { _mm_store_ps(p, v); }
+    MATHS_INLINE void StoreUnaligned(float* p) const { _mm_storeu_ps(p, v); }
+    
+    MATHS_INLINE SIMDFloat4 operator+(SIMDFloat4 o) const { return { _mm_add_ps(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator-(SIMDFloat4 o) const { return { _mm_sub_ps(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator*(SIMDFloat4 o) const { return { _mm_mul_ps(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator/(SIMDFloat4 o) const { return { _mm_div_ps(v, o.v) }; }
+    
+    static MATHS_INLINE SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b) { return { _mm_min_ps(a.v, b.v) }; }
+    static MATHS_INLINE SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b) { return { _mm_max_ps(a.v, b.v) }; }
+    
+    template <int Lane>
+    MATHS_INLINE SIMDFloat4 Splat() const { return { _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)) }; }
+    
+    // (x0, y0, x1, y1) -> (x0, x0, x1, x1) and (y0, y0, y1, y1): two packed
+    // Vec2s split into their components.
+    MATHS_INLINE SIMDFloat4 DuplicateEven() const { return { _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0)) }; }
+    MATHS_INLINE SIMDFloat4 DuplicateOdd() const { return { _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1)) }; }
+    
+    // (x, y, z, w) -> (x, y, x, y) and (z, w, z, w).
+    MATHS_INLINE SIMDFloat4 DuplicateLow() const { return { _mm_movelh_ps(v, v) }; }
+    MATHS_INLINE SIMDFloat4 DuplicateHigh() const { return { _mm_movehl_ps(v, v) }; }
+#elif MOLTEN_MATHS_NEON
+    float32x4_t v;
+    
+    static MATHS_INLINE SIMDFloat4 Load(const float* p) { return { vld1q_f32(p) }; }
+    static MATHS_INLINE SIMDFloat4 LoadUnaligned(const float* p) { return { vld1q_f32(p) }; }
+    static MATHS_INLINE SIMDFloat4 Set(float x) { return { vdupq_n_f32(x) }; }
+    static MATHS_INLINE SIMDFloat4 Set(float x, float y, float z, float w)
+    {
+        const float lanes[4] = { x, y, z, w };
+        return { vld1q_f32(lanes) };
+    }
+    
+    MATHS_INLINE void Store(float* p) const { vst1q_f32(p, v); }
+    MATHS_INLINE void StoreUnaligned(float* p) const { vst1q_f32(p, v); }
+    
+    MATHS_INLINE SIMDFloat4 operator+(SIMDFloat4 o) const { return { vaddq_f32(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator-(SIMDFloat4 o) const { return { vsubq_f32(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator*(SIMDFloat4 o) const { return { vmulq_f32(v, o.v) }; }
+    MATHS_INLINE SIMDFloat4 operator/(SIMDFloat4 o) const { return { vdivq_f32(v, o.v) }; }
+    
+    static MATHS_INLINE SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b) { return { vminq_f32(a.v, b.v) }; }
+    static MATHS_INLINE SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b) { return { vmaxq_f32(a.v, b.v) }; }
+    
+    template <int Lane>
+    MATHS_INLINE SIMDFloat4 Splat() const { return { vdupq_laneq_f32(v, Lane) }; }
+    
+    MATHS_INLINE SIMDFloat4 DuplicateEven() const { return { vtrn1q_f32(v, v) }; }
+    MATHS_INLINE SIMDFloat4 DuplicateOdd() const { return { vtrn2q_f32(v, v) }; }
+    
+    MATHS_INLINE SIMDFloat4 DuplicateLow() const { return { vcombine_f32(vget_low_f32(v), vget_low_f32(v)) }; }
+    MATHS_INLINE SIMDFloat4 DuplicateHigh() const { return { vcombine_f32(vget_high_f32(v), vget_high_f32(v)) }; }
+#else
+    float v[4];
+    
+    static MATHS_INLINE SIMDFloat4 Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    static MATHS_INLINE SIMDFloat4 LoadUnaligned(const float* p) { return Load(p); }
+    static MATHS_INLINE SIMDFloat4 Set(float x) { return { { x, x, x, x } }; }
+    static MATHS_INLINE SIMDFloat4 Set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+    
+    MATHS_INLINE void Store(float* p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+    MATHS_INLINE void StoreUnaligned(float* p) const { Store(p); }
+    
+    MATHS_INLINE SIMDFloat4 operator+(SIMDFloat4 o) const { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+    MATHS_INLINE SIMDFloat4 operator-(SIMDFloat4 o) const { return { { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] } }; }
+    MATHS_INLINE SIMDFloat4 operator*(SIMDFloat4 o) const { return { { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] } }; }
+    MATHS_INLINE SIMDFloat4 operator/(SIMDFloat4 o) const { return { { v[0] / o.v[0], v[1] / o.v[1], v[2] / o.v[2], v[3] / o.v[3] } }; }
+    
+    static MATHS_INLINE SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b)
+    {
+        SIMDFloat4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i];
+        return r;
+    }
+    
+    static MATHS_INLINE SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b)
+    {
+        SIMDFloat4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = a.v[i] < b.v[i] ? b.v[i] : a.v[i];
+        return r;
+    }
+    
+    template <int Lane>
+    MATHS_INLINE SIMDFloat4 Splat() const { return Set(v[Lane]); }
+    
+    MATHS_INLINE SIMDFloat4 DuplicateEven() const { return { { v[0], v[0], v[2], v[2] } }; }
+    MATHS_INLINE SIMDFloat4 DuplicateOdd() const { return { { v[1], v[1], v[3], v[3] } }; }
+    
+    MATHS_INLINE SIMDFloat4 DuplicateLow() const { return { { v[0], v[1], v[0], v[1] } }; }
+    MATHS_INLINE SIMDFloat4 DuplicateHigh() const { return { { v[2], v[3], v[2], v[3] } }; }
+#endif
+    
+    // a * b + c.
+    static MATHS_INLINE SIMDFloat4 MulAdd(SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 c) { return a * b + c; }
+};
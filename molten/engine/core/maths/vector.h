@@ -0,0 +1,251 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Vector types laid out like Metal's float2, float3 and float4 (and the Apple
+// simd types they replaced): 8, 16 and 16 bytes, Vec3 padded to 16. Structs
+// made of them can be copied straight into GPU buffers.
+//
+// Everything is constexpr. Vec4 runs on SIMDFloat4 outside constant
+// evaluation; Vec2 and Vec3 are too narrow for that to pay off.
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "simd-float4.h"
+
+struct alignas(8) Vec2
+{
+    float x, y;
+    
+    constexpr Vec2() : x(0.0f), y(0.0f) {}
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+    constexpr explicit Vec2(float s) : x(s), y(s) {}
+    
+    constexpr float& operator[](int i) { return i == 0 ? x : y; }
+    constexpr float operator[](int i) const { return i == 0 ? x : y; }
+    
+    constexpr Vec2& operator+=(const Vec2& o) { x += o.x; y += o.y; return *this; }
+    constexpr Vec2& operator-=(const Vec2& o) { x -= o.x; y -= o.y; return *this; }
+    constexpr Vec2& operator*=(const Vec2& o) { x *= o.x; y *= o.y; return *this; }
+    constexpr Vec2& operator/=(const Vec2& o) { x /= o.x; y /= o.y; return *this; }
+    constexpr Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+    constexpr Vec2& operator/=(float s) { x /= s; y /= s; return *this; }
+};
+
+struct alignas(16) Vec3
+{
+    float x, y, z;
+    
+    constexpr Vec3() : x(0.0f), y(0.0f), z(0.0f) {}
+    constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vec3(const Vec2& xy, float z) : x(xy.x), y(xy.y), z(z) {}
+    constexpr explicit Vec3(float s) : x(s), y(s), z(s) {}
+    
+    constexpr float& operator[](int i) { return i == 0 ? x : (i == 1 ? y : z); }
+    constexpr float operator[](int i) const { return i == 0 ? x : (i == 1 ? y : z); }
+    
+    constexpr Vec2 XY() const { return { x, y }; }
+    
+    constexpr Vec3& operator+=(const Vec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+    constexpr Vec3& operator-=(const Vec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+    constexpr Vec3& operator*=(const Vec3& o) { x *= o.x; y *= o.y; z *= o.z; return *this; }
+    constexpr Vec3& operator/=(const Vec3& o) { x /= o.x; y /= o.y; z /= o.z; return *this; }
+    constexpr Vec3& operator*=(float s) { x *= s; y *= s; z *= s; return *this; }
+    constexpr Vec3& operator/=(float s) { x /= s; y /= s; z /= s; return *this; }
+};
+
+struct alignas(16) Vec4
+{
+    float x, y, z, w;
+    
+    constexpr Vec4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+    constexpr Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vec4(const Vec3& xyz, float w) : x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
+    constexpr Vec4(const Vec2& xy, const Vec2& zw) : x(xy.x), y(xy.y), z(zw.x), w(zw.y) {}
+    constexpr explicit Vec4(float s) : x(s), y(s), z(s), w(s) {}
+    
+    MATHS_INLINE SIMDFloat4 Load() const { return SIMDFloat4::Load(&x); }
+    
+    static MATHS_INLINE Vec4 Store(SIMDFloat4 r)
+    {
+        Vec4 v;
+        r.Store(&v.x);
+        return v;
+    }
+    
+    constexpr float& operator[](int i) { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+    constexpr float operator[](int i) const { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+    
+    constexpr Vec2 XY() const { return { x, y }; }
+    constexpr Vec2 ZW() const { return { z, w }; }
+    constexpr Vec3 XYZ() const { return { x, y, z }; }
+    
+    constexpr Vec4& operator+=(const Vec4& o);
+    constexpr Vec4& operator-=(const Vec4& o);
+    constexpr Vec4& operator*=(const Vec4& o);
+    constexpr Vec4& operator*=(float s);
+};
+
+static_assert(sizeof(Vec2) == 8 && alignof(Vec2) == 8, "Vec2 must match Metal's float2");
+static_assert(sizeof(Vec3) == 16 && alignof(Vec3) == 16, "Vec3 must match Metal's float3");
+static_assert(sizeof(Vec4) == 16 && alignof(Vec4) == 16, "Vec4 must match Metal's float4");
+static_assert(std::is_trivially_copyable_v<Vec2> && std::is_trivially_copyable_v<Vec3> && std::is_trivially_copyable_v<Vec4>,
+              "Vectors are copied into GPU buffers with memcpy");
+
+// Vec2
+
+constexpr Vec2 operator-(const Vec2& a) { return { -a.x, -a.y }; }
+constexpr Vec2 operator+(const Vec2& a, const Vec2& b) { return { a.x + b.x, a.y + b.y }; }
+constexpr Vec2 operator-(const Vec2& a, const Vec2& b) { return { a.x - b.x, a.y - b.y }; }
+constexpr Vec2 operator*(const Vec2& a, const Vec2& b) { return { a.x * b.x, a.y * b.y }; }
+constexpr Vec2 operator/(const Vec2& a, const Vec2& b) { return { a.x / b.x, a.y / b.y }; }
+constexpr Vec2 operator*(const Vec2& a, float s) { return { a.x * s, a.y * s }; }
+constexpr Vec2 operator*(float s, const Vec2& a) { return { a.x * s, a.y * s }; }
+constexpr Vec2 operator/(const Vec2& a, float s) { return { a.x / s, a.y / s }; }
+constexpr bool operator==(const Vec2& a, const Vec2& b) { return a.x == b.x && a.y == b.y; }
+constexpr bool operator!=(const Vec2& a, const Vec2& b) { return !(a == b); }
+
+constexpr float Dot(const Vec2& a, const Vec2& b) { return a.x * b.x + a.y * b.y; }
+
+// z of the 3D cross product: positive when b is counter-clockwise from a.
+constexpr float Cross(const Vec2& a, const Vec2& b) { return a.x * b.y - a.y * b.x; }
+
+// a rotated 90 degrees counter-clockwise.
+constexpr Vec2 Perpendicular(const Vec2& a) { return { -a.y, a.x }; }
+
+constexpr float LengthSquared(const Vec2& a) { return Dot(a, a); }
+inline float Length(const Vec2& a) { return std::sqrt(Dot(a, a)); }
+constexpr Vec2 Min(const Vec2& a, const Vec2& b) { return { b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y }; }
+constexpr Vec2 Max(const Vec2& a, const Vec2& b) { return { a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y }; }
+constexpr Vec2 Lerp(const Vec2& a, const Vec2& b, float t) { return a + (b - a) * t; }
+
+// Zero stays zero instead of turning into NaNs.
+inline Vec2 Normalize(const Vec2& a)
+{
+    float length = Length(a);
+    return length > 0.0f ? a / length : Vec2();
+}
+
+// Vec3
+
+constexpr Vec3 operator-(const Vec3& a) { return { -a.x, -a.y, -a.z }; }
+constexpr Vec3 operator+(const Vec3& a, const Vec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+constexpr Vec3 operator-(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+constexpr Vec3 operator*(const Vec3& a, const Vec3& b) { return { a.x * b.x, a.y * b.y, a.z * b.z }; }
+constexpr Vec3 operator/(const Vec3& a, const Vec3& b) { return { a.x / b.x, a.y / b.y, a.z / b.z }; }
+constexpr Vec3 operator*(const Vec3& a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+constexpr Vec3 operator*(float s, const Vec3& a) { return { a.x * s, a.y * s, a.z * s }; }
+constexpr Vec3 operator/(const Vec3& a, float s) { return { a.x / s, a.y / s, a.z / s }; }
+constexpr bool operator==(const Vec3& a, const Vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+constexpr bool operator!=(const Vec3& a, const Vec3& b) { return !(a == b); }
+
+constexpr float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+constexpr Vec3 Cross(const Vec3& a, const Vec3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+constexpr float LengthSquared(const Vec3& a) { return Dot(a, a); }
+inline float Length(const Vec3& a) { return std::sqrt(Dot(a, a)); }
+constexpr Vec3 Min(const Vec3& a, const Vec3& b) { return { b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y, b.z < a.z ? b.z : a.z }; }
+constexpr Vec3 Max(const Vec3& a, const Vec3& b) { return { a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y, a.z < b.z ? b.z : a.z }; }
+constexpr Vec3 Lerp(const Vec3& a, const Vec3& b, float t) { return a + (b - a) * t; }
+
+inline Vec3 Normalize(const Vec3& a)
+{
+    float length = Length(a);
+    return length > 0.0f ? a / length : Vec3();
+}
+
+// Vec4
+
+constexpr Vec4 operator-(const Vec4& a) { return { -a.x, -a.y, -a.z, -a.w }; }
+
+MATHS_INLINE constexpr Vec4 operator+(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated()) return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+    return Vec4::Store(a.Load() + b.Load());
+}
+
+MATHS_INLINE constexpr Vec4 operator-(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated()) return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+    return Vec4::Store(a.Load() - b.Load());
+}
+
+MATHS_INLINE constexpr Vec4 operator*(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated()) return { a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w };
+    return Vec4::Store(a.Load() * b.Load());
+}
+
+MATHS_INLINE constexpr Vec4 operator/(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated()) return { a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w };
+    return Vec4::Store(a.Load() / b.Load());
+}
+
+MATHS_INLINE constexpr Vec4 operator*(const Vec4& a, float s)
+{
+    if (std::is_constant_evaluated()) return { a.x * s, a.y * s, a.z * s, a.w * s };
+    return Vec4::Store(a.Load() * SIMDFloat4::Set(s));
+}
+
+MATHS_INLINE constexpr Vec4 operator*(float s, const Vec4& a) { return a * s; }
+MATHS_INLINE constexpr Vec4 operator/(const Vec4& a, float s) { return a * (1.0f / s); }
+
+constexpr Vec4& Vec4::operator+=(const Vec4& o) { return *this = *this + o; }
+constexpr Vec4& Vec4::operator-=(const Vec4& o) { return *this = *this - o; }
+constexpr Vec4& Vec4::operator*=(const Vec4& o) { return *this = *this * o; }
+constexpr Vec4& Vec4::operator*=(float s) { return *this = *this * s; }
+
+constexpr bool operator==(const Vec4& a, const Vec4& b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+constexpr bool operator!=(const Vec4& a, const Vec4& b) { return !(a == b); }
+
+constexpr float Dot(const Vec4& a, const Vec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+constexpr float LengthSquared(const Vec4& a) { return Dot(a, a); }
+inline float Length(const Vec4& a) { return std::sqrt(Dot(a, a)); }
+
+MATHS_INLINE constexpr Vec4 Min(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated())
+        return { b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y, b.z < a.z ? b.z : a.z, b.w < a.w ? b.w : a.w };
+    return Vec4::Store(SIMDFloat4::Min(a.Load(), b.Load()));
+}
+
+MATHS_INLINE constexpr Vec4 Max(const Vec4& a, const Vec4& b)
+{
+    if (std::is_constant_evaluated())
+        return { a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y, a.z < b.z ? b.z : a.z, a.w < b.w ? b.w : a.w };
+    return Vec4::Store(SIMDFloat4::Max(a.Load(), b.Load()));
+}
+
+MATHS_INLINE constexpr Vec4 Lerp(const Vec4& a, const Vec4& b, float t) { return a + (b - a) * t; }
+
+inline Vec4 Normalize(const Vec4& a)
+{
+    float length = Length(a);
+    return length > 0.0f ? a / length : Vec4();
+}
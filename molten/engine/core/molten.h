@@ -25,20 +25,22 @@
 #include "renderer/sprite-2D.h"
 #include "application/game.h"
 #include "application/input.h"
+#include "jobs/job-system.h"
+#include "ecs/world.h"
+#include "ecs/query.h"
+#include "ecs/command-buffer.h"
+#include "ecs/sprite-components.h"
+#include "physics/physics-world-2D.h"
+#include "assets/asset-loader.h"
+#include "utils/profiler.h"
 
 #define LOG_CLIENT
 #include "utils/log-macros.h"
 
-//TODO: batch 2d sprites - make a decent 2d renderer - right now it's the most inefficent thing ever, reconstructing vertex data every frame; Ideally it would take all sprites in at once, create a spritesheet with all the images, gather all the data, make a huge buffer, send it to the gpu for drawing and only update this buffer when we want to change the positions of the sprites in the game - this keeps everything on the screen with only a single draw call, with minimal overhead.
-
 //TODO: cleanup the code and comment on how it works - it's a mess rn.
 //TODO: turn radians to degrees - much more understandable
 //TODO: be able to use 2D spritesheets, specify index and get the appropriate texture.
-//TODO: 2D blending (alpha blending)
-//TODO: 2D depth sorting
 //TODO: 2D animations
-//TODO: 2D phisics
-//TODO: entity component system
 //TODO: audio
 //TODO: make simple 2d game
 //TODO: 3D model reading and importing
@@ -48,7 +50,5 @@
 //TODO: simple fx (gaussian blur, hdr, bloom, ssao, antialiasing)
 //TODO: 3D phisics
 //TODO: custom editor
-//TODO: properly exporting and packaging
 //TODO: raytracing/pathtracing
 //TODO: custom ui
-//TODO: custom maths lib
@@ -0,0 +1,382 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "collision-2D.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define MOLTEN_COLLISION_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MOLTEN_COLLISION_NEON 1
+#endif
+
+// Contacts this far apart are still reported, so resting bodies keep a
+// stable manifold instead of flickering in and out of contact.
+static constexpr float SpeculativeDistance = 1.0f;
+
+void CollideCircles(const Pose2D& poseA, float radiusA, const Pose2D& poseB, float radiusB, Manifold2D& manifold)
+{
+    manifold.count = 0;
+    
+    Vec2 d = poseB.position - poseA.position;
+    float distanceSquared = Dot(d, d);
+    float reach = radiusA + radiusB + SpeculativeDistance;
+    
+    if (distanceSquared > reach * reach) return;
+    
+    float distance = std::sqrt(distanceSquared);
+    Vec2 normal = distance > FLT_EPSILON ? d * (1.0f / distance) : Vec2{0.0f, 1.0f};
+    
+    float separation = distance - radiusA - radiusB;
+    
+    manifold.normal = normal;
+    manifold.points[0].point = poseA.position + normal * (radiusA + 0.5f * separation);
+    manifold.points[0].separation = separation;
+    manifold.points[0].id = 0;
+    manifold.count = 1;
+}
+
+void CollidePolygonCircle(const PolygonShape& polygonA, const Pose2D& poseA, float radiusB, const Pose2D& poseB, Manifold2D& manifold)
+{
+    manifold.count = 0;
+    
+    // Circle center in the polygon's frame.
+    Vec2 d = poseB.position - poseA.position;
+    Vec2 center = {poseA.c * d.x + poseA.s * d.y, -poseA.s * d.x + poseA.c * d.y};
+    
+    float reach = radiusB + SpeculativeDistance;
+    
+    uint32_t face = 0;
+    float maxSeparation = -FLT_MAX;
+    
+    for (uint32_t i = 0; i < polygonA.count; i++)
+    {
+        float s = Dot(polygonA.normals[i], center - polygonA.vertices[i]);
+        
+        if (s > reach) return;
+        if (s > maxSeparation) { maxSeparation = s; face = i; }
+    }
+    
+    const Vec2& v1 = polygonA.vertices[face];
+    const Vec2& v2 = polygonA.vertices[(face + 1) % polygonA.count];
+    
+    Vec2 localNormal = polygonA.normals[face];
+    Vec2 surface;
+    uint32_t id = face;
+    
+    // Past either end of the face, the nearest feature is that corner.
+    float u1 = Dot(center - v1, v2 - v1);
+    float u2 = Dot(center - v2, v1 - v2);
+    
+    if (maxSeparation > 0.0f && (u1 <= 0.0f || u2 <= 0.0f))
+    {
+        const Vec2& corner = u1 <= 0.0f ? v1 : v2;
+        
+        Vec2 offset = center - corner;
+        float distance = std::sqrt(Dot(offset, offset));
+        
+        if (distance > reach) return;
+        
+        localNormal = distance > FLT_EPSILON ? offset * (1.0f / distance) : localNormal;
+        surface = corner;
+        maxSeparation = distance;
+        id = (u1 <= 0.0f ? face : (face + 1) % polygonA.count) | 0x100u;
+    }
+    else
+    {
+        surface = center - localNormal * maxSeparation;
+    }
+    
+    float separation = maxSeparation - radiusB;
+    
+    manifold.normal = poseA.Rotate(localNormal);
+    
+    Vec2 surfaceA = poseA.Apply(surface);
+    
+    manifold.points[0].point = surfaceA + manifold.normal * (0.5f * separation);
+    manifold.points[0].separation = separation;
+    manifold.points[0].id = id;
+    manifold.count = 1;
+}
+
+struct WorldPolygon
+{
+    Vec2 vertices[MaxPolygonVertices];
+    Vec2 normals[MaxPolygonVertices];
+    uint32_t count;
+};
+
+static void ToWorld(const PolygonShape& polygon, const Pose2D& pose, WorldPolygon& out)
+{
+    out.count = polygon.count;
+    
+    for (uint32_t i = 0; i < polygon.count; i++)
+    {
+        out.vertices[i] = pose.Apply(polygon.vertices[i]);
+        out.normals[i] = pose.Rotate(polygon.normals[i]);
+    }
+}
+
+// Largest separation along one of a's face normals, i.e. how far b is
+// outside a's best separating face.
+static float FindMaxSeparation(const WorldPolygon& a, const WorldPolygon& b, uint32_t& bestFace)
+{
+    float best = -FLT_MAX;
+    bestFace = 0;
+    
+    for (uint32_t i = 0; i < a.count; i++)
+    {
+        float deepest = FLT_MAX;
+        
+        for (uint32_t j = 0; j < b.count; j++)
+            deepest = std::min(deepest, Dot(a.normals[i], b.vertices[j] - a.vertices[i]));
+        
+        if (deepest > best) { best = deepest; bestFace = i; }
+    }
+    
+    return best;
+}
+
+void CollidePolygons(const PolygonShape& polygonA, const Pose2D& poseA, const PolygonShape& polygonB, const Pose2D& poseB, Manifold2D& manifold)
+{
+    manifold.count = 0;
+    
+    WorldPolygon a, b;
+    ToWorld(polygonA, poseA, a);
+    ToWorld(polygonB, poseB, b);
+    
+    uint32_t faceA, faceB;
+    
+    float separationA = FindMaxSeparation(a, b, faceA);
+    if (separationA > SpeculativeDistance) return;
+    
+    float separationB = FindMaxSeparation(b, a, faceB);
+    if (separationB > SpeculativeDistance) return;
+    
+    // Prefer A's face unless B's is clearly better, so the reference face
+    // doesn't flip back and forth between nearly equal candidates.
+    const WorldPolygon* reference = &a;
+    const WorldPolygon* incident = &b;
+    uint32_t referenceFace = faceA;
+    bool flip = false;
+    
+    if (separationB > separationA + 0.1f * SpeculativeDistance)
+    {
+        reference = &b;
+        incident = &a;
+        referenceFace = faceB;
+        flip = true;
+    }
+    
+    Vec2 normal = reference->normals[referenceFace];
+    
+    // The incident face is the one most anti-parallel to the normal.
+    uint32_t incidentFace = 0;
+    float minDot = FLT_MAX;
+    
+    for (uint32_t i = 0; i < incident->count; i++)
+    {
+        float d = Dot(normal, incident->normals[i]);
+        if (d < minDot) { minDot = d; incidentFace = i; }
+    }
+    
+    Vec2 clip[2] = { incident->vertices[incidentFace], incident->vertices[(incidentFace + 1) % incident->count] };
+    
+    Vec2 v1 = reference->vertices[referenceFace];
+    Vec2 v2 = reference->vertices[(referenceFace + 1) % reference->count];
+    
+    Vec2 tangent = v2 - v1;
+    tangent = tangent * (1.0f / std::sqrt(Dot(tangent, tangent)));
+    
+    // Clip the incident edge to the reference face's side planes.
+    float lower = Dot(tangent, v1);
+    float upper = Dot(tangent, v2);
+    
+    for (int side = 0; side < 2; side++)
+    {
+        float sign = side == 0 ? -1.0f : 1.0f;
+        float offset = side == 0 ? -lower : upper;
+        
+        float d0 = sign * Dot(tangent, clip[0]) - offset;
+        float d1 = sign * Dot(tangent, clip[1]) - offset;
+        
+        if (d0 > 0.0f && d1 > 0.0f) return;
+        
+        if (d0 > 0.0f || d1 > 0.0f)
+        {
+            int outside = d0 > 0.0f ? 0 : 1;
+            float t = d0 / (d0 - d1);
+            
+            clip[outside] = clip[0] + (clip[1] - clip[0]) * t;
+        }
+    }
+    
+    float faceOffset = Dot(normal, v1);
+    
+    manifold.normal = flip ? Vec2{-normal.x, -normal.y} : normal;
+    
+    for (int i = 0; i < 2; i++)
+    {
+        float separation = Dot(normal, clip[i]) - faceOffset;
+        if (separation > SpeculativeDistance) continue;
+        
+        ContactPoint2D& point = manifold.points[manifold.count++];
+        
+        // Halfway between the incident corner and the reference face.
+        point.point = clip[i] - normal * (0.5f * separation);
+        point.separation = separation;
+        // Named after the features, not whether the point got clipped, so
+        // it keeps its warm start while the shapes slide along each other.
+        point.id = (referenceFace << 16) | (incidentFace << 8) | (i << 1) | (flip ? 1u : 0u);
+    }
+}
+
+namespace
+{
+#if MOLTEN_COLLISION_SSE
+    struct CircleLanes
+    {
+        __m128 v;
+        
+        static CircleLanes Load(const float* p) { return { _mm_loadu_ps(p) }; }
+        static CircleLanes Set(float x) { return { _mm_set1_ps(x) }; }
+        
+        void Store(float* p) const { _mm_storeu_ps(p, v); }
+        
+        CircleLanes operator+(CircleLanes o) const { return { _mm_add_ps(v, o.v) }; }
+        CircleLanes operator-(CircleLanes o) const { return { _mm_sub_ps(v, o.v) }; }
+        CircleLanes operator*(CircleLanes o) const { return { _mm_mul_ps(v, o.v) }; }
+        CircleLanes operator/(CircleLanes o) const { return { _mm_div_ps(v, o.v) }; }
+        
+        static CircleLanes Sqrt(CircleLanes x) { return { _mm_sqrt_ps(x.v) }; }
+        static CircleLanes Max(CircleLanes a, CircleLanes b) { return { _mm_max_ps(a.v, b.v) }; }
+        
+        // Bit i set where a <= b.
+        static int LessEqualMask(CircleLanes a, CircleLanes b) { return _mm_movemask_ps(_mm_cmple_ps(a.v, b.v)); }
+    };
+#elif MOLTEN_COLLISION_NEON
+    struct CircleLanes
+    {
+        float32x4_t v;
+        
+        static CircleLanes Load(const float* p) { return { vld1q_f32(p) }; }
+        static CircleLanes Set(float x) { return { vdupq_n_f32(x) }; }
+        
+        void Store(float* p) const { vst1q_f32(p, v); }
+        
+        CircleLanes operator+(CircleLanes o) const { return { vaddq_f32(v, o.v) }; }
+        CircleLanes operator-(CircleLanes o) const { return { vsubq_f32(v, o.v) }; }
+        CircleLanes operator*(CircleLanes o) const { return { vmulq_f32(v, o.v) }; }
+        CircleLanes operator/(CircleLanes o) const { return { vdivq_f32(v, o.v) }; }
+        
+        static CircleLanes Sqrt(CircleLanes x) { return { vsqrtq_f32(x.v) }; }
+        static CircleLanes Max(CircleLanes a, CircleLanes b) { return { vmaxq_f32(a.v, b.v) }; }
+        
+        static int LessEqualMask(CircleLanes a, CircleLanes b)
+        {
+            static const uint32_t bits[4] = { 1, 2, 4, 8 };
+            return static_cast<int>(vaddvq_u32(vandq_u32(vcleq_f32(a.v, b.v), vld1q_u32(bits))));
+        }
+    };
+#endif
+}
+
+void CollideCircleBatch(const CircleBatch& circles, size_t count, Manifold2D* const* manifolds)
+{
+    size_t i = 0;
+    
+#if MOLTEN_COLLISION_SSE || MOLTEN_COLLISION_NEON
+    const CircleLanes speculative = CircleLanes::Set(SpeculativeDistance);
+    const CircleLanes epsilon = CircleLanes::Set(FLT_EPSILON);
+    const CircleLanes half = CircleLanes::Set(0.5f);
+    
+    for (; i + 4 <= count; i += 4)
+    {
+        CircleLanes ax = CircleLanes::Load(circles.positionAX + i);
+        CircleLanes ay = CircleLanes::Load(circles.positionAY + i);
+        CircleLanes ra = CircleLanes::Load(circles.radiusA + i);
+        CircleLanes bx = CircleLanes::Load(circles.positionBX + i);
+        CircleLanes by = CircleLanes::Load(circles.positionBY + i);
+        CircleLanes rb = CircleLanes::Load(circles.radiusB + i);
+        
+        CircleLanes dx = bx - ax;
+        CircleLanes dy = by - ay;
+        CircleLanes distanceSquared = dx * dx + dy * dy;
+        CircleLanes reach = ra + rb + speculative;
+        
+        int touching = CircleLanes::LessEqualMask(distanceSquared, reach * reach);
+        
+        for (int lane = 0; lane < 4; lane++)
+            manifolds[i + lane]->count = 0;
+        
+        if (!touching) continue;
+        
+        CircleLanes distance = CircleLanes::Sqrt(distanceSquared);
+        CircleLanes inverse = CircleLanes::Set(1.0f) / CircleLanes::Max(distance, epsilon);
+        CircleLanes nx = dx * inverse;
+        CircleLanes ny = dy * inverse;
+        CircleLanes separation = distance - ra - rb;
+        CircleLanes offset = ra + half * separation;
+        CircleLanes px = ax + nx * offset;
+        CircleLanes py = ay + ny * offset;
+        
+        alignas(16) float out[6][4];
+        nx.Store(out[0]);
+        ny.Store(out[1]);
+        separation.Store(out[2]);
+        px.Store(out[3]);
+        py.Store(out[4]);
+        distance.Store(out[5]);
+        
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (!(touching & (1 << lane))) continue;
+            
+            Manifold2D& manifold = *manifolds[i + lane];
+            
+            // Coincident centers have no direction; push apart vertically,
+            // like CollideCircles.
+            bool coincident = out[5][lane] <= FLT_EPSILON;
+            
+            manifold.normal = coincident ? Vec2{0.0f, 1.0f} : Vec2{out[0][lane], out[1][lane]};
+            manifold.points[0].point = coincident ? Vec2{circles.positionAX[i + lane], circles.positionAY[i + lane] + circles.radiusA[i + lane] + 0.5f * out[2][lane]}
+                                                  : Vec2{out[3][lane], out[4][lane]};
+            manifold.points[0].separation = out[2][lane];
+            manifold.points[0].id = 0;
+            manifold.count = 1;
+        }
+    }
+#endif
+    
+    for (; i < count; i++)
+    {
+        Pose2D poseA, poseB;
+        poseA.position = Vec2{circles.positionAX[i], circles.positionAY[i]};
+        poseB.position = Vec2{circles.positionBX[i], circles.positionBY[i]};
+        
+        CollideCircles(poseA, circles.radiusA[i], poseB, circles.radiusB[i], *manifolds[i]);
+    }
+}
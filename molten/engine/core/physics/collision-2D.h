@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+#include "../maths/vector.h"
+#include "physics-shapes.h"
+
+// Position and rotation of a body, with the rotation's sine and cosine.
+struct Pose2D
+{
+    Vec2 position = {0.0f, 0.0f};
+    float c = 1.0f;
+    float s = 0.0f;
+    
+    inline Vec2 Apply(const Vec2& v) const
+    {
+        return Vec2{position.x + c * v.x - s * v.y, position.y + s * v.x + c * v.y};
+    }
+    
+    inline Vec2 Rotate(const Vec2& v) const
+    {
+        return Vec2{c * v.x - s * v.y, s * v.x + c * v.y};
+    }
+};
+
+struct ContactPoint2D
+{
+    // World space, halfway between the two surfaces.
+    Vec2 point = {0.0f, 0.0f};
+    
+    // Negative when the shapes overlap.
+    float separation = 0.0f;
+    
+    // Identifies the features that touch, so impulses carry over between
+    // steps while the same corners stay in contact.
+    uint32_t id = 0;
+};
+
+// Contact between body A and body B; the normal points from A to B.
+struct Manifold2D
+{
+    Vec2 normal = {0.0f, 0.0f};
+    ContactPoint2D points[2];
+    uint32_t count = 0;
+};
+
+void CollideCircles(const Pose2D& poseA, float radiusA, const Pose2D& poseB, float radiusB, Manifold2D& manifold);
+
+void CollidePolygonCircle(const PolygonShape& polygonA, const Pose2D& poseA, float radiusB, const Pose2D& poseB, Manifold2D& manifold);
+
+void CollidePolygons(const PolygonShape& polygonA, const Pose2D& poseA, const PolygonShape& polygonB, const Pose2D& poseB, Manifold2D& manifold);
+
+// Circle pairs in struct-of-arrays form, for CollideCircleBatch.
+struct CircleBatch
+{
+    const float* positionAX = nullptr;
+    const float* positionAY = nullptr;
+    const float* radiusA = nullptr;
+    const float* positionBX = nullptr;
+    const float* positionBY = nullptr;
+    const float* radiusB = nullptr;
+};
+
+// Same results as CollideCircles, four pairs per SSE/NEON instruction.
+void CollideCircleBatch(const CircleBatch& circles, size_t count, Manifold2D* const* manifolds);
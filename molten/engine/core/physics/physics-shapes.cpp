@@ -0,0 +1,130 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "physics-shapes.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+static void FinishPolygon(PolygonShape& polygon)
+{
+    polygon.radius = 0.0f;
+    
+    for (uint32_t i = 0; i < polygon.count; i++)
+    {
+        Vec2 edge = polygon.vertices[(i + 1) % polygon.count] - polygon.vertices[i];
+        float length = std::sqrt(edge.x * edge.x + edge.y * edge.y);
+        
+        polygon.normals[i] = Vec2{edge.y / length, -edge.x / length};
+        
+        const Vec2& v = polygon.vertices[i];
+        polygon.radius = std::max(polygon.radius, std::sqrt(v.x * v.x + v.y * v.y));
+    }
+}
+
+PolygonShape MakeBoxShape(const Vec2& halfExtents)
+{
+    PolygonShape polygon;
+    polygon.count = 4;
+    polygon.vertices[0] = Vec2{-halfExtents.x, -halfExtents.y};
+    polygon.vertices[1] = Vec2{ halfExtents.x, -halfExtents.y};
+    polygon.vertices[2] = Vec2{ halfExtents.x,  halfExtents.y};
+    polygon.vertices[3] = Vec2{-halfExtents.x,  halfExtents.y};
+    
+    FinishPolygon(polygon);
+    return polygon;
+}
+
+bool MakePolygonShape(const Vec2* points, uint32_t count, PolygonShape& polygon)
+{
+    if (count < 3) return false;
+    
+    // Monotone chain hull, counterclockwise.
+    std::vector<Vec2> sorted(points, points + count);
+    std::sort(sorted.begin(), sorted.end(), [](const Vec2& a, const Vec2& b)
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    
+    std::vector<Vec2> hull(2 * sorted.size());
+    size_t k = 0;
+    
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        while (k >= 2 && Cross(hull[k - 1] - hull[k - 2], sorted[i] - hull[k - 2]) <= 0.0f) k--;
+        hull[k++] = sorted[i];
+    }
+    
+    for (size_t i = sorted.size() - 1, lower = k + 1; i > 0; i--)
+    {
+        while (k >= lower && Cross(hull[k - 1] - hull[k - 2], sorted[i - 1] - hull[k - 2]) <= 0.0f) k--;
+        hull[k++] = sorted[i - 1];
+    }
+    
+    size_t hullCount = k - 1;
+    if (hullCount < 3 || hullCount > MaxPolygonVertices) return false;
+    
+    // Area-weighted centroid of the fan triangles.
+    float area = 0.0f;
+    Vec2 centroid = {0.0f, 0.0f};
+    
+    for (size_t i = 0; i < hullCount; i++)
+    {
+        const Vec2& a = hull[i];
+        const Vec2& b = hull[(i + 1) % hullCount];
+        
+        float triangleArea = 0.5f * Cross(a, b);
+        
+        area += triangleArea;
+        centroid += (a + b) * (triangleArea / 3.0f);
+    }
+    
+    if (area <= 1e-6f) return false;
+    
+    centroid = centroid * (1.0f / area);
+    
+    polygon.count = static_cast<uint32_t>(hullCount);
+    
+    for (uint32_t i = 0; i < polygon.count; i++)
+        polygon.vertices[i] = hull[i] - centroid;
+    
+    FinishPolygon(polygon);
+    return true;
+}
+
+void ComputePolygonMass(const PolygonShape& polygon, float& area, float& inertia)
+{
+    area = 0.0f;
+    inertia = 0.0f;
+    
+    for (uint32_t i = 0; i < polygon.count; i++)
+    {
+        const Vec2& a = polygon.vertices[i];
+        const Vec2& b = polygon.vertices[(i + 1) % polygon.count];
+        
+        float cross = Cross(a, b);
+        
+        area += 0.5f * cross;
+        inertia += cross * (a.x * a.x + a.x * b.x + b.x * b.x + a.y * a.y + a.y * b.y + b.y * b.y) / 12.0f;
+    }
+}
@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+#include "../maths/vector.h"
+
+enum class ShapeType : uint8_t
+{
+    Circle,
+    Polygon
+};
+
+static constexpr uint32_t MaxPolygonVertices = 8;
+
+// Convex polygon in body space, counterclockwise, with its centroid at the
+// body origin. Boxes are polygons too, so they rotate with their body.
+struct PolygonShape
+{
+    Vec2 vertices[MaxPolygonVertices];
+    Vec2 normals[MaxPolygonVertices];
+    uint32_t count = 0;
+    
+    // Distance from the origin to the furthest vertex.
+    float radius = 0.0f;
+};
+
+PolygonShape MakeBoxShape(const Vec2& halfExtents);
+
+// Builds a polygon from the convex hull of the points, recentered on its
+// centroid. Returns false for fewer than three non-collinear points or a
+// hull with more than MaxPolygonVertices corners.
+bool MakePolygonShape(const Vec2* points, uint32_t count, PolygonShape& polygon);
+
+// Area and the polar moment of area about the centroid; multiplied by the
+// density they give mass and rotational inertia.
+void ComputePolygonMass(const PolygonShape& polygon, float& area, float& inertia);
@@ -0,0 +1,1391 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "physics-world-2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../jobs/job-system.h"
+#include "../renderer/sprite-2D.h"
+#include "../utils/log-macros.h"
+#include "../utils/profiler.h"
+
+// Bounds are widened by this much so pairs, and speculative contacts, are
+// found a little before the shapes touch.
+static constexpr float BoundsMargin = 1.0f;
+
+// Overlap the solver leaves alone, and how much of the rest it removes per
+// step. Correcting all of it at once makes stacks jitter.
+static constexpr float LinearSlop = 0.5f;
+static constexpr float Baumgarte = 0.2f;
+
+// Slower impacts don't bounce, so resting contacts settle.
+static constexpr float RestitutionThreshold = 30.0f;
+
+// w x r for a scalar angular velocity.
+static inline Vec2 CrossScalar(float w, const Vec2& r)
+{
+    return Vec2{-w * r.y, w * r.x};
+}
+
+// Maps a float to an unsigned integer with the same ordering.
+static inline uint32_t OrderedBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+BodyHandle PhysicsWorld2D::CreateBody(const BodyDesc& desc, ShapeType shape, float radius, uint32_t polygon, float area, float inertia)
+{
+    uint32_t slot;
+    
+    if (!m_FreeSlots.empty())
+    {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+    
+    uint32_t index = static_cast<uint32_t>(m_PositionX.size());
+    m_Slots[slot].dense = index;
+    
+    bool dynamic = desc.type == BodyType::Dynamic;
+    float mass = desc.density * area;
+    
+    if (dynamic && mass <= 0.0f)
+        LOG_CORE_WARN("Dynamic body with non-positive mass, it will not react to contacts");
+    
+    m_DenseToSlot.push_back(slot);
+    m_PositionX.push_back(desc.position.x);
+    m_PositionY.push_back(desc.position.y);
+    m_Rotation.push_back(desc.rotation);
+    m_PreviousX.push_back(desc.position.x);
+    m_PreviousY.push_back(desc.position.y);
+    m_PreviousRotation.push_back(desc.rotation);
+    m_VelocityX.push_back(desc.type == BodyType::Static ? 0.0f : desc.velocity.x);
+    m_VelocityY.push_back(desc.type == BodyType::Static ? 0.0f : desc.velocity.y);
+    m_AngularVelocity.push_back(desc.type == BodyType::Static ? 0.0f : desc.angularVelocity);
+    m_InverseMass.push_back(dynamic && mass > 0.0f ? 1.0f / mass : 0.0f);
+    m_InverseInertia.push_back(dynamic && mass > 0.0f && !desc.fixedRotation ? 1.0f / (desc.density * inertia) : 0.0f);
+    m_Friction.push_back(desc.friction);
+    m_Restitution.push_back(desc.restitution);
+    m_SleepTime.push_back(0.0f);
+    m_Type.push_back(desc.type);
+    m_Awake.push_back(desc.type != BodyType::Static);
+    m_Moved.push_back(0);
+    m_ShapeType.push_back(shape);
+    m_Radius.push_back(radius);
+    m_Polygon.push_back(polygon);
+    m_Sprite.emplace_back();
+    m_MinX.push_back(0.0f);
+    m_MinY.push_back(0.0f);
+    m_MaxX.push_back(0.0f);
+    m_MaxY.push_back(0.0f);
+    
+    return { slot, m_Slots[slot].generation };
+}
+
+BodyHandle PhysicsWorld2D::CreateCircle(const BodyDesc& desc, float radius)
+{
+    if (radius <= 0.0f)
+    {
+        LOG_CORE_ERROR("Circle body needs a positive radius, got {}", radius);
+        return BodyHandle();
+    }
+    
+    float area = 3.14159265f * radius * radius;
+    
+    return CreateBody(desc, ShapeType::Circle, radius, InvalidIndex, area, 0.5f * radius * radius * area);
+}
+
+BodyHandle PhysicsWorld2D::CreateBox(const BodyDesc& desc, const Vec2& halfExtents)
+{
+    if (halfExtents.x <= 0.0f || halfExtents.y <= 0.0f)
+    {
+        LOG_CORE_ERROR("Box body needs positive half extents, got {}x{}", halfExtents.x, halfExtents.y);
+        return BodyHandle();
+    }
+    
+    PolygonShape box = MakeBoxShape(halfExtents);
+    
+    uint32_t polygon;
+    
+    if (!m_FreePolygons.empty())
+    {
+        polygon = m_FreePolygons.back();
+        m_FreePolygons.pop_back();
+        m_Polygons[polygon] = box;
+    }
+    else
+    {
+        polygon = static_cast<uint32_t>(m_Polygons.size());
+        m_Polygons.push_back(box);
+    }
+    
+    float area, inertia;
+    ComputePolygonMass(box, area, inertia);
+    
+    return CreateBody(desc, ShapeType::Polygon, box.radius, polygon, area, inertia);
+}
+
+BodyHandle PhysicsWorld2D::CreatePolygon(const BodyDesc& desc, const Vec2* points, uint32_t count)
+{
+    PolygonShape shape;
+    
+    if (!MakePolygonShape(points, count, shape))
+    {
+        LOG_CORE_ERROR("Polygon body needs 3 to {} points spanning an area", MaxPolygonVertices);
+        return BodyHandle();
+    }
+    
+    uint32_t polygon;
+    
+    if (!m_FreePolygons.empty())
+    {
+        polygon = m_FreePolygons.back();
+        m_FreePolygons.pop_back();
+        m_Polygons[polygon] = shape;
+    }
+    else
+    {
+        polygon = static_cast<uint32_t>(m_Polygons.size());
+        m_Polygons.push_back(shape);
+    }
+    
+    float area, inertia;
+    ComputePolygonMass(shape, area, inertia);
+    
+    return CreateBody(desc, ShapeType::Polygon, shape.radius, polygon, area, inertia);
+}
+
+template<typename T>
+static inline void SwapRemove(std::vector<T>& column, uint32_t index)
+{
+    column[index] = std::move(column.back());
+    column.pop_back();
+}
+
+bool PhysicsWorld2D::Destroy(BodyHandle handle)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return false;
+    
+    // Whatever rested on the body has to notice it is gone; the next step
+    // wakes it, for every body removed in between at once.
+    m_RemovedBounds.push_back({ m_MinX[index], m_MinY[index], m_MaxX[index], m_MaxY[index] });
+    
+    if (m_Polygon[index] != InvalidIndex) m_FreePolygons.push_back(m_Polygon[index]);
+    
+    uint32_t last = static_cast<uint32_t>(Size() - 1);
+    
+    SwapRemove(m_DenseToSlot, index);
+    SwapRemove(m_PositionX, index);
+    SwapRemove(m_PositionY, index);
+    SwapRemove(m_Rotation, index);
+    SwapRemove(m_PreviousX, index);
+    SwapRemove(m_PreviousY, index);
+    SwapRemove(m_PreviousRotation, index);
+    SwapRemove(m_VelocityX, index);
+    SwapRemove(m_VelocityY, index);
+    SwapRemove(m_AngularVelocity, index);
+    SwapRemove(m_InverseMass, index);
+    SwapRemove(m_InverseInertia, index);
+    SwapRemove(m_Friction, index);
+    SwapRemove(m_Restitution, index);
+    SwapRemove(m_SleepTime, index);
+    SwapRemove(m_Type, index);
+    SwapRemove(m_Awake, index);
+    SwapRemove(m_Moved, index);
+    SwapRemove(m_ShapeType, index);
+    SwapRemove(m_Radius, index);
+    SwapRemove(m_Polygon, index);
+    SwapRemove(m_Sprite, index);
+    SwapRemove(m_MinX, index);
+    SwapRemove(m_MinY, index);
+    SwapRemove(m_MaxX, index);
+    SwapRemove(m_MaxY, index);
+    
+    if (index != last) m_Slots[m_DenseToSlot[index]].dense = index;
+    
+    Slot& slot = m_Slots[handle.index];
+    slot.dense = InvalidIndex;
+    if (++slot.generation == 0) slot.generation = 1;
+    m_FreeSlots.push_back(handle.index);
+    
+    return true;
+}
+
+void PhysicsWorld2D::Clear()
+{
+    for (uint32_t slotIndex : m_DenseToSlot)
+    {
+        Slot& slot = m_Slots[slotIndex];
+        slot.dense = InvalidIndex;
+        if (++slot.generation == 0) slot.generation = 1;
+        m_FreeSlots.push_back(slotIndex);
+    }
+    
+    m_DenseToSlot.clear();
+    m_PositionX.clear();
+    m_PositionY.clear();
+    m_Rotation.clear();
+    m_PreviousX.clear();
+    m_PreviousY.clear();
+    m_PreviousRotation.clear();
+    m_VelocityX.clear();
+    m_VelocityY.clear();
+    m_AngularVelocity.clear();
+    m_InverseMass.clear();
+    m_InverseInertia.clear();
+    m_Friction.clear();
+    m_Restitution.clear();
+    m_SleepTime.clear();
+    m_Type.clear();
+    m_Awake.clear();
+    m_Moved.clear();
+    m_ShapeType.clear();
+    m_Radius.clear();
+    m_Polygon.clear();
+    m_Sprite.clear();
+    m_MinX.clear();
+    m_MinY.clear();
+    m_MaxX.clear();
+    m_MaxY.clear();
+    
+    m_Polygons.clear();
+    m_FreePolygons.clear();
+    m_RemovedBounds.clear();
+    m_Cache.clear();
+    m_Accumulator = 0.0f;
+}
+
+void PhysicsWorld2D::WakeIndex(uint32_t index)
+{
+    if (m_Type[index] == BodyType::Static) return;
+    
+    m_Awake[index] = 1;
+    m_SleepTime[index] = 0.0f;
+}
+
+void PhysicsWorld2D::SetPosition(BodyHandle handle, const Vec2& position)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    // A teleport, so nothing to interpolate from.
+    m_PositionX[index] = m_PreviousX[index] = position.x;
+    m_PositionY[index] = m_PreviousY[index] = position.y;
+    m_Moved[index] = 1;
+    WakeIndex(index);
+}
+
+void PhysicsWorld2D::SetRotation(BodyHandle handle, float radians)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Rotation[index] = m_PreviousRotation[index] = radians;
+    m_Moved[index] = 1;
+    WakeIndex(index);
+}
+
+void PhysicsWorld2D::SetVelocity(BodyHandle handle, const Vec2& velocity)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_Type[index] == BodyType::Static) return;
+    
+    m_VelocityX[index] = velocity.x;
+    m_VelocityY[index] = velocity.y;
+    WakeIndex(index);
+}
+
+void PhysicsWorld2D::SetAngularVelocity(BodyHandle handle, float velocity)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_Type[index] == BodyType::Static) return;
+    
+    m_AngularVelocity[index] = velocity;
+    WakeIndex(index);
+}
+
+void PhysicsWorld2D::ApplyImpulse(BodyHandle handle, const Vec2& impulse, const Vec2& point)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_Type[index] != BodyType::Dynamic) return;
+    
+    Vec2 r = point - Vec2{m_PositionX[index], m_PositionY[index]};
+    
+    m_VelocityX[index] += m_InverseMass[index] * impulse.x;
+    m_VelocityY[index] += m_InverseMass[index] * impulse.y;
+    m_AngularVelocity[index] += m_InverseInertia[index] * Cross(r, impulse);
+    WakeIndex(index);
+}
+
+void PhysicsWorld2D::Wake(BodyHandle handle)
+{
+    uint32_t index = IndexOf(handle);
+    if (index != InvalidIndex) WakeIndex(index);
+}
+
+Vec2 PhysicsWorld2D::GetPosition(BodyHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index == InvalidIndex ? Vec2{0.0f, 0.0f} : Vec2{m_PositionX[index], m_PositionY[index]};
+}
+
+float PhysicsWorld2D::GetRotation(BodyHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index == InvalidIndex ? 0.0f : m_Rotation[index];
+}
+
+Vec2 PhysicsWorld2D::GetVelocity(BodyHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index == InvalidIndex ? Vec2{0.0f, 0.0f} : Vec2{m_VelocityX[index], m_VelocityY[index]};
+}
+
+float PhysicsWorld2D::GetAngularVelocity(BodyHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index == InvalidIndex ? 0.0f : m_AngularVelocity[index];
+}
+
+bool PhysicsWorld2D::IsAwake(BodyHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex && m_Awake[index];
+}
+
+void PhysicsWorld2D::AttachSprite(BodyHandle body, SpriteHandle sprite)
+{
+    uint32_t index = IndexOf(body);
+    if (index == InvalidIndex) return;
+    
+    CORE_ASSERT(m_Sprites, "PhysicsWorld2D::AttachSprite called before SetSprites");
+    
+    m_Sprite[index] = sprite;
+    m_Moved[index] = 1;
+}
+
+void PhysicsWorld2D::AttachSprite(BodyHandle body, const Sprite2D& sprite)
+{
+    if (!sprite.IsAdded())
+    {
+        LOG_CORE_WARN("Sprite must be added to the renderer before a body can drive it");
+        return;
+    }
+    
+    AttachSprite(body, sprite.GetHandle());
+}
+
+void PhysicsWorld2D::SetFixedTimestep(float seconds)
+{
+    if (seconds <= 0.0f)
+    {
+        LOG_CORE_WARN("Fixed timestep must be positive, got {}", seconds);
+        return;
+    }
+    
+    m_FixedTimestep = seconds;
+}
+
+uint64_t PhysicsWorld2D::PairKey(uint32_t a, uint32_t b) const
+{
+    return (static_cast<uint64_t>(m_DenseToSlot[a]) << 32) | m_DenseToSlot[b];
+}
+
+uint32_t PhysicsWorld2D::FindRoot(uint32_t index)
+{
+    while (m_Parent[index] != index)
+    {
+        m_Parent[index] = m_Parent[m_Parent[index]];
+        index = m_Parent[index];
+    }
+    
+    return index;
+}
+
+void PhysicsWorld2D::UpdateBounds()
+{
+    PROFILE_SCOPE("PhysicsWorld2D::UpdateBounds");
+    
+    m_Cos.resize(Size());
+    m_Sin.resize(Size());
+    
+    auto update = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            m_Cos[i] = std::cos(m_Rotation[i]);
+            m_Sin[i] = std::sin(m_Rotation[i]);
+            
+            float extentX, extentY;
+            
+            if (m_ShapeType[i] == ShapeType::Circle)
+            {
+                extentX = extentY = m_Radius[i];
+            }
+            else
+            {
+                // Half extents of the rotated polygon's box.
+                const PolygonShape& polygon = m_Polygons[m_Polygon[i]];
+                
+                float c = m_Cos[i];
+                float s = m_Sin[i];
+                
+                extentX = extentY = 0.0f;
+                
+                for (uint32_t v = 0; v < polygon.count; v++)
+                {
+                    const Vec2& p = polygon.vertices[v];
+                    
+                    extentX = std::max(extentX, std::fabs(c * p.x - s * p.y));
+                    extentY = std::max(extentY, std::fabs(s * p.x + c * p.y));
+                }
+            }
+            
+            m_MinX[i] = m_PositionX[i] - extentX - BoundsMargin;
+            m_MaxX[i] = m_PositionX[i] + extentX + BoundsMargin;
+            m_MinY[i] = m_PositionY[i] - extentY - BoundsMargin;
+            m_MaxY[i] = m_PositionY[i] + extentY + BoundsMargin;
+        }
+    };
+    
+    if (m_JobSystem) m_JobSystem->ParallelFor(Size(), 0, update);
+    else update(0, Size());
+}
+
+void PhysicsWorld2D::WakeRemovedNeighbours()
+{
+    if (m_RemovedBounds.empty()) return;
+    
+    PROFILE_SCOPE("PhysicsWorld2D::WakeRemovedNeighbours");
+    
+    // Sleeping bodies and removed bounds, each sorted by left edge. Of two
+    // boxes overlapping on x, one starts inside the other's span, so each
+    // side only scans the other list across its own span.
+    m_SortKeys.clear();
+    
+    for (uint32_t i = 0; i < Size(); i++)
+        if (!m_Awake[i] && m_Type[i] != BodyType::Static) m_SortKeys.push_back({ OrderedBits(m_MinX[i]), i });
+    
+    RadixSort(m_SortKeys, m_SortScratch);
+    
+    std::sort(m_RemovedBounds.begin(), m_RemovedBounds.end(), [](const Bounds& a, const Bounds& b) { return a.minX < b.minX; });
+    
+    auto overlapsY = [&](uint32_t i, const Bounds& removed) { return m_MinY[i] <= removed.maxY && m_MaxY[i] >= removed.minY; };
+    
+    for (const Bounds& removed : m_RemovedBounds)
+    {
+        auto body = std::lower_bound(m_SortKeys.begin(), m_SortKeys.end(), OrderedBits(removed.minX),
+                                     [](const SortKey& key, uint64_t left) { return key.key < left; });
+        
+        for (; body != m_SortKeys.end() && m_MinX[body->index] <= removed.maxX; ++body)
+            if (overlapsY(body->index, removed)) WakeIndex(body->index);
+    }
+    
+    for (const SortKey& key : m_SortKeys)
+    {
+        uint32_t i = key.index;
+        
+        auto removed = std::upper_bound(m_RemovedBounds.begin(), m_RemovedBounds.end(), m_MinX[i],
+                                        [](float left, const Bounds& bounds) { return left < bounds.minX; });
+        
+        for (; removed != m_RemovedBounds.end() && removed->minX <= m_MaxX[i]; ++removed)
+            if (overlapsY(i, *removed)) WakeIndex(i);
+    }
+    
+    m_RemovedBounds.clear();
+}
+
+void PhysicsWorld2D::FindPairs()
+{
+    PROFILE_SCOPE("PhysicsWorld2D::FindPairs");
+    
+    size_t count = Size();
+    
+    // A single sweep along x would test a body against everything above
+    // and below it in a tall pile, so bodies are first split into bands a
+    // few bodies high and each band is swept on its own. A body is listed
+    // in every band it spans, sorted by band and then by left edge.
+    float totalHeight = 0.0f;
+    size_t movingCount = 0;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (m_Type[i] == BodyType::Static) continue;
+        
+        totalHeight += m_MaxY[i] - m_MinY[i];
+        movingCount++;
+    }
+    
+    float bandHeight = movingCount > 0 ? 4.0f * totalHeight / movingCount : 256.0f;
+    float inverseBandHeight = 1.0f / bandHeight;
+    
+    auto bandOf = [&](float y)
+    {
+        return static_cast<int32_t>(std::clamp(std::floor(y * inverseBandHeight), -1.0e9f, 1.0e9f));
+    };
+    
+    m_SortKeys.clear();
+    
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t left = OrderedBits(m_MinX[i]);
+        
+        for (int32_t band = bandOf(m_MinY[i]), last = bandOf(m_MaxY[i]); band <= last; band++)
+            m_SortKeys.push_back({ (static_cast<uint64_t>(static_cast<uint32_t>(band) ^ 0x80000000u) << 32) | left, i });
+    }
+    
+    RadixSort(m_SortKeys, m_SortScratch);
+    
+    size_t entryCount = m_SortKeys.size();
+    
+    // Each range of the sorted list sweeps forward on its own; appending
+    // the ranges' pairs in order keeps the result independent of threads.
+    size_t rangeCount = m_JobSystem ? std::max<size_t>(1, std::min<size_t>(entryCount / 256, m_JobSystem->GetWorkerCount() * 4)) : 1;
+    
+    if (m_RangePairs.size() < rangeCount) m_RangePairs.resize(rangeCount);
+    
+    auto sweep = [&](size_t begin, size_t end)
+    {
+        for (size_t range = begin; range < end; range++)
+        {
+            std::vector<Pair>& pairs = m_RangePairs[range];
+            pairs.clear();
+            
+            size_t first = entryCount * range / rangeCount;
+            size_t last = entryCount * (range + 1) / rangeCount;
+            
+            for (size_t p = first; p < last; p++)
+            {
+                uint32_t i = m_SortKeys[p].index;
+                uint32_t band = static_cast<uint32_t>(m_SortKeys[p].key >> 32);
+                
+                bool movingI = m_Type[i] != BodyType::Static && m_Awake[i];
+                bool dynamicI = m_Type[i] == BodyType::Dynamic;
+                
+                for (size_t q = p + 1; q < entryCount; q++)
+                {
+                    if (static_cast<uint32_t>(m_SortKeys[q].key >> 32) != band) break;
+                    
+                    uint32_t j = m_SortKeys[q].index;
+                    
+                    if (m_MinX[j] > m_MaxX[i]) break;
+                    if (m_MinY[j] > m_MaxY[i] || m_MaxY[j] < m_MinY[i]) continue;
+                    
+                    // Bodies sharing several bands meet in each; only the
+                    // lowest shared one reports them.
+                    int32_t lowest = std::max(bandOf(m_MinY[i]), bandOf(m_MinY[j]));
+                    if ((static_cast<uint32_t>(lowest) ^ 0x80000000u) != band) continue;
+                    
+                    // Something must be able to move and something must
+                    // respond to contacts.
+                    bool movingJ = m_Type[j] != BodyType::Static && m_Awake[j];
+                    bool dynamicJ = m_Type[j] == BodyType::Dynamic;
+                    
+                    if (!(movingI || movingJ) || !(dynamicI || dynamicJ)) continue;
+                    
+                    if (m_DenseToSlot[i] < m_DenseToSlot[j]) pairs.push_back({ i, j });
+                    else pairs.push_back({ j, i });
+                }
+            }
+        }
+    };
+    
+    if (m_JobSystem && rangeCount > 1) m_JobSystem->ParallelFor(rangeCount, 1, sweep);
+    else sweep(0, rangeCount);
+    
+    m_Pairs.clear();
+    
+    for (size_t range = 0; range < rangeCount; range++)
+        m_Pairs.insert(m_Pairs.end(), m_RangePairs[range].begin(), m_RangePairs[range].end());
+}
+
+void PhysicsWorld2D::Collide()
+{
+    PROFILE_SCOPE("PhysicsWorld2D::Collide");
+    
+    size_t pairCount = m_Pairs.size();
+    
+    m_Manifolds.resize(pairCount);
+    m_CirclePairs.clear();
+    m_OtherPairs.clear();
+    
+    for (uint32_t k = 0; k < pairCount; k++)
+    {
+        const Pair& pair = m_Pairs[k];
+        
+        if (m_ShapeType[pair.a] == ShapeType::Circle && m_ShapeType[pair.b] == ShapeType::Circle) m_CirclePairs.push_back(k);
+        else m_OtherPairs.push_back(k);
+    }
+    
+    // Circle pairs are gathered into columns for the batched kernel.
+    size_t circleCount = m_CirclePairs.size();
+    
+    for (std::vector<float>& column : m_CircleColumns)
+        column.resize(circleCount);
+    
+    m_CircleManifolds.resize(circleCount);
+    
+    for (size_t c = 0; c < circleCount; c++)
+    {
+        const Pair& pair = m_Pairs[m_CirclePairs[c]];
+        
+        m_CircleColumns[0][c] = m_PositionX[pair.a];
+        m_CircleColumns[1][c] = m_PositionY[pair.a];
+        m_CircleColumns[2][c] = m_Radius[pair.a];
+        m_CircleColumns[3][c] = m_PositionX[pair.b];
+        m_CircleColumns[4][c] = m_PositionY[pair.b];
+        m_CircleColumns[5][c] = m_Radius[pair.b];
+        m_CircleManifolds[c] = &m_Manifolds[m_CirclePairs[c]];
+    }
+    
+    auto collideCircles = [&](size_t begin, size_t end)
+    {
+        // Blocks of four, so only the last block takes the scalar tail.
+        begin *= 4;
+        end = std::min(end * 4, circleCount);
+        
+        CircleBatch batch;
+        batch.positionAX = m_CircleColumns[0].data() + begin;
+        batch.positionAY = m_CircleColumns[1].data() + begin;
+        batch.radiusA = m_CircleColumns[2].data() + begin;
+        batch.positionBX = m_CircleColumns[3].data() + begin;
+        batch.positionBY = m_CircleColumns[4].data() + begin;
+        batch.radiusB = m_CircleColumns[5].data() + begin;
+        
+        CollideCircleBatch(batch, end - begin, m_CircleManifolds.data() + begin);
+    };
+    
+    auto collideOthers = [&](size_t begin, size_t end)
+    {
+        for (size_t k = begin; k < end; k++)
+        {
+            const Pair& pair = m_Pairs[m_OtherPairs[k]];
+            Manifold2D& manifold = m_Manifolds[m_OtherPairs[k]];
+            
+            Pose2D poseA = GetPose(pair.a);
+            Pose2D poseB = GetPose(pair.b);
+            
+            if (m_ShapeType[pair.a] == ShapeType::Polygon && m_ShapeType[pair.b] == ShapeType::Polygon)
+            {
+                CollidePolygons(m_Polygons[m_Polygon[pair.a]], poseA, m_Polygons[m_Polygon[pair.b]], poseB, manifold);
+            }
+            else if (m_ShapeType[pair.a] == ShapeType::Polygon)
+            {
+                CollidePolygonCircle(m_Polygons[m_Polygon[pair.a]], poseA, m_Radius[pair.b], poseB, manifold);
+            }
+            else
+            {
+                // The polygon is B here, so flip the normal to keep it A to B.
+                CollidePolygonCircle(m_Polygons[m_Polygon[pair.b]], poseB, m_Radius[pair.a], poseA, manifold);
+                manifold.normal = Vec2{-manifold.normal.x, -manifold.normal.y};
+            }
+        }
+    };
+    
+    size_t circleBlocks = (circleCount + 3) / 4;
+    
+    if (m_JobSystem)
+    {
+        m_JobSystem->ParallelFor(circleBlocks, 0, collideCircles);
+        m_JobSystem->ParallelFor(m_OtherPairs.size(), 0, collideOthers);
+    }
+    else
+    {
+        collideCircles(0, circleBlocks);
+        collideOthers(0, m_OtherPairs.size());
+    }
+    
+    // Keep the touching pairs and warm start them from last step's impulses.
+    m_Contacts.clear();
+    
+    for (size_t k = 0; k < pairCount; k++)
+    {
+        const Manifold2D& manifold = m_Manifolds[k];
+        if (manifold.count == 0) continue;
+        
+        const Pair& pair = m_Pairs[k];
+        
+        Contact contact = {};
+        contact.a = pair.a;
+        contact.b = pair.b;
+        contact.manifold = manifold;
+        contact.friction = std::sqrt(m_Friction[pair.a] * m_Friction[pair.b]);
+        contact.restitution = std::max(m_Restitution[pair.a], m_Restitution[pair.b]);
+        
+        uint64_t key = PairKey(pair.a, pair.b);
+        
+        auto cached = std::lower_bound(m_Cache.begin(), m_Cache.end(), key,
+                                       [](const CachedManifold& entry, uint64_t value) { return entry.key < value; });
+        
+        if (cached != m_Cache.end() && cached->key == key)
+        {
+            for (uint32_t p = 0; p < manifold.count; p++)
+            {
+                for (uint32_t q = 0; q < cached->count; q++)
+                {
+                    if (cached->ids[q] != manifold.points[p].id) continue;
+                    
+                    contact.normalImpulse[p] = cached->normalImpulse[q];
+                    contact.tangentImpulse[p] = cached->tangentImpulse[q];
+                }
+            }
+        }
+        
+        m_Contacts.push_back(contact);
+    }
+}
+
+bool PhysicsWorld2D::BuildIslands()
+{
+    PROFILE_SCOPE("PhysicsWorld2D::BuildIslands");
+    
+    size_t count = Size();
+    bool woke = false;
+    
+    m_Parent.resize(count);
+    
+    for (uint32_t i = 0; i < count; i++)
+        m_Parent[i] = i;
+    
+    // Only dynamic bodies join islands; static and kinematic ones would
+    // otherwise glue everything resting on them into one island.
+    for (const Contact& contact : m_Contacts)
+    {
+        if (m_Type[contact.a] != BodyType::Dynamic || m_Type[contact.b] != BodyType::Dynamic) continue;
+        
+        uint32_t rootA = FindRoot(contact.a);
+        uint32_t rootB = FindRoot(contact.b);
+        
+        if (rootA != rootB) m_Parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+    }
+    
+    // A moving kinematic body wakes what it touches.
+    for (const Contact& contact : m_Contacts)
+    {
+        for (uint32_t side = 0; side < 2; side++)
+        {
+            uint32_t kinematic = side == 0 ? contact.a : contact.b;
+            uint32_t other = side == 0 ? contact.b : contact.a;
+            
+            if (m_Type[kinematic] != BodyType::Kinematic || m_Type[other] != BodyType::Dynamic) continue;
+            
+            if (m_Awake[other]) continue;
+            
+            if (m_VelocityX[kinematic] != 0.0f || m_VelocityY[kinematic] != 0.0f || m_AngularVelocity[kinematic] != 0.0f)
+            {
+                WakeIndex(other);
+                woke = true;
+            }
+        }
+    }
+    
+    // Number islands in order of their lowest body, and wake every island
+    // that has an awake body in it.
+    m_IslandOf.assign(count, InvalidIndex);
+    
+    m_Islands.clear();
+    m_IslandAwake.clear();
+    m_FreeBodies.clear();
+    
+    m_Touching.assign(count, 0);
+    
+    for (const Contact& contact : m_Contacts)
+    {
+        m_Touching[contact.a] = 1;
+        m_Touching[contact.b] = 1;
+    }
+    
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (m_Type[i] == BodyType::Static) continue;
+        
+        if (m_Type[i] == BodyType::Kinematic || !m_Touching[i])
+        {
+            if (m_Awake[i]) m_FreeBodies.push_back(i);
+            continue;
+        }
+        
+        uint32_t root = FindRoot(i);
+        
+        if (m_IslandOf[root] == InvalidIndex)
+        {
+            m_IslandOf[root] = static_cast<uint32_t>(m_Islands.size());
+            m_Islands.push_back({ 0, 0, 0, 0 });
+            m_IslandAwake.push_back(0);
+        }
+        
+        m_IslandOf[i] = m_IslandOf[root];
+        m_Islands[m_IslandOf[i]].bodyCount++;
+        
+        if (m_Awake[i]) m_IslandAwake[m_IslandOf[i]] = 1;
+    }
+    
+    for (const Contact& contact : m_Contacts)
+    {
+        uint32_t dynamic = m_Type[contact.a] == BodyType::Dynamic ? contact.a : contact.b;
+        m_Islands[m_IslandOf[dynamic]].contactCount++;
+    }
+    
+    uint32_t bodyOffset = 0;
+    uint32_t contactOffset = 0;
+    
+    for (Island& island : m_Islands)
+    {
+        island.bodyStart = bodyOffset;
+        island.contactStart = contactOffset;
+        bodyOffset += island.bodyCount;
+        contactOffset += island.contactCount;
+        island.bodyCount = 0;
+        island.contactCount = 0;
+    }
+    
+    m_IslandBodies.resize(bodyOffset);
+    m_IslandContacts.resize(contactOffset);
+    m_LocalIndex.assign(count, -1);
+    
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (m_IslandOf[i] == InvalidIndex) continue;
+        
+        Island& island = m_Islands[m_IslandOf[i]];
+        uint32_t local = island.bodyStart + island.bodyCount++;
+        
+        m_IslandBodies[local] = i;
+        m_LocalIndex[i] = static_cast<int32_t>(local);
+        
+        if (m_IslandAwake[m_IslandOf[i]] && !m_Awake[i])
+        {
+            WakeIndex(i);
+            woke = true;
+        }
+    }
+    
+    for (uint32_t c = 0; c < m_Contacts.size(); c++)
+    {
+        Contact& contact = m_Contacts[c];
+        
+        contact.localA = m_Type[contact.a] == BodyType::Dynamic ? m_LocalIndex[contact.a] : -1;
+        contact.localB = m_Type[contact.b] == BodyType::Dynamic ? m_LocalIndex[contact.b] : -1;
+        
+        uint32_t dynamic = contact.localA >= 0 ? contact.a : contact.b;
+        Island& island = m_Islands[m_IslandOf[dynamic]];
+        
+        m_IslandContacts[island.contactStart + island.contactCount++] = c;
+    }
+    
+    // Islands that are asleep as a whole stay out of the solver.
+    size_t awakeIslands = 0;
+    
+    for (size_t i = 0; i < m_Islands.size(); i++)
+        if (m_IslandAwake[i]) m_Islands[awakeIslands++] = m_Islands[i];
+    
+    m_Islands.resize(awakeIslands);
+    
+    return woke;
+}
+
+void PhysicsWorld2D::SolveIsland(const Island& island, float dt)
+{
+    float inverseDt = 1.0f / dt;
+    
+    for (uint32_t k = island.bodyStart; k < island.bodyStart + island.bodyCount; k++)
+    {
+        uint32_t i = m_IslandBodies[k];
+        
+        m_LocalVelocity[k] = Vec2{m_VelocityX[i], m_VelocityY[i]} + m_Gravity * dt;
+        m_LocalAngularVelocity[k] = m_AngularVelocity[i];
+    }
+    
+    // Each contact works on copies of its two bodies' velocities. Static and
+    // kinematic bodies are only read, and have no mass to push.
+    struct BodyVelocity
+    {
+        Vec2 v;
+        float w;
+    };
+    
+    auto load = [&](int32_t local, uint32_t index)
+    {
+        if (local >= 0) return BodyVelocity{ m_LocalVelocity[local], m_LocalAngularVelocity[local] };
+        return BodyVelocity{ Vec2{m_VelocityX[index], m_VelocityY[index]}, m_AngularVelocity[index] };
+    };
+    
+    auto store = [&](int32_t local, const BodyVelocity& body)
+    {
+        if (local < 0) return;
+        
+        m_LocalVelocity[local] = body.v;
+        m_LocalAngularVelocity[local] = body.w;
+    };
+    
+    auto apply = [](const Contact& contact, BodyVelocity& a, BodyVelocity& b, const Vec2& rA, const Vec2& rB, const Vec2& impulse)
+    {
+        a.v -= impulse * contact.inverseMassA;
+        a.w -= contact.inverseInertiaA * Cross(rA, impulse);
+        b.v += impulse * contact.inverseMassB;
+        b.w += contact.inverseInertiaB * Cross(rB, impulse);
+    };
+    
+    auto relativeVelocity = [](const BodyVelocity& a, const BodyVelocity& b, const Vec2& rA, const Vec2& rB)
+    {
+        return (b.v + CrossScalar(b.w, rB)) - (a.v + CrossScalar(a.w, rA));
+    };
+    
+    for (uint32_t k = island.contactStart; k < island.contactStart + island.contactCount; k++)
+    {
+        Contact& contact = m_Contacts[m_IslandContacts[k]];
+        
+        const Vec2 normal = contact.manifold.normal;
+        const Vec2 tangent = Vec2{normal.y, -normal.x};
+        
+        float massA = contact.inverseMassA = m_InverseMass[contact.a];
+        float massB = contact.inverseMassB = m_InverseMass[contact.b];
+        float inertiaA = contact.inverseInertiaA = m_InverseInertia[contact.a];
+        float inertiaB = contact.inverseInertiaB = m_InverseInertia[contact.b];
+        
+        BodyVelocity a = load(contact.localA, contact.a);
+        BodyVelocity b = load(contact.localB, contact.b);
+        
+        for (uint32_t p = 0; p < contact.manifold.count; p++)
+        {
+            const ContactPoint2D& point = contact.manifold.points[p];
+            
+            Vec2 rA = point.point - Vec2{m_PositionX[contact.a], m_PositionY[contact.a]};
+            Vec2 rB = point.point - Vec2{m_PositionX[contact.b], m_PositionY[contact.b]};
+            
+            contact.anchorA[p] = rA;
+            contact.anchorB[p] = rB;
+            
+            float rnA = Cross(rA, normal);
+            float rnB = Cross(rB, normal);
+            float normalMass = massA + massB + inertiaA * rnA * rnA + inertiaB * rnB * rnB;
+            contact.normalMass[p] = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+            
+            float rtA = Cross(rA, tangent);
+            float rtB = Cross(rB, tangent);
+            float tangentMass = massA + massB + inertiaA * rtA * rtA + inertiaB * rtB * rtB;
+            contact.tangentMass[p] = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+            
+            // The lowest normal velocity the point may end up with: a gap
+            // may close by the end of the step, an overlap is pushed out a
+            // bit at a time.
+            float separation = point.separation;
+            float target;
+            
+            if (separation > 0.0f) target = -separation * inverseDt;
+            else target = Baumgarte * inverseDt * std::max(0.0f, -(separation + LinearSlop));
+            
+            float normalVelocity = Dot(relativeVelocity(a, b, rA, rB), normal);
+            
+            if (separation <= 0.0f && normalVelocity < -RestitutionThreshold)
+                target = std::max(target, -contact.restitution * normalVelocity);
+            
+            contact.bias[p] = target;
+            
+            apply(contact, a, b, rA, rB, normal * contact.normalImpulse[p] + tangent * contact.tangentImpulse[p]);
+        }
+        
+        store(contact.localA, a);
+        store(contact.localB, b);
+        
+        // Two points are solved together; one after the other, the first
+        // always takes more of the load and stacks slowly tip over.
+        contact.block = false;
+        
+        if (contact.manifold.count == 2)
+        {
+            float rn1A = Cross(contact.anchorA[0], normal);
+            float rn1B = Cross(contact.anchorB[0], normal);
+            float rn2A = Cross(contact.anchorA[1], normal);
+            float rn2B = Cross(contact.anchorB[1], normal);
+            
+            float k11 = massA + massB + inertiaA * rn1A * rn1A + inertiaB * rn1B * rn1B;
+            float k22 = massA + massB + inertiaA * rn2A * rn2A + inertiaB * rn2B * rn2B;
+            float k12 = massA + massB + inertiaA * rn1A * rn2A + inertiaB * rn1B * rn2B;
+            float determinant = k11 * k22 - k12 * k12;
+            
+            // Nearly parallel rows mean the points act as one; the single
+            // point solve handles that better.
+            if (k11 * k11 < 1000.0f * determinant)
+            {
+                contact.block = true;
+                contact.blockK[0] = k11;
+                contact.blockK[1] = k12;
+                contact.blockK[2] = k22;
+                contact.blockInverse[0] = k22 / determinant;
+                contact.blockInverse[1] = -k12 / determinant;
+                contact.blockInverse[2] = k11 / determinant;
+            }
+        }
+    }
+    
+    // Finds the impulses of both points of a manifold at once: the pair
+    // that leaves neither point approaching faster than its target, trying
+    // both points pushing, then either alone, then neither.
+    auto solveBlock = [&](Contact& contact, BodyVelocity& a, BodyVelocity& b)
+    {
+        const Vec2 normal = contact.manifold.normal;
+        
+        float k11 = contact.blockK[0], k12 = contact.blockK[1], k22 = contact.blockK[2];
+        float a1 = contact.normalImpulse[0], a2 = contact.normalImpulse[1];
+        
+        float vn1 = Dot(relativeVelocity(a, b, contact.anchorA[0], contact.anchorB[0]), normal);
+        float vn2 = Dot(relativeVelocity(a, b, contact.anchorA[1], contact.anchorB[1]), normal);
+        
+        // Velocities the points would have with no impulse at all.
+        float b1 = vn1 - contact.bias[0] - (k11 * a1 + k12 * a2);
+        float b2 = vn2 - contact.bias[1] - (k12 * a1 + k22 * a2);
+        
+        float x1, x2;
+        
+        x1 = -(contact.blockInverse[0] * b1 + contact.blockInverse[1] * b2);
+        x2 = -(contact.blockInverse[1] * b1 + contact.blockInverse[2] * b2);
+        
+        if (x1 < 0.0f || x2 < 0.0f)
+        {
+            x1 = -contact.normalMass[0] * b1;
+            x2 = 0.0f;
+            
+            if (x1 < 0.0f || k12 * x1 + b2 < 0.0f)
+            {
+                x1 = 0.0f;
+                x2 = -contact.normalMass[1] * b2;
+                
+                if (x2 < 0.0f || k12 * x2 + b1 < 0.0f)
+                {
+                    x2 = 0.0f;
+                    
+                    // Both separating already; if not, the system has no
+                    // answer and the impulses are left alone.
+                    if (b1 < 0.0f || b2 < 0.0f) return;
+                }
+            }
+        }
+        
+        contact.normalImpulse[0] = x1;
+        contact.normalImpulse[1] = x2;
+        
+        apply(contact, a, b, contact.anchorA[0], contact.anchorB[0], normal * (x1 - a1));
+        apply(contact, a, b, contact.anchorA[1], contact.anchorB[1], normal * (x2 - a2));
+    };
+    
+    for (int iteration = 0; iteration < m_VelocityIterations; iteration++)
+    {
+        for (uint32_t k = island.contactStart; k < island.contactStart + island.contactCount; k++)
+        {
+            Contact& contact = m_Contacts[m_IslandContacts[k]];
+            
+            const Vec2 normal = contact.manifold.normal;
+            const Vec2 tangent = Vec2{normal.y, -normal.x};
+            
+            BodyVelocity a = load(contact.localA, contact.a);
+            BodyVelocity b = load(contact.localB, contact.b);
+            
+            // Friction first: the normal impulses are what matters most, so
+            // they get the last word.
+            for (uint32_t p = 0; p < contact.manifold.count; p++)
+            {
+                const Vec2& rA = contact.anchorA[p];
+                const Vec2& rB = contact.anchorB[p];
+                
+                float tangentVelocity = Dot(relativeVelocity(a, b, rA, rB), tangent);
+                float maxFriction = contact.friction * contact.normalImpulse[p];
+                
+                float previous = contact.tangentImpulse[p];
+                contact.tangentImpulse[p] = std::clamp(previous - contact.tangentMass[p] * tangentVelocity, -maxFriction, maxFriction);
+                
+                apply(contact, a, b, rA, rB, tangent * (contact.tangentImpulse[p] - previous));
+            }
+            
+            if (contact.block)
+            {
+                solveBlock(contact, a, b);
+            }
+            else
+            {
+                for (uint32_t p = 0; p < contact.manifold.count; p++)
+                {
+                    const Vec2& rA = contact.anchorA[p];
+                    const Vec2& rB = contact.anchorB[p];
+                    
+                    float normalVelocity = Dot(relativeVelocity(a, b, rA, rB), normal);
+                    
+                    float previous = contact.normalImpulse[p];
+                    contact.normalImpulse[p] = std::max(previous - contact.normalMass[p] * (normalVelocity - contact.bias[p]), 0.0f);
+                    
+                    apply(contact, a, b, rA, rB, normal * (contact.normalImpulse[p] - previous));
+                }
+            }
+            
+            store(contact.localA, a);
+            store(contact.localB, b);
+        }
+    }
+    
+    // Integrate and write back. The island sleeps as a whole once its
+    // restless body has been still long enough.
+    float minSleepTime = TimeToSleep;
+    
+    for (uint32_t k = island.bodyStart; k < island.bodyStart + island.bodyCount; k++)
+    {
+        uint32_t i = m_IslandBodies[k];
+        
+        Vec2 velocity = m_LocalVelocity[k];
+        float angularVelocity = m_LocalAngularVelocity[k];
+        
+        m_VelocityX[i] = velocity.x;
+        m_VelocityY[i] = velocity.y;
+        m_AngularVelocity[i] = angularVelocity;
+        m_PositionX[i] += velocity.x * dt;
+        m_PositionY[i] += velocity.y * dt;
+        m_Rotation[i] += angularVelocity * dt;
+        m_Moved[i] = 1;
+        
+        if (velocity.x * velocity.x + velocity.y * velocity.y > SleepLinearVelocity * SleepLinearVelocity ||
+            angularVelocity * angularVelocity > SleepAngularVelocity * SleepAngularVelocity)
+            m_SleepTime[i] = 0.0f;
+        else
+            m_SleepTime[i] += dt;
+        
+        minSleepTime = std::min(minSleepTime, m_SleepTime[i]);
+    }
+    
+    if (minSleepTime < TimeToSleep) return;
+    
+    for (uint32_t k = island.bodyStart; k < island.bodyStart + island.bodyCount; k++)
+    {
+        uint32_t i = m_IslandBodies[k];
+        
+        m_Awake[i] = 0;
+        m_VelocityX[i] = 0.0f;
+        m_VelocityY[i] = 0.0f;
+        m_AngularVelocity[i] = 0.0f;
+    }
+}
+
+void PhysicsWorld2D::IntegrateFreeBodies(size_t begin, size_t end, float dt)
+{
+    for (size_t k = begin; k < end; k++)
+    {
+        uint32_t i = m_FreeBodies[k];
+        
+        if (m_Type[i] == BodyType::Kinematic)
+        {
+            if (m_VelocityX[i] == 0.0f && m_VelocityY[i] == 0.0f && m_AngularVelocity[i] == 0.0f) continue;
+        }
+        else
+        {
+            m_VelocityX[i] += m_Gravity.x * dt;
+            m_VelocityY[i] += m_Gravity.y * dt;
+        }
+        
+        m_PositionX[i] += m_VelocityX[i] * dt;
+        m_PositionY[i] += m_VelocityY[i] * dt;
+        m_Rotation[i] += m_AngularVelocity[i] * dt;
+        m_Moved[i] = 1;
+        
+        if (m_Type[i] != BodyType::Dynamic) continue;
+        
+        float speed = m_VelocityX[i] * m_VelocityX[i] + m_VelocityY[i] * m_VelocityY[i];
+        
+        if (speed > SleepLinearVelocity * SleepLinearVelocity ||
+            m_AngularVelocity[i] * m_AngularVelocity[i] > SleepAngularVelocity * SleepAngularVelocity)
+            m_SleepTime[i] = 0.0f;
+        else
+            m_SleepTime[i] += dt;
+        
+        // Gravity keeps a falling body from ever resting, so this only
+        // catches bodies in a world without it.
+        if (m_SleepTime[i] >= TimeToSleep)
+        {
+            m_Awake[i] = 0;
+            m_VelocityX[i] = 0.0f;
+            m_VelocityY[i] = 0.0f;
+            m_AngularVelocity[i] = 0.0f;
+        }
+    }
+}
+
+void PhysicsWorld2D::Solve(float dt)
+{
+    PROFILE_SCOPE("PhysicsWorld2D::Solve");
+    
+    m_LocalVelocity.resize(m_IslandBodies.size());
+    m_LocalAngularVelocity.resize(m_IslandBodies.size());
+    
+    // Islands touch disjoint bodies and contacts, so each is its own job.
+    auto solveIslands = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            SolveIsland(m_Islands[i], dt);
+    };
+    
+    auto integrate = [&](size_t begin, size_t end)
+    {
+        IntegrateFreeBodies(begin, end, dt);
+    };
+    
+    if (m_JobSystem)
+    {
+        m_JobSystem->ParallelFor(m_Islands.size(), 1, solveIslands);
+        m_JobSystem->ParallelFor(m_FreeBodies.size(), 0, integrate);
+    }
+    else
+    {
+        solveIslands(0, m_Islands.size());
+        integrate(0, m_FreeBodies.size());
+    }
+}
+
+void PhysicsWorld2D::CacheImpulses()
+{
+    // Contacts are already grouped by pair order of the sweep, not by key,
+    // so sort them once for the binary searches of the next step.
+    m_SortKeys.resize(m_Contacts.size());
+    
+    for (uint32_t c = 0; c < m_Contacts.size(); c++)
+        m_SortKeys[c] = { PairKey(m_Contacts[c].a, m_Contacts[c].b), c };
+    
+    RadixSort(m_SortKeys, m_SortScratch);
+    
+    m_NextCache.resize(m_Contacts.size());
+    
+    for (size_t k = 0; k < m_SortKeys.size(); k++)
+    {
+        const Contact& contact = m_Contacts[m_SortKeys[k].index];
+        CachedManifold& cached = m_NextCache[k];
+        
+        cached.key = m_SortKeys[k].key;
+        cached.count = contact.manifold.count;
+        
+        for (uint32_t p = 0; p < contact.manifold.count; p++)
+        {
+            cached.ids[p] = contact.manifold.points[p].id;
+            cached.normalImpulse[p] = contact.normalImpulse[p];
+            cached.tangentImpulse[p] = contact.tangentImpulse[p];
+        }
+    }
+    
+    std::swap(m_Cache, m_NextCache);
+}
+
+void PhysicsWorld2D::Step(float dt)
+{
+    PROFILE_SCOPE("PhysicsWorld2D::Step");
+    
+    if (dt <= 0.0f) return;
+    
+    m_PreviousX = m_PositionX;
+    m_PreviousY = m_PositionY;
+    m_PreviousRotation = m_Rotation;
+    
+    UpdateBounds();
+    WakeRemovedNeighbours();
+    
+    // Pairs between sleeping bodies were skipped, so bodies woken up here
+    // still lack their other contacts; look again until nothing new wakes.
+    do
+    {
+        FindPairs();
+        Collide();
+    }
+    while (BuildIslands());
+    
+    Solve(dt);
+    CacheImpulses();
+    
+    m_Stats.bodies = Size();
+    m_Stats.awakeBodies = 0;
+    m_Stats.pairs = m_Pairs.size();
+    m_Stats.contacts = m_Contacts.size();
+    m_Stats.islands = m_Islands.size();
+    
+    for (size_t i = 0; i < Size(); i++)
+        m_Stats.awakeBodies += m_Awake[i] && m_Type[i] == BodyType::Dynamic;
+    
+    PROFILE_COUNTER("Physics contacts", m_Stats.contacts);
+    PROFILE_COUNTER("Physics islands", m_Stats.islands);
+    PROFILE_COUNTER("Awake bodies", m_Stats.awakeBodies);
+}
+
+void PhysicsWorld2D::Update(float dt)
+{
+    m_Accumulator += dt;
+    
+    int steps = 0;
+    
+    while (m_Accumulator >= m_FixedTimestep && steps < m_MaxSubSteps)
+    {
+        Step(m_FixedTimestep);
+        m_Accumulator -= m_FixedTimestep;
+        steps++;
+    }
+    
+    if (m_Accumulator >= m_FixedTimestep) m_Accumulator = std::fmod(m_Accumulator, m_FixedTimestep);
+    
+    WriteSprites(GetInterpolationAlpha());
+}
+
+void PhysicsWorld2D::WriteSprites(float alpha)
+{
+    PROFILE_SCOPE("PhysicsWorld2D::WriteSprites");
+    
+    if (!m_Sprites) return;
+    
+    for (size_t i = 0; i < Size(); i++)
+    {
+        if (!m_Moved[i]) continue;
+        
+        float x = m_PositionX[i], y = m_PositionY[i], rotation = m_Rotation[i];
+        
+        // Still moving: blend, and write again next time with a new alpha.
+        // Once a step leaves the body in place its exact pose is written
+        // and it goes quiet.
+        if (x != m_PreviousX[i] || y != m_PreviousY[i] || rotation != m_PreviousRotation[i])
+        {
+            x = m_PreviousX[i] + (x - m_PreviousX[i]) * alpha;
+            y = m_PreviousY[i] + (y - m_PreviousY[i]) * alpha;
+            rotation = m_PreviousRotation[i] + (rotation - m_PreviousRotation[i]) * alpha;
+        }
+        else
+        {
+            m_Moved[i] = 0;
+        }
+        
+        if (!m_Sprites->IsAlive(m_Sprite[i])) continue;
+        
+        m_Sprites->SetPosition(m_Sprite[i], Vec2{x, y});
+        m_Sprites->SetRotation(m_Sprite[i], rotation);
+    }
+}
@@ -0,0 +1,385 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "../maths/vector.h"
+#include "physics-shapes.h"
+#include "collision-2D.h"
+#include "../renderer/sprite-store.h"
+#include "../utils/radix-sort.h"
+
+class JobSystem;
+class Sprite2D;
+
+// Stable reference to a body in a PhysicsWorld2D, see SpriteHandle.
+struct BodyHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const BodyHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const BodyHandle& other) const { return !(*this == other); }
+};
+
+enum class BodyType : uint8_t
+{
+    // Never moves.
+    Static,
+    
+    // Moves with the velocity it is given and pushes dynamic bodies, but
+    // nothing pushes it.
+    Kinematic,
+    
+    Dynamic
+};
+
+struct BodyDesc
+{
+    BodyType type = BodyType::Dynamic;
+    
+    Vec2 position = {0.0f, 0.0f};
+    float rotation = 0.0f;
+    
+    Vec2 velocity = {0.0f, 0.0f};
+    float angularVelocity = 0.0f;
+    
+    float density = 1.0f;
+    float friction = 0.4f;
+    float restitution = 0.0f;
+    
+    bool fixedRotation = false;
+};
+
+struct PhysicsStats
+{
+    size_t bodies = 0;
+    size_t awakeBodies = 0;
+    size_t pairs = 0;
+    size_t contacts = 0;
+    size_t islands = 0;
+};
+
+// 2D rigid bodies with circle and convex polygon shapes, in the same units
+// as sprites (pixels, y up).
+//
+// A step finds overlapping bounds by sweep and prune along x within
+// horizontal bands, collides the pairs in parallel (circle pairs four at a
+// time), groups touching bodies into islands and solves each island's
+// contacts with sequential impulses as its own job. Islands that stay still long enough
+// fall asleep and cost nothing until something touches them.
+//
+// Body data lives in dense columns like SpriteStore's; handles stay valid
+// while other bodies come and go.
+class PhysicsWorld2D
+{
+private:
+    
+    struct Slot
+    {
+        uint32_t generation = 1;
+        uint32_t dense = InvalidIndex;
+    };
+    
+    struct Pair
+    {
+        uint32_t a;
+        uint32_t b;
+    };
+    
+    struct Bounds
+    {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+    };
+    
+    // One manifold being solved. Bodies are referred to by dense index and
+    // by their position in the island's velocity arrays (-1 for bodies the
+    // solver only reads: static and kinematic ones).
+    struct Contact
+    {
+        uint32_t a;
+        uint32_t b;
+        int32_t localA;
+        int32_t localB;
+        
+        Manifold2D manifold;
+        
+        float friction;
+        float restitution;
+        
+        float inverseMassA;
+        float inverseMassB;
+        float inverseInertiaA;
+        float inverseInertiaB;
+        
+        float normalImpulse[2];
+        float tangentImpulse[2];
+        float normalMass[2];
+        float tangentMass[2];
+        float bias[2];
+        Vec2 anchorA[2];
+        Vec2 anchorB[2];
+        
+        // Two-point manifolds: the points' effective mass matrix and its
+        // inverse, both symmetric (xx, xy, yy).
+        bool block;
+        float blockK[3];
+        float blockInverse[3];
+    };
+    
+    struct Island
+    {
+        uint32_t bodyStart;
+        uint32_t bodyCount;
+        uint32_t contactStart;
+        uint32_t contactCount;
+    };
+    
+    // Impulses of last step's contact points, sorted by body pair for warm
+    // starting.
+    struct CachedManifold
+    {
+        uint64_t key;
+        uint32_t ids[2];
+        float normalImpulse[2];
+        float tangentImpulse[2];
+        uint32_t count;
+    };
+    
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+    std::vector<uint32_t> m_DenseToSlot;
+    
+    // Dense columns, all the same length.
+    std::vector<float> m_PositionX;
+    std::vector<float> m_PositionY;
+    std::vector<float> m_Rotation;
+    
+    // Pose at the start of the last step, to interpolate sprites between
+    // steps.
+    std::vector<float> m_PreviousX;
+    std::vector<float> m_PreviousY;
+    std::vector<float> m_PreviousRotation;
+    
+    std::vector<float> m_VelocityX;
+    std::vector<float> m_VelocityY;
+    std::vector<float> m_AngularVelocity;
+    std::vector<float> m_InverseMass;
+    std::vector<float> m_InverseInertia;
+    std::vector<float> m_Friction;
+    std::vector<float> m_Restitution;
+    std::vector<float> m_SleepTime;
+    std::vector<BodyType> m_Type;
+    std::vector<uint8_t> m_Awake;
+    std::vector<uint8_t> m_Moved;
+    std::vector<ShapeType> m_ShapeType;
+    std::vector<float> m_Radius;
+    std::vector<uint32_t> m_Polygon;
+    std::vector<SpriteHandle> m_Sprite;
+    std::vector<float> m_MinX;
+    std::vector<float> m_MinY;
+    std::vector<float> m_MaxX;
+    std::vector<float> m_MaxY;
+    
+    // Rotation as cosine and sine, refreshed with the bounds every step.
+    std::vector<float> m_Cos;
+    std::vector<float> m_Sin;
+    
+    std::vector<PolygonShape> m_Polygons;
+    std::vector<uint32_t> m_FreePolygons;
+    
+    // Bounds of bodies destroyed since the last step; sleeping bodies they
+    // overlap are woken at the start of the next one.
+    std::vector<Bounds> m_RemovedBounds;
+    
+    JobSystem* m_JobSystem = nullptr;
+    SpriteStore* m_Sprites = nullptr;
+    
+    Vec2 m_Gravity = {0.0f, -980.0f};
+    
+    float m_FixedTimestep = 1.0f / 60.0f;
+    float m_Accumulator = 0.0f;
+    int m_MaxSubSteps = 4;
+    int m_VelocityIterations = 8;
+    
+    // Per-step scratch, kept to avoid reallocating.
+    std::vector<SortKey> m_SortKeys;
+    std::vector<SortKey> m_SortScratch;
+    std::vector<std::vector<Pair>> m_RangePairs;
+    std::vector<Pair> m_Pairs;
+    std::vector<Manifold2D> m_Manifolds;
+    std::vector<uint32_t> m_CirclePairs;
+    std::vector<uint32_t> m_OtherPairs;
+    std::vector<float> m_CircleColumns[6];
+    std::vector<Manifold2D*> m_CircleManifolds;
+    std::vector<Contact> m_Contacts;
+    std::vector<uint32_t> m_Parent;
+    std::vector<uint32_t> m_IslandOf;
+    std::vector<uint8_t> m_Touching;
+    std::vector<uint8_t> m_IslandAwake;
+    std::vector<Island> m_Islands;
+    std::vector<uint32_t> m_IslandBodies;
+    std::vector<uint32_t> m_IslandContacts;
+    std::vector<int32_t> m_LocalIndex;
+    std::vector<uint32_t> m_FreeBodies;
+    std::vector<Vec2> m_LocalVelocity;
+    std::vector<float> m_LocalAngularVelocity;
+    std::vector<CachedManifold> m_Cache;
+    std::vector<CachedManifold> m_NextCache;
+    
+    PhysicsStats m_Stats;
+    
+    BodyHandle CreateBody(const BodyDesc& desc, ShapeType shape, float radius, uint32_t polygon, float area, float inertia);
+    
+    inline Pose2D GetPose(uint32_t index) const
+    {
+        Pose2D pose;
+        pose.position = Vec2{m_PositionX[index], m_PositionY[index]};
+        pose.c = m_Cos[index];
+        pose.s = m_Sin[index];
+        return pose;
+    }
+    
+    uint64_t PairKey(uint32_t a, uint32_t b) const;
+    
+    uint32_t FindRoot(uint32_t index);
+    
+    void WakeIndex(uint32_t index);
+    
+    void UpdateBounds();
+    
+    void WakeRemovedNeighbours();
+    
+    void FindPairs();
+    
+    void Collide();
+    
+    // Returns true if it woke sleeping bodies.
+    bool BuildIslands();
+    
+    void SolveIsland(const Island& island, float dt);
+    
+    void IntegrateFreeBodies(size_t begin, size_t end, float dt);
+    
+    void Solve(float dt);
+    
+    void CacheImpulses();
+    
+public:
+    
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+    
+    // Bodies are awake until they move slower than this for TimeToSleep.
+    static constexpr float SleepLinearVelocity = 5.0f;
+    static constexpr float SleepAngularVelocity = 0.05f;
+    static constexpr float TimeToSleep = 0.5f;
+    
+    BodyHandle CreateCircle(const BodyDesc& desc, float radius);
+    BodyHandle CreateBox(const BodyDesc& desc, const Vec2& halfExtents);
+    
+    // The points' convex hull becomes the shape, centered on its centroid.
+    // Returns an invalid handle if MakePolygonShape rejects them.
+    BodyHandle CreatePolygon(const BodyDesc& desc, const Vec2* points, uint32_t count);
+    
+    bool Destroy(BodyHandle handle);
+    
+    void Clear();
+    
+    inline bool IsAlive(BodyHandle handle) const
+    {
+        return handle.index < m_Slots.size() && m_Slots[handle.index].generation == handle.generation &&
+               m_Slots[handle.index].dense != InvalidIndex;
+    }
+    
+    inline uint32_t IndexOf(BodyHandle handle) const { return IsAlive(handle) ? m_Slots[handle.index].dense : InvalidIndex; }
+    
+    inline size_t Size() const { return m_PositionX.size(); }
+    
+    // Setters wake the body. They ignore dead handles.
+    void SetPosition(BodyHandle handle, const Vec2& position);
+    void SetRotation(BodyHandle handle, float radians);
+    void SetVelocity(BodyHandle handle, const Vec2& velocity);
+    void SetAngularVelocity(BodyHandle handle, float velocity);
+    void ApplyImpulse(BodyHandle handle, const Vec2& impulse, const Vec2& point);
+    void Wake(BodyHandle handle);
+    
+    Vec2 GetPosition(BodyHandle handle) const;
+    float GetRotation(BodyHandle handle) const;
+    Vec2 GetVelocity(BodyHandle handle) const;
+    float GetAngularVelocity(BodyHandle handle) const;
+    bool IsAwake(BodyHandle handle) const;
+    
+    // Column access, e.g. to checksum a simulation.
+    inline const float* GetPositionsX() const { return m_PositionX.data(); }
+    inline const float* GetPositionsY() const { return m_PositionY.data(); }
+    inline const float* GetRotations() const { return m_Rotation.data(); }
+    
+    // The body writes its position and rotation straight into the sprite
+    // while it moves; sleeping bodies write nothing. Sprites must live in
+    // the store given to SetSprites.
+    void AttachSprite(BodyHandle body, SpriteHandle sprite);
+    void AttachSprite(BodyHandle body, const Sprite2D& sprite);
+    
+    void SetSprites(SpriteStore* sprites) { m_Sprites = sprites; }
+    
+    void SetJobSystem(JobSystem* jobSystem) { m_JobSystem = jobSystem; }
+    
+    void SetGravity(const Vec2& gravity) { m_Gravity = gravity; }
+    Vec2 GetGravity() const { return m_Gravity; }
+    
+    void SetFixedTimestep(float seconds);
+    float GetFixedTimestep() const { return m_FixedTimestep; }
+    
+    // Steps per Update at most; time beyond that is dropped so a long frame
+    // can't make the next one longer still.
+    void SetMaxSubSteps(int steps) { m_MaxSubSteps = steps > 0 ? steps : 1; }
+    
+    void SetVelocityIterations(int iterations) { m_VelocityIterations = iterations > 0 ? iterations : 1; }
+    
+    // Runs as many fixed steps as the elapsed time covers, then writes the
+    // bodies that moved into their sprites, interpolated by the time left
+    // over.
+    void Update(float dt);
+    
+    // Advances the simulation by exactly dt, without touching sprites. For
+    // loops that run their own fixed ticks; follow with WriteSprites.
+    void Step(float dt);
+    
+    // Writes the pose of every body that moved in the last step into its
+    // sprite, alpha of the way from where the step started to where it
+    // ended. Bodies keep writing until a step leaves them where they were.
+    void WriteSprites(float alpha = 1.0f);
+    
+    // How far the accumulator is into the next fixed step, in [0, 1).
+    float GetInterpolationAlpha() const { return m_Accumulator / m_FixedTimestep; }
+    
+    // Counters of the last step.
+    const PhysicsStats& GetStats() const { return m_Stats; }
+};
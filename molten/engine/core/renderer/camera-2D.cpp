@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "camera-2D.h"
+
+#include <cmath>
+
+#include "../utils/log-macros.h"
+
+Camera2D::Camera2D(float viewportWidth, float viewportHeight)
+: m_Position{viewportWidth * 0.5f, viewportHeight * 0.5f}, m_ViewportWidth(viewportWidth), m_ViewportHeight(viewportHeight) {}
+
+void Camera2D::SetZoom(float zoom)
+{
+    if (!(zoom > 0.0f))
+    {
+        LOG_CORE_WARN("Camera zoom must be positive, got {}", zoom);
+        return;
+    }
+    
+    m_Zoom = zoom;
+}
+
+void Camera2D::SetViewport(float width, float height)
+{
+    m_ViewportWidth = width;
+    m_ViewportHeight = height;
+}
+
+Mat4 Camera2D::GetViewProjection() const
+{
+    if (m_ViewportWidth <= 0.0f || m_ViewportHeight <= 0.0f) return Mat4();
+    
+    // clip = scale * R(-rotation) * (world - position)
+    float c = std::cos(m_Rotation);
+    float s = std::sin(m_Rotation);
+    
+    float scaleX = 2.0f * m_Zoom / m_ViewportWidth;
+    float scaleY = 2.0f * m_Zoom / m_ViewportHeight;
+    
+    float tx = -scaleX * (c * m_Position.x + s * m_Position.y);
+    float ty = -scaleY * (-s * m_Position.x + c * m_Position.y);
+    
+    return Mat4(
+      Vec4{ scaleX * c, -scaleY * s, 0.0f, 0.0f}, // Column 0
+      Vec4{ scaleX * s,  scaleY * c, 0.0f, 0.0f}, // Column 1
+      Vec4{ 0.0f,        0.0f,       1.0f, 0.0f}, // Column 2
+      Vec4{ tx,          ty,         0.0f, 1.0f}  // Column 3
+    );
+}
+
+Rect2D Camera2D::GetVisibleBounds() const
+{
+    float halfWidth = m_ViewportWidth * 0.5f / m_Zoom;
+    float halfHeight = m_ViewportHeight * 0.5f / m_Zoom;
+    
+    float c = std::fabs(std::cos(m_Rotation));
+    float s = std::fabs(std::sin(m_Rotation));
+    
+    Vec2 extent = {c * halfWidth + s * halfHeight, s * halfWidth + c * halfHeight};
+    
+    return { m_Position - extent, m_Position + extent };
+}
+
+Vec2 Camera2D::ScreenToWorld(const Vec2& screen) const
+{
+    // Screen space has its origin at the bottom left, like Ortho.
+    Vec2 view = (screen - Vec2{m_ViewportWidth * 0.5f, m_ViewportHeight * 0.5f}) / m_Zoom;
+    
+    float c = std::cos(m_Rotation);
+    float s = std::sin(m_Rotation);
+    
+    return m_Position + Vec2{c * view.x - s * view.y, s * view.x + c * view.y};
+}
+
+Vec2 Camera2D::WorldToScreen(const Vec2& world) const
+{
+    Vec2 offset = world - m_Position;
+    
+    float c = std::cos(m_Rotation);
+    float s = std::sin(m_Rotation);
+    
+    Vec2 view = {c * offset.x + s * offset.y, -s * offset.x + c * offset.y};
+    
+    return view * m_Zoom + Vec2{m_ViewportWidth * 0.5f, m_ViewportHeight * 0.5f};
+}
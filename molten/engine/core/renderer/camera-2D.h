@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "../maths/matrix.h"
+
+// Axis-aligned rectangle in world units.
+struct Rect2D
+{
+    Vec2 min;
+    Vec2 max;
+    
+    bool Overlaps(const Rect2D& other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+    }
+};
+
+// 2D camera looking at a point of the world. Zoom scales world units to
+// pixels; rotation turns the view counterclockwise, in radians.
+class Camera2D
+{
+private:
+    
+    Vec2 m_Position = {0.0f, 0.0f};
+    float m_Zoom = 1.0f;
+    float m_Rotation = 0.0f;
+    
+    float m_ViewportWidth = 0.0f;
+    float m_ViewportHeight = 0.0f;
+    
+public:
+    
+    Camera2D() = default;
+    
+    // Centered on the viewport, which matches Ortho(0, width, 0, height).
+    Camera2D(float viewportWidth, float viewportHeight);
+    
+    void SetPosition(const Vec2& position) { m_Position = position; }
+    void SetZoom(float zoom);
+    void SetRotation(float radians) { m_Rotation = radians; }
+    void SetViewport(float width, float height);
+    
+    void Move(const Vec2& offset) { m_Position += offset; }
+    
+    Vec2 GetPosition() const { return m_Position; }
+    float GetZoom() const { return m_Zoom; }
+    float GetRotation() const { return m_Rotation; }
+    float GetViewportWidth() const { return m_ViewportWidth; }
+    float GetViewportHeight() const { return m_ViewportHeight; }
+    
+    // World to clip space, used in place of the projection matrix.
+    Mat4 GetViewProjection() const;
+    
+    // Smallest world-space rectangle containing everything on screen.
+    Rect2D GetVisibleBounds() const;
+    
+    Vec2 ScreenToWorld(const Vec2& screen) const;
+    Vec2 WorldToScreen(const Vec2& world) const;
+};
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "cooked-texture.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <filesystem>
+
+#include "../utils/block-compression.h"
+#include "../utils/mip-chain.h"
+#include "../utils/log-macros.h"
+
+static constexpr char CookedFileMagic[4] = { 'M', 'T', 'E', 'X' };
+static constexpr uint32_t CookedFileVersion = 1;
+
+// The pixels start on this boundary, which mapping preserves.
+static constexpr uint64_t CookedDataAlignment = 64;
+
+static constexpr uint32_t CookedFlagFlipped = 1;
+
+struct CookedFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipLevelCount;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+};
+
+bool CookedTexture::Open(const char* path)
+{
+    AssetData bytes;
+    if (!bytes.OpenFile(path)) return false;
+    
+    return Open(std::move(bytes), path);
+}
+
+bool CookedTexture::Open(AssetData&& bytes, const char* name)
+{
+    m_Bytes = std::move(bytes);
+    
+    CookedFileHeader header;
+    
+    if (m_Bytes.GetSize() < sizeof(header))
+    {
+        LOG_CORE_ERROR("Cooked texture is truncated: {}", name);
+        m_Bytes = AssetData();
+        return false;
+    }
+    
+    std::memcpy(&header, m_Bytes.GetData(), sizeof(header));
+    
+    if (std::memcmp(header.magic, CookedFileMagic, sizeof(header.magic)) != 0 || header.version != CookedFileVersion ||
+        header.format > static_cast<uint32_t>(TextureFormat::BC3RGBA) || header.mipLevelCount == 0 || header.mipLevelCount > 32)
+    {
+        LOG_CORE_ERROR("Not a cooked texture, or from another version: {}", name);
+        m_Bytes = AssetData();
+        return false;
+    }
+    
+    m_Desc.width = header.width;
+    m_Desc.height = header.height;
+    m_Desc.format = static_cast<TextureFormat>(header.format);
+    m_Desc.mipLevelCount = header.mipLevelCount;
+    
+    if (header.dataSize != GetTextureSize(m_Desc) || header.dataOffset > m_Bytes.GetSize() ||
+        header.dataSize > m_Bytes.GetSize() - header.dataOffset)
+    {
+        LOG_CORE_ERROR("Cooked texture is truncated: {}", name);
+        m_Bytes = AssetData();
+        return false;
+    }
+    
+    m_Flipped = (header.flags & CookedFlagFlipped) != 0;
+    m_Data = m_Bytes.GetData() + header.dataOffset;
+    m_DataSize = static_cast<size_t>(header.dataSize);
+    
+    return true;
+}
+
+std::string CookedTexture::GetCookedPath(const std::string& sourcePath)
+{
+    return std::filesystem::path(sourcePath).replace_extension(Extension).string();
+}
+
+CookedTexture* CookedTexture::OpenForSource(const std::string& sourcePath, const ImageLoadOptions& options)
+{
+    std::string cookedPath = GetCookedPath(sourcePath);
+    
+    CookedTexture* cooked = nullptr;
+    
+    if (AssetArchive::HasMounted())
+    {
+        AssetData bytes;
+        
+        if (AssetArchive::Contains(cookedPath) && AssetArchive::Load(cookedPath, bytes))
+        {
+            cooked = new CookedTexture();
+            
+            if (!cooked->Open(std::move(bytes), cookedPath.c_str()) || cooked->IsFlipped() != options.flipVertically)
+            {
+                delete cooked;
+                cooked = nullptr;
+            }
+            
+            return cooked;
+        }
+        
+        // A packed source without a cooked twin isn't looked for on disk.
+        if (AssetArchive::Contains(sourcePath)) return nullptr;
+    }
+    
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+    if (error) return nullptr;
+    
+    // An edited source wins over its stale cooked file during development.
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    if (!error && sourceTime > cookedTime) return nullptr;
+    
+    cooked = new CookedTexture();
+    
+    if (!cooked->Open(cookedPath.c_str()) || cooked->IsFlipped() != options.flipVertically)
+    {
+        delete cooked;
+        return nullptr;
+    }
+    
+    return cooked;
+}
+
+bool CookedTexture::Cook(const char* sourcePath, const char* outputPath, const CookOptions& options)
+{
+    ImageLoadOptions loadOptions;
+    loadOptions.flipVertically = options.flipVertically;
+    
+    Image image(sourcePath, loadOptions);
+    if (!image.IsValid()) return false;
+    
+    TextureDesc desc;
+    desc.width = static_cast<uint32_t>(image.GetWidth());
+    desc.height = static_cast<uint32_t>(image.GetHeight());
+    desc.format = options.format;
+    desc.mipLevelCount = 1;
+    
+    if (options.mipmaps) desc.mipLevelCount = GetMipLevelCount(desc.width, desc.height);
+    
+    // The whole RGBA8 chain first, then each level is compressed on its own.
+    std::vector<uint8_t> chain(GetMipChainSize(desc.width, desc.height, desc.mipLevelCount));
+    std::memcpy(chain.data(), image.GetData(), size_t(desc.width) * desc.height * 4);
+    
+    GenerateMipChain(chain.data(), desc.width, desc.height, desc.mipLevelCount, options.mipFilter);
+    
+    // Uncompressed textures store the chain as it is.
+    std::vector<uint8_t> data;
+    
+    if (desc.format == TextureFormat::RGBA8Unorm)
+    {
+        data.swap(chain);
+    }
+    else
+    {
+        data.resize(GetTextureSize(desc));
+        
+        const uint8_t* level = chain.data();
+        size_t offset = 0;
+        
+        for (uint32_t i = 0; i < desc.mipLevelCount; i++)
+        {
+            uint32_t width = GetMipDimension(desc.width, i);
+            uint32_t height = GetMipDimension(desc.height, i);
+            
+            if (desc.format == TextureFormat::BC1RGBA) CompressBC1(level, width, height, &data[offset]);
+            else CompressBC3(level, width, height, &data[offset]);
+            
+            offset += GetTextureLevelSize(desc.format, width, height);
+            level += size_t(width) * height * 4;
+        }
+    }
+    
+    CookedFileHeader header = {};
+    std::memcpy(header.magic, CookedFileMagic, sizeof(header.magic));
+    header.version = CookedFileVersion;
+    header.format = static_cast<uint32_t>(desc.format);
+    header.width = desc.width;
+    header.height = desc.height;
+    header.mipLevelCount = desc.mipLevelCount;
+    header.flags = options.flipVertically ? CookedFlagFlipped : 0;
+    header.dataOffset = (sizeof(header) + CookedDataAlignment - 1) & ~(CookedDataAlignment - 1);
+    header.dataSize = data.size();
+    
+    FILE* file = std::fopen(outputPath, "wb");
+    if (!file) { LOG_CORE_ERROR("Failed to open cooked texture for writing: {}", outputPath); return false; }
+    
+    static const uint8_t padding[CookedDataAlignment] = {};
+    
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(padding, 1, header.dataOffset - sizeof(header), file) == header.dataOffset - sizeof(header);
+    ok = ok && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    
+    ok = std::fclose(file) == 0 && ok;
+    
+    if (!ok) LOG_CORE_ERROR("Failed to write cooked texture: {}", outputPath);
+    
+    return ok;
+}
@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "render-device.h"
+#include "../utils/image.h"
+#include "../utils/mip-chain.h"
+#include "../assets/asset-archive.h"
+
+struct CookOptions
+{
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    bool mipmaps = true;
+    bool flipVertically = true;
+    
+    MipFilterOptions mipFilter;
+};
+
+// A texture cooked offline (.mtex): a small header followed by the whole mip
+// chain, already flipped and in its GPU format, in exactly the layout
+// RenderDevice::CreateTexture takes. Opening one maps the file, or finds it in
+// a mounted archive, and checks the header; the pixels are read straight from
+// the mapping when uploaded, with no decoding and no copy.
+class CookedTexture
+{
+private:
+    
+    AssetData m_Bytes;
+    
+    TextureDesc m_Desc;
+    bool m_Flipped = false;
+    
+    const uint8_t* m_Data = nullptr;
+    size_t m_DataSize = 0;
+    
+public:
+    
+    static constexpr const char* Extension = ".mtex";
+    
+    CookedTexture() = default;
+    
+    CookedTexture(const CookedTexture&) = delete;
+    CookedTexture& operator=(const CookedTexture&) = delete;
+    
+    bool Open(const char* path);
+    
+    // Takes over bytes already loaded, e.g. from an archive; name is only used for logging.
+    bool Open(AssetData&& bytes, const char* name);
+    
+    // The cooked file that stands in for a source image: same path, .mtex extension.
+    static std::string GetCookedPath(const std::string& sourcePath);
+    
+    // Opens the cooked file of a source image, if it exists, is at least as
+    // new as the source and was flipped the way the options ask. Returns
+    // nullptr otherwise, so the caller decodes the source instead. Mounted
+    // archives are trusted to be cooked together with their sources.
+    static CookedTexture* OpenForSource(const std::string& sourcePath, const ImageLoadOptions& options = ImageLoadOptions());
+    
+    // Decodes a source image and writes it cooked to outputPath.
+    static bool Cook(const char* sourcePath, const char* outputPath, const CookOptions& options = CookOptions());
+    
+    // Starts reading the pixels in, e.g. from a loading thread ahead of the upload.
+    void Prefetch() const { MappedFile::Prefetch(m_Data, m_DataSize); }
+    
+    inline const TextureDesc& GetDesc() const { return m_Desc; }
+    inline bool IsFlipped() const { return m_Flipped; }
+    
+    // Every level, largest first, as CreateTexture expects them.
+    inline const uint8_t* GetData() const { return m_Data; }
+    inline size_t GetDataSize() const { return m_DataSize; }
+};
@@ -0,0 +1,127 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "frame-ring.h"
+
+#include <algorithm>
+
+void FrameRingAllocator::Reset(size_t sliceSize, uint32_t sliceCount)
+{
+    m_SliceSize = sliceSize;
+    m_SliceCount = sliceCount;
+    m_Slot = 0;
+    m_Head = 0;
+}
+
+void FrameRingAllocator::BeginFrame(uint32_t slot)
+{
+    m_Slot = m_SliceCount > 0 ? slot % m_SliceCount : 0;
+    m_Head = 0;
+}
+
+size_t FrameRingAllocator::Allocate(size_t size, size_t alignment)
+{
+    size_t offset = (m_Head + alignment - 1) & ~(alignment - 1);
+    
+    if (offset + size > m_SliceSize) return InvalidOffset;
+    
+    m_Head = offset + size;
+    
+    return m_Slot * m_SliceSize + offset;
+}
+
+void FrameSliceTracker::Reset(uint32_t sliceCount)
+{
+    m_SliceCount = std::min(sliceCount, FrameSync::MaxFramesInFlight);
+    
+    InvalidateAll();
+}
+
+void FrameSliceTracker::InvalidateAll()
+{
+    for (Slice& slice : m_Slices)
+    {
+        slice.pending.clear();
+        slice.pendingBytes = 0;
+        slice.full = true;
+    }
+}
+
+void FrameSliceTracker::AddRange(size_t offset, size_t size)
+{
+    if (size == 0) return;
+    
+    for (uint32_t i = 0; i < m_SliceCount; i++)
+    {
+        Slice& slice = m_Slices[i];
+        if (slice.full) continue;
+        
+        slice.pending.push_back({ offset, size });
+        slice.pendingBytes += size;
+    }
+}
+
+const std::vector<FrameSliceTracker::Range>& FrameSliceTracker::TakeRanges(uint32_t slot, size_t size)
+{
+    Slice& slice = m_Slices[slot % std::max<uint32_t>(m_SliceCount, 1)];
+    
+    if (slice.full || slice.pendingBytes >= size)
+    {
+        slice.pending.clear();
+        if (size > 0) slice.pending.push_back({ 0, size });
+    }
+    else
+    {
+        std::sort(slice.pending.begin(), slice.pending.end(),
+                  [](const Range& a, const Range& b) { return a.offset < b.offset; });
+        
+        // Merge overlapping and touching ranges, clipped to the source size.
+        size_t merged = 0;
+        
+        for (const Range& range : slice.pending)
+        {
+            if (range.offset >= size) break;
+            
+            size_t end = std::min(range.offset + range.size, size);
+            
+            if (merged > 0 && range.offset <= slice.pending[merged - 1].offset + slice.pending[merged - 1].size)
+            {
+                Range& last = slice.pending[merged - 1];
+                last.size = std::max(last.offset + last.size, end) - last.offset;
+                continue;
+            }
+            
+            slice.pending[merged++] = { range.offset, end - range.offset };
+        }
+        
+        slice.pending.resize(merged);
+    }
+    
+    slice.pendingBytes = 0;
+    slice.full = false;
+    
+    // The caller uploads these before the next AddRange, which starts the list over.
+    m_Scratch.swap(slice.pending);
+    slice.pending.clear();
+    
+    return m_Scratch;
+}
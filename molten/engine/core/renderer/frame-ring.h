@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "frame-sync.h"
+
+// Linear allocator over a buffer split into one slice per frame in flight.
+// BeginFrame rewinds the slice of the given slot; allocations from it stay
+// valid until that slot comes around again, which FrameSync makes sure only
+// happens once the GPU is done with it.
+class FrameRingAllocator
+{
+private:
+    
+    size_t m_SliceSize = 0;
+    uint32_t m_SliceCount = 0;
+    
+    uint32_t m_Slot = 0;
+    size_t m_Head = 0;
+    
+public:
+    
+    static constexpr size_t InvalidOffset = static_cast<size_t>(-1);
+    
+    void Reset(size_t sliceSize, uint32_t sliceCount);
+    
+    void BeginFrame(uint32_t slot);
+    
+    // Offset from the start of the whole buffer, or InvalidOffset if the
+    // slice is full. alignment must be a power of two.
+    size_t Allocate(size_t size, size_t alignment = 16);
+    
+    inline size_t GetSliceSize() const { return m_SliceSize; }
+    
+    inline uint32_t GetSliceCount() const { return m_SliceCount; }
+    
+    inline size_t GetTotalSize() const { return m_SliceSize * m_SliceCount; }
+    
+    inline size_t GetUsed() const { return m_Head; }
+};
+
+// Tracks which bytes of each per-frame copy of a persistent buffer are out
+// of date. Every change is recorded for all slices; a slice's list is only
+// consumed when its frame comes around, so each copy catches up on what it
+// missed while the GPU was reading it.
+class FrameSliceTracker
+{
+public:
+    
+    struct Range
+    {
+        size_t offset;
+        size_t size;
+    };
+    
+private:
+    
+    struct Slice
+    {
+        std::vector<Range> pending;
+        size_t pendingBytes = 0;
+        bool full = true;
+    };
+    
+    Slice m_Slices[FrameSync::MaxFramesInFlight];
+    uint32_t m_SliceCount = 0;
+    
+    std::vector<Range> m_Scratch;
+    
+public:
+    
+    void Reset(uint32_t sliceCount);
+    
+    // Every slice needs a full upload, e.g. after the buffer was recreated.
+    void InvalidateAll();
+    
+    void AddRange(size_t offset, size_t size);
+    
+    // Ranges the slice needs to match a size-byte source, sorted and merged,
+    // then forgets them. A slice that fell behind by more than its size gets
+    // one full range instead.
+    const std::vector<Range>& TakeRanges(uint32_t slot, size_t size);
+    
+    inline uint32_t GetSliceCount() const { return m_SliceCount; }
+};
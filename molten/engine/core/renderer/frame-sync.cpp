@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "frame-sync.h"
+
+#include <algorithm>
+
+#include "../utils/log-macros.h"
+
+FrameSync::FrameSync(uint32_t framesInFlight)
+: m_FramesInFlight(std::clamp<uint32_t>(framesInFlight, 1, MaxFramesInFlight)) {}
+
+uint32_t FrameSync::Acquire()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    
+    m_Condition.wait(lock, [this] { return m_Acquired - m_Completed < m_FramesInFlight; });
+    
+    return static_cast<uint32_t>(m_Acquired++ % m_FramesInFlight);
+}
+
+bool FrameSync::TryAcquire(uint32_t& slot)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    
+    if (m_Acquired - m_Completed >= m_FramesInFlight) return false;
+    
+    slot = static_cast<uint32_t>(m_Acquired++ % m_FramesInFlight);
+    return true;
+}
+
+void FrameSync::Signal()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        
+        if (m_Completed == m_Acquired)
+        {
+            LOG_CORE_WARN("FrameSync signalled with no frame in flight.");
+            return;
+        }
+        
+        m_Completed++;
+    }
+    
+    m_Condition.notify_all();
+}
+
+void FrameSync::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    
+    m_Condition.wait(lock, [this] { return m_Completed == m_Acquired; });
+}
+
+uint32_t FrameSync::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return static_cast<uint32_t>(m_Acquired - m_Completed);
+}
+
+uint64_t FrameSync::GetCompletedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Completed;
+}
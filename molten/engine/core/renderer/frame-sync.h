@@ -0,0 +1,72 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+// Counting fence between the CPU and a GPU that finishes frames in order.
+// Acquire blocks while framesInFlight frames are still unfinished, then
+// returns the slot (frame number modulo framesInFlight) the new frame may
+// write. Whatever runs the frames, such as a command buffer completion
+// handler or a test, calls Signal once for every acquired frame.
+class FrameSync
+{
+private:
+    
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    
+    uint32_t m_FramesInFlight;
+    
+    uint64_t m_Acquired = 0;
+    uint64_t m_Completed = 0;
+    
+public:
+    
+    static constexpr uint32_t MaxFramesInFlight = 3;
+    
+    explicit FrameSync(uint32_t framesInFlight = 2);
+    
+    FrameSync(const FrameSync&) = delete;
+    FrameSync& operator=(const FrameSync&) = delete;
+    
+    uint32_t Acquire();
+    
+    // Non-blocking Acquire; false if every slot is still in flight.
+    bool TryAcquire(uint32_t& slot);
+    
+    // Marks the oldest unfinished frame as done. Safe from any thread.
+    void Signal();
+    
+    // Blocks until every acquired frame was signalled.
+    void WaitIdle();
+    
+    uint32_t GetFramesInFlight() const { return m_FramesInFlight; }
+    
+    // Frames acquired but not signalled yet.
+    uint32_t GetPendingCount() const;
+    
+    uint64_t GetCompletedCount() const;
+};
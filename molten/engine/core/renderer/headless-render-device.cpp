@@ -0,0 +1,303 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "headless-render-device.h"
+
+#include <cstring>
+
+#include "../utils/log-macros.h"
+
+HeadlessRenderDevice::HeadlessRenderDevice(bool recordCommands, uint32_t framesInFlight)
+: RenderDevice(framesInFlight), m_RecordCommands(recordCommands) {}
+
+void HeadlessRenderDevice::Record(const RenderCommand& command)
+{
+    if (m_RecordCommands) m_Commands.push_back(command);
+}
+
+BufferHandle HeadlessRenderDevice::CreateBuffer(size_t size, const void* data)
+{
+    if (size == 0) return BufferHandle();
+    
+    std::vector<uint8_t> bytes(size);
+    
+    if (data)
+    {
+        std::memcpy(bytes.data(), data, size);
+        m_Stats.bytesUploaded += size;
+    }
+    
+    m_Stats.buffersCreated++;
+    
+    return BufferHandle{ m_Buffers.Add(std::move(bytes)) };
+}
+
+void HeadlessRenderDevice::UpdateBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size)
+{
+    std::vector<uint8_t>* bytes = m_Buffers.Get(buffer.id);
+    if (!bytes || !data || size == 0) return;
+    
+    if (offset + size > bytes->size())
+    {
+        LOG_CORE_ERROR("Buffer update out of range ({} + {} > {})", offset, size, bytes->size());
+        return;
+    }
+    
+    std::memcpy(bytes->data() + offset, data, size);
+    
+    m_Stats.bytesUploaded += size;
+}
+
+void HeadlessRenderDevice::DestroyBuffer(BufferHandle buffer)
+{
+    m_Buffers.Remove(buffer.id);
+}
+
+TextureHandle HeadlessRenderDevice::CreateTexture(const TextureDesc& desc, const void* pixels)
+{
+    if (desc.width == 0 || desc.height == 0 || desc.mipLevelCount == 0) return TextureHandle();
+    
+    HeadlessTexture texture;
+    texture.desc = desc;
+    
+    size_t byteSize = GetTextureSize(desc);
+    
+    if (pixels)
+    {
+        texture.pixels.resize(byteSize);
+        std::memcpy(texture.pixels.data(), pixels, byteSize);
+        m_Stats.bytesUploaded += byteSize;
+    }
+    
+    m_Stats.texturesCreated++;
+    
+    return TextureHandle{ m_Textures.Add(std::move(texture)) };
+}
+
+void HeadlessRenderDevice::UpdateTexture(TextureHandle texture, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* pixels)
+{
+    HeadlessTexture* headlessTexture = m_Textures.Get(texture.id);
+    if (!headlessTexture || !pixels || width == 0 || height == 0) return;
+    
+    const TextureDesc& desc = headlessTexture->desc;
+    
+    if (IsBlockCompressed(desc.format))
+    {
+        LOG_CORE_ERROR("Compressed textures can't be updated");
+        return;
+    }
+    
+    uint32_t levelWidth = GetMipDimension(desc.width, level);
+    uint32_t levelHeight = GetMipDimension(desc.height, level);
+    
+    if (level >= desc.mipLevelCount || x + width > levelWidth || y + height > levelHeight)
+    {
+        LOG_CORE_ERROR("Texture update out of range (level {}, {}, {}, {}x{})", level, x, y, width, height);
+        return;
+    }
+    
+    if (headlessTexture->pixels.empty()) headlessTexture->pixels.resize(GetTextureSize(desc));
+    
+    // Levels are stored one after the other, as CreateTexture takes them.
+    size_t levelOffset = 0;
+    
+    for (uint32_t i = 0; i < level; i++)
+        levelOffset += GetTextureLevelSize(desc.format, GetMipDimension(desc.width, i), GetMipDimension(desc.height, i));
+    
+    auto src = static_cast<const uint8_t*>(pixels);
+    
+    for (uint32_t row = 0; row < height; row++)
+        std::memcpy(&headlessTexture->pixels[levelOffset + (size_t(y + row) * levelWidth + x) * 4], src + size_t(row) * width * 4, size_t(width) * 4);
+    
+    m_Stats.bytesUploaded += size_t(width) * height * 4;
+}
+
+void HeadlessRenderDevice::DestroyTexture(TextureHandle texture)
+{
+    m_Textures.Remove(texture.id);
+}
+
+PipelineHandle HeadlessRenderDevice::CreatePipeline(const PipelineDesc& desc)
+{
+    if (!desc.vertexFunction || !desc.fragmentFunction)
+    {
+        LOG_CORE_ERROR("Pipeline is missing a vertex or fragment function.");
+        return PipelineHandle();
+    }
+    
+    m_Stats.pipelinesCreated++;
+    
+    return PipelineHandle{ m_Pipelines.Add(desc) };
+}
+
+void HeadlessRenderDevice::DestroyPipeline(PipelineHandle pipeline)
+{
+    m_Pipelines.Remove(pipeline.id);
+}
+
+SamplerHandle HeadlessRenderDevice::CreateSampler(const SamplerDesc& desc)
+{
+    m_Stats.samplersCreated++;
+    
+    return SamplerHandle{ m_Samplers.Add(desc) };
+}
+
+void HeadlessRenderDevice::DestroySampler(SamplerHandle sampler)
+{
+    m_Samplers.Remove(sampler.id);
+}
+
+bool HeadlessRenderDevice::BeginFrame(const ClearColor&)
+{
+    AcquireFrame();
+    
+    ResetBindings();
+    
+    m_InFrame = true;
+    
+    Record({ RenderCommandType::BeginFrame });
+    
+    return true;
+}
+
+void HeadlessRenderDevice::SetPipeline(PipelineHandle pipeline)
+{
+    if (!m_InFrame || pipeline == m_BoundPipeline) return;
+    
+    m_BoundPipeline = pipeline;
+    m_Stats.pipelineChanges++;
+    
+    Record({ RenderCommandType::SetPipeline, pipeline.id });
+}
+
+void HeadlessRenderDevice::SetVertexBuffer(BufferHandle buffer, size_t offset, uint32_t index)
+{
+    if (!m_InFrame || index >= MaxBindSlots) return;
+    
+    if (buffer == m_BoundVertexBuffers[index] && offset == m_BoundVertexOffsets[index]) return;
+    
+    m_BoundVertexBuffers[index] = buffer;
+    m_BoundVertexOffsets[index] = offset;
+    m_Stats.bufferBindChanges++;
+    
+    Record({ RenderCommandType::SetVertexBuffer, buffer.id, index, offset });
+}
+
+void HeadlessRenderDevice::SetFragmentTexture(TextureHandle texture, uint32_t index)
+{
+    if (!m_InFrame || index >= MaxBindSlots || texture == m_BoundTextures[index]) return;
+    
+    m_BoundTextures[index] = texture;
+    m_Stats.textureBindChanges++;
+    
+    Record({ RenderCommandType::SetFragmentTexture, texture.id, index });
+}
+
+void HeadlessRenderDevice::SetFragmentSampler(SamplerHandle sampler, uint32_t index)
+{
+    if (!m_InFrame || index >= MaxBindSlots || sampler == m_BoundSamplers[index]) return;
+    
+    m_BoundSamplers[index] = sampler;
+    m_Stats.samplerBindChanges++;
+    
+    Record({ RenderCommandType::SetFragmentSampler, sampler.id, index });
+}
+
+void HeadlessRenderDevice::Draw(PrimitiveType primitive, size_t vertexStart, size_t vertexCount)
+{
+    if (!m_InFrame || vertexCount == 0) return;
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += vertexCount;
+    
+    Record({ RenderCommandType::Draw, 0, static_cast<uint32_t>(primitive), vertexStart, vertexCount });
+}
+
+void HeadlessRenderDevice::DrawInstanced(PrimitiveType primitive, size_t vertexStart, size_t vertexCount,
+                                         size_t instanceStart, size_t instanceCount)
+{
+    if (!m_InFrame || vertexCount == 0 || instanceCount == 0) return;
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += vertexCount * instanceCount;
+    m_Stats.instancesDrawn += instanceCount;
+    
+    Record({ RenderCommandType::DrawInstanced, 0, static_cast<uint32_t>(primitive), vertexStart, vertexCount,
+             instanceStart, instanceCount });
+}
+
+void HeadlessRenderDevice::DrawIndexed(PrimitiveType primitive, BufferHandle indexBuffer, IndexType indexType,
+                                       size_t indexStart, size_t indexCount)
+{
+    if (!m_InFrame || indexCount == 0) return;
+    
+    size_t indexSize = indexType == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    
+    const std::vector<uint8_t>* indices = m_Buffers.Get(indexBuffer.id);
+    if (!indices || (indexStart + indexCount) * indexSize > indices->size())
+    {
+        LOG_CORE_ERROR("Indexed draw reads past the end of index buffer {}", indexBuffer.id);
+        return;
+    }
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += indexCount;
+    
+    Record({ RenderCommandType::DrawIndexed, indexBuffer.id, static_cast<uint32_t>(primitive), indexStart, indexCount });
+}
+
+void HeadlessRenderDevice::EndFrame()
+{
+    if (!m_InFrame) return;
+    
+    m_InFrame = false;
+    m_Stats.frames++;
+    
+    Record({ RenderCommandType::EndFrame });
+    
+    m_FrameAcquired = false;
+    
+    if (m_ManualCompletion) m_UncompletedFrames++;
+    else m_FrameSync.Signal();
+}
+
+bool HeadlessRenderDevice::CompleteFrame()
+{
+    if (m_UncompletedFrames == 0) return false;
+    
+    m_UncompletedFrames--;
+    m_FrameSync.Signal();
+    
+    return true;
+}
+
+const std::vector<uint8_t>* HeadlessRenderDevice::GetBufferContents(BufferHandle buffer) const
+{
+    return m_Buffers.Get(buffer.id);
+}
+
+const std::vector<uint8_t>* HeadlessRenderDevice::GetTextureContents(TextureHandle texture) const
+{
+    const HeadlessTexture* headlessTexture = m_Textures.Get(texture.id);
+    
+    return headlessTexture ? &headlessTexture->pixels : nullptr;
+}
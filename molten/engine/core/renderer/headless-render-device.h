@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "render-device.h"
+#include "resource-pool.h"
+
+enum class RenderCommandType
+{
+    BeginFrame,
+    SetPipeline,
+    SetVertexBuffer,
+    SetFragmentTexture,
+    SetFragmentSampler,
+    Draw,
+    DrawInstanced,
+    DrawIndexed,
+    EndFrame
+};
+
+// One entry of the recorded command stream. Only the fields relevant to the
+// command type are filled in.
+struct RenderCommand
+{
+    RenderCommandType type;
+    uint32_t handle = 0;
+    uint32_t index = 0;
+    uint64_t first = 0;
+    uint64_t count = 0;
+    uint64_t instanceStart = 0;
+    uint64_t instanceCount = 0;
+};
+
+// RenderDevice that never touches a GPU. Buffers and textures keep their
+// bytes in system memory and every submitted command is appended to a list,
+// so the renderer's CPU side can be run, profiled and diffed anywhere.
+class HeadlessRenderDevice : public RenderDevice
+{
+private:
+    
+    struct HeadlessTexture
+    {
+        TextureDesc desc;
+        std::vector<uint8_t> pixels;
+    };
+    
+    ResourcePool<std::vector<uint8_t>> m_Buffers;
+    ResourcePool<HeadlessTexture> m_Textures;
+    ResourcePool<PipelineDesc> m_Pipelines;
+    ResourcePool<SamplerDesc> m_Samplers;
+    
+    std::vector<RenderCommand> m_Commands;
+    
+    bool m_RecordCommands = true;
+    bool m_InFrame = false;
+    
+    // With manual completion, ended frames stay in flight until CompleteFrame,
+    // standing in for the GPU finishing them.
+    bool m_ManualCompletion = false;
+    uint32_t m_UncompletedFrames = 0;
+    
+    void Record(const RenderCommand& command);
+    
+public:
+    
+    explicit HeadlessRenderDevice(bool recordCommands = true, uint32_t framesInFlight = 2);
+    
+    BufferHandle CreateBuffer(size_t size, const void* data = nullptr) override;
+    void UpdateBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size) override;
+    void DestroyBuffer(BufferHandle buffer) override;
+    
+    // Commands are only recorded, so every format works.
+    bool SupportsTextureFormat(TextureFormat) const override { return true; }
+    
+    TextureHandle CreateTexture(const TextureDesc& desc, const void* pixels) override;
+    void UpdateTexture(TextureHandle texture, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* pixels) override;
+    void DestroyTexture(TextureHandle texture) override;
+    
+    PipelineHandle CreatePipeline(const PipelineDesc& desc) override;
+    void DestroyPipeline(PipelineHandle pipeline) override;
+    
+    SamplerHandle CreateSampler(const SamplerDesc& desc) override;
+    void DestroySampler(SamplerHandle sampler) override;
+    
+    bool BeginFrame(const ClearColor& clearColor) override;
+    
+    void SetPipeline(PipelineHandle pipeline) override;
+    void SetVertexBuffer(BufferHandle buffer, size_t offset, uint32_t index) override;
+    void SetFragmentTexture(TextureHandle texture, uint32_t index) override;
+    void SetFragmentSampler(SamplerHandle sampler, uint32_t index) override;
+    
+    void Draw(PrimitiveType primitive, size_t vertexStart, size_t vertexCount) override;
+    void DrawInstanced(PrimitiveType primitive, size_t vertexStart, size_t vertexCount,
+                       size_t instanceStart, size_t instanceCount) override;
+    void DrawIndexed(PrimitiveType primitive, BufferHandle indexBuffer, IndexType indexType,
+                     size_t indexStart, size_t indexCount) override;
+    
+    void EndFrame() override;
+    
+    // Contents of a buffer as the GPU would see them, or nullptr if the handle is dead.
+    const std::vector<uint8_t>* GetBufferContents(BufferHandle buffer) const;
+    
+    // Every mip level of a texture, as CreateTexture takes them; empty until
+    // it is given pixels, nullptr if the handle is dead.
+    const std::vector<uint8_t>* GetTextureContents(TextureHandle texture) const;
+    
+    inline const std::vector<RenderCommand>& GetCommands() const { return m_Commands; }
+    
+    inline void ClearCommands() { m_Commands.clear(); }
+    
+    inline void SetRecordCommands(bool record) { m_RecordCommands = record; }
+    
+    // Acquiring a frame blocks while every slot is uncompleted, so a test
+    // driving this from one thread must complete frames before that.
+    inline void SetManualCompletion(bool manual) { m_ManualCompletion = manual; }
+    
+    // Finishes the oldest uncompleted frame. False if none is in flight.
+    bool CompleteFrame();
+    
+    inline uint32_t GetUncompletedFrames() const { return m_UncompletedFrames; }
+    
+    // Slot the current or next frame writes, for checking ring offsets.
+    inline uint32_t GetFrameSlot() const { return m_FrameSlot; }
+};
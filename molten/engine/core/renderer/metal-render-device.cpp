@@ -0,0 +1,596 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "metal-render-device.h"
+
+#include <cstring>
+#include <filesystem>
+
+#include <Metal/Metal.hpp>
+#include <QuartzCore/CAMetalLayer.hpp>
+
+#include "../application/window.h"
+#include "../utils/log-macros.h"
+
+static MTL::VertexFormat ToMetal(VertexFormat format)
+{
+    switch (format)
+    {
+        case VertexFormat::Float:  return MTL::VertexFormatFloat;
+        case VertexFormat::Float2: return MTL::VertexFormatFloat2;
+        case VertexFormat::Float3: return MTL::VertexFormatFloat3;
+        case VertexFormat::Float4: return MTL::VertexFormatFloat4;
+        case VertexFormat::UChar4Normalized: return MTL::VertexFormatUChar4Normalized;
+        case VertexFormat::UShort2Normalized: return MTL::VertexFormatUShort2Normalized;
+        case VertexFormat::UShort4Normalized: return MTL::VertexFormatUShort4Normalized;
+        case VertexFormat::Short: return MTL::VertexFormatShort;
+        case VertexFormat::Int: return MTL::VertexFormatInt;
+    }
+    
+    return MTL::VertexFormatInvalid;
+}
+
+static MTL::PixelFormat ToMetal(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::RGBA8Unorm: return MTL::PixelFormatRGBA8Unorm;
+        case TextureFormat::BC1RGBA:    return MTL::PixelFormatBC1_RGBA;
+        case TextureFormat::BC3RGBA:    return MTL::PixelFormatBC3_RGBA;
+    }
+    
+    return MTL::PixelFormatRGBA8Unorm;
+}
+
+static MTL::SamplerMinMagFilter ToMetal(SamplerFilter filter)
+{
+    return filter == SamplerFilter::Nearest ? MTL::SamplerMinMagFilterNearest : MTL::SamplerMinMagFilterLinear;
+}
+
+static MTL::SamplerMipFilter ToMetal(SamplerMipFilter filter)
+{
+    switch (filter)
+    {
+        case SamplerMipFilter::NotMipmapped: return MTL::SamplerMipFilterNotMipmapped;
+        case SamplerMipFilter::Nearest:      return MTL::SamplerMipFilterNearest;
+        case SamplerMipFilter::Linear:       return MTL::SamplerMipFilterLinear;
+    }
+    
+    return MTL::SamplerMipFilterNotMipmapped;
+}
+
+static MTL::SamplerAddressMode ToMetal(SamplerAddressMode mode)
+{
+    return mode == SamplerAddressMode::Repeat ? MTL::SamplerAddressModeRepeat : MTL::SamplerAddressModeClampToEdge;
+}
+
+static MTL::PrimitiveType ToMetal(PrimitiveType primitive)
+{
+    return primitive == PrimitiveType::TriangleStrip ? MTL::PrimitiveTypeTriangleStrip : MTL::PrimitiveTypeTriangle;
+}
+
+MetalRenderDevice::MetalRenderDevice(Window* window, uint32_t framesInFlight)
+: RenderDevice(framesInFlight), m_Window(window)
+{
+    m_Device = MTL::CreateSystemDefaultDevice();
+    if (!m_Device) { CORE_ASSERT(false, "Failed to create Metal device."); return; }
+    
+    if (m_Window && m_Window->GetMetalLayer())
+        m_Window->GetMetalLayer()->setDevice(m_Device);
+    
+    m_DefaultLibrary = m_Device->newDefaultLibrary();
+    if (!m_DefaultLibrary) LOG_CORE_ERROR("Failed to load Metal default library.");
+    
+    m_CommandQueue = m_Device->newCommandQueue();
+    if (!m_CommandQueue) LOG_CORE_ERROR("Failed to create Metal command queue.");
+}
+
+BufferHandle MetalRenderDevice::CreateBuffer(size_t size, const void* data)
+{
+    if (!m_Device || size == 0) return BufferHandle();
+    
+    MTL::Buffer* buffer = data ? m_Device->newBuffer(data, size, MTL::ResourceStorageModeShared)
+                               : m_Device->newBuffer(size, MTL::ResourceStorageModeShared);
+    
+    if (!buffer) { LOG_CORE_ERROR("Failed to create Metal buffer of {} bytes", size); return BufferHandle(); }
+    
+    m_Stats.buffersCreated++;
+    if (data) m_Stats.bytesUploaded += size;
+    
+    return BufferHandle{ m_Buffers.Add(buffer) };
+}
+
+void MetalRenderDevice::UpdateBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size)
+{
+    MTL::Buffer** metalBuffer = m_Buffers.Get(buffer.id);
+    if (!metalBuffer || !data || size == 0) return;
+    
+    if (offset + size > (*metalBuffer)->length())
+    {
+        LOG_CORE_ERROR("Buffer update out of range ({} + {} > {})", offset, size, (*metalBuffer)->length());
+        return;
+    }
+    
+    // Shared storage: the CPU write is the upload.
+    std::memcpy(static_cast<unsigned char*>((*metalBuffer)->contents()) + offset, data, size);
+    
+    m_Stats.bytesUploaded += size;
+}
+
+void MetalRenderDevice::DestroyBuffer(BufferHandle buffer)
+{
+    MTL::Buffer* metalBuffer = nullptr;
+    if (m_Buffers.Remove(buffer.id, &metalBuffer) && metalBuffer) metalBuffer->release();
+}
+
+bool MetalRenderDevice::SupportsTextureFormat(TextureFormat format) const
+{
+    return !IsBlockCompressed(format) || (m_Device && m_Device->supportsBCTextureCompression());
+}
+
+TextureHandle MetalRenderDevice::CreateTexture(const TextureDesc& desc, const void* pixels)
+{
+    if (!m_Device || desc.width == 0 || desc.height == 0 || desc.mipLevelCount == 0) return TextureHandle();
+    
+    if (!SupportsTextureFormat(desc.format))
+    {
+        LOG_CORE_ERROR("Texture format {} is not supported by this GPU", static_cast<int>(desc.format));
+        return TextureHandle();
+    }
+    
+    MTL::TextureDescriptor* textureDescriptor = MTL::TextureDescriptor::alloc()->init();
+    
+    textureDescriptor->setPixelFormat(ToMetal(desc.format));
+    textureDescriptor->setWidth(desc.width);
+    textureDescriptor->setHeight(desc.height);
+    textureDescriptor->setMipmapLevelCount(desc.mipLevelCount);
+
+    MTL::Texture* texture = m_Device->newTexture(textureDescriptor);
+    
+    textureDescriptor->release();
+    
+    if (!texture) { LOG_CORE_ERROR("Failed to create Metal texture {}x{}", desc.width, desc.height); return TextureHandle(); }
+    
+    if (pixels)
+    {
+        auto level = static_cast<const uint8_t*>(pixels);
+        
+        for (uint32_t i = 0; i < desc.mipLevelCount; i++)
+        {
+            uint32_t width = GetMipDimension(desc.width, i);
+            uint32_t height = GetMipDimension(desc.height, i);
+            
+            MTL::Region region = MTL::Region(0, 0, 0, width, height, 1);
+            
+            texture->replaceRegion(region, i, level, GetTextureRowPitch(desc.format, width));
+            
+            level += GetTextureLevelSize(desc.format, width, height);
+        }
+        
+        m_Stats.bytesUploaded += GetTextureSize(desc);
+    }
+    
+    m_Stats.texturesCreated++;
+    
+    return TextureHandle{ m_Textures.Add(texture) };
+}
+
+void MetalRenderDevice::UpdateTexture(TextureHandle texture, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* pixels)
+{
+    MTL::Texture** metalTexture = m_Textures.Get(texture.id);
+    if (!metalTexture || !pixels || width == 0 || height == 0) return;
+    
+    if ((*metalTexture)->pixelFormat() != MTL::PixelFormatRGBA8Unorm)
+    {
+        LOG_CORE_ERROR("Compressed textures can't be updated");
+        return;
+    }
+    
+    uint32_t levelWidth = GetMipDimension(static_cast<uint32_t>((*metalTexture)->width()), level);
+    uint32_t levelHeight = GetMipDimension(static_cast<uint32_t>((*metalTexture)->height()), level);
+    
+    if (level >= (*metalTexture)->mipmapLevelCount() || x + width > levelWidth || y + height > levelHeight)
+    {
+        LOG_CORE_ERROR("Texture update out of range (level {}, {}, {}, {}x{})", level, x, y, width, height);
+        return;
+    }
+    
+    MTL::Region region = MTL::Region(x, y, 0, width, height, 1);
+    NS::UInteger bytesPerRow = 4 * width;
+    
+    (*metalTexture)->replaceRegion(region, level, pixels, bytesPerRow);
+    
+    m_Stats.bytesUploaded += bytesPerRow * height;
+}
+
+void MetalRenderDevice::DestroyTexture(TextureHandle texture)
+{
+    MTL::Texture* metalTexture = nullptr;
+    if (m_Textures.Remove(texture.id, &metalTexture) && metalTexture) metalTexture->release();
+}
+
+PipelineHandle MetalRenderDevice::CreatePipeline(const PipelineDesc& desc)
+{
+    if (!m_Device || !m_DefaultLibrary) return PipelineHandle();
+    
+    auto vertexShader = m_DefaultLibrary->newFunction(NS::String::string(desc.vertexFunction, NS::UTF8StringEncoding));
+    auto fragmentShader = m_DefaultLibrary->newFunction(NS::String::string(desc.fragmentFunction, NS::UTF8StringEncoding));
+
+    if (!vertexShader || !fragmentShader)
+    {
+        LOG_CORE_ERROR("Shader function not found in Metal library.");
+        
+        if (vertexShader) vertexShader->release();
+        if (fragmentShader) fragmentShader->release();
+        return PipelineHandle();
+    }
+
+    MTL::RenderPipelineDescriptor* pipelineDescriptor = MTL::RenderPipelineDescriptor::alloc()->init();
+    
+    if (desc.label) pipelineDescriptor->setLabel(NS::String::string(desc.label, NS::UTF8StringEncoding));
+    
+    pipelineDescriptor->setVertexFunction(vertexShader);
+    pipelineDescriptor->setFragmentFunction(fragmentShader);
+    
+    auto pixelFormat = (MTL::PixelFormat)m_Window->GetMetalLayer()->pixelFormat();
+    
+    MTL::RenderPipelineColorAttachmentDescriptor* colorAttachment = pipelineDescriptor->colorAttachments()->object(0);
+    colorAttachment->setPixelFormat(pixelFormat);
+    
+    if (desc.blendMode != BlendMode::Opaque)
+    {
+        bool additive = desc.blendMode == BlendMode::Additive;
+        
+        colorAttachment->setBlendingEnabled(true);
+        colorAttachment->setRgbBlendOperation(MTL::BlendOperationAdd);
+        colorAttachment->setAlphaBlendOperation(MTL::BlendOperationAdd);
+        colorAttachment->setSourceRGBBlendFactor(MTL::BlendFactorSourceAlpha);
+        colorAttachment->setDestinationRGBBlendFactor(additive ? MTL::BlendFactorOne : MTL::BlendFactorOneMinusSourceAlpha);
+        colorAttachment->setSourceAlphaBlendFactor(MTL::BlendFactorOne);
+        colorAttachment->setDestinationAlphaBlendFactor(additive ? MTL::BlendFactorOne : MTL::BlendFactorOneMinusSourceAlpha);
+    }
+    
+    auto vertexDescriptor = MTL::VertexDescriptor::alloc()->init();
+    
+    for (uint32_t i = 0; i < desc.vertexLayout.attributeCount; i++)
+    {
+        const VertexAttributeDesc& attribute = desc.vertexLayout.attributes[i];
+        
+        vertexDescriptor->attributes()->object(i)->setFormat(ToMetal(attribute.format));
+        vertexDescriptor->attributes()->object(i)->setOffset(attribute.offset);
+        vertexDescriptor->attributes()->object(i)->setBufferIndex(attribute.bufferIndex);
+    }
+
+    vertexDescriptor->layouts()->object(0)->setStride(desc.vertexLayout.stride);
+    vertexDescriptor->layouts()->object(0)->setStepFunction(desc.vertexLayout.stepFunction == VertexStepFunction::PerInstance
+                                                            ? MTL::VertexStepFunctionPerInstance
+                                                            : MTL::VertexStepFunctionPerVertex);
+    vertexDescriptor->layouts()->object(0)->setStepRate(1);
+
+    pipelineDescriptor->setVertexDescriptor(vertexDescriptor);
+
+    vertexDescriptor->release();
+
+    // Metal looks the functions up in the archive before compiling them.
+    if (m_PipelineArchive) pipelineDescriptor->setBinaryArchives(NS::Array::array(m_PipelineArchive));
+
+    NS::Error* error = nullptr;
+    MTL::RenderPipelineState* pipeline = m_Device->newRenderPipelineState(pipelineDescriptor, &error);
+    
+    if (pipeline && m_PipelineArchive)
+    {
+        NS::Error* archiveError = nullptr;
+        
+        if (m_PipelineArchive->addRenderPipelineFunctions(pipelineDescriptor, &archiveError)) m_PipelineArchiveDirty = true;
+        else LOG_CORE_WARN("Could not add pipeline to cache: {}", archiveError ? archiveError->localizedDescription()->utf8String() : "unknown error");
+    }
+
+    pipelineDescriptor->release();
+    vertexShader->release();
+    fragmentShader->release();
+
+    if (!pipeline)
+    {
+        LOG_CORE_ERROR("Failed to create Render Pipeline State: {}", error ? error->localizedDescription()->utf8String() : "unknown error");
+        return PipelineHandle();
+    }
+    
+    m_Stats.pipelinesCreated++;
+    
+    return PipelineHandle{ m_Pipelines.Add(pipeline) };
+}
+
+void MetalRenderDevice::DestroyPipeline(PipelineHandle pipeline)
+{
+    MTL::RenderPipelineState* metalPipeline = nullptr;
+    if (m_Pipelines.Remove(pipeline.id, &metalPipeline) && metalPipeline) metalPipeline->release();
+}
+
+SamplerHandle MetalRenderDevice::CreateSampler(const SamplerDesc& desc)
+{
+    if (!m_Device) return SamplerHandle();
+    
+    MTL::SamplerDescriptor* samplerDesc = MTL::SamplerDescriptor::alloc()->init();
+    
+    samplerDesc->setMinFilter(ToMetal(desc.minFilter));
+    samplerDesc->setMagFilter(ToMetal(desc.magFilter));
+    samplerDesc->setMipFilter(ToMetal(desc.mipFilter));
+    samplerDesc->setSAddressMode(ToMetal(desc.addressModeS));
+    samplerDesc->setTAddressMode(ToMetal(desc.addressModeT));
+    
+    MTL::SamplerState* sampler = m_Device->newSamplerState(samplerDesc);
+    
+    samplerDesc->release();
+
+    if (!sampler) { LOG_CORE_ERROR("Failed to create Metal sampler state."); return SamplerHandle(); }
+    
+    m_Stats.samplersCreated++;
+    
+    return SamplerHandle{ m_Samplers.Add(sampler) };
+}
+
+void MetalRenderDevice::DestroySampler(SamplerHandle sampler)
+{
+    MTL::SamplerState* metalSampler = nullptr;
+    if (m_Samplers.Remove(sampler.id, &metalSampler) && metalSampler) metalSampler->release();
+}
+
+bool MetalRenderDevice::OpenPipelineCache(const char* path)
+{
+    if (!m_Device || !path || *path == '\0') return false;
+    
+    if (m_PipelineArchive) { m_PipelineArchive->release(); m_PipelineArchive = nullptr; }
+    
+    m_PipelineCachePath = path;
+    m_PipelineArchiveDirty = false;
+    
+    std::error_code fsError;
+    bool exists = std::filesystem::exists(m_PipelineCachePath, fsError);
+    
+    MTL::BinaryArchiveDescriptor* descriptor = MTL::BinaryArchiveDescriptor::alloc()->init();
+    
+    if (exists) descriptor->setUrl(NS::URL::fileURLWithPath(NS::String::string(path, NS::UTF8StringEncoding)));
+    
+    NS::Error* error = nullptr;
+    m_PipelineArchive = m_Device->newBinaryArchive(descriptor, &error);
+    
+    // An archive from another OS or GPU can't be read; start a fresh one.
+    if (!m_PipelineArchive && exists)
+    {
+        LOG_CORE_WARN("Discarding unreadable pipeline cache {}: {}", path, error ? error->localizedDescription()->utf8String() : "unknown error");
+        
+        descriptor->setUrl(nullptr);
+        error = nullptr;
+        m_PipelineArchive = m_Device->newBinaryArchive(descriptor, &error);
+    }
+    
+    descriptor->release();
+    
+    if (!m_PipelineArchive)
+    {
+        LOG_CORE_WARN("Pipeline cache unavailable: {}", error ? error->localizedDescription()->utf8String() : "unknown error");
+        return false;
+    }
+    
+    return exists;
+}
+
+bool MetalRenderDevice::SavePipelineCache()
+{
+    if (!m_PipelineArchive || !m_PipelineArchiveDirty) return false;
+    
+    std::error_code fsError;
+    std::filesystem::create_directories(std::filesystem::path(m_PipelineCachePath).parent_path(), fsError);
+    
+    NS::Error* error = nullptr;
+    NS::URL* url = NS::URL::fileURLWithPath(NS::String::string(m_PipelineCachePath.c_str(), NS::UTF8StringEncoding));
+    
+    if (!m_PipelineArchive->serializeToURL(url, &error))
+    {
+        LOG_CORE_WARN("Failed to save pipeline cache {}: {}", m_PipelineCachePath, error ? error->localizedDescription()->utf8String() : "unknown error");
+        return false;
+    }
+    
+    m_PipelineArchiveDirty = false;
+    
+    return true;
+}
+
+bool MetalRenderDevice::BeginFrame(const ClearColor& clearColor)
+{
+    if (!m_CommandQueue)
+    {
+        LOG_CORE_ERROR("Cannot begin frame: CommandQueue not ready.");
+        return false;
+    }
+    
+    // Blocks only while every per-frame slot is still in use by the GPU.
+    AcquireFrame();
+    
+    m_Drawable = m_Window->GetMetalLayer()->nextDrawable();
+    if (!m_Drawable)
+    {
+        LOG_CORE_WARN("Metal drawable is null. Possibly invalid layer size or window not ready.");
+        CancelFrame();
+        return false;
+    }
+
+    m_CommandBuffer = m_CommandQueue->commandBuffer();
+
+    MTL::RenderPassDescriptor* renderPassDescriptor = MTL::RenderPassDescriptor::alloc()->init();
+
+    auto colorAttachment = renderPassDescriptor->colorAttachments()->object(0);
+    
+    colorAttachment->setTexture(m_Drawable->texture());
+    colorAttachment->setLoadAction(MTL::LoadActionClear);
+    colorAttachment->setClearColor(MTL::ClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a));
+    colorAttachment->setStoreAction(MTL::StoreActionStore);
+
+    m_Encoder = m_CommandBuffer->renderCommandEncoder(renderPassDescriptor);
+    
+    renderPassDescriptor->release();
+    
+    ResetBindings();
+    
+    if (!m_Encoder)
+    {
+        m_CommandBuffer = nullptr;
+        m_Drawable = nullptr;
+        CancelFrame();
+        return false;
+    }
+    
+    return true;
+}
+
+void MetalRenderDevice::SetPipeline(PipelineHandle pipeline)
+{
+    if (!m_Encoder || pipeline == m_BoundPipeline) return;
+    
+    MTL::RenderPipelineState** metalPipeline = m_Pipelines.Get(pipeline.id);
+    if (!metalPipeline) return;
+    
+    m_Encoder->setRenderPipelineState(*metalPipeline);
+    
+    m_BoundPipeline = pipeline;
+    m_Stats.pipelineChanges++;
+}
+
+void MetalRenderDevice::SetVertexBuffer(BufferHandle buffer, size_t offset, uint32_t index)
+{
+    if (!m_Encoder || index >= MaxBindSlots) return;
+    
+    if (buffer == m_BoundVertexBuffers[index] && offset == m_BoundVertexOffsets[index]) return;
+    
+    MTL::Buffer** metalBuffer = m_Buffers.Get(buffer.id);
+    
+    if (buffer == m_BoundVertexBuffers[index] && metalBuffer) m_Encoder->setVertexBufferOffset(offset, index);
+    
+    else m_Encoder->setVertexBuffer(metalBuffer ? *metalBuffer : nullptr, offset, index);
+    
+    m_BoundVertexBuffers[index] = buffer;
+    m_BoundVertexOffsets[index] = offset;
+    m_Stats.bufferBindChanges++;
+}
+
+void MetalRenderDevice::SetFragmentTexture(TextureHandle texture, uint32_t index)
+{
+    if (!m_Encoder || index >= MaxBindSlots || texture == m_BoundTextures[index]) return;
+    
+    MTL::Texture** metalTexture = m_Textures.Get(texture.id);
+    
+    m_Encoder->setFragmentTexture(metalTexture ? *metalTexture : nullptr, index);
+    
+    m_BoundTextures[index] = texture;
+    m_Stats.textureBindChanges++;
+}
+
+void MetalRenderDevice::SetFragmentSampler(SamplerHandle sampler, uint32_t index)
+{
+    if (!m_Encoder || index >= MaxBindSlots || sampler == m_BoundSamplers[index]) return;
+    
+    MTL::SamplerState** metalSampler = m_Samplers.Get(sampler.id);
+    
+    m_Encoder->setFragmentSamplerState(metalSampler ? *metalSampler : nullptr, index);
+    
+    m_BoundSamplers[index] = sampler;
+    m_Stats.samplerBindChanges++;
+}
+
+void MetalRenderDevice::Draw(PrimitiveType primitive, size_t vertexStart, size_t vertexCount)
+{
+    if (!m_Encoder || vertexCount == 0) return;
+    
+    m_Encoder->drawPrimitives(ToMetal(primitive), vertexStart, vertexCount);
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += vertexCount;
+}
+
+void MetalRenderDevice::DrawInstanced(PrimitiveType primitive, size_t vertexStart, size_t vertexCount,
+                                      size_t instanceStart, size_t instanceCount)
+{
+    if (!m_Encoder || vertexCount == 0 || instanceCount == 0) return;
+    
+    // Per-instance attributes are fetched from baseInstance onwards.
+    m_Encoder->drawPrimitives(ToMetal(primitive), vertexStart, vertexCount, instanceCount, instanceStart);
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += vertexCount * instanceCount;
+    m_Stats.instancesDrawn += instanceCount;
+}
+
+void MetalRenderDevice::DrawIndexed(PrimitiveType primitive, BufferHandle indexBuffer, IndexType indexType,
+                                    size_t indexStart, size_t indexCount)
+{
+    MTL::Buffer** metalBuffer = m_Buffers.Get(indexBuffer.id);
+    if (!m_Encoder || !metalBuffer || indexCount == 0) return;
+    
+    bool wide = indexType == IndexType::UInt32;
+    size_t offset = indexStart * (wide ? sizeof(uint32_t) : sizeof(uint16_t));
+    
+    m_Encoder->drawIndexedPrimitives(ToMetal(primitive), indexCount, wide ? MTL::IndexTypeUInt32 : MTL::IndexTypeUInt16,
+                                     *metalBuffer, offset);
+    
+    m_Stats.drawCalls++;
+    m_Stats.verticesDrawn += indexCount;
+}
+
+void MetalRenderDevice::EndFrame()
+{
+    if (!m_Encoder) return;
+    
+    m_Encoder->endEncoding();
+    m_Encoder = nullptr;
+
+    m_CommandBuffer->presentDrawable(m_Drawable);
+    
+    // The GPU releases this frame's slot when it's done, instead of the CPU
+    // waiting here; the next frame only blocks if every slot is still busy.
+    FrameSync* frameSync = &m_FrameSync;
+    m_CommandBuffer->addCompletedHandler([frameSync](MTL::CommandBuffer*) { frameSync->Signal(); });
+    
+    m_CommandBuffer->commit();
+    
+    m_FrameAcquired = false;
+    
+    m_CommandBuffer = nullptr;
+    m_Drawable = nullptr;
+    
+    m_Stats.frames++;
+}
+
+MetalRenderDevice::~MetalRenderDevice()
+{
+    // Completion handlers still pending would signal a destroyed FrameSync.
+    WaitIdle();
+    
+    m_Buffers.ForEach([](MTL::Buffer* buffer) { if (buffer) buffer->release(); });
+    m_Textures.ForEach([](MTL::Texture* texture) { if (texture) texture->release(); });
+    m_Pipelines.ForEach([](MTL::RenderPipelineState* pipeline) { if (pipeline) pipeline->release(); });
+    m_Samplers.ForEach([](MTL::SamplerState* sampler) { if (sampler) sampler->release(); });
+    
+    if (m_PipelineArchive) { m_PipelineArchive->release(); m_PipelineArchive = nullptr; }
+    if (m_CommandQueue) { m_CommandQueue->release(); m_CommandQueue = nullptr; }
+    if (m_DefaultLibrary) { m_DefaultLibrary->release(); m_DefaultLibrary = nullptr; }
+    if (m_Device) { m_Device->release(); m_Device = nullptr; }
+}
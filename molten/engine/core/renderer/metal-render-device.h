@@ -0,0 +1,117 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+
+#include "render-device.h"
+#include "resource-pool.h"
+
+namespace MTL
+{
+    class Device;
+    class Library;
+    class CommandQueue;
+    class CommandBuffer;
+    class RenderCommandEncoder;
+    class RenderPipelineState;
+    class SamplerState;
+    class Buffer;
+    class Texture;
+    class BinaryArchive;
+}
+
+namespace CA
+{
+    class MetalDrawable;
+}
+
+class Window;
+
+// RenderDevice backed by metal-cpp, presenting into the window's CAMetalLayer.
+class MetalRenderDevice : public RenderDevice
+{
+private:
+    
+    Window* m_Window = nullptr;
+    
+    MTL::Device* m_Device = nullptr;
+    MTL::Library* m_DefaultLibrary = nullptr;
+    MTL::CommandQueue* m_CommandQueue = nullptr;
+    
+    CA::MetalDrawable* m_Drawable = nullptr;
+    MTL::CommandBuffer* m_CommandBuffer = nullptr;
+    MTL::RenderCommandEncoder* m_Encoder = nullptr;
+    
+    ResourcePool<MTL::Buffer*> m_Buffers;
+    ResourcePool<MTL::Texture*> m_Textures;
+    ResourcePool<MTL::RenderPipelineState*> m_Pipelines;
+    ResourcePool<MTL::SamplerState*> m_Samplers;
+    
+    // Compiled pipeline functions, loaded from and saved to m_PipelineCachePath.
+    MTL::BinaryArchive* m_PipelineArchive = nullptr;
+    std::string m_PipelineCachePath;
+    bool m_PipelineArchiveDirty = false;
+    
+public:
+    
+    explicit MetalRenderDevice(Window* window, uint32_t framesInFlight = FrameSync::MaxFramesInFlight);
+    
+    BufferHandle CreateBuffer(size_t size, const void* data = nullptr) override;
+    void UpdateBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size) override;
+    void DestroyBuffer(BufferHandle buffer) override;
+    
+    bool SupportsTextureFormat(TextureFormat format) const override;
+    
+    TextureHandle CreateTexture(const TextureDesc& desc, const void* pixels) override;
+    void UpdateTexture(TextureHandle texture, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* pixels) override;
+    void DestroyTexture(TextureHandle texture) override;
+    
+    PipelineHandle CreatePipeline(const PipelineDesc& desc) override;
+    void DestroyPipeline(PipelineHandle pipeline) override;
+    
+    SamplerHandle CreateSampler(const SamplerDesc& desc) override;
+    void DestroySampler(SamplerHandle sampler) override;
+    
+    bool OpenPipelineCache(const char* path) override;
+    bool SavePipelineCache() override;
+    
+    bool BeginFrame(const ClearColor& clearColor) override;
+    
+    void SetPipeline(PipelineHandle pipeline) override;
+    void SetVertexBuffer(BufferHandle buffer, size_t offset, uint32_t index) override;
+    void SetFragmentTexture(TextureHandle texture, uint32_t index) override;
+    void SetFragmentSampler(SamplerHandle sampler, uint32_t index) override;
+    
+    void Draw(PrimitiveType primitive, size_t vertexStart, size_t vertexCount) override;
+    void DrawInstanced(PrimitiveType primitive, size_t vertexStart, size_t vertexCount,
+                       size_t instanceStart, size_t instanceCount) override;
+    void DrawIndexed(PrimitiveType primitive, BufferHandle indexBuffer, IndexType indexType,
+                     size_t indexStart, size_t indexCount) override;
+    
+    void EndFrame() override;
+    
+    inline MTL::Device* GetMetalDevice() const { return m_Device; }
+    
+    ~MetalRenderDevice() override;
+};
@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// AVX2 path of the quad kernel. Everything after the target pragma is
+// compiled for AVX2, so QuadKernel only calls in here after checking the CPU.
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#include "quad-kernel.h"
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "quad-kernel-lanes.h"
+
+namespace
+{
+    struct AVX2Lanes
+    {
+        static constexpr size_t Width = 8;
+        
+        __m256 v;
+        
+        static AVX2Lanes Load(const float* p) { return { _mm256_loadu_ps(p) }; }
+        static AVX2Lanes Set(float x) { return { _mm256_set1_ps(x) }; }
+        static AVX2Lanes Zero() { return { _mm256_setzero_ps() }; }
+        
+        void Store(float* p) const { _mm256_store_ps(p, v); }
+        
+        AVX2Lanes operator+(AVX2Lanes o) const { return { _mm256_add_ps(v, o.v) }; }
+        AVX2Lanes operator-(AVX2Lanes o) const { return { _mm256_sub_ps(v, o.v) }; }
+        AVX2Lanes operator*(AVX2Lanes o) const { return { _mm256_mul_ps(v, o.v) }; }
+        
+        static AVX2Lanes Round(AVX2Lanes x) { return { _mm256_round_ps(x.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+        
+        static AVX2Lanes SelectBit(AVX2Lanes q, int bit, AVX2Lanes a, AVX2Lanes b)
+        {
+            __m256i bits = _mm256_set1_epi32(bit);
+            __m256 mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_cvttps_epi32(q.v), bits), bits));
+            return { _mm256_blendv_ps(b.v, a.v, mask) };
+        }
+        
+        static bool AllZero(AVX2Lanes x) { return _mm256_movemask_ps(_mm256_cmp_ps(x.v, _mm256_setzero_ps(), _CMP_EQ_OQ)) == 0xFF; }
+    };
+}
+
+void ExpandQuadsAVX2(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices)
+{
+    ExpandQuads<AVX2Lanes>(sprites, count, vertices);
+}
+
+void ExpandPackedQuadsAVX2(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices)
+{
+    ExpandQuads<AVX2Lanes>(sprites, count, vertices);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,221 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Path-independent part of the quad kernel. Each translation unit that
+// implements a path includes this after defining its lane type, so it lives
+// in an unnamed namespace: code compiled for AVX2 must never be picked by the
+// linker for a call made on the scalar or SSE path.
+//
+// A lane type V provides Width, Load, Set, Zero, Store, +, -, *, Round (to
+// nearest even), SelectBit(q, bit, a, b) (a where integer q has the bit set,
+// else b) and AllZero.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "quad-kernel.h"
+
+namespace
+{
+    // Cephes-style sine and cosine: reduce to [-pi/4, pi/4] around the nearest
+    // multiple of pi/2, then pick and negate by quadrant. Accurate to about
+    // 1e-7 for the angles sprites use (|x| below a few thousand radians).
+    template <typename V>
+    inline void QuadSinCos(V x, V& sinOut, V& cosOut)
+    {
+        V q = V::Round(x * V::Set(0.636619772367581f));
+        
+        V r = x - q * V::Set(1.5703125f);
+        r = r - q * V::Set(4.837512969970703125e-4f);
+        r = r - q * V::Set(7.54978995489188216e-8f);
+        
+        V r2 = r * r;
+        
+        V s = r + r * r2 * (V::Set(-1.6666654611e-1f) + r2 * (V::Set(8.3321608736e-3f) + r2 * V::Set(-1.9515295891e-4f)));
+        V c = V::Set(1.0f) - r2 * V::Set(0.5f) +
+              r2 * r2 * (V::Set(4.166664568298827e-2f) + r2 * (V::Set(-1.388731625493765e-3f) + r2 * V::Set(2.443315711809948e-5f)));
+        
+        // Odd quadrants swap sine and cosine; quadrants 2 and 3 negate the
+        // sine, 1 and 2 the cosine.
+        V sinBase = V::SelectBit(q, 1, c, s);
+        V cosBase = V::SelectBit(q, 1, s, c);
+        
+        sinOut = V::SelectBit(q, 2, V::Zero() - sinBase, sinBase);
+        cosOut = V::SelectBit(q + V::Set(1.0f), 2, V::Zero() - cosBase, cosBase);
+    }
+    
+    // Corners are ordered (-,-), (-,+), (+,+), (+,-); the two triangles reuse
+    // the first and third.
+    inline void WriteQuad(VertexData2D* vertices, size_t sprite, const float cornerX[4], const float cornerY[4],
+                          const Vec4& color, const Vec4& uvRect, int32_t textureIndex)
+    {
+        static constexpr int CornerOrder[6] = { 0, 1, 2, 0, 2, 3 };
+        
+        const Vec2 texCoords[4] =
+        {
+            { uvRect.x, uvRect.y },
+            { uvRect.x, uvRect.w },
+            { uvRect.z, uvRect.w },
+            { uvRect.z, uvRect.y },
+        };
+        
+        vertices += sprite * QuadKernel::VerticesPerQuad;
+        
+        for (int i = 0; i < 6; i++)
+        {
+            const int corner = CornerOrder[i];
+            
+            vertices[i].position = Vec3{ cornerX[corner], cornerY[corner], 0.0f };
+            vertices[i].texCoord = texCoords[corner];
+            vertices[i].color = color;
+            vertices[i].textureIndex = static_cast<float>(textureIndex);
+        }
+    }
+    
+    // Indexed variant: one vertex per corner in the same order, the shared
+    // index buffer forms the triangles.
+    inline void WriteQuad(PackedVertexData2D* vertices, size_t sprite, const float cornerX[4], const float cornerY[4],
+                          const Vec4& color, const Vec4& uvRect, int32_t textureIndex)
+    {
+        const uint16_t u0 = PackUnorm16(uvRect.x);
+        const uint16_t v0 = PackUnorm16(uvRect.y);
+        const uint16_t u1 = PackUnorm16(uvRect.z);
+        const uint16_t v1 = PackUnorm16(uvRect.w);
+        
+        const uint16_t texCoords[4][2] = { { u0, v0 }, { u0, v1 }, { u1, v1 }, { u1, v0 } };
+        
+        const uint8_t packedColor[4] = { PackUnorm8(color.x), PackUnorm8(color.y), PackUnorm8(color.z), PackUnorm8(color.w) };
+        
+        vertices += sprite * QuadKernel::PackedVerticesPerQuad;
+        
+        for (int corner = 0; corner < 4; corner++)
+        {
+            PackedVertexData2D& vertex = vertices[corner];
+            
+            vertex.position[0] = cornerX[corner];
+            vertex.position[1] = cornerY[corner];
+            vertex.texCoord[0] = texCoords[corner][0];
+            vertex.texCoord[1] = texCoords[corner][1];
+            
+            for (int c = 0; c < 4; c++) vertex.color[c] = packedColor[c];
+            
+            vertex.textureIndex = static_cast<int16_t>(textureIndex);
+            vertex.padding = 0;
+        }
+    }
+    
+    template <typename V, typename Vertex>
+    inline void ExpandQuadBlock(const QuadKernelInput& in, size_t first, Vertex* vertices)
+    {
+        constexpr size_t W = V::Width;
+        
+        V rotation = V::Load(in.rotation + first);
+        V sinAngle, cosAngle;
+        
+        // Most sprites are never rotated, which makes the trig free.
+        if (V::AllZero(rotation))
+        {
+            sinAngle = V::Zero();
+            cosAngle = V::Set(1.0f);
+        }
+        else
+        {
+            QuadSinCos(rotation, sinAngle, cosAngle);
+        }
+        
+        V halfX = V::Load(in.sizeX + first) * V::Set(0.5f);
+        V halfY = V::Load(in.sizeY + first) * V::Set(0.5f);
+        
+        // Half-extent axes of the rotated quad.
+        V axisAX = halfX * cosAngle;
+        V axisAY = halfX * sinAngle;
+        V axisBX = V::Zero() - halfY * sinAngle;
+        V axisBY = halfY * cosAngle;
+        
+        V positionX = V::Load(in.positionX + first);
+        V positionY = V::Load(in.positionY + first);
+        
+        alignas(32) float cornerX[4][W];
+        alignas(32) float cornerY[4][W];
+        
+        (positionX - axisAX - axisBX).Store(cornerX[0]);
+        (positionY - axisAY - axisBY).Store(cornerY[0]);
+        (positionX - axisAX + axisBX).Store(cornerX[1]);
+        (positionY - axisAY + axisBY).Store(cornerY[1]);
+        (positionX + axisAX + axisBX).Store(cornerX[2]);
+        (positionY + axisAY + axisBY).Store(cornerY[2]);
+        (positionX + axisAX - axisBX).Store(cornerX[3]);
+        (positionY + axisAY - axisBY).Store(cornerY[3]);
+        
+        for (size_t lane = 0; lane < W; lane++)
+        {
+            const size_t sprite = first + lane;
+            
+            const float laneX[4] = { cornerX[0][lane], cornerX[1][lane], cornerX[2][lane], cornerX[3][lane] };
+            const float laneY[4] = { cornerY[0][lane], cornerY[1][lane], cornerY[2][lane], cornerY[3][lane] };
+            
+            WriteQuad(vertices, sprite, laneX, laneY, in.color[sprite], in.uvRect[sprite], in.textureIndex[sprite]);
+        }
+    }
+    
+    // One sprite per lane, used for the tail of every path.
+    struct ScalarLanes
+    {
+        static constexpr size_t Width = 1;
+        
+        float v;
+        
+        static ScalarLanes Load(const float* p) { return { *p }; }
+        static ScalarLanes Set(float x) { return { x }; }
+        static ScalarLanes Zero() { return { 0.0f }; }
+        
+        void Store(float* p) const { *p = v; }
+        
+        ScalarLanes operator+(ScalarLanes o) const { return { v + o.v }; }
+        ScalarLanes operator-(ScalarLanes o) const { return { v - o.v }; }
+        ScalarLanes operator*(ScalarLanes o) const { return { v * o.v }; }
+        
+        static ScalarLanes Round(ScalarLanes x) { return { std::nearbyint(x.v) }; }
+        
+        static ScalarLanes SelectBit(ScalarLanes q, int bit, ScalarLanes a, ScalarLanes b)
+        {
+            return (static_cast<int32_t>(q.v) & bit) ? a : b;
+        }
+        
+        static bool AllZero(ScalarLanes x) { return x.v == 0.0f; }
+    };
+    
+    template <typename V, typename Vertex>
+    inline void ExpandQuads(const QuadKernelInput& in, size_t count, Vertex* vertices)
+    {
+        size_t i = 0;
+        
+        for (; i + V::Width <= count; i += V::Width)
+            ExpandQuadBlock<V>(in, i, vertices);
+        
+        for (; i < count; i++)
+            ExpandQuadBlock<ScalarLanes>(in, i, vertices);
+    }
+}
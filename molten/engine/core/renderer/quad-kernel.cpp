@@ -0,0 +1,276 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "quad-kernel.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define MOLTEN_QUAD_KERNEL_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MOLTEN_QUAD_KERNEL_NEON 1
+#endif
+
+#include "quad-kernel-lanes.h"
+
+#if MOLTEN_QUAD_KERNEL_X86
+// Lives in its own file so only that file is compiled for AVX2.
+void ExpandQuadsAVX2(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices);
+void ExpandPackedQuadsAVX2(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices);
+#endif
+
+namespace
+{
+#if MOLTEN_QUAD_KERNEL_X86
+    struct SSELanes
+    {
+        static constexpr size_t Width = 4;
+        
+        __m128 v;
+        
+        static SSELanes Load(const float* p) { return { _mm_loadu_ps(p) }; }
+        static SSELanes Set(float x) { return { _mm_set1_ps(x) }; }
+        static SSELanes Zero() { return { _mm_setzero_ps() }; }
+        
+        void Store(float* p) const { _mm_store_ps(p, v); }
+        
+        SSELanes operator+(SSELanes o) const { return { _mm_add_ps(v, o.v) }; }
+        SSELanes operator-(SSELanes o) const { return { _mm_sub_ps(v, o.v) }; }
+        SSELanes operator*(SSELanes o) const { return { _mm_mul_ps(v, o.v) }; }
+        
+        // cvtps rounds to nearest even under the default MXCSR mode.
+        static SSELanes Round(SSELanes x) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(x.v)) }; }
+        
+        static SSELanes SelectBit(SSELanes q, int bit, SSELanes a, SSELanes b)
+        {
+            __m128i bits = _mm_set1_epi32(bit);
+            __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_cvttps_epi32(q.v), bits), bits));
+            return { _mm_or_ps(_mm_and_ps(mask, a.v), _mm_andnot_ps(mask, b.v)) };
+        }
+        
+        static bool AllZero(SSELanes x) { return _mm_movemask_ps(_mm_cmpeq_ps(x.v, _mm_setzero_ps())) == 0xF; }
+    };
+#endif
+    
+#if MOLTEN_QUAD_KERNEL_NEON
+    struct NEONLanes
+    {
+        static constexpr size_t Width = 4;
+        
+        float32x4_t v;
+        
+        static NEONLanes Load(const float* p) { return { vld1q_f32(p) }; }
+        static NEONLanes Set(float x) { return { vdupq_n_f32(x) }; }
+        static NEONLanes Zero() { return { vdupq_n_f32(0.0f) }; }
+        
+        void Store(float* p) const { vst1q_f32(p, v); }
+        
+        NEONLanes operator+(NEONLanes o) const { return { vaddq_f32(v, o.v) }; }
+        NEONLanes operator-(NEONLanes o) const { return { vsubq_f32(v, o.v) }; }
+        NEONLanes operator*(NEONLanes o) const { return { vmulq_f32(v, o.v) }; }
+        
+        static NEONLanes Round(NEONLanes x) { return { vrndnq_f32(x.v) }; }
+        
+        static NEONLanes SelectBit(NEONLanes q, int bit, NEONLanes a, NEONLanes b)
+        {
+            uint32x4_t mask = vtstq_s32(vcvtq_s32_f32(q.v), vdupq_n_s32(bit));
+            return { vbslq_f32(mask, a.v, b.v) };
+        }
+        
+        static bool AllZero(NEONLanes x) { return vminvq_u32(vceqzq_f32(x.v)) == 0xFFFFFFFFu; }
+    };
+#endif
+    
+    void ExpandQuadsScalar(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices)
+    {
+        ExpandQuads<ScalarLanes>(sprites, count, vertices);
+    }
+    
+    void ExpandPackedQuadsScalar(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices)
+    {
+        ExpandQuads<ScalarLanes>(sprites, count, vertices);
+    }
+    
+#if MOLTEN_QUAD_KERNEL_X86
+    void ExpandQuadsSSE(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices)
+    {
+        ExpandQuads<SSELanes>(sprites, count, vertices);
+    }
+    
+    void ExpandPackedQuadsSSE(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices)
+    {
+        ExpandQuads<SSELanes>(sprites, count, vertices);
+    }
+#endif
+    
+#if MOLTEN_QUAD_KERNEL_NEON
+    void ExpandQuadsNEON(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices)
+    {
+        ExpandQuads<NEONLanes>(sprites, count, vertices);
+    }
+    
+    void ExpandPackedQuadsNEON(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices)
+    {
+        ExpandQuads<NEONLanes>(sprites, count, vertices);
+    }
+#endif
+}
+
+std::atomic<QuadKernel::ExpandFunction> QuadKernel::s_Expand = nullptr;
+std::atomic<QuadKernel::ExpandPackedFunction> QuadKernel::s_ExpandPacked = nullptr;
+std::atomic<QuadKernelPath> QuadKernel::s_Path = QuadKernelPath::Scalar;
+
+bool QuadKernel::IsSupported(QuadKernelPath path)
+{
+    switch (path)
+    {
+        case QuadKernelPath::Scalar:
+            return true;
+            
+#if MOLTEN_QUAD_KERNEL_X86
+        case QuadKernelPath::SSE:
+            return true;
+            
+        case QuadKernelPath::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+            
+#if MOLTEN_QUAD_KERNEL_NEON
+        case QuadKernelPath::NEON:
+            return true;
+#endif
+            
+        default:
+            return false;
+    }
+}
+
+QuadKernelPath QuadKernel::GetBestPath()
+{
+    if (IsSupported(QuadKernelPath::AVX2)) return QuadKernelPath::AVX2;
+    if (IsSupported(QuadKernelPath::NEON)) return QuadKernelPath::NEON;
+    if (IsSupported(QuadKernelPath::SSE)) return QuadKernelPath::SSE;
+    
+    return QuadKernelPath::Scalar;
+}
+
+QuadKernel::ExpandFunction QuadKernel::GetFunction(QuadKernelPath path)
+{
+    switch (path)
+    {
+#if MOLTEN_QUAD_KERNEL_X86
+        case QuadKernelPath::SSE: return ExpandQuadsSSE;
+        case QuadKernelPath::AVX2: return ExpandQuadsAVX2;
+#endif
+            
+#if MOLTEN_QUAD_KERNEL_NEON
+        case QuadKernelPath::NEON: return ExpandQuadsNEON;
+#endif
+            
+        default: return ExpandQuadsScalar;
+    }
+}
+
+QuadKernel::ExpandPackedFunction QuadKernel::GetPackedFunction(QuadKernelPath path)
+{
+    switch (path)
+    {
+#if MOLTEN_QUAD_KERNEL_X86
+        case QuadKernelPath::SSE: return ExpandPackedQuadsSSE;
+        case QuadKernelPath::AVX2: return ExpandPackedQuadsAVX2;
+#endif
+            
+#if MOLTEN_QUAD_KERNEL_NEON
+        case QuadKernelPath::NEON: return ExpandPackedQuadsNEON;
+#endif
+            
+        default: return ExpandPackedQuadsScalar;
+    }
+}
+
+bool QuadKernel::SetPath(QuadKernelPath path)
+{
+    if (!IsSupported(path)) return false;
+    
+    s_Path = path;
+    s_ExpandPacked = GetPackedFunction(path);
+    s_Expand = GetFunction(path);
+    
+    return true;
+}
+
+QuadKernelPath QuadKernel::GetPath()
+{
+    if (!s_Expand.load(std::memory_order_acquire)) SetPath(GetBestPath());
+    
+    return s_Path;
+}
+
+const char* QuadKernel::GetPathName(QuadKernelPath path)
+{
+    switch (path)
+    {
+        case QuadKernelPath::Scalar: return "Scalar";
+        case QuadKernelPath::SSE: return "SSE";
+        case QuadKernelPath::AVX2: return "AVX2";
+        case QuadKernelPath::NEON: return "NEON";
+    }
+    
+    return "Unknown";
+}
+
+void QuadKernel::Expand(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices)
+{
+    ExpandFunction expand = s_Expand.load(std::memory_order_acquire);
+    
+    // Racing first calls all store the same function, so no lock is needed.
+    if (!expand)
+    {
+        SetPath(GetBestPath());
+        expand = s_Expand.load(std::memory_order_acquire);
+    }
+    
+    expand(sprites, count, vertices);
+}
+
+void QuadKernel::ExpandPacked(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices)
+{
+    // s_Expand is published last, so once it is set this one is too.
+    if (!s_Expand.load(std::memory_order_acquire)) SetPath(GetBestPath());
+    
+    s_ExpandPacked.load(std::memory_order_acquire)(sprites, count, vertices);
+}
+
+void QuadKernel::WriteIndices(uint32_t firstQuad, size_t count, uint32_t* indices)
+{
+    static constexpr uint32_t CornerOrder[6] = { 0, 1, 2, 0, 2, 3 };
+    
+    for (size_t quad = 0; quad < count; quad++)
+    {
+        const uint32_t base = (firstQuad + static_cast<uint32_t>(quad)) * static_cast<uint32_t>(PackedVerticesPerQuad);
+        
+        for (size_t i = 0; i < IndicesPerQuad; i++)
+            indices[quad * IndicesPerQuad + i] = base + CornerOrder[i];
+    }
+}
@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../maths/vector.h"
+#include "vertex-data-2D.h"
+
+// Column pointers for the sprites a kernel call reads, laid out like
+// SpriteStore's columns. Element 0 is the first sprite expanded.
+struct QuadKernelInput
+{
+    const float* positionX = nullptr;
+    const float* positionY = nullptr;
+    const float* sizeX = nullptr;
+    const float* sizeY = nullptr;
+    const float* rotation = nullptr;
+    const Vec4* color = nullptr;
+    const Vec4* uvRect = nullptr;
+    const int32_t* textureIndex = nullptr;
+};
+
+enum class QuadKernelPath
+{
+    Scalar,
+    SSE,
+    AVX2,
+    NEON
+};
+
+// Expands sprites into quad vertices several sprites at a time. The widest
+// path the CPU supports is picked on first use; every path shares the same
+// polynomial sine/cosine, so they produce matching vertices.
+class QuadKernel
+{
+private:
+    
+    using ExpandFunction = void (*)(const QuadKernelInput&, size_t, VertexData2D*);
+    using ExpandPackedFunction = void (*)(const QuadKernelInput&, size_t, PackedVertexData2D*);
+    
+    static std::atomic<ExpandFunction> s_Expand;
+    static std::atomic<ExpandPackedFunction> s_ExpandPacked;
+    static std::atomic<QuadKernelPath> s_Path;
+    
+    static ExpandFunction GetFunction(QuadKernelPath path);
+    
+    static ExpandPackedFunction GetPackedFunction(QuadKernelPath path);
+    
+public:
+    
+    static constexpr size_t VerticesPerQuad = 6;
+    
+    // Packed quads share corners through an index buffer.
+    static constexpr size_t PackedVerticesPerQuad = 4;
+    static constexpr size_t IndicesPerQuad = 6;
+    
+    static bool IsSupported(QuadKernelPath path);
+    
+    static QuadKernelPath GetBestPath();
+    
+    // Forces a path, e.g. to compare them. Returns false if the CPU can't run it.
+    static bool SetPath(QuadKernelPath path);
+    
+    static QuadKernelPath GetPath();
+    
+    static const char* GetPathName(QuadKernelPath path);
+    
+    // Writes count * VerticesPerQuad vertices to the given destination.
+    static void Expand(const QuadKernelInput& sprites, size_t count, VertexData2D* vertices);
+    
+    // Writes count * PackedVerticesPerQuad quantized vertices.
+    static void ExpandPacked(const QuadKernelInput& sprites, size_t count, PackedVertexData2D* vertices);
+    
+    // Index pattern for quads [firstQuad, firstQuad + count), matching the
+    // corner order ExpandPacked writes.
+    static void WriteIndices(uint32_t firstQuad, size_t count, uint32_t* indices);
+};
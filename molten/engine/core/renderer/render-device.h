@@ -0,0 +1,379 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "frame-sync.h"
+
+// Thin backend-agnostic layer between Renderer2D and the graphics API.
+// Resources are referred to by small integer handles; 0 is never a valid id.
+
+struct BufferHandle
+{
+    uint32_t id = 0;
+    
+    bool IsValid() const { return id != 0; }
+    bool operator==(const BufferHandle& other) const { return id == other.id; }
+    bool operator!=(const BufferHandle& other) const { return id != other.id; }
+};
+
+struct TextureHandle
+{
+    uint32_t id = 0;
+    
+    bool IsValid() const { return id != 0; }
+    bool operator==(const TextureHandle& other) const { return id == other.id; }
+    bool operator!=(const TextureHandle& other) const { return id != other.id; }
+};
+
+struct PipelineHandle
+{
+    uint32_t id = 0;
+    
+    bool IsValid() const { return id != 0; }
+    bool operator==(const PipelineHandle& other) const { return id == other.id; }
+    bool operator!=(const PipelineHandle& other) const { return id != other.id; }
+};
+
+struct SamplerHandle
+{
+    uint32_t id = 0;
+    
+    bool IsValid() const { return id != 0; }
+    bool operator==(const SamplerHandle& other) const { return id == other.id; }
+    bool operator!=(const SamplerHandle& other) const { return id != other.id; }
+};
+
+// BC1 and BC3 store 4x4 pixel blocks in 8 and 16 bytes.
+enum class TextureFormat
+{
+    RGBA8Unorm,
+    BC1RGBA,
+    BC3RGBA
+};
+
+enum class VertexFormat
+{
+    Float,
+    Float2,
+    Float3,
+    Float4,
+    UChar4Normalized,
+    UShort2Normalized,
+    UShort4Normalized,
+    Short,
+    Int
+};
+
+enum class IndexType
+{
+    UInt16,
+    UInt32
+};
+
+enum class VertexStepFunction
+{
+    PerVertex,
+    PerInstance
+};
+
+enum class SamplerFilter
+{
+    Nearest,
+    Linear
+};
+
+enum class SamplerMipFilter
+{
+    NotMipmapped,
+    Nearest,
+    Linear
+};
+
+enum class SamplerAddressMode
+{
+    ClampToEdge,
+    Repeat
+};
+
+// How a pipeline combines its output with the backbuffer. Alpha and
+// Additive weight the source by its (straight) alpha.
+enum class BlendMode : uint8_t
+{
+    Opaque,
+    Alpha,
+    Additive
+};
+
+static constexpr uint32_t BlendModeCount = 3;
+
+enum class PrimitiveType
+{
+    Triangle,
+    TriangleStrip
+};
+
+struct TextureDesc
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    uint32_t mipLevelCount = 1;
+};
+
+inline bool IsBlockCompressed(TextureFormat format) { return format != TextureFormat::RGBA8Unorm; }
+
+// Bytes in one row of pixels, or of 4x4 blocks for compressed formats.
+inline size_t GetTextureRowPitch(TextureFormat format, uint32_t width)
+{
+    switch (format)
+    {
+        case TextureFormat::BC1RGBA: return size_t((width + 3) / 4) * 8;
+        case TextureFormat::BC3RGBA: return size_t((width + 3) / 4) * 16;
+        default: return size_t(width) * 4;
+    }
+}
+
+inline size_t GetTextureLevelSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+    uint32_t rows = IsBlockCompressed(format) ? (height + 3) / 4 : height;
+    
+    return GetTextureRowPitch(format, width) * rows;
+}
+
+inline uint32_t GetMipDimension(uint32_t size, uint32_t level)
+{
+    uint32_t dimension = level < 32 ? size >> level : 0;
+    
+    return dimension > 0 ? dimension : 1;
+}
+
+// Size of the level chain CreateTexture expects: every level of the
+// description, largest first, tightly packed one after the other.
+inline size_t GetTextureSize(const TextureDesc& desc)
+{
+    size_t size = 0;
+    
+    for (uint32_t level = 0; level < desc.mipLevelCount; level++)
+        size += GetTextureLevelSize(desc.format, GetMipDimension(desc.width, level), GetMipDimension(desc.height, level));
+    
+    return size;
+}
+
+struct VertexAttributeDesc
+{
+    VertexFormat format = VertexFormat::Float;
+    uint32_t offset = 0;
+    uint32_t bufferIndex = 0;
+};
+
+struct VertexLayoutDesc
+{
+    static constexpr uint32_t MaxAttributes = 8;
+    
+    VertexAttributeDesc attributes[MaxAttributes];
+    uint32_t attributeCount = 0;
+    
+    uint32_t stride = 0;
+    VertexStepFunction stepFunction = VertexStepFunction::PerVertex;
+};
+
+struct PipelineDesc
+{
+    const char* label = nullptr;
+    const char* vertexFunction = nullptr;
+    const char* fragmentFunction = nullptr;
+    
+    VertexLayoutDesc vertexLayout;
+    
+    BlendMode blendMode = BlendMode::Opaque;
+};
+
+struct SamplerDesc
+{
+    SamplerFilter minFilter = SamplerFilter::Linear;
+    SamplerFilter magFilter = SamplerFilter::Linear;
+    SamplerMipFilter mipFilter = SamplerMipFilter::NotMipmapped;
+    SamplerAddressMode addressModeS = SamplerAddressMode::ClampToEdge;
+    SamplerAddressMode addressModeT = SamplerAddressMode::ClampToEdge;
+};
+
+struct ClearColor
+{
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+    float a = 1.0f;
+};
+
+// Counters every backend keeps up to date; reset them once per frame to get
+// per-frame numbers. State changes only count binds that differ from what
+// was already bound.
+struct RenderDeviceStats
+{
+    uint64_t frames = 0;
+    uint64_t drawCalls = 0;
+    uint64_t verticesDrawn = 0;
+    uint64_t instancesDrawn = 0;
+    uint64_t bytesUploaded = 0;
+    uint64_t buffersCreated = 0;
+    uint64_t texturesCreated = 0;
+    uint64_t pipelinesCreated = 0;
+    uint64_t samplersCreated = 0;
+    uint64_t pipelineChanges = 0;
+    uint64_t bufferBindChanges = 0;
+    uint64_t textureBindChanges = 0;
+    uint64_t samplerBindChanges = 0;
+};
+
+class RenderDevice
+{
+protected:
+    
+    static constexpr uint32_t MaxBindSlots = 32;
+    
+    RenderDeviceStats m_Stats;
+    
+    // What the current pass has bound, so backends can drop redundant binds.
+    PipelineHandle m_BoundPipeline;
+    BufferHandle m_BoundVertexBuffers[MaxBindSlots];
+    size_t m_BoundVertexOffsets[MaxBindSlots] = {};
+    TextureHandle m_BoundTextures[MaxBindSlots];
+    SamplerHandle m_BoundSamplers[MaxBindSlots];
+    
+    // Frames the CPU has started but the GPU hasn't finished. Backends signal
+    // it when a frame completes, or right away if it was never submitted.
+    FrameSync m_FrameSync;
+    
+    bool m_FrameAcquired = false;
+    uint32_t m_FrameSlot = 0;
+    
+    // Gives back a slot taken by AcquireFrame when nothing was submitted.
+    inline void CancelFrame()
+    {
+        if (!m_FrameAcquired) return;
+        
+        m_FrameAcquired = false;
+        m_FrameSync.Signal();
+    }
+    
+    inline void ResetBindings()
+    {
+        m_BoundPipeline = PipelineHandle();
+        
+        for (uint32_t i = 0; i < MaxBindSlots; i++)
+        {
+            m_BoundVertexBuffers[i] = BufferHandle();
+            m_BoundVertexOffsets[i] = 0;
+            m_BoundTextures[i] = TextureHandle();
+            m_BoundSamplers[i] = SamplerHandle();
+        }
+    }
+    
+public:
+    
+    explicit RenderDevice(uint32_t framesInFlight = 2) : m_FrameSync(framesInFlight) {}
+    
+    virtual ~RenderDevice() = default;
+    
+    // Resources
+    
+    virtual BufferHandle CreateBuffer(size_t size, const void* data = nullptr) = 0;
+    virtual void UpdateBuffer(BufferHandle buffer, size_t offset, const void* data, size_t size) = 0;
+    virtual void DestroyBuffer(BufferHandle buffer) = 0;
+    
+    // Pixels, if given, hold every mip level laid out as GetTextureSize describes.
+    virtual TextureHandle CreateTexture(const TextureDesc& desc, const void* pixels) = 0;
+    
+    // Uncompressed formats always are; block formats depend on the GPU.
+    virtual bool SupportsTextureFormat(TextureFormat format) const { return !IsBlockCompressed(format); }
+    
+    // Replaces a sub-rectangle of one mip level with tightly packed RGBA8
+    // pixels; x, y and the size are in that level's texels. Only for
+    // uncompressed textures.
+    virtual void UpdateTexture(TextureHandle texture, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* pixels) = 0;
+    virtual void DestroyTexture(TextureHandle texture) = 0;
+    
+    virtual PipelineHandle CreatePipeline(const PipelineDesc& desc) = 0;
+    virtual void DestroyPipeline(PipelineHandle pipeline) = 0;
+    
+    virtual SamplerHandle CreateSampler(const SamplerDesc& desc) = 0;
+    virtual void DestroySampler(SamplerHandle sampler) = 0;
+    
+    // Optional on-disk cache of compiled pipelines, so a warm start skips
+    // shader compilation. Backends without one return false.
+    virtual bool OpenPipelineCache(const char* /*path*/) { return false; }
+    virtual bool SavePipelineCache() { return false; }
+    
+    // Frame submission. Everything between BeginFrame and EndFrame is
+    // recorded into a single render pass targeting the backbuffer.
+    
+    // Waits until the per-frame data slot of the next frame is no longer
+    // read by the GPU and returns it. Renderers call this before writing
+    // per-frame data; BeginFrame calls it too, and the slot stays the same
+    // until EndFrame.
+    inline uint32_t AcquireFrame()
+    {
+        if (!m_FrameAcquired)
+        {
+            m_FrameSlot = m_FrameSync.Acquire();
+            m_FrameAcquired = true;
+        }
+        
+        return m_FrameSlot;
+    }
+    
+    inline uint32_t GetFramesInFlight() const { return m_FrameSync.GetFramesInFlight(); }
+    
+    // Blocks until the GPU finished every submitted frame. Gives back a slot
+    // that was acquired but never began, so call it outside BeginFrame/EndFrame.
+    inline void WaitIdle() { CancelFrame(); m_FrameSync.WaitIdle(); }
+    
+    // Returns false when there's nothing to render into this frame.
+    virtual bool BeginFrame(const ClearColor& clearColor) = 0;
+    
+    virtual void SetPipeline(PipelineHandle pipeline) = 0;
+    virtual void SetVertexBuffer(BufferHandle buffer, size_t offset, uint32_t index) = 0;
+    virtual void SetFragmentTexture(TextureHandle texture, uint32_t index) = 0;
+    virtual void SetFragmentSampler(SamplerHandle sampler, uint32_t index) = 0;
+    
+    virtual void Draw(PrimitiveType primitive, size_t vertexStart, size_t vertexCount) = 0;
+    
+    // Draws instanceCount copies of the vertex range. Per-instance attributes
+    // are fetched starting at instanceStart.
+    virtual void DrawInstanced(PrimitiveType primitive, size_t vertexStart, size_t vertexCount,
+                               size_t instanceStart, size_t instanceCount) = 0;
+    
+    // Draws indexCount vertices fetched through the index buffer, starting
+    // at element indexStart of it.
+    virtual void DrawIndexed(PrimitiveType primitive, BufferHandle indexBuffer, IndexType indexType,
+                             size_t indexStart, size_t indexCount) = 0;
+    
+    virtual void EndFrame() = 0;
+    
+    inline const RenderDeviceStats& GetStats() const { return m_Stats; }
+    
+    inline void ResetStats() { m_Stats = RenderDeviceStats(); }
+};
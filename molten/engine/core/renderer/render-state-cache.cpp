@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "render-state-cache.h"
+
+#include <cstring>
+
+namespace
+{
+    // FNV-1a, fed field by field so padding bytes never reach the hash.
+    constexpr uint64_t HashSeed = 14695981039346656037ull;
+    
+    inline uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        
+        return hash;
+    }
+    
+    template <typename T>
+    inline uint64_t HashValue(uint64_t hash, const T& value)
+    {
+        return HashBytes(hash, &value, sizeof(T));
+    }
+    
+    inline uint64_t HashString(uint64_t hash, const char* string)
+    {
+        // The terminator keeps ("ab", "c") apart from ("a", "bc").
+        if (string) hash = HashBytes(hash, string, std::strlen(string));
+        return HashValue(hash, '\0');
+    }
+    
+    inline const char* OrEmpty(const char* string) { return string ? string : ""; }
+}
+
+uint64_t RenderStateCache::Hash(const VertexLayoutDesc& layout)
+{
+    uint64_t hash = HashSeed;
+    
+    hash = HashValue(hash, layout.attributeCount);
+    
+    for (uint32_t i = 0; i < layout.attributeCount && i < VertexLayoutDesc::MaxAttributes; i++)
+    {
+        hash = HashValue(hash, layout.attributes[i].format);
+        hash = HashValue(hash, layout.attributes[i].offset);
+        hash = HashValue(hash, layout.attributes[i].bufferIndex);
+    }
+    
+    hash = HashValue(hash, layout.stride);
+    hash = HashValue(hash, layout.stepFunction);
+    
+    return hash;
+}
+
+uint64_t RenderStateCache::Hash(const PipelineDesc& desc)
+{
+    uint64_t hash = Hash(desc.vertexLayout);
+    
+    hash = HashString(hash, desc.vertexFunction);
+    hash = HashString(hash, desc.fragmentFunction);
+    hash = HashValue(hash, desc.blendMode);
+    
+    return hash;
+}
+
+uint64_t RenderStateCache::Hash(const SamplerDesc& desc)
+{
+    uint64_t hash = HashSeed;
+    
+    hash = HashValue(hash, desc.minFilter);
+    hash = HashValue(hash, desc.magFilter);
+    hash = HashValue(hash, desc.mipFilter);
+    hash = HashValue(hash, desc.addressModeS);
+    hash = HashValue(hash, desc.addressModeT);
+    
+    return hash;
+}
+
+bool RenderStateCache::Equal(const VertexLayoutDesc& a, const VertexLayoutDesc& b)
+{
+    if (a.attributeCount != b.attributeCount || a.stride != b.stride || a.stepFunction != b.stepFunction) return false;
+    
+    for (uint32_t i = 0; i < a.attributeCount && i < VertexLayoutDesc::MaxAttributes; i++)
+    {
+        const VertexAttributeDesc& x = a.attributes[i];
+        const VertexAttributeDesc& y = b.attributes[i];
+        
+        if (x.format != y.format || x.offset != y.offset || x.bufferIndex != y.bufferIndex) return false;
+    }
+    
+    return true;
+}
+
+bool RenderStateCache::Equal(const SamplerDesc& a, const SamplerDesc& b)
+{
+    return a.minFilter == b.minFilter && a.magFilter == b.magFilter && a.mipFilter == b.mipFilter &&
+           a.addressModeS == b.addressModeS && a.addressModeT == b.addressModeT;
+}
+
+PipelineHandle RenderStateCache::GetPipeline(const PipelineDesc& desc)
+{
+    if (!m_Device) return PipelineHandle();
+    
+    std::vector<PipelineEntry>& bucket = m_Pipelines[Hash(desc)];
+    
+    for (const PipelineEntry& entry : bucket)
+    {
+        if (entry.vertexFunction == OrEmpty(desc.vertexFunction) &&
+            entry.fragmentFunction == OrEmpty(desc.fragmentFunction) &&
+            entry.blendMode == desc.blendMode && Equal(entry.vertexLayout, desc.vertexLayout))
+        {
+            m_Hits++;
+            return entry.handle;
+        }
+    }
+    
+    m_Misses++;
+    
+    PipelineHandle handle = m_Device->CreatePipeline(desc);
+    if (handle.IsValid()) bucket.push_back({ OrEmpty(desc.vertexFunction), OrEmpty(desc.fragmentFunction), desc.vertexLayout, desc.blendMode, handle });
+    
+    return handle;
+}
+
+SamplerHandle RenderStateCache::GetSampler(const SamplerDesc& desc)
+{
+    if (!m_Device) return SamplerHandle();
+    
+    std::vector<SamplerEntry>& bucket = m_Samplers[Hash(desc)];
+    
+    for (const SamplerEntry& entry : bucket)
+    {
+        if (Equal(entry.desc, desc))
+        {
+            m_Hits++;
+            return entry.handle;
+        }
+    }
+    
+    m_Misses++;
+    
+    SamplerHandle handle = m_Device->CreateSampler(desc);
+    if (handle.IsValid()) bucket.push_back({ desc, handle });
+    
+    return handle;
+}
+
+void RenderStateCache::Clear()
+{
+    if (m_Device)
+    {
+        for (auto& [hash, bucket] : m_Pipelines)
+            for (const PipelineEntry& entry : bucket) m_Device->DestroyPipeline(entry.handle);
+        
+        for (auto& [hash, bucket] : m_Samplers)
+            for (const SamplerEntry& entry : bucket) m_Device->DestroySampler(entry.handle);
+    }
+    
+    m_Pipelines.clear();
+    m_Samplers.clear();
+}
+
+size_t RenderStateCache::GetPipelineCount() const
+{
+    size_t count = 0;
+    for (const auto& [hash, bucket] : m_Pipelines) count += bucket.size();
+    return count;
+}
+
+size_t RenderStateCache::GetSamplerCount() const
+{
+    size_t count = 0;
+    for (const auto& [hash, bucket] : m_Samplers) count += bucket.size();
+    return count;
+}
+
+RenderStateCache::~RenderStateCache()
+{
+    Clear();
+}
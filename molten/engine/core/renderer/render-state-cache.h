@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include "render-device.h"
+
+// Creates each distinct pipeline and sampler once. States are looked up by a
+// hash of everything that affects them (labels don't), and a hit is checked
+// field by field so a hash collision can't hand back the wrong state. The
+// cache owns what it created until Clear.
+class RenderStateCache
+{
+private:
+    
+    struct PipelineEntry
+    {
+        std::string vertexFunction;
+        std::string fragmentFunction;
+        VertexLayoutDesc vertexLayout;
+        BlendMode blendMode;
+        PipelineHandle handle;
+    };
+    
+    struct SamplerEntry
+    {
+        SamplerDesc desc;
+        SamplerHandle handle;
+    };
+    
+    RenderDevice* m_Device = nullptr;
+    
+    std::unordered_map<uint64_t, std::vector<PipelineEntry>> m_Pipelines;
+    std::unordered_map<uint64_t, std::vector<SamplerEntry>> m_Samplers;
+    
+    uint64_t m_Hits = 0;
+    uint64_t m_Misses = 0;
+    
+public:
+    
+    explicit RenderStateCache(RenderDevice* device) : m_Device(device) {}
+    
+    RenderStateCache(const RenderStateCache&) = delete;
+    RenderStateCache& operator=(const RenderStateCache&) = delete;
+    
+    // Invalid handle if the device failed to create the state; failures are
+    // not cached, so a later call tries again.
+    PipelineHandle GetPipeline(const PipelineDesc& desc);
+    
+    SamplerHandle GetSampler(const SamplerDesc& desc);
+    
+    // Destroys every cached state.
+    void Clear();
+    
+    static uint64_t Hash(const PipelineDesc& desc);
+    static uint64_t Hash(const VertexLayoutDesc& layout);
+    static uint64_t Hash(const SamplerDesc& desc);
+    
+    static bool Equal(const VertexLayoutDesc& a, const VertexLayoutDesc& b);
+    static bool Equal(const SamplerDesc& a, const SamplerDesc& b);
+    
+    size_t GetPipelineCount() const;
+    size_t GetSamplerCount() const;
+    
+    inline uint64_t GetHits() const { return m_Hits; }
+    inline uint64_t GetMisses() const { return m_Misses; }
+    
+    ~RenderStateCache();
+};
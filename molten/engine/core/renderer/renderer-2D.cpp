@@ -0,0 +1,678 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "renderer-2D.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "vertex-data-2D.h"
+#include "quad-kernel.h"
+#include "../utils/log-macros.h"
+#include "../utils/profiler.h"
+#include "sprite-2D.h"
+#include "texture-2D.h"
+
+Renderer2D::Renderer2D(RenderDevice* device, unsigned int width, unsigned int height)
+: m_Device(device), m_States(device), m_Camera(static_cast<float>(width), static_cast<float>(height)),
+  m_ViewportWidth(width), m_ViewportHeight(height)
+{
+    m_Batch.SetFormat(SpriteBatchFormat::Instances);
+}
+
+void Renderer2D::SetBatchFormat(SpriteBatchFormat format)
+{
+    if (format == m_Batch.GetFormat()) return;
+    
+    m_Batch.SetFormat(format);
+    
+    // Every slot changes size and layout, and the pipeline reads a different layout.
+    m_Sprites.MarkAllDirty();
+    m_BatchSlices.InvalidateAll();
+    
+    for (PipelineHandle& pipeline : m_Pipelines) pipeline = PipelineHandle();
+}
+
+void Renderer2D::AddSprite(Sprite2D* sprite)
+{
+    if (!sprite) return;
+    
+    if (sprite->IsAdded())
+    {
+        LOG_CORE_WARN("Sprite {} was already added to a renderer.", sprite->GetId());
+        return;
+    }
+    
+    SpriteHandle handle = m_Sprites.Create(sprite->m_Position, sprite->m_Size, sprite->m_Rotation,
+                                           sprite->m_Color, sprite->m_Texture);
+    
+    m_Sprites.SetOwner(handle, sprite);
+    m_Sprites.SetLayer(handle, sprite->m_Layer);
+    m_Sprites.SetDepth(handle, sprite->m_Depth);
+    m_Sprites.SetBlendMode(handle, sprite->m_BlendMode);
+    
+    sprite->SetId(m_NextSpriteId++);
+    sprite->Bind(&m_Sprites, handle);
+}
+
+void Renderer2D::RemoveSprite(Sprite2D* sprite)
+{
+    if (!sprite || sprite->m_Store != &m_Sprites) return;
+    
+    SpriteHandle handle = sprite->GetHandle();
+    
+    sprite->Unbind();
+    
+    // The last sprite moves into the freed slot; only that one slot gets rewritten.
+    m_Sprites.Destroy(handle);
+}
+
+SpriteHandle Renderer2D::CreateSprite(const Vec2& position, const Vec2& size, float rotation,
+                                      const Vec4& color, std::shared_ptr<Texture2D> texture)
+{
+    return m_Sprites.Create(position, size, rotation, color, std::move(texture));
+}
+
+void Renderer2D::DestroySprite(SpriteHandle handle)
+{
+    uint32_t index = m_Sprites.IndexOf(handle);
+    if (index == SpriteStore::InvalidIndex) return;
+    
+    if (Sprite2D* owner = m_Sprites.GetOwners()[index]) owner->Unbind();
+    
+    m_Sprites.Destroy(handle);
+}
+
+void Renderer2D::UpdateProjMatrix(unsigned int width, unsigned int height)
+{
+    m_ViewportWidth = width;
+    m_ViewportHeight = height;
+
+    m_Camera.SetViewport(static_cast<float>(width), static_cast<float>(height));
+    
+    // Uploaded into the frame's uniform slice when the frame is recorded.
+    m_ProjMatrix = m_Camera.GetViewProjection();
+}
+
+void Renderer2D::ResolveTextures()
+{
+    PROFILE_SCOPE("Renderer2D::ResolveTextures");
+    
+    // Only sprites that got a new texture since the last frame are pending.
+    std::vector<SpriteHandle>& pending = m_Sprites.GetUnresolvedTextures();
+    
+    // Sprites whose texture finished loading swap the placeholder for it.
+    size_t stillLoading = 0;
+    
+    for (SpriteHandle handle : m_LoadingSprites)
+    {
+        Texture2D* texture = m_Sprites.GetTexture(handle);
+        if (!texture) continue;
+        
+        if (texture->IsLoading())
+        {
+            m_LoadingSprites[stillLoading++] = handle;
+            continue;
+        }
+        
+        m_Sprites.SetTextureRegion(handle, SpriteStore::NoTexture, Vec4{0.0f, 0.0f, 1.0f, 1.0f});
+        pending.push_back(handle);
+    }
+    
+    m_LoadingSprites.resize(stillLoading);
+    
+    for (SpriteHandle handle : pending)
+    {
+        Texture2D* texture = m_Sprites.GetTexture(handle);
+        if (!texture || m_Sprites.GetTextureIndex(handle) != SpriteStore::NoTexture) continue;
+        
+        // Images already in the atlas, baked ones included, need no pixels.
+        if (const AtlasRegion* region = m_Atlas.Find(texture->GetAtlasKey()))
+        {
+            m_Sprites.SetTextureRegion(handle, static_cast<int32_t>(region->page), region->uvRect);
+            continue;
+        }
+        
+        if (texture->IsLoading())
+        {
+            if (const AtlasRegion* placeholder = GetPlaceholder())
+                m_Sprites.SetTextureRegion(handle, static_cast<int32_t>(placeholder->page), placeholder->uvRect);
+            
+            m_LoadingSprites.push_back(handle);
+            continue;
+        }
+        
+        if (!texture->HasPixels()) continue;
+        
+        // Block compressed textures can't be copied into the atlas pages.
+        const AtlasRegion* region = IsBlockCompressed(texture->GetFormat()) ? nullptr :
+            m_Atlas.Insert(texture->GetAtlasKey(), texture->GetWidth(), texture->GetHeight(), texture->GetPixels());
+        
+        if (region)
+        {
+            m_Sprites.SetTextureRegion(handle, static_cast<int32_t>(region->page), region->uvRect);
+            continue;
+        }
+        
+        if (!texture->GetHandle().IsValid()) texture->Upload(m_Device, m_JobSystem);
+        
+        m_Sprites.SetTextureRegion(handle, StandaloneTextureSlot, Vec4{0.0f, 0.0f, 1.0f, 1.0f});
+    }
+    
+    pending.clear();
+    
+    m_Atlas.Upload(m_Device, m_JobSystem);
+}
+
+const AtlasRegion* Renderer2D::GetPlaceholder()
+{
+    static const std::string Key = "molten/placeholder";
+    
+    if (const AtlasRegion* region = m_Atlas.Find(Key)) return region;
+    
+    constexpr uint32_t Size = 8;
+    uint8_t pixels[Size * Size * 4];
+    
+    for (uint32_t y = 0; y < Size; y++)
+    {
+        for (uint32_t x = 0; x < Size; x++)
+        {
+            uint8_t shade = ((x / 2 + y / 2) & 1) ? 96 : 160;
+            uint8_t* pixel = pixels + (y * Size + x) * 4;
+            
+            pixel[0] = pixel[1] = pixel[2] = shade;
+            pixel[3] = 255;
+        }
+    }
+    
+    return m_Atlas.Insert(Key, Size, Size, pixels);
+}
+
+uint64_t Renderer2D::MakeSortKey(int16_t layer, BlendMode blendMode, uint32_t textureKey, float depth)
+{
+    // Flip the sign bit of positive floats and every bit of negative ones so
+    // the bits order like the values, then invert so greater depths come first.
+    uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+    depthBits = (depthBits & 0x80000000u) ? ~depthBits : (depthBits | 0x80000000u);
+    depthBits = ~depthBits;
+    
+    uint64_t layerBits = static_cast<uint16_t>(layer) ^ 0x8000u;
+    
+    return (layerBits << 48) |
+           (static_cast<uint64_t>(blendMode) << 46) |
+           (static_cast<uint64_t>(textureKey & 0x3FFFu) << 32) |
+           depthBits;
+}
+
+void Renderer2D::SortSprites()
+{
+    PROFILE_SCOPE("Renderer2D::SortSprites");
+    
+    // Nothing the keys depend on changed, so last frame's order still holds.
+    if (!m_Sprites.HasOrderChanged()) return;
+    
+    m_Sprites.ClearOrderChanged();
+    
+    size_t count = m_Sprites.Size();
+    
+    const int16_t* layers = m_Sprites.GetLayers();
+    const float* depths = m_Sprites.GetDepths();
+    const BlendMode* blendModes = m_Sprites.GetBlendModes();
+    const int32_t* textureIndices = m_Sprites.GetTextureIndices();
+    const std::shared_ptr<Texture2D>* textures = m_Sprites.GetTextures();
+    
+    m_SortKeys.resize(count);
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t textureKey = 0;
+        
+        if (textureIndices[i] == StandaloneTextureSlot && textures[i])
+            textureKey = textures[i]->GetHandle().id;
+        
+        m_SortKeys[i] = { MakeSortKey(layers[i], blendModes[i], textureKey, depths[i]), static_cast<uint32_t>(i) };
+    }
+    
+    // Adding sprites in order or moving one without crossing another keeps the keys sorted.
+    if (IsSorted(m_SortKeys)) return;
+    
+    // Stable, so sprites with equal keys keep drawing in the order they already had.
+    RadixSort(m_SortKeys, m_SortScratch);
+    
+    m_SortOrder.resize(count);
+    for (size_t i = 0; i < count; i++) m_SortOrder[i] = m_SortKeys[i].index;
+    
+    m_Sprites.Reorder(m_SortOrder.data());
+}
+
+void Renderer2D::SetCullingEnabled(bool enabled)
+{
+    if (enabled == m_CullingEnabled) return;
+    
+    m_CullingEnabled = enabled;
+    
+    // The batch goes back to one slot per sprite, all of them stale.
+    if (!enabled) m_Sprites.MarkAllDirty();
+}
+
+void Renderer2D::UpdateGrid()
+{
+    PROFILE_SCOPE("Renderer2D::UpdateGrid");
+    
+    std::vector<SpriteHandle>& destroyed = m_Sprites.GetDestroyed();
+    
+    for (SpriteHandle handle : destroyed)
+        m_Grid.Remove(handle);
+    
+    destroyed.clear();
+    
+    // Everything that was created, moved or resized is in the dirty list.
+    for (uint32_t index : m_Sprites.GetDirtyIndices())
+        m_Grid.Update(m_Sprites, index);
+}
+
+void Renderer2D::UpdateCulledBatch()
+{
+    m_Visible.clear();
+    m_Grid.Query(m_Sprites, m_Camera.GetVisibleBounds(), m_Visible);
+    
+    // Dense order is draw order.
+    std::sort(m_Visible.begin(), m_Visible.end());
+    
+    m_Batch.Resize(m_Visible.size());
+    
+    if (m_BatchCulled && m_Visible == m_PreviousVisible)
+    {
+        // Same sprites in the same slots: only the changed ones need rewriting.
+        m_DirtyScratch.clear();
+        
+        for (uint32_t index : m_Sprites.GetDirtyIndices())
+        {
+            auto slot = std::lower_bound(m_Visible.begin(), m_Visible.end(), index);
+            
+            if (slot != m_Visible.end() && *slot == index)
+                m_DirtyScratch.push_back(static_cast<uint32_t>(slot - m_Visible.begin()));
+        }
+        
+        std::sort(m_DirtyScratch.begin(), m_DirtyScratch.end());
+        
+        m_Batch.WriteSpritesGathered(m_Sprites, m_Visible, m_DirtyScratch, m_JobSystem);
+    }
+    else
+    {
+        m_Batch.WriteSpritesGathered(m_Sprites, m_Visible, 0, m_Visible.size(), m_JobSystem);
+    }
+    
+    m_PreviousVisible = m_Visible;
+    m_BatchCulled = true;
+    
+    m_Sprites.ClearDirty();
+}
+
+void Renderer2D::UpdateBatch()
+{
+    PROFILE_SCOPE("Renderer2D::UpdateBatch");
+    
+    if (m_CullingEnabled)
+    {
+        UpdateCulledBatch();
+        return;
+    }
+    
+    m_BatchCulled = false;
+    
+    m_Batch.Resize(m_Sprites.Size());
+    
+    const std::vector<uint32_t>& dirty = m_Sprites.GetDirtyIndices();
+    
+    // A list as long as the store covers (almost) every slot; rewriting them
+    // all is cheaper than sorting it.
+    if (dirty.size() == m_Sprites.Size())
+    {
+        m_Batch.WriteSprites(m_Sprites, 0, m_Sprites.Size(), m_JobSystem);
+    }
+    else
+    {
+        // Ascending order lets neighbouring slots merge into one upload range.
+        m_DirtyScratch.assign(dirty.begin(), dirty.end());
+        std::sort(m_DirtyScratch.begin(), m_DirtyScratch.end());
+        
+        m_Batch.WriteSprites(m_Sprites, m_DirtyScratch, m_JobSystem);
+    }
+    
+    m_Sprites.ClearDirty();
+}
+
+void Renderer2D::UploadBatch()
+{
+    PROFILE_SCOPE("Renderer2D::UploadBatch");
+    
+    // Waits here, not after submitting, if the GPU still reads every slice.
+    uint32_t slot = m_Device->AcquireFrame();
+    uint32_t sliceCount = m_Device->GetFramesInFlight();
+    
+    size_t byteSize = m_Batch.GetByteSize();
+    if (byteSize == 0) { m_Batch.ClearDirtyRanges(); return; }
+    
+    if (!m_BatchBuffer.IsValid() || byteSize > m_BatchSliceSize)
+    {
+        // Grow geometrically so adding sprites one at a time doesn't reallocate every frame.
+        size_t newSliceSize = std::max(byteSize, m_BatchSliceSize * 2);
+        
+        if (m_BatchBuffer.IsValid()) { m_Device->DestroyBuffer(m_BatchBuffer); m_BatchBuffer = BufferHandle(); }
+        
+        m_BatchBuffer = m_Device->CreateBuffer(newSliceSize * sliceCount);
+        if (!m_BatchBuffer.IsValid()) { LOG_CORE_ERROR("Failed to create batch buffer of {} bytes", newSliceSize * sliceCount); m_BatchSliceSize = 0; return; }
+        
+        m_BatchSliceSize = newSliceSize;
+        
+        // Fresh slices have no valid contents, so each gets everything once.
+        m_BatchSlices.Reset(sliceCount);
+    }
+    else
+    {
+        for (const BatchDirtyRange& range : m_Batch.GetDirtyRanges())
+            m_BatchSlices.AddRange(range.offset, range.size);
+    }
+    
+    m_Batch.ClearDirtyRanges();
+    
+    m_BatchSliceOffset = slot * m_BatchSliceSize;
+    
+    auto bytes = static_cast<const unsigned char*>(m_Batch.GetData());
+    size_t uploaded = 0;
+    
+    for (const FrameSliceTracker::Range& range : m_BatchSlices.TakeRanges(slot, byteSize))
+    {
+        m_Device->UpdateBuffer(m_BatchBuffer, m_BatchSliceOffset + range.offset, bytes + range.offset, range.size);
+        uploaded += range.size;
+    }
+    
+    PROFILE_COUNTER("Batch bytes uploaded", uploaded);
+    
+    if (m_Batch.GetFormat() == SpriteBatchFormat::PackedVertices) EnsureIndexBuffer(m_Batch.GetSpriteCount());
+}
+
+void Renderer2D::EnsureIndexBuffer(size_t spriteCount)
+{
+    if (m_IndexBuffer.IsValid() && spriteCount <= m_IndexCapacity) return;
+    
+    // The pattern never changes, so it is written once per growth and shared by every frame.
+    size_t capacity = std::max(spriteCount, m_IndexCapacity * 2);
+    
+    std::vector<uint32_t> indices(capacity * SpriteBatch2D::IndicesPerSprite);
+    QuadKernel::WriteIndices(0, capacity, indices.data());
+    
+    if (m_IndexBuffer.IsValid()) { m_Device->DestroyBuffer(m_IndexBuffer); m_IndexBuffer = BufferHandle(); }
+    
+    m_IndexBuffer = m_Device->CreateBuffer(indices.size() * sizeof(uint32_t), indices.data());
+    if (!m_IndexBuffer.IsValid()) { LOG_CORE_ERROR("Failed to create index buffer for {} sprites", capacity); m_IndexCapacity = 0; return; }
+    
+    m_IndexCapacity = capacity;
+}
+
+void Renderer2D::PrepareRenderingData()
+{
+    PROFILE_SCOPE("Renderer2D::PrepareRenderingData");
+    
+    if (!m_Device) { CORE_ASSERT(false, "Render device is null."); return; }
+
+    ResolveTextures();
+    
+    // Attached sprites take their new world transforms before the dirty list is read.
+    m_Transforms.Update(&m_Sprites);
+    
+    SortSprites();
+    
+    UpdateGrid();
+    UpdateBatch();
+    UploadBatch();
+    
+    UpdateProjMatrix(m_ViewportWidth, m_ViewportHeight);
+
+    // States come from the cache, so this only creates them the first time.
+    if (!m_Pipelines[0].IsValid() || !m_Sampler.IsValid()) CreateStates();
+    
+    PROFILE_COUNTER("Sprites", m_Sprites.Size());
+    PROFILE_COUNTER("Visible sprites", GetVisibleCount());
+}
+
+void Renderer2D::CreateStates()
+{
+    PipelineDesc pipelineDesc;
+    pipelineDesc.fragmentFunction = "spriteFragmentShader";
+    
+    VertexLayoutDesc& layout = pipelineDesc.vertexLayout;
+    
+    if (m_Batch.GetFormat() == SpriteBatchFormat::PackedVertices)
+    {
+        pipelineDesc.label = "2D Packed Rendering Pipeline";
+        pipelineDesc.vertexFunction = "spritePackedVertexShader";
+        
+        layout.attributes[0] = { VertexFormat::Float2, offsetof(PackedVertexData2D, position), 0 };
+        layout.attributes[1] = { VertexFormat::UShort2Normalized, offsetof(PackedVertexData2D, texCoord), 0 };
+        layout.attributes[2] = { VertexFormat::UChar4Normalized, offsetof(PackedVertexData2D, color), 0 };
+        layout.attributes[3] = { VertexFormat::Short, offsetof(PackedVertexData2D, textureIndex), 0 };
+        layout.attributeCount = 4;
+        layout.stride = sizeof(PackedVertexData2D);
+        layout.stepFunction = VertexStepFunction::PerVertex;
+    }
+    else if (m_Batch.GetFormat() == SpriteBatchFormat::Instances)
+    {
+        pipelineDesc.label = "2D Instanced Rendering Pipeline";
+        pipelineDesc.vertexFunction = "spriteInstanceVertexShader";
+        
+        layout.attributes[0] = { VertexFormat::Float2, offsetof(SpriteInstance2D, position), 0 };
+        layout.attributes[1] = { VertexFormat::Float2, offsetof(SpriteInstance2D, size), 0 };
+        layout.attributes[2] = { VertexFormat::Float, offsetof(SpriteInstance2D, rotation), 0 };
+        layout.attributes[3] = { VertexFormat::UChar4Normalized, offsetof(SpriteInstance2D, color), 0 };
+        layout.attributes[4] = { VertexFormat::UShort4Normalized, offsetof(SpriteInstance2D, uvRect), 0 };
+        layout.attributes[5] = { VertexFormat::Int, offsetof(SpriteInstance2D, textureIndex), 0 };
+        layout.attributeCount = 6;
+        layout.stride = sizeof(SpriteInstance2D);
+        layout.stepFunction = VertexStepFunction::PerInstance;
+    }
+    else
+    {
+        pipelineDesc.label = "2D Rendering Pipeline";
+        pipelineDesc.vertexFunction = "spriteVertexShader";
+        
+        layout.attributes[0] = { VertexFormat::Float3, offsetof(VertexData2D, position), 0 };
+        layout.attributes[1] = { VertexFormat::Float2, offsetof(VertexData2D, texCoord), 0 };
+        layout.attributes[2] = { VertexFormat::Float4, offsetof(VertexData2D, color), 0 };
+        layout.attributes[3] = { VertexFormat::Float, offsetof(VertexData2D, textureIndex), 0 };
+        layout.attributeCount = 4;
+        layout.stride = sizeof(VertexData2D);
+        layout.stepFunction = VertexStepFunction::PerVertex;
+    }
+
+    for (uint32_t blend = 0; blend < BlendModeCount; blend++)
+    {
+        pipelineDesc.blendMode = static_cast<BlendMode>(blend);
+        
+        m_Pipelines[blend] = m_States.GetPipeline(pipelineDesc);
+        if (!m_Pipelines[blend].IsValid()) return;
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.minFilter = SamplerFilter::Linear;
+    samplerDesc.magFilter = SamplerFilter::Linear;
+    samplerDesc.mipFilter = SamplerMipFilter::Linear;
+    samplerDesc.addressModeS = SamplerAddressMode::ClampToEdge;
+    samplerDesc.addressModeT = SamplerAddressMode::ClampToEdge;
+    
+    m_Sampler = m_States.GetSampler(samplerDesc);
+}
+
+void Renderer2D::IssueRenderCall()
+{
+    PROFILE_SCOPE("Renderer2D::IssueRenderCall");
+    
+    if (!m_Device || !m_Pipelines[0].IsValid())
+    {
+        LOG_CORE_ERROR("Cannot issue render call: device or pipeline not ready.");
+        return;
+    }
+    
+    if (!m_Device->BeginFrame({ 41.0f / 255.0f, 42.0f / 255.0f, 48.0f / 255.0f, 1.0f })) return;
+
+    uint32_t slot = m_Device->AcquireFrame();
+    
+    if (!m_UniformBuffer.IsValid())
+    {
+        m_UniformRing.Reset(UniformSliceSize, m_Device->GetFramesInFlight());
+        m_UniformBuffer = m_Device->CreateBuffer(m_UniformRing.GetTotalSize());
+    }
+    
+    m_UniformRing.BeginFrame(slot);
+    
+    size_t projOffset = m_UniformRing.Allocate(sizeof(Mat4), UniformAlignment);
+    m_Device->UpdateBuffer(m_UniformBuffer, projOffset, &m_ProjMatrix, sizeof(Mat4));
+
+    m_Device->SetPipeline(m_Pipelines[0]);
+    m_Device->SetVertexBuffer(m_UniformBuffer, projOffset, 1);
+    m_Device->SetFragmentSampler(m_Sampler, 0);
+    
+    if (m_BatchBuffer.IsValid())
+    {
+        m_Device->SetVertexBuffer(m_BatchBuffer, m_BatchSliceOffset, 0);
+        
+        for (size_t page = 0; page < m_Atlas.GetPageCount(); page++)
+            m_Device->SetFragmentTexture(m_Atlas.GetPageTexture(page), static_cast<uint32_t>(page));
+        
+        // Sprites are in draw order. Atlas and untextured sprites all draw
+        // together; only a change of blend mode or standalone texture has to
+        // start a new run, and the sort key keeps those grouped.
+        const int32_t* textureIndices = m_Sprites.GetTextureIndices();
+        const std::shared_ptr<Texture2D>* textures = m_Sprites.GetTextures();
+        const BlendMode* blendModes = m_Sprites.GetBlendModes();
+        
+        // A culled batch maps slots to sprites. Sprites destroyed after the
+        // batch was built keep their slot and draw with the defaults.
+        auto spriteAt = [&](size_t slot) -> size_t { return m_BatchCulled ? m_Visible[slot] : slot; };
+        
+        auto standaloneTexture = [&](size_t slot)
+        {
+            size_t index = spriteAt(slot);
+            
+            if (index >= m_Sprites.Size() || textureIndices[index] != StandaloneTextureSlot || !textures[index]) return TextureHandle();
+            return textures[index]->GetHandle();
+        };
+        
+        auto blendModeAt = [&](size_t slot)
+        {
+            size_t index = spriteAt(slot);
+            return index < m_Sprites.Size() ? blendModes[index] : BlendMode::Opaque;
+        };
+        
+        size_t spriteCount = std::min(m_BatchCulled ? m_Visible.size() : m_Sprites.Size(), m_Batch.GetSpriteCount());
+        size_t runStart = 0;
+        
+        while (runStart < spriteCount)
+        {
+            TextureHandle texture = standaloneTexture(runStart);
+            BlendMode blendMode = blendModeAt(runStart);
+            
+            size_t runEnd = runStart + 1;
+            
+            while (runEnd < spriteCount && standaloneTexture(runEnd) == texture && blendModeAt(runEnd) == blendMode)
+                runEnd++;
+            
+            PipelineHandle pipeline = m_Pipelines[static_cast<uint32_t>(blendMode)];
+            
+            if (!pipeline.IsValid()) { runStart = runEnd; continue; }
+            
+            m_Device->SetPipeline(pipeline);
+            
+            if (texture.IsValid()) m_Device->SetFragmentTexture(texture, StandaloneTextureSlot);
+            
+            if (m_Batch.GetFormat() == SpriteBatchFormat::Instances)
+            {
+                m_Device->DrawInstanced(PrimitiveType::Triangle, 0, SpriteBatch2D::VerticesPerSprite, runStart, runEnd - runStart);
+            }
+            else if (m_Batch.GetFormat() == SpriteBatchFormat::PackedVertices)
+            {
+                size_t indexStart = runStart * SpriteBatch2D::IndicesPerSprite;
+                size_t indexCount = (runEnd - runStart) * SpriteBatch2D::IndicesPerSprite;
+                
+                m_Device->DrawIndexed(PrimitiveType::Triangle, m_IndexBuffer, IndexType::UInt32, indexStart, indexCount);
+            }
+            else
+            {
+                size_t vertexStart = runStart * SpriteBatch2D::VerticesPerSprite;
+                size_t vertexCount = (runEnd - runStart) * SpriteBatch2D::VerticesPerSprite;
+                
+                m_Device->Draw(PrimitiveType::Triangle, vertexStart, vertexCount);
+            }
+            
+            runStart = runEnd;
+        }
+    }
+
+    m_Device->EndFrame();
+}
+
+void Renderer2D::Cleanup()
+{
+    if (m_Device)
+    {
+        // Buffers may still be read by frames in flight.
+        m_Device->WaitIdle();
+        
+        if (m_BatchBuffer.IsValid()) m_Device->DestroyBuffer(m_BatchBuffer);
+        if (m_UniformBuffer.IsValid()) m_Device->DestroyBuffer(m_UniformBuffer);
+        if (m_IndexBuffer.IsValid()) m_Device->DestroyBuffer(m_IndexBuffer);
+    }
+    
+    m_BatchBuffer = BufferHandle();
+    m_UniformBuffer = BufferHandle();
+    m_IndexBuffer = BufferHandle();
+    m_IndexCapacity = 0;
+    
+    m_BatchSliceSize = 0;
+    m_BatchSliceOffset = 0;
+    m_Batch.Resize(0);
+    m_Batch.ClearDirtyRanges();
+    
+    m_Atlas.Clear();
+    
+    m_Grid.Clear();
+    m_LoadingSprites.clear();
+    m_Visible.clear();
+    m_PreviousVisible.clear();
+    m_BatchCulled = false;
+    
+    // Sprite objects outlive the renderer, so hand their values back first.
+    for (size_t i = 0; i < m_Sprites.Size(); i++)
+        if (Sprite2D* owner = m_Sprites.GetOwners()[i]) owner->Unbind();
+
+    m_Sprites.Clear();
+    m_Transforms.Clear();
+}
+
+Renderer2D::~Renderer2D()
+{
+    // Pipelines and samplers belong to the state cache.
+    m_States.Clear();
+}
@@ -21,68 +21,180 @@
 // SOFTWARE.
 
 #include <vector>
-#include <unordered_set>
-#include <random>
+#include <memory>
 
 #include "../maths/matrix.h"
+#include "render-device.h"
+#include "sprite-batch-2D.h"
+#include "texture-atlas.h"
+#include "sprite-store.h"
+#include "transform-hierarchy-2D.h"
+#include "frame-ring.h"
+#include "render-state-cache.h"
+#include "../utils/radix-sort.h"
+#include "camera-2D.h"
+#include "sprite-grid.h"
 
-namespace MTL
-{
-    class Buffer;
-    class Library;
-    class CommandQueue;
-    class RenderPipelineState;
-    class CommandBuffer;
-    class Device;
-    class SamplerState;
-    class Buffer;
-}
-
-namespace CA
-{
-    class MetalDrawable;
-}
-
-class Window;
 class Sprite2D;
+class Texture2D;
+class JobSystem;
 
 class Renderer2D
 {
 private:
     
-    MTL::Library* m_MetalDefaultLibrary = nullptr;
-    MTL::CommandQueue* m_MetalCommandQueue = nullptr;
-    MTL::RenderPipelineState* m_MetalRenderPSO = nullptr;
+    RenderDevice* m_Device = nullptr;
+    
+    // Optional; batch building is split across its workers when set.
+    JobSystem* m_JobSystem = nullptr;
+    
+    // Owns every pipeline and sampler this renderer uses.
+    RenderStateCache m_States;
+    
+    // One pipeline per blend mode, all for the current batch format.
+    PipelineHandle m_Pipelines[BlendModeCount];
+    SamplerHandle m_Sampler;
+    
+    // One persistent arena shared by every sprite in the store, holding either
+    // expanded vertices or one instance record per sprite. The GPU buffer
+    // holds a copy per frame in flight; each copy only receives the ranges
+    // that changed since its own last frame.
+    SpriteBatch2D m_Batch;
+    BufferHandle m_BatchBuffer;
+    size_t m_BatchSliceSize = 0;
+    size_t m_BatchSliceOffset = 0;
+    FrameSliceTracker m_BatchSlices;
+    
+    // Static quad index pattern for the packed format, sized in sprites.
+    BufferHandle m_IndexBuffer;
+    size_t m_IndexCapacity = 0;
+    
+    // Every sprite image is packed in here; the pages are bound together so
+    // only sprites that fell back to a standalone texture split the batch.
+    TextureAtlas m_Atlas;
+    
+    Mat4 m_ProjMatrix;
+    
+    Camera2D m_Camera;
+    
+    // Every sprite, indexed by position so a frame only visits the sprites
+    // near the view. Kept up to date from the store's dirty list.
+    SpriteGrid m_Grid;
+    
+    // With culling the batch holds only the visible sprites: slot s draws
+    // dense index m_Visible[s], in draw order.
+    bool m_CullingEnabled = true;
+    bool m_BatchCulled = false;
+    std::vector<uint32_t> m_Visible;
+    std::vector<uint32_t> m_PreviousVisible;
+    
+    // Per-frame uniforms, suballocated from the current frame's slice.
+    static constexpr size_t UniformSliceSize = 4096;
+    static constexpr size_t UniformAlignment = 256;
+    
+    BufferHandle m_UniformBuffer;
+    FrameRingAllocator m_UniformRing;
+    
+    unsigned int m_ViewportWidth = 0;
+    unsigned int m_ViewportHeight = 0;
+    
+    // Every sprite drawn by this renderer; dense index i is batch slot i.
+    SpriteStore m_Sprites;
+    std::vector<uint32_t> m_DirtyScratch;
+    
+    // Parent/child transforms; nodes with a sprite attached drive it.
+    TransformHierarchy2D m_Transforms;
+    
+    // Draw keys of the last sort and the permutation built from them.
+    std::vector<SortKey> m_SortKeys;
+    std::vector<SortKey> m_SortScratch;
+    std::vector<uint32_t> m_SortOrder;
+    
+    unsigned int m_NextSpriteId = 1;
     
-    CA::MetalDrawable* m_MetalDrawable = nullptr;
-    MTL::CommandBuffer* m_MetalCommandBuffer = nullptr;
-    MTL::SamplerState* m_MetalSamplerState = nullptr;
+    // Sprites drawing the placeholder while their texture loads. Entries can
+    // go stale; they are dropped when checked.
+    std::vector<SpriteHandle> m_LoadingSprites;
     
-    std::vector<MTL::Buffer*> m_VertexBuffers;
-    simd::float4x4 m_ProjMatrix;
-    MTL::Buffer* m_ProjBuffer = nullptr;
+    void ResolveTextures();
     
-    std::vector<Sprite2D*> m_Queue;
-    std::unordered_set<unsigned int> s_UsedIds;
-    std::mt19937 s_Rng;
+    // A small checkerboard packed in the atlas the first time it's needed.
+    const AtlasRegion* GetPlaceholder();
     
-    Window* m_Window = nullptr;
+    // Puts the store in draw order, if anything it depends on changed.
+    void SortSprites();
+    
+    void UpdateGrid();
+    
+    void UpdateBatch();
+    
+    void UpdateCulledBatch();
+    
+    void UploadBatch();
+    
+    void EnsureIndexBuffer(size_t spriteCount);
+    
+    void CreateStates();
+    
+    // Layer, then blend mode, then standalone texture, then depth (far to
+    // near). Atlas and untextured sprites share texture key 0 since they
+    // draw together, so only their depth orders them within a layer.
+    static uint64_t MakeSortKey(int16_t layer, BlendMode blendMode, uint32_t textureKey, float depth);
     
 public:
     
-    explicit Renderer2D(Window* window);
+    // Texture slot for sprites whose image didn't fit in the atlas.
+    static constexpr int StandaloneTextureSlot = TextureAtlas::MaxPages;
+    
+    explicit Renderer2D(RenderDevice* device, unsigned int width, unsigned int height);
+    
+    // Instances (the default) upload one compact record per sprite and let
+    // the vertex stage build the quad; PackedVertices and Vertices expand
+    // quads on the CPU, quantized and indexed or as full vertices.
+    void SetBatchFormat(SpriteBatchFormat format);
+    
+    SpriteBatchFormat GetBatchFormat() const { return m_Batch.GetFormat(); }
     
     void AddSprite(Sprite2D* sprite);
     
     void RemoveSprite(Sprite2D* sprite);
     
+    // Sprites without a Sprite2D object, addressed only through their handle.
+    SpriteHandle CreateSprite(const Vec2& position, const Vec2& size, float rotation = 0.0f,
+                              const Vec4& color = {1.0f, 1.0f, 1.0f, 1.0f},
+                              std::shared_ptr<Texture2D> texture = nullptr);
+    
+    void DestroySprite(SpriteHandle handle);
+    
+    SpriteStore& GetSprites() { return m_Sprites; }
+    
+    // CPU copy of the batch; the slice of the last frame should match it.
+    const SpriteBatch2D& GetBatch() const { return m_Batch; }
+    
+    // Updated at the start of PrepareRenderingData.
+    TransformHierarchy2D& GetTransforms() { return m_Transforms; }
+    
+    Camera2D& GetCamera() { return m_Camera; }
+    
+    // Off, every sprite is drawn whether it's on screen or not.
+    void SetCullingEnabled(bool enabled);
+    
+    bool IsCullingEnabled() const { return m_CullingEnabled; }
+    
+    // Sprites drawn last frame.
+    size_t GetVisibleCount() const { return m_BatchCulled ? m_Visible.size() : m_Sprites.Size(); }
+    
     void UpdateProjMatrix(unsigned int width, unsigned int height);
     
     void PrepareRenderingData();
     
     void IssueRenderCall();
     
-    Window* GetWindow() const { return m_Window; }
+    RenderDevice* GetDevice() const { return m_Device; }
+    
+    void SetJobSystem(JobSystem* jobSystem) { m_JobSystem = jobSystem; }
+    
+    TextureAtlas& GetAtlas() { return m_Atlas; }
     
     void Cleanup();
     
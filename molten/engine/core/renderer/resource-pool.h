@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+// Dense storage for backend resources addressed by 1-based handle ids.
+// Freed ids are recycled so the table stays as small as the live set.
+template<typename T>
+class ResourcePool
+{
+private:
+    
+    std::vector<T> m_Items;
+    std::vector<bool> m_Alive;
+    std::vector<uint32_t> m_FreeIds;
+    
+public:
+    
+    uint32_t Add(T item)
+    {
+        if (!m_FreeIds.empty())
+        {
+            uint32_t id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+            
+            m_Items[id - 1] = std::move(item);
+            m_Alive[id - 1] = true;
+            return id;
+        }
+        
+        m_Items.push_back(std::move(item));
+        m_Alive.push_back(true);
+        return static_cast<uint32_t>(m_Items.size());
+    }
+    
+    bool Remove(uint32_t id, T* removed = nullptr)
+    {
+        if (!IsAlive(id)) return false;
+        
+        if (removed) *removed = m_Items[id - 1];
+        
+        m_Items[id - 1] = T();
+        m_Alive[id - 1] = false;
+        m_FreeIds.push_back(id);
+        return true;
+    }
+    
+    inline bool IsAlive(uint32_t id) const { return id != 0 && id <= m_Items.size() && m_Alive[id - 1]; }
+    
+    inline T* Get(uint32_t id) { return IsAlive(id) ? &m_Items[id - 1] : nullptr; }
+    
+    inline const T* Get(uint32_t id) const { return IsAlive(id) ? &m_Items[id - 1] : nullptr; }
+    
+    template<typename Fn>
+    void ForEach(Fn&& fn)
+    {
+        for (size_t i = 0; i < m_Items.size(); i++)
+            if (m_Alive[i]) fn(m_Items[i]);
+    }
+    
+    void Clear()
+    {
+        m_Items.clear();
+        m_Alive.clear();
+        m_FreeIds.clear();
+    }
+};
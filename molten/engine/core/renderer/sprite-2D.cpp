@@ -22,36 +22,112 @@
 
 #include "sprite-2D.h"
 
-#include <Metal/Metal.hpp>
-
 #include "../utils/log-macros.h"
 #include "texture-2D.h"
+#include "../assets/asset-loader.h"
 
-Sprite2D::Sprite2D(simd::float2 position,
-                   simd::float2 size,
+Sprite2D::Sprite2D(Vec2 position,
+                   Vec2 size,
                    float rotation,
                    const char* filepath)
     : m_Position(position), m_Color{1.0f, 1.0f, 1.0f, 1.0f},
-      m_Size(size), m_Rotation(rotation), m_Texture(nullptr)
+      m_Size(size), m_Rotation(rotation)
 {
     if (filepath && *filepath != '\0')
-        m_Texture = new Texture2D(filepath);
+        m_Texture = AssetLoader::LoadTexture(filepath).GetTexture();
 }
 
-Sprite2D::Sprite2D(simd::float2 position,
-                   simd::float4 color,
-                   simd::float2 size,
+Sprite2D::Sprite2D(Vec2 position,
+                   Vec4 color,
+                   Vec2 size,
                    float rotation,
                    const char* filepath)
     : m_Position(position), m_Color(color),
-      m_Size(size), m_Rotation(rotation), m_Texture(nullptr)
+      m_Size(size), m_Rotation(rotation)
 {
     if (filepath && *filepath != '\0')
-        m_Texture = new Texture2D(filepath);
+        m_Texture = AssetLoader::LoadTexture(filepath).GetTexture();
+
+}
+
+void Sprite2D::Bind(SpriteStore* store, SpriteHandle handle)
+{
+    m_Store = store;
+    m_Handle = handle;
+    
+    // The store holds the texture reference from now on.
+    m_Texture.reset();
+}
+
+void Sprite2D::Unbind()
+{
+    if (!m_Store) return;
+    
+    m_Position = m_Store->GetPosition(m_Handle);
+    m_Size = m_Store->GetSize(m_Handle);
+    m_Rotation = m_Store->GetRotation(m_Handle);
+    m_Color = m_Store->GetColor(m_Handle);
+    m_Layer = m_Store->GetLayer(m_Handle);
+    m_Depth = m_Store->GetDepth(m_Handle);
+    m_BlendMode = m_Store->GetBlendMode(m_Handle);
+    
+    uint32_t index = m_Store->IndexOf(m_Handle);
+    if (index != SpriteStore::InvalidIndex) m_Texture = m_Store->GetTextures()[index];
+    
+    m_Store = nullptr;
+    m_Handle = SpriteHandle();
+}
+
+void Sprite2D::SetPosition(const Vec2& pos)
+{
+    if (m_Store) m_Store->SetPosition(m_Handle, pos);
+    else m_Position = pos;
+}
 
+void Sprite2D::SetSize(const Vec2& size)
+{
+    if (m_Store) m_Store->SetSize(m_Handle, size);
+    else m_Size = size;
+}
+
+void Sprite2D::SetRotation(float radians)
+{
+    if (m_Store) m_Store->SetRotation(m_Handle, radians);
+    else m_Rotation = radians;
+}
+
+void Sprite2D::SetColor(const Vec4& color)
+{
+    if (m_Store) m_Store->SetColor(m_Handle, color);
+    else m_Color = color;
+}
+
+void Sprite2D::SetTexture(std::shared_ptr<Texture2D> texture)
+{
+    if (m_Store) m_Store->SetTexture(m_Handle, std::move(texture));
+    else m_Texture = std::move(texture);
+}
+
+void Sprite2D::SetLayer(int16_t layer)
+{
+    if (m_Store) m_Store->SetLayer(m_Handle, layer);
+    else m_Layer = layer;
+}
+
+void Sprite2D::SetDepth(float depth)
+{
+    if (m_Store) m_Store->SetDepth(m_Handle, depth);
+    else m_Depth = depth;
+}
+
+void Sprite2D::SetBlendMode(BlendMode blendMode)
+{
+    if (m_Store) m_Store->SetBlendMode(m_Handle, blendMode);
+    else m_BlendMode = blendMode;
 }
 
 Sprite2D::~Sprite2D()
 {
-    if (m_Texture) delete m_Texture;
+    // A sprite destroyed while still added must not leave a dangling entry.
+    if (m_Store) m_Store->Destroy(m_Handle);
 }
@@ -20,51 +20,93 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include <simd/simd.h>
+#include <memory>
+
+#include "../maths/vector.h"
+#include "sprite-store.h"
 
 class Texture2D;
 
+// A sprite object owned by game code. Until it's added to a renderer it keeps
+// its own values; once added, the data lives in the renderer's SpriteStore and
+// this object only forwards to it through its handle.
 class Sprite2D
 {
 private:
     
-    unsigned int m_Id;
+    unsigned int m_Id = 0;
     
-    simd::float2 m_Position;
-    simd::float4 m_Color;
-    simd::float2 m_Size;
+    Vec2 m_Position;
+    Vec4 m_Color;
+    Vec2 m_Size;
     
     float m_Rotation;
     
-    Texture2D* m_Texture = nullptr;
+    int16_t m_Layer = 0;
+    float m_Depth = 0.0f;
+    BlendMode m_BlendMode = BlendMode::Opaque;
+    
+    // Shared with every other sprite using the same image through TextureCache.
+    std::shared_ptr<Texture2D> m_Texture;
+    
+    SpriteStore* m_Store = nullptr;
+    SpriteHandle m_Handle;
+    
+    friend class Renderer2D;
+    
+    void Bind(SpriteStore* store, SpriteHandle handle);
+    
+    // Copies the stored values back so the sprite survives leaving the store.
+    void Unbind();
 
 public:
     
-    explicit Sprite2D(simd::float2 position,
-             simd::float2 size = {100.0f, 100.0f},
+    static constexpr int NoTexture = SpriteStore::NoTexture;
+    
+    explicit Sprite2D(Vec2 position,
+             Vec2 size = {100.0f, 100.0f},
              float rotation = 0.0f,
              const char* filepath = nullptr);
 
-    explicit Sprite2D(simd::float2 position,
-             simd::float4 color,
-             simd::float2 size = {100.0f, 100.0f},
+    explicit Sprite2D(Vec2 position,
+             Vec4 color,
+             Vec2 size = {100.0f, 100.0f},
              float rotation = 0.0f,
              const char* filepath = nullptr);
+    
+    Sprite2D(const Sprite2D&) = delete;
+    Sprite2D& operator=(const Sprite2D&) = delete;
 
     void SetId(unsigned int id) { m_Id = id; }
-    void SetPosition(const simd::float2& pos) { m_Position = pos; }
-    void SetSize(const simd::float2& size) { m_Size = size; }
-    void SetRotation(float radians) { m_Rotation = radians; }
-    void SetColor(const simd::float4& color) { m_Color = color; }
+    void SetPosition(const Vec2& pos);
+    void SetSize(const Vec2& size);
+    void SetRotation(float radians);
+    void SetColor(const Vec4& color);
+    void SetTexture(std::shared_ptr<Texture2D> texture);
+    
+    // Higher layers draw on top. Within a layer, sprites with a greater depth
+    // are further away and draw first.
+    void SetLayer(int16_t layer);
+    void SetDepth(float depth);
+    void SetBlendMode(BlendMode blendMode);
 
     unsigned int GetId() const { return m_Id; }
     
-    simd::float2 GetPosition() const { return m_Position; }
-    simd::float4 GetColor() const { return m_Color; }
-    simd::float2 GetSize() const { return m_Size; }
-    float GetRotation() const { return m_Rotation; }
+    Vec2 GetPosition() const { return m_Store ? m_Store->GetPosition(m_Handle) : m_Position; }
+    Vec4 GetColor() const { return m_Store ? m_Store->GetColor(m_Handle) : m_Color; }
+    Vec2 GetSize() const { return m_Store ? m_Store->GetSize(m_Handle) : m_Size; }
+    float GetRotation() const { return m_Store ? m_Store->GetRotation(m_Handle) : m_Rotation; }
+    Vec4 GetUVRect() const { return m_Store ? m_Store->GetUVRect(m_Handle) : Vec4{0.0f, 0.0f, 1.0f, 1.0f}; }
+    int GetTextureIndex() const { return m_Store ? m_Store->GetTextureIndex(m_Handle) : NoTexture; }
+    int16_t GetLayer() const { return m_Store ? m_Store->GetLayer(m_Handle) : m_Layer; }
+    float GetDepth() const { return m_Store ? m_Store->GetDepth(m_Handle) : m_Depth; }
+    BlendMode GetBlendMode() const { return m_Store ? m_Store->GetBlendMode(m_Handle) : m_BlendMode; }
 
-    Texture2D* GetTexture() const { return m_Texture; }
+    Texture2D* GetTexture() const { return m_Store ? m_Store->GetTexture(m_Handle) : m_Texture.get(); }
+    
+    SpriteHandle GetHandle() const { return m_Handle; }
+    
+    bool IsAdded() const { return m_Store != nullptr; }
 
     ~Sprite2D();
 };
@@ -1,10 +1,15 @@
 #include <metal_stdlib>
 using namespace metal;
 
+// Atlas pages occupy slots [0, 16), slot 16 holds a standalone texture for
+// sprites whose image didn't fit in the atlas (see Renderer2D).
+constant int kTextureSlotCount = 17;
+
 struct VertexIn {
-    float3 position [[attribute(0)]];
-    float2 texCoord [[attribute(1)]];
-    float4 color    [[attribute(2)]];
+    float3 position     [[attribute(0)]];
+    float2 texCoord     [[attribute(1)]];
+    float4 color        [[attribute(2)]];
+    float  textureIndex [[attribute(3)]];
 };
 
 struct Uniforms {
@@ -15,6 +20,7 @@ struct VertexOut {
     float4 position [[position]];
     float2 texCoord;
     float4 color;
+    float  textureIndex [[flat]];
 };
 
 vertex VertexOut spriteVertexShader(VertexIn in [[stage_in]],
@@ -25,19 +31,80 @@ vertex VertexOut spriteVertexShader(VertexIn in [[stage_in]],
     out.position = uniforms.projectionMatrix * worldPos;
     out.texCoord = in.texCoord;
     out.color = in.color;
+    out.textureIndex = in.textureIndex;
+    return out;
+}
+
+// Quantized corners drawn through the shared quad index buffer, see
+// PackedVertexData2D.
+struct PackedVertexIn {
+    float2 position     [[attribute(0)]];
+    float2 texCoord     [[attribute(1)]];
+    float4 color        [[attribute(2)]];
+    short  textureIndex [[attribute(3)]];
+};
+
+vertex VertexOut spritePackedVertexShader(PackedVertexIn in [[stage_in]],
+                                          constant Uniforms& uniforms [[buffer(1)]])
+{
+    VertexOut out;
+    out.position = uniforms.projectionMatrix * float4(in.position, 0.0, 1.0);
+    out.texCoord = in.texCoord;
+    out.color = in.color;
+    out.textureIndex = float(in.textureIndex);
+    return out;
+}
+
+// One record per sprite, see SpriteInstance2D. Each instance draws six
+// vertices; the vertex id picks the quad corner.
+struct InstanceIn {
+    float2 position     [[attribute(0)]];
+    float2 size         [[attribute(1)]];
+    float  rotation     [[attribute(2)]];
+    float4 color        [[attribute(3)]];
+    float4 uvRect       [[attribute(4)]];
+    int    textureIndex [[attribute(5)]];
+};
+
+vertex VertexOut spriteInstanceVertexShader(InstanceIn in [[stage_in]],
+                                            uint vertexId [[vertex_id]],
+                                            constant Uniforms& uniforms [[buffer(1)]])
+{
+    // Same corner order and winding as the CPU quad kernel.
+    const int cornerOrder[6] = { 0, 1, 2, 0, 2, 3 };
+    const float2 cornerSigns[4] = { float2(-1.0, -1.0), float2(-1.0, 1.0), float2(1.0, 1.0), float2(1.0, -1.0) };
+
+    int corner = cornerOrder[vertexId % 6];
+    float2 sign = cornerSigns[corner];
+
+    float cosAngle;
+    float sinAngle = sincos(in.rotation, cosAngle);
+
+    float2 local = sign * in.size * 0.5;
+    float2 world = in.position + float2(local.x * cosAngle - local.y * sinAngle,
+                                        local.x * sinAngle + local.y * cosAngle);
+
+    VertexOut out;
+    out.position = uniforms.projectionMatrix * float4(world, 0.0, 1.0);
+    out.texCoord = float2(sign.x < 0.0 ? in.uvRect.x : in.uvRect.z,
+                          sign.y < 0.0 ? in.uvRect.y : in.uvRect.w);
+    out.color = in.color;
+    out.textureIndex = float(in.textureIndex);
     return out;
 }
 
 fragment float4 spriteFragmentShader(VertexOut in [[stage_in]],
-                               texture2d<float> spriteTexture [[texture(0)]],
+                               array<texture2d<float>, kTextureSlotCount> textures [[texture(0)]],
                                sampler spriteSampler [[sampler(0)]])
 {
-    if (spriteTexture.get_width() == 0) {
+    int index = int(rint(in.textureIndex));
+    
+    if (index < 0 || index >= kTextureSlotCount || textures[index].get_width() == 0) {
         // No texture bound, output vertex color only
         return in.color;
     }
 
-    float4 texColor = spriteTexture.sample(spriteSampler, in.texCoord);
+    float4 texColor = textures[index].sample(spriteSampler, in.texCoord);
 
     // If texture sample is fully transparent (alpha == 0), fallback to vertex color
     if (texColor.a == 0.0) {
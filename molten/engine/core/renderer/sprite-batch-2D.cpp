@@ -0,0 +1,285 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sprite-batch-2D.h"
+
+#include <algorithm>
+
+#include "sprite-store.h"
+#include "quad-kernel.h"
+#include "../jobs/job-system.h"
+#include "../utils/profiler.h"
+
+void SpriteBatch2D::SetFormat(SpriteBatchFormat format)
+{
+    if (format == m_Format) return;
+    
+    m_Format = format;
+    
+    std::vector<VertexData2D>().swap(m_Vertices);
+    std::vector<PackedVertexData2D>().swap(m_PackedVertices);
+    std::vector<SpriteInstance2D>().swap(m_Instances);
+    m_DirtyRanges.clear();
+    
+    Resize(m_SpriteCount);
+}
+
+void SpriteBatch2D::Resize(size_t spriteCount)
+{
+    m_SpriteCount = spriteCount;
+    
+    switch (m_Format)
+    {
+        case SpriteBatchFormat::Vertices: m_Vertices.resize(spriteCount * VerticesPerSprite); break;
+        case SpriteBatchFormat::PackedVertices: m_PackedVertices.resize(spriteCount * PackedVerticesPerSprite); break;
+        case SpriteBatchFormat::Instances: m_Instances.resize(spriteCount); break;
+    }
+    
+    // Ranges past the new end no longer exist in the arena.
+    size_t byteSize = GetByteSize();
+    
+    for (size_t i = 0; i < m_DirtyRanges.size();)
+    {
+        BatchDirtyRange& range = m_DirtyRanges[i];
+        
+        if (range.offset >= byteSize)
+        {
+            m_DirtyRanges.erase(m_DirtyRanges.begin() + i);
+            continue;
+        }
+        
+        if (range.offset + range.size > byteSize) range.size = byteSize - range.offset;
+        
+        i++;
+    }
+}
+
+void SpriteBatch2D::MarkDirty(size_t offset, size_t size)
+{
+    // Slots are usually rewritten in ascending order, so neighbouring sprites
+    // collapse into a single range instead of one upload each.
+    if (!m_DirtyRanges.empty())
+    {
+        BatchDirtyRange& last = m_DirtyRanges.back();
+        
+        if (last.offset + last.size == offset)
+        {
+            last.size += size;
+            return;
+        }
+    }
+    
+    m_DirtyRanges.push_back({ offset, size });
+}
+
+void SpriteBatch2D::AddWorkItems(size_t first, size_t count)
+{
+    while (count > 0)
+    {
+        size_t chunkEnd = (first / ChunkSize + 1) * ChunkSize;
+        size_t itemCount = std::min(count, chunkEnd - first);
+        
+        m_WorkItems.push_back({ first, itemCount });
+        
+        first += itemCount;
+        count -= itemCount;
+    }
+}
+
+void SpriteBatch2D::ExpandWorkItems(const SpriteStore& sprites, JobSystem* jobs)
+{
+    PROFILE_SCOPE("SpriteBatch2D::ExpandWorkItems");
+    
+    if (m_SlotSprites && m_GatherPositionX.size() < m_SpriteCount)
+    {
+        m_GatherPositionX.resize(m_SpriteCount);
+        m_GatherPositionY.resize(m_SpriteCount);
+        m_GatherSizeX.resize(m_SpriteCount);
+        m_GatherSizeY.resize(m_SpriteCount);
+        m_GatherRotation.resize(m_SpriteCount);
+        m_GatherColor.resize(m_SpriteCount);
+        m_GatherUVRect.resize(m_SpriteCount);
+        m_GatherTextureIndex.resize(m_SpriteCount);
+    }
+    
+    auto expand = [this, &sprites](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const WorkItem& item = m_WorkItems[i];
+            
+            QuadKernelInput input;
+            
+            if (m_SlotSprites)
+            {
+                // Each item gathers only its own slots, so workers stay disjoint.
+                for (size_t slot = item.first; slot < item.first + item.count; slot++)
+                {
+                    uint32_t sprite = m_SlotSprites[slot];
+                    
+                    m_GatherPositionX[slot] = sprites.GetPositionsX()[sprite];
+                    m_GatherPositionY[slot] = sprites.GetPositionsY()[sprite];
+                    m_GatherSizeX[slot] = sprites.GetSizesX()[sprite];
+                    m_GatherSizeY[slot] = sprites.GetSizesY()[sprite];
+                    m_GatherRotation[slot] = sprites.GetRotations()[sprite];
+                    m_GatherColor[slot] = sprites.GetColors()[sprite];
+                    m_GatherUVRect[slot] = sprites.GetUVRects()[sprite];
+                    m_GatherTextureIndex[slot] = sprites.GetTextureIndices()[sprite];
+                }
+                
+                input.positionX = m_GatherPositionX.data() + item.first;
+                input.positionY = m_GatherPositionY.data() + item.first;
+                input.sizeX = m_GatherSizeX.data() + item.first;
+                input.sizeY = m_GatherSizeY.data() + item.first;
+                input.rotation = m_GatherRotation.data() + item.first;
+                input.color = m_GatherColor.data() + item.first;
+                input.uvRect = m_GatherUVRect.data() + item.first;
+                input.textureIndex = m_GatherTextureIndex.data() + item.first;
+            }
+            else
+            {
+                input.positionX = sprites.GetPositionsX() + item.first;
+                input.positionY = sprites.GetPositionsY() + item.first;
+                input.sizeX = sprites.GetSizesX() + item.first;
+                input.sizeY = sprites.GetSizesY() + item.first;
+                input.rotation = sprites.GetRotations() + item.first;
+                input.color = sprites.GetColors() + item.first;
+                input.uvRect = sprites.GetUVRects() + item.first;
+                input.textureIndex = sprites.GetTextureIndices() + item.first;
+            }
+            
+            switch (m_Format)
+            {
+                case SpriteBatchFormat::Vertices:
+                    QuadKernel::Expand(input, item.count, &m_Vertices[item.first * VerticesPerSprite]);
+                    break;
+                    
+                case SpriteBatchFormat::PackedVertices:
+                    QuadKernel::ExpandPacked(input, item.count, &m_PackedVertices[item.first * PackedVerticesPerSprite]);
+                    break;
+                    
+                case SpriteBatchFormat::Instances:
+                    PackSpriteInstances(input, item.count, &m_Instances[item.first]);
+                    break;
+            }
+        }
+    };
+    
+    // Items cover disjoint slots, so workers never touch the same bytes.
+    if (jobs && m_WorkItems.size() > 1) jobs->ParallelFor(m_WorkItems.size(), 1, expand);
+    else expand(0, m_WorkItems.size());
+    
+    m_WorkItems.clear();
+    m_SlotSprites = nullptr;
+}
+
+void SpriteBatch2D::WriteSprites(const SpriteStore& sprites, size_t first, size_t count, JobSystem* jobs)
+{
+    size_t limit = std::min(m_SpriteCount, sprites.Size());
+    if (first >= limit) return;
+    
+    count = std::min(count, limit - first);
+    
+    m_WorkItems.clear();
+    AddWorkItems(first, count);
+    ExpandWorkItems(sprites, jobs);
+    
+    MarkDirty(first * GetSpriteStride(), count * GetSpriteStride());
+}
+
+void SpriteBatch2D::WriteSprites(const SpriteStore& sprites, const std::vector<uint32_t>& sortedIndices, JobSystem* jobs)
+{
+    size_t limit = std::min(m_SpriteCount, sprites.Size());
+    
+    m_WorkItems.clear();
+    
+    for (size_t i = 0; i < sortedIndices.size();)
+    {
+        size_t runEnd = i + 1;
+        
+        while (runEnd < sortedIndices.size() && sortedIndices[runEnd] == sortedIndices[runEnd - 1] + 1)
+            runEnd++;
+        
+        size_t first = sortedIndices[i];
+        size_t count = runEnd - i;
+        
+        i = runEnd;
+        
+        // Slots past the end belong to sprites removed since they were marked.
+        if (first >= limit) break;
+        
+        count = std::min(count, limit - first);
+        
+        AddWorkItems(first, count);
+        MarkDirty(first * GetSpriteStride(), count * GetSpriteStride());
+    }
+    
+    ExpandWorkItems(sprites, jobs);
+}
+
+void SpriteBatch2D::WriteSpritesGathered(const SpriteStore& sprites, const std::vector<uint32_t>& slotSprites,
+                                         size_t first, size_t count, JobSystem* jobs)
+{
+    size_t limit = std::min(m_SpriteCount, slotSprites.size());
+    if (first >= limit) return;
+    
+    count = std::min(count, limit - first);
+    
+    m_WorkItems.clear();
+    AddWorkItems(first, count);
+    
+    m_SlotSprites = slotSprites.data();
+    ExpandWorkItems(sprites, jobs);
+    
+    MarkDirty(first * GetSpriteStride(), count * GetSpriteStride());
+}
+
+void SpriteBatch2D::WriteSpritesGathered(const SpriteStore& sprites, const std::vector<uint32_t>& slotSprites,
+                                         const std::vector<uint32_t>& sortedSlots, JobSystem* jobs)
+{
+    size_t limit = std::min(m_SpriteCount, slotSprites.size());
+    
+    m_WorkItems.clear();
+    
+    for (size_t i = 0; i < sortedSlots.size();)
+    {
+        size_t runEnd = i + 1;
+        
+        while (runEnd < sortedSlots.size() && sortedSlots[runEnd] == sortedSlots[runEnd - 1] + 1)
+            runEnd++;
+        
+        size_t first = sortedSlots[i];
+        size_t count = runEnd - i;
+        
+        i = runEnd;
+        
+        if (first >= limit) break;
+        
+        count = std::min(count, limit - first);
+        
+        AddWorkItems(first, count);
+        MarkDirty(first * GetSpriteStride(), count * GetSpriteStride());
+    }
+    
+    m_SlotSprites = slotSprites.data();
+    ExpandWorkItems(sprites, jobs);
+}
@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "vertex-data-2D.h"
+#include "sprite-instance-2D.h"
+
+class SpriteStore;
+class JobSystem;
+
+// Byte range of the batch arena that changed since the last upload.
+struct BatchDirtyRange
+{
+    size_t offset;
+    size_t size;
+};
+
+// What one batch slot holds: VerticesPerSprite expanded vertices, four
+// quantized corners drawn through a shared index buffer, or a single
+// SpriteInstance2D the vertex stage expands.
+enum class SpriteBatchFormat
+{
+    Vertices,
+    PackedVertices,
+    Instances
+};
+
+// CPU side of the persistent sprite batch: every sprite owns a fixed slot in
+// one contiguous arena. Only the slots that get rewritten are recorded as
+// dirty, so the renderer can upload just those bytes.
+class SpriteBatch2D
+{
+private:
+    
+    SpriteBatchFormat m_Format = SpriteBatchFormat::Vertices;
+    
+    // Only the array matching the format is in use.
+    std::vector<VertexData2D> m_Vertices;
+    std::vector<PackedVertexData2D> m_PackedVertices;
+    std::vector<SpriteInstance2D> m_Instances;
+    
+    std::vector<BatchDirtyRange> m_DirtyRanges;
+    
+    size_t m_SpriteCount = 0;
+    
+    // Slot ranges handed to the quad kernel, rebuilt by every write.
+    struct WorkItem
+    {
+        size_t first;
+        size_t count;
+    };
+    
+    std::vector<WorkItem> m_WorkItems;
+    
+    // For gathered writes: the sprite each slot takes, and the columns
+    // copied into slot order so the kernels can read them contiguously.
+    const uint32_t* m_SlotSprites = nullptr;
+    
+    std::vector<float> m_GatherPositionX;
+    std::vector<float> m_GatherPositionY;
+    std::vector<float> m_GatherSizeX;
+    std::vector<float> m_GatherSizeY;
+    std::vector<float> m_GatherRotation;
+    std::vector<Vec4> m_GatherColor;
+    std::vector<Vec4> m_GatherUVRect;
+    std::vector<int32_t> m_GatherTextureIndex;
+    
+    void MarkDirty(size_t offset, size_t size);
+    
+    void AddWorkItems(size_t first, size_t count);
+    
+    void ExpandWorkItems(const SpriteStore& sprites, JobSystem* jobs);
+    
+public:
+    
+    static constexpr size_t VerticesPerSprite = 6;
+    static constexpr size_t PackedVerticesPerSprite = 4;
+    static constexpr size_t IndicesPerSprite = 6;
+    
+    // Work items never cross a multiple of this many slots. The split only
+    // depends on which slots are written, never on the thread count, so the
+    // batch bytes come out identical however many workers run it.
+    static constexpr size_t ChunkSize = 1024;
+    
+    // Switching drops the arena's contents; every slot has to be written again.
+    void SetFormat(SpriteBatchFormat format);
+    
+    inline SpriteBatchFormat GetFormat() const { return m_Format; }
+    
+    // Grows or shrinks the arena to hold spriteCount slots, keeping existing data.
+    void Resize(size_t spriteCount);
+    
+    // Expands or packs the store's sprites [first, first + count) into the
+    // slots with the same indices. With a job system, chunks are written by the workers
+    // straight into their own slots.
+    void WriteSprites(const SpriteStore& sprites, size_t first, size_t count, JobSystem* jobs = nullptr);
+    
+    inline void WriteSprite(const SpriteStore& sprites, size_t index) { WriteSprites(sprites, index, 1); }
+    
+    // Same for a list of slots in ascending order; consecutive slots are
+    // written as one run.
+    void WriteSprites(const SpriteStore& sprites, const std::vector<uint32_t>& sortedIndices, JobSystem* jobs = nullptr);
+    
+    // Gathered variants for when slots don't match dense indices, e.g. a
+    // culled batch: slot s is written from sprite slotSprites[s].
+    void WriteSpritesGathered(const SpriteStore& sprites, const std::vector<uint32_t>& slotSprites,
+                              size_t first, size_t count, JobSystem* jobs = nullptr);
+    
+    void WriteSpritesGathered(const SpriteStore& sprites, const std::vector<uint32_t>& slotSprites,
+                              const std::vector<uint32_t>& sortedSlots, JobSystem* jobs = nullptr);
+    
+    inline const std::vector<BatchDirtyRange>& GetDirtyRanges() const { return m_DirtyRanges; }
+    
+    inline void ClearDirtyRanges() { m_DirtyRanges.clear(); }
+    
+    inline const VertexData2D* GetVertices() const { return m_Vertices.data(); }
+    
+    inline const PackedVertexData2D* GetPackedVertices() const { return m_PackedVertices.data(); }
+    
+    inline const SpriteInstance2D* GetInstances() const { return m_Instances.data(); }
+    
+    // Start of the arena in whichever format is active.
+    inline const void* GetData() const
+    {
+        switch (m_Format)
+        {
+            case SpriteBatchFormat::PackedVertices: return m_PackedVertices.data();
+            case SpriteBatchFormat::Instances: return m_Instances.data();
+            default: return m_Vertices.data();
+        }
+    }
+    
+    inline size_t GetSpriteCount() const { return m_SpriteCount; }
+    
+    inline size_t GetVertexCount() const { return m_Vertices.size(); }
+    
+    // Bytes one sprite occupies in the arena.
+    inline size_t GetSpriteStride() const
+    {
+        switch (m_Format)
+        {
+            case SpriteBatchFormat::PackedVertices: return PackedVerticesPerSprite * sizeof(PackedVertexData2D);
+            case SpriteBatchFormat::Instances: return sizeof(SpriteInstance2D);
+            default: return VerticesPerSprite * sizeof(VertexData2D);
+        }
+    }
+    
+    inline size_t GetByteSize() const { return m_SpriteCount * GetSpriteStride(); }
+};
@@ -0,0 +1,185 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sprite-grid.h"
+
+#include <cmath>
+
+// Radius of the circle around the sprite's center that holds it at any rotation.
+static inline float BoundingRadius(const SpriteStore& sprites, uint32_t index)
+{
+    float sizeX = sprites.GetSizesX()[index];
+    float sizeY = sprites.GetSizesY()[index];
+    
+    return 0.5f * std::sqrt(sizeX * sizeX + sizeY * sizeY);
+}
+
+SpriteGrid::SpriteGrid(float cellSize)
+: m_CellSize(cellSize > 0.0f ? cellSize : 256.0f) {}
+
+int32_t SpriteGrid::CellCoordinate(float value) const
+{
+    float cell = std::floor(value / m_CellSize);
+    
+    // Keeps far-off or non-finite positions from overflowing the key.
+    if (!(cell > -1.0e9f)) return -1000000000;
+    if (!(cell < 1.0e9f)) return 1000000000;
+    
+    return static_cast<int32_t>(cell);
+}
+
+void SpriteGrid::Unlink(Entry& entry)
+{
+    std::vector<uint32_t>* list = nullptr;
+    auto cell = m_Cells.end();
+    
+    if (entry.location == Location::Cell)
+    {
+        cell = m_Cells.find(entry.cell);
+        if (cell != m_Cells.end()) list = &cell->second;
+    }
+    else if (entry.location == Location::Large)
+    {
+        list = &m_Large;
+    }
+    
+    if (list)
+    {
+        // Swap-and-pop, fixing up the position of the entry that moved.
+        uint32_t moved = list->back();
+        (*list)[entry.position] = moved;
+        m_Entries[moved].position = entry.position;
+        list->pop_back();
+        
+        if (cell != m_Cells.end() && list->empty()) m_Cells.erase(cell);
+        
+        m_Count--;
+    }
+    
+    entry.location = Location::None;
+}
+
+void SpriteGrid::Update(const SpriteStore& sprites, uint32_t index)
+{
+    if (index >= sprites.Size()) return;
+    
+    SpriteHandle handle = sprites.HandleAt(index);
+    
+    if (handle.index >= m_Entries.size()) m_Entries.resize(handle.index + 1);
+    
+    Entry& entry = m_Entries[handle.index];
+    
+    Location location = Location::Large;
+    uint64_t cell = 0;
+    
+    if (BoundingRadius(sprites, index) <= m_CellSize * 0.5f)
+    {
+        location = Location::Cell;
+        cell = CellKey(CellCoordinate(sprites.GetPositionsX()[index]), CellCoordinate(sprites.GetPositionsY()[index]));
+    }
+    
+    // Most updates are sprites moving within their cell.
+    if (entry.handle == handle && entry.location == location && entry.cell == cell) return;
+    
+    Unlink(entry);
+    
+    std::vector<uint32_t>& list = location == Location::Cell ? m_Cells[cell] : m_Large;
+    
+    entry.handle = handle;
+    entry.cell = cell;
+    entry.position = static_cast<uint32_t>(list.size());
+    entry.location = location;
+    
+    list.push_back(handle.index);
+    
+    m_Count++;
+}
+
+void SpriteGrid::Remove(SpriteHandle handle)
+{
+    if (handle.index >= m_Entries.size()) return;
+    
+    Entry& entry = m_Entries[handle.index];
+    if (entry.handle == handle) Unlink(entry);
+}
+
+void SpriteGrid::Clear()
+{
+    m_Cells.clear();
+    m_Large.clear();
+    m_Entries.clear();
+    m_Count = 0;
+}
+
+void SpriteGrid::Query(const SpriteStore& sprites, const Rect2D& rect, std::vector<uint32_t>& indices) const
+{
+    auto visit = [&](const std::vector<uint32_t>& list)
+    {
+        for (uint32_t slot : list)
+        {
+            uint32_t index = sprites.IndexOf(m_Entries[slot].handle);
+            if (index == SpriteStore::InvalidIndex) continue;
+            
+            float radius = BoundingRadius(sprites, index);
+            float x = sprites.GetPositionsX()[index];
+            float y = sprites.GetPositionsY()[index];
+            
+            if (x + radius >= rect.min.x && x - radius <= rect.max.x && y + radius >= rect.min.y && y - radius <= rect.max.y)
+                indices.push_back(index);
+        }
+    };
+    
+    visit(m_Large);
+    
+    // Sprites reach at most half a cell past the cell holding their center.
+    float looseness = m_CellSize * 0.5f;
+    
+    int32_t minX = CellCoordinate(rect.min.x - looseness);
+    int32_t minY = CellCoordinate(rect.min.y - looseness);
+    int32_t maxX = CellCoordinate(rect.max.x + looseness);
+    int32_t maxY = CellCoordinate(rect.max.y + looseness);
+    
+    double rangeCells = (static_cast<double>(maxX) - minX + 1.0) * (static_cast<double>(maxY) - minY + 1.0);
+    
+    // Zoomed far out, walking the occupied cells beats probing every empty one.
+    if (rangeCells > static_cast<double>(m_Cells.size()))
+    {
+        for (const auto& [key, list] : m_Cells)
+        {
+            int32_t x = static_cast<int32_t>(key >> 32);
+            int32_t y = static_cast<int32_t>(key & 0xFFFFFFFFu);
+            
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY) visit(list);
+        }
+        
+        return;
+    }
+    
+    for (int32_t y = minY; y <= maxY; y++)
+    {
+        for (int32_t x = minX; x <= maxX; x++)
+        {
+            auto cell = m_Cells.find(CellKey(x, y));
+            if (cell != m_Cells.end()) visit(cell->second);
+        }
+    }
+}
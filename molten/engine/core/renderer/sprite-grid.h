@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+#include "sprite-store.h"
+#include "camera-2D.h"
+
+// Loose, hashed uniform grid over the sprites of a SpriteStore. Each sprite
+// lives in the one cell holding its center, and queries widen the rectangle
+// by half a cell, so a sprite no bigger than a cell is always found. Larger
+// sprites are kept in a separate list every query checks. Only occupied
+// cells exist, so the world can be any size.
+//
+// Entries are keyed by the handle's slot index, which stays the same while
+// the store reorders its dense columns.
+class SpriteGrid
+{
+private:
+    
+    enum class Location : uint8_t
+    {
+        None,
+        Cell,
+        Large
+    };
+    
+    struct Entry
+    {
+        SpriteHandle handle;
+        uint64_t cell = 0;
+        uint32_t position = 0;
+        Location location = Location::None;
+    };
+    
+    float m_CellSize;
+    
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+    std::vector<uint32_t> m_Large;
+    
+    std::vector<Entry> m_Entries;
+    
+    size_t m_Count = 0;
+    
+    void Unlink(Entry& entry);
+    
+    int32_t CellCoordinate(float value) const;
+    
+    static uint64_t CellKey(int32_t x, int32_t y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    
+public:
+    
+    explicit SpriteGrid(float cellSize = 256.0f);
+    
+    // Inserts the sprite at the dense index or moves it to the cell its
+    // current position and size put it in.
+    void Update(const SpriteStore& sprites, uint32_t index);
+    
+    void Remove(SpriteHandle handle);
+    
+    void Clear();
+    
+    // Appends the dense index of every sprite whose bounds overlap the
+    // rectangle, in no particular order.
+    void Query(const SpriteStore& sprites, const Rect2D& rect, std::vector<uint32_t>& indices) const;
+    
+    inline float GetCellSize() const { return m_CellSize; }
+    
+    inline size_t GetCellCount() const { return m_Cells.size(); }
+    
+    inline size_t GetCount() const { return m_Count; }
+};
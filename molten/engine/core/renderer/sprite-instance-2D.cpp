@@ -0,0 +1,55 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sprite-instance-2D.h"
+
+#include "vertex-data-2D.h"
+
+void PackSpriteInstances(const QuadKernelInput& sprites, size_t count, SpriteInstance2D* instances)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        SpriteInstance2D& instance = instances[i];
+        
+        instance.position[0] = sprites.positionX[i];
+        instance.position[1] = sprites.positionY[i];
+        instance.size[0] = sprites.sizeX[i];
+        instance.size[1] = sprites.sizeY[i];
+        instance.rotation = sprites.rotation[i];
+        
+        const Vec4& color = sprites.color[i];
+        
+        instance.color[0] = PackUnorm8(color.x);
+        instance.color[1] = PackUnorm8(color.y);
+        instance.color[2] = PackUnorm8(color.z);
+        instance.color[3] = PackUnorm8(color.w);
+        
+        const Vec4& uvRect = sprites.uvRect[i];
+        
+        instance.uvRect[0] = PackUnorm16(uvRect.x);
+        instance.uvRect[1] = PackUnorm16(uvRect.y);
+        instance.uvRect[2] = PackUnorm16(uvRect.z);
+        instance.uvRect[3] = PackUnorm16(uvRect.w);
+        
+        instance.textureIndex = sprites.textureIndex[i];
+    }
+}
@@ -0,0 +1,52 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "quad-kernel.h"
+
+// Compact per-sprite record for instanced drawing: the vertex stage of
+// spriteInstanceVertexShader expands it into the quad, so the CPU writes one
+// of these instead of VerticesPerQuad full vertices. Plain arrays keep the
+// struct 4-byte aligned, so it packs to exactly 36 bytes.
+struct SpriteInstance2D
+{
+    float position[2];
+    float size[2];
+    float rotation;
+    
+    // RGBA8, read as UChar4Normalized.
+    uint8_t color[4];
+    
+    // Atlas rect (u0, v0, u1, v1) as UShort4Normalized, clamped to [0, 1].
+    uint16_t uvRect[4];
+    
+    int32_t textureIndex;
+};
+
+static_assert(sizeof(SpriteInstance2D) == 36, "SpriteInstance2D must match the instance vertex descriptor");
+
+// Packs count sprites from the given columns into instance records.
+void PackSpriteInstances(const QuadKernelInput& sprites, size_t count, SpriteInstance2D* instances);
@@ -0,0 +1,397 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sprite-store.h"
+
+#include "texture-2D.h"
+
+// Replaces column with its elements gathered in the given order.
+template <typename T>
+static void Permute(std::vector<T>& column, const uint32_t* order)
+{
+    std::vector<T> permuted;
+    permuted.reserve(column.size());
+    
+    for (size_t i = 0; i < column.size(); i++)
+        permuted.push_back(std::move(column[order[i]]));
+    
+    column.swap(permuted);
+}
+
+SpriteHandle SpriteStore::Create(const Vec2& position, const Vec2& size, float rotation,
+                                 const Vec4& color, std::shared_ptr<Texture2D> texture)
+{
+    uint32_t slotIndex;
+    
+    if (!m_FreeSlots.empty())
+    {
+        slotIndex = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        slotIndex = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+    
+    uint32_t dense = static_cast<uint32_t>(Size());
+    
+    m_Slots[slotIndex].dense = dense;
+    
+    SpriteHandle handle = { slotIndex, m_Slots[slotIndex].generation };
+    
+    m_PositionX.push_back(position.x);
+    m_PositionY.push_back(position.y);
+    m_SizeX.push_back(size.x);
+    m_SizeY.push_back(size.y);
+    m_Rotation.push_back(rotation);
+    m_Color.push_back(color);
+    m_UVRect.push_back(Vec4{0.0f, 0.0f, 1.0f, 1.0f});
+    m_TextureIndex.push_back(NoTexture);
+    m_Layer.push_back(0);
+    m_Depth.push_back(0.0f);
+    m_BlendMode.push_back(BlendMode::Opaque);
+    m_Owner.push_back(nullptr);
+    m_DenseToSlot.push_back(slotIndex);
+    m_DirtyPosition.push_back(InvalidIndex);
+    
+    if (texture) m_UnresolvedTextures.push_back(handle);
+    m_Texture.push_back(std::move(texture));
+    
+    MarkDirty(dense);
+    m_OrderChanged = true;
+    
+    return handle;
+}
+
+bool SpriteStore::Destroy(SpriteHandle handle)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return false;
+    
+    uint32_t last = static_cast<uint32_t>(Size() - 1);
+    
+    if (index != last)
+    {
+        m_PositionX[index] = m_PositionX[last];
+        m_PositionY[index] = m_PositionY[last];
+        m_SizeX[index] = m_SizeX[last];
+        m_SizeY[index] = m_SizeY[last];
+        m_Rotation[index] = m_Rotation[last];
+        m_Color[index] = m_Color[last];
+        m_UVRect[index] = m_UVRect[last];
+        m_TextureIndex[index] = m_TextureIndex[last];
+        m_Layer[index] = m_Layer[last];
+        m_Depth[index] = m_Depth[last];
+        m_BlendMode[index] = m_BlendMode[last];
+        m_Texture[index] = std::move(m_Texture[last]);
+        m_Owner[index] = m_Owner[last];
+        m_DenseToSlot[index] = m_DenseToSlot[last];
+        
+        m_Slots[m_DenseToSlot[index]].dense = index;
+        
+        // The moved sprite now occupies a different batch slot and draws out of order.
+        MarkDirty(index);
+        m_OrderChanged = true;
+    }
+    
+    // The last index goes away; left in the list, the next Create would queue it twice.
+    if (uint32_t position = m_DirtyPosition[last]; position != InvalidIndex)
+    {
+        uint32_t moved = m_DirtyIndices.back();
+        m_DirtyIndices[position] = moved;
+        m_DirtyPosition[moved] = position;
+        m_DirtyIndices.pop_back();
+    }
+    
+    m_PositionX.pop_back();
+    m_PositionY.pop_back();
+    m_SizeX.pop_back();
+    m_SizeY.pop_back();
+    m_Rotation.pop_back();
+    m_Color.pop_back();
+    m_UVRect.pop_back();
+    m_TextureIndex.pop_back();
+    m_Layer.pop_back();
+    m_Depth.pop_back();
+    m_BlendMode.pop_back();
+    m_Texture.pop_back();
+    m_Owner.pop_back();
+    m_DenseToSlot.pop_back();
+    m_DirtyPosition.pop_back();
+    
+    m_Destroyed.push_back(handle);
+    
+    Slot& slot = m_Slots[handle.index];
+    slot.dense = InvalidIndex;
+    
+    // Generation 0 is reserved for invalid handles.
+    if (++slot.generation == 0) slot.generation = 1;
+    
+    m_FreeSlots.push_back(handle.index);
+    
+    return true;
+}
+
+void SpriteStore::Clear()
+{
+    for (uint32_t i = 0; i < m_DenseToSlot.size(); i++)
+    {
+        Slot& slot = m_Slots[m_DenseToSlot[i]];
+        slot.dense = InvalidIndex;
+        
+        if (++slot.generation == 0) slot.generation = 1;
+        
+        m_FreeSlots.push_back(m_DenseToSlot[i]);
+    }
+    
+    m_PositionX.clear();
+    m_PositionY.clear();
+    m_SizeX.clear();
+    m_SizeY.clear();
+    m_Rotation.clear();
+    m_Color.clear();
+    m_UVRect.clear();
+    m_TextureIndex.clear();
+    m_Layer.clear();
+    m_Depth.clear();
+    m_BlendMode.clear();
+    m_Texture.clear();
+    m_Owner.clear();
+    m_DenseToSlot.clear();
+    m_DirtyPosition.clear();
+    
+    m_DirtyIndices.clear();
+    m_UnresolvedTextures.clear();
+    m_Destroyed.clear();
+    m_OrderChanged = false;
+}
+
+void SpriteStore::SetPosition(SpriteHandle handle, const Vec2& position)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_PositionX[index] = position.x;
+    m_PositionY[index] = position.y;
+    MarkDirty(index);
+}
+
+void SpriteStore::SetSize(SpriteHandle handle, const Vec2& size)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_SizeX[index] = size.x;
+    m_SizeY[index] = size.y;
+    MarkDirty(index);
+}
+
+void SpriteStore::SetRotation(SpriteHandle handle, float radians)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Rotation[index] = radians;
+    MarkDirty(index);
+}
+
+void SpriteStore::SetTransform(SpriteHandle handle, const Vec2& position, float radians, const Vec2& size)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_PositionX[index] = position.x;
+    m_PositionY[index] = position.y;
+    m_Rotation[index] = radians;
+    m_SizeX[index] = size.x;
+    m_SizeY[index] = size.y;
+    MarkDirty(index);
+}
+
+void SpriteStore::SetColor(SpriteHandle handle, const Vec4& color)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Color[index] = color;
+    MarkDirty(index);
+}
+
+void SpriteStore::SetTexture(SpriteHandle handle, std::shared_ptr<Texture2D> texture)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    if (texture) m_UnresolvedTextures.push_back(handle);
+    
+    m_Texture[index] = std::move(texture);
+    m_TextureIndex[index] = NoTexture;
+    m_UVRect[index] = Vec4{0.0f, 0.0f, 1.0f, 1.0f};
+    MarkDirty(index);
+    m_OrderChanged = true;
+}
+
+void SpriteStore::SetTextureRegion(SpriteHandle handle, int32_t textureIndex, const Vec4& uvRect)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_TextureIndex[index] = textureIndex;
+    m_UVRect[index] = uvRect;
+    MarkDirty(index);
+    m_OrderChanged = true;
+}
+
+void SpriteStore::SetLayer(SpriteHandle handle, int16_t layer)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_Layer[index] == layer) return;
+    
+    m_Layer[index] = layer;
+    m_OrderChanged = true;
+}
+
+void SpriteStore::SetDepth(SpriteHandle handle, float depth)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_Depth[index] == depth) return;
+    
+    m_Depth[index] = depth;
+    m_OrderChanged = true;
+}
+
+void SpriteStore::SetBlendMode(SpriteHandle handle, BlendMode blendMode)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex || m_BlendMode[index] == blendMode) return;
+    
+    m_BlendMode[index] = blendMode;
+    m_OrderChanged = true;
+}
+
+void SpriteStore::SetOwner(SpriteHandle handle, Sprite2D* owner)
+{
+    uint32_t index = IndexOf(handle);
+    if (index != InvalidIndex) m_Owner[index] = owner;
+}
+
+Vec2 SpriteStore::GetPosition(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? Vec2{m_PositionX[index], m_PositionY[index]} : Vec2{0.0f, 0.0f};
+}
+
+Vec2 SpriteStore::GetSize(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? Vec2{m_SizeX[index], m_SizeY[index]} : Vec2{0.0f, 0.0f};
+}
+
+float SpriteStore::GetRotation(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Rotation[index] : 0.0f;
+}
+
+Vec4 SpriteStore::GetColor(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Color[index] : Vec4{0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+Vec4 SpriteStore::GetUVRect(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_UVRect[index] : Vec4{0.0f, 0.0f, 1.0f, 1.0f};
+}
+
+int32_t SpriteStore::GetTextureIndex(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_TextureIndex[index] : NoTexture;
+}
+
+int16_t SpriteStore::GetLayer(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Layer[index] : 0;
+}
+
+float SpriteStore::GetDepth(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Depth[index] : 0.0f;
+}
+
+BlendMode SpriteStore::GetBlendMode(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_BlendMode[index] : BlendMode::Opaque;
+}
+
+Texture2D* SpriteStore::GetTexture(SpriteHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Texture[index].get() : nullptr;
+}
+
+void SpriteStore::ClearDirty()
+{
+    for (uint32_t index : m_DirtyIndices)
+        m_DirtyPosition[index] = InvalidIndex;
+    
+    m_DirtyIndices.clear();
+}
+
+void SpriteStore::MarkAllDirty()
+{
+    for (uint32_t i = 0; i < Size(); i++)
+        MarkDirty(i);
+}
+
+void SpriteStore::Reorder(const uint32_t* order)
+{
+    Permute(m_PositionX, order);
+    Permute(m_PositionY, order);
+    Permute(m_SizeX, order);
+    Permute(m_SizeY, order);
+    Permute(m_Rotation, order);
+    Permute(m_Color, order);
+    Permute(m_UVRect, order);
+    Permute(m_TextureIndex, order);
+    Permute(m_Layer, order);
+    Permute(m_Depth, order);
+    Permute(m_BlendMode, order);
+    Permute(m_Texture, order);
+    Permute(m_Owner, order);
+    Permute(m_DenseToSlot, order);
+    
+    // Dirty marks stay with the indices: a slot rewritten before the move
+    // still has to be rewritten, and so does every slot that moved.
+    for (uint32_t i = 0; i < Size(); i++)
+    {
+        m_Slots[m_DenseToSlot[i]].dense = i;
+        
+        if (order[i] != i) MarkDirty(i);
+    }
+}
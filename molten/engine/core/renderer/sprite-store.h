@@ -0,0 +1,196 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "../maths/vector.h"
+#include "render-device.h"
+
+class Texture2D;
+class Sprite2D;
+
+// Stable reference to a sprite in a SpriteStore. The generation changes every
+// time a slot is reused, so a handle to a destroyed sprite never aliases the
+// sprite that replaced it.
+struct SpriteHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const SpriteHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SpriteHandle& other) const { return !(*this == other); }
+};
+
+// Sprite data in dense struct-of-arrays columns. Create, Destroy and handle
+// lookup are O(1): handles go through a sparse slot table to the dense index,
+// and removal moves the last sprite into the hole (swap-and-pop), so the
+// columns never have gaps. Dense indices are also the sprites' batch slots
+// and their draw order; the renderer reorders them to sort sprites.
+class SpriteStore
+{
+private:
+    
+    struct Slot
+    {
+        uint32_t generation = 1;
+        uint32_t dense = InvalidIndex;
+    };
+    
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+    
+    // Dense columns, all the same length.
+    std::vector<float> m_PositionX;
+    std::vector<float> m_PositionY;
+    std::vector<float> m_SizeX;
+    std::vector<float> m_SizeY;
+    std::vector<float> m_Rotation;
+    std::vector<Vec4> m_Color;
+    std::vector<Vec4> m_UVRect;
+    std::vector<int32_t> m_TextureIndex;
+    std::vector<int16_t> m_Layer;
+    std::vector<float> m_Depth;
+    std::vector<BlendMode> m_BlendMode;
+    std::vector<std::shared_ptr<Texture2D>> m_Texture;
+    std::vector<Sprite2D*> m_Owner;
+    std::vector<uint32_t> m_DenseToSlot;
+    
+    // Dense indices written since the last ClearDirty, each listed once, and
+    // where each index sits in that list (InvalidIndex when clean).
+    std::vector<uint32_t> m_DirtyIndices;
+    std::vector<uint32_t> m_DirtyPosition;
+    
+    // Sprites that got a texture but no atlas region yet.
+    std::vector<SpriteHandle> m_UnresolvedTextures;
+    
+    // Sprites destroyed since the last time the renderer drained this.
+    std::vector<SpriteHandle> m_Destroyed;
+    
+    // Set whenever something the draw order depends on changes.
+    bool m_OrderChanged = false;
+    
+    inline void MarkDirty(uint32_t index)
+    {
+        if (m_DirtyPosition[index] != InvalidIndex) return;
+        
+        m_DirtyPosition[index] = static_cast<uint32_t>(m_DirtyIndices.size());
+        m_DirtyIndices.push_back(index);
+    }
+    
+public:
+    
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+    static constexpr int32_t NoTexture = -1;
+    
+    SpriteHandle Create(const Vec2& position, const Vec2& size, float rotation,
+                        const Vec4& color, std::shared_ptr<Texture2D> texture = nullptr);
+    
+    bool Destroy(SpriteHandle handle);
+    
+    void Clear();
+    
+    inline bool IsAlive(SpriteHandle handle) const
+    {
+        return handle.index < m_Slots.size() && m_Slots[handle.index].generation == handle.generation &&
+               m_Slots[handle.index].dense != InvalidIndex;
+    }
+    
+    // Dense index of a live sprite, or InvalidIndex.
+    inline uint32_t IndexOf(SpriteHandle handle) const { return IsAlive(handle) ? m_Slots[handle.index].dense : InvalidIndex; }
+    
+    inline SpriteHandle HandleAt(uint32_t index) const { return { m_DenseToSlot[index], m_Slots[m_DenseToSlot[index]].generation }; }
+    
+    inline size_t Size() const { return m_PositionX.size(); }
+    
+    // Per-sprite access through handles. Setters ignore dead handles.
+    
+    void SetPosition(SpriteHandle handle, const Vec2& position);
+    void SetSize(SpriteHandle handle, const Vec2& size);
+    void SetRotation(SpriteHandle handle, float radians);
+    
+    // Position, rotation and size in one lookup, for systems that drive
+    // sprites from their own transforms.
+    void SetTransform(SpriteHandle handle, const Vec2& position, float radians, const Vec2& size);
+    
+    void SetColor(SpriteHandle handle, const Vec4& color);
+    void SetTexture(SpriteHandle handle, std::shared_ptr<Texture2D> texture);
+    void SetTextureRegion(SpriteHandle handle, int32_t textureIndex, const Vec4& uvRect);
+    void SetLayer(SpriteHandle handle, int16_t layer);
+    void SetDepth(SpriteHandle handle, float depth);
+    void SetBlendMode(SpriteHandle handle, BlendMode blendMode);
+    void SetOwner(SpriteHandle handle, Sprite2D* owner);
+    
+    Vec2 GetPosition(SpriteHandle handle) const;
+    Vec2 GetSize(SpriteHandle handle) const;
+    float GetRotation(SpriteHandle handle) const;
+    Vec4 GetColor(SpriteHandle handle) const;
+    Vec4 GetUVRect(SpriteHandle handle) const;
+    int32_t GetTextureIndex(SpriteHandle handle) const;
+    int16_t GetLayer(SpriteHandle handle) const;
+    float GetDepth(SpriteHandle handle) const;
+    BlendMode GetBlendMode(SpriteHandle handle) const;
+    Texture2D* GetTexture(SpriteHandle handle) const;
+    
+    // Column access for systems that walk every sprite.
+    
+    inline const float* GetPositionsX() const { return m_PositionX.data(); }
+    inline const float* GetPositionsY() const { return m_PositionY.data(); }
+    inline const float* GetSizesX() const { return m_SizeX.data(); }
+    inline const float* GetSizesY() const { return m_SizeY.data(); }
+    inline const float* GetRotations() const { return m_Rotation.data(); }
+    inline const Vec4* GetColors() const { return m_Color.data(); }
+    inline const Vec4* GetUVRects() const { return m_UVRect.data(); }
+    inline const int32_t* GetTextureIndices() const { return m_TextureIndex.data(); }
+    inline const int16_t* GetLayers() const { return m_Layer.data(); }
+    inline const float* GetDepths() const { return m_Depth.data(); }
+    inline const BlendMode* GetBlendModes() const { return m_BlendMode.data(); }
+    inline const std::shared_ptr<Texture2D>* GetTextures() const { return m_Texture.data(); }
+    inline Sprite2D* const* GetOwners() const { return m_Owner.data(); }
+    
+    inline const std::vector<uint32_t>& GetDirtyIndices() const { return m_DirtyIndices; }
+    
+    void ClearDirty();
+    
+    // Every sprite needs rewriting, e.g. after the batch was reallocated.
+    void MarkAllDirty();
+    
+    inline std::vector<SpriteHandle>& GetUnresolvedTextures() { return m_UnresolvedTextures; }
+    
+    // Handles of destroyed sprites, for indices kept outside the store.
+    inline std::vector<SpriteHandle>& GetDestroyed() { return m_Destroyed; }
+    
+    // Whether sprites were added, removed or changed layer, depth, blend mode
+    // or texture since the last ClearOrderChanged.
+    inline bool HasOrderChanged() const { return m_OrderChanged; }
+    
+    inline void ClearOrderChanged() { m_OrderChanged = false; }
+    
+    // Moves the sprite at dense index order[i] to index i for every i; order
+    // must be a permutation of [0, Size()). Handles stay valid and every
+    // index whose contents changed is marked dirty.
+    void Reorder(const uint32_t* order);
+};
@@ -17,50 +17,151 @@
 
 #include "texture-2D.h"
 
-#include <Metal/Metal.hpp>
+#include <cstring>
+#include <vector>
 
+#include "cooked-texture.h"
+#include "texture-atlas.h"
 #include "../utils/image.h"
+#include "../utils/mip-chain.h"
 #include "../utils/log-macros.h"
 
 Texture2D::Texture2D(const char* filepath)
-    : m_Image(new Image(filepath))
+    : m_Filepath(filepath ? filepath : ""), m_AtlasKey(TextureAtlas::MakeKey(m_Filepath))
 {
-    m_Image = new Image(filepath);
+    if (filepath) m_Cooked = CookedTexture::OpenForSource(m_Filepath);
+    
+    if (m_Cooked)
+    {
+        m_State = TextureState::Ready;
+        return;
+    }
+    
+    SetImage(filepath ? new Image(filepath) : nullptr);
+    
+    if (m_State == TextureState::Failed) LOG_CORE_ERROR("Image loading failed, Texture2D not created.");
+}
 
-    if (!m_Image->IsValid())
+Texture2D::Texture2D(const std::string& filepath, Image* image)
+    : m_Filepath(filepath), m_AtlasKey(TextureAtlas::MakeKey(filepath)), m_Image(image), m_State(TextureState::Ready)
+{
+    if (!m_Image || !m_Image->IsValid())
     {
-        m_Image = nullptr;
-        m_MetalTexture = nullptr;
-        
         delete m_Image;
         
+        m_Image = nullptr;
+        m_State = TextureState::Failed;
+        
         LOG_CORE_ERROR("Image loading failed, Texture2D not created.");
     }
 }
 
-void Texture2D::SetMetalDevice(MTL::Device* metalDevice)
+Texture2D::Texture2D(const std::string& filepath, CookedTexture* cooked)
+    : m_Filepath(filepath), m_AtlasKey(TextureAtlas::MakeKey(filepath)), m_Cooked(cooked), m_State(cooked ? TextureState::Ready : TextureState::Failed) {}
+
+Texture2D* Texture2D::CreatePending(const std::string& filepath)
 {
-    if (!m_Image) return;
+    Texture2D* texture = new Texture2D();
+    texture->m_Filepath = filepath;
+    texture->m_AtlasKey = TextureAtlas::MakeKey(filepath);
+    
+    return texture;
+}
+
+void Texture2D::SetImage(Image* image)
+{
+    if (m_State != TextureState::Loading)
+    {
+        delete image;
+        return;
+    }
+    
+    if (!image || !image->IsValid())
+    {
+        delete image;
+        
+        // Image already logged why it failed.
+        m_State = TextureState::Failed;
+        return;
+    }
+    
+    m_Image = image;
+    m_State = TextureState::Ready;
+}
+
+void Texture2D::SetCooked(CookedTexture* cooked)
+{
+    if (m_State != TextureState::Loading || !cooked)
+    {
+        delete cooked;
+        
+        if (m_State == TextureState::Loading) m_State = TextureState::Failed;
+        return;
+    }
     
-    MTL::TextureDescriptor* textureDescriptor = MTL::TextureDescriptor::alloc()->init();
+    m_Cooked = cooked;
+    m_State = TextureState::Ready;
+}
+
+uint32_t Texture2D::GetWidth() const
+{
+    if (m_Cooked) return m_Cooked->GetDesc().width;
     
-    textureDescriptor->setPixelFormat(MTL::PixelFormatRGBA8Unorm);
-    textureDescriptor->setWidth(m_Image->GetWidth());
-    textureDescriptor->setHeight(m_Image->GetHeight());
+    return m_Image ? static_cast<uint32_t>(m_Image->GetWidth()) : 0;
+}
+
+uint32_t Texture2D::GetHeight() const
+{
+    if (m_Cooked) return m_Cooked->GetDesc().height;
+    
+    return m_Image ? static_cast<uint32_t>(m_Image->GetHeight()) : 0;
+}
 
-    m_MetalTexture = metalDevice->newTexture(textureDescriptor);
+TextureFormat Texture2D::GetFormat() const
+{
+    return m_Cooked ? m_Cooked->GetDesc().format : TextureFormat::RGBA8Unorm;
+}
 
-    MTL::Region region = MTL::Region(0, 0, 0, m_Image->GetWidth(), m_Image->GetHeight(), 1);
-    NS::UInteger bytesPerRow = 4 * m_Image->GetWidth();
+const uint8_t* Texture2D::GetPixels() const
+{
+    if (m_Cooked) return m_Cooked->GetData();
+    
+    return m_Image ? m_Image->GetData() : nullptr;
+}
 
-    m_MetalTexture->replaceRegion(region, 0, m_Image->GetData(), bytesPerRow);
+void Texture2D::Upload(RenderDevice* device, JobSystem* jobSystem)
+{
+    if (!device || m_Handle.IsValid()) return;
+    
+    if (m_Cooked)
+    {
+        m_Device = device;
+        m_Handle = device->CreateTexture(m_Cooked->GetDesc(), m_Cooked->GetData());
+        return;
+    }
+    
+    if (!m_Image) return;
+    
+    TextureDesc desc;
+    desc.width = m_Image->GetWidth();
+    desc.height = m_Image->GetHeight();
+    desc.format = TextureFormat::RGBA8Unorm;
+    desc.mipLevelCount = GetMipLevelCount(desc.width, desc.height);
+    
+    // The chain is only needed until the device has its copy.
+    std::vector<uint8_t> chain(GetMipChainSize(desc.width, desc.height, desc.mipLevelCount));
+    std::memcpy(chain.data(), m_Image->GetData(), size_t(desc.width) * desc.height * 4);
+    
+    GenerateMipChain(chain.data(), desc.width, desc.height, desc.mipLevelCount, MipFilterOptions(), jobSystem);
 
-    textureDescriptor->release();
+    m_Device = device;
+    m_Handle = device->CreateTexture(desc, chain.data());
 }
 
 Texture2D::~Texture2D()
 {
     if(m_Image) delete m_Image;
+    if(m_Cooked) delete m_Cooked;
     
-    m_MetalTexture->release();
+    if (m_Device && m_Handle.IsValid()) m_Device->DestroyTexture(m_Handle);
 }
@@ -20,28 +20,89 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-namespace MTL
-{
-    class Device;
-    class Texture;
-}
+#include <string>
+
+#include "render-device.h"
 
 class Image;
+class CookedTexture;
+class JobSystem;
+
+enum class TextureState : uint8_t
+{
+    Loading,
+    Ready,
+    Failed
+};
 
 class Texture2D
 {
 private:
+    std::string m_Filepath;
+    
+    // Name the image is packed under in an atlas: TextureAtlas::MakeKey of
+    // the file path, unless the texture came from elsewhere.
+    std::string m_AtlasKey;
+    
+    // Pixels come from either a decoded image or a cooked file, never both.
     Image* m_Image = nullptr;
+    CookedTexture* m_Cooked = nullptr;
+    
+    TextureState m_State = TextureState::Loading;
     
-    MTL::Texture* m_MetalTexture = nullptr;
+    RenderDevice* m_Device = nullptr;
+    TextureHandle m_Handle;
+    
+    Texture2D() = default;
     
 public:
+    // Uses the cooked twin of the file (see CookedTexture) when there is an
+    // up to date one, and decodes the file otherwise.
     explicit Texture2D(const char* filepath);
     
-    void SetMetalDevice(MTL::Device* metalDevice);
+    // Takes ownership of an already decoded image.
+    explicit Texture2D(const std::string& filepath, Image* image);
+    
+    // Takes ownership of an opened cooked texture.
+    explicit Texture2D(const std::string& filepath, CookedTexture* cooked);
+    
+    Texture2D(const Texture2D&) = delete;
+    Texture2D& operator=(const Texture2D&) = delete;
+    
+    // A texture whose image is still being decoded somewhere else. It reads
+    // as loading, and renderers draw a placeholder, until SetImage.
+    static Texture2D* CreatePending(const std::string& filepath);
+    
+    // Hands over the image of a pending texture; an invalid or null image
+    // marks it failed. Call it from the thread that renders.
+    void SetImage(Image* image);
+    void SetCooked(CookedTexture* cooked);
+    
+    // Creates the device texture with a full mip chain: filtered from the
+    // image, with the job system's help for large ones, or every level of the
+    // cooked file straight from its mapping. Only the first call uploads.
+    void Upload(RenderDevice* device, JobSystem* jobSystem = nullptr);
+    
+    inline const std::string& GetFilepath() const { return m_Filepath; }
+    
+    inline const std::string& GetAtlasKey() const { return m_AtlasKey; }
+    inline void SetAtlasKey(const std::string& key) { m_AtlasKey = key; }
     
     inline const Image* GetImage() const { return m_Image; }
-    inline MTL::Texture* GetMetalTexture() const { return m_MetalTexture; }
+    inline const CookedTexture* GetCooked() const { return m_Cooked; }
+    
+    inline bool HasPixels() const { return m_Image || m_Cooked; }
+    
+    // Size and format of the top level, and its pixels; cooked textures may
+    // be block compressed.
+    uint32_t GetWidth() const;
+    uint32_t GetHeight() const;
+    TextureFormat GetFormat() const;
+    const uint8_t* GetPixels() const;
+    inline TextureHandle GetHandle() const { return m_Handle; }
+    
+    inline TextureState GetState() const { return m_State; }
+    inline bool IsLoading() const { return m_State == TextureState::Loading; }
     
     ~Texture2D();
 };
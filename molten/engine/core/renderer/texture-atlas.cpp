@@ -0,0 +1,495 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "texture-atlas.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+#include <filesystem>
+
+#include "../utils/image.h"
+#include "../utils/mip-chain.h"
+#include "../utils/log-macros.h"
+
+static constexpr char AtlasFileMagic[4] = { 'M', 'A', 'T', 'L' };
+static constexpr uint32_t AtlasFileVersion = 2;
+
+struct AtlasFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t pageSize;
+    uint32_t padding;
+    uint32_t extrude;
+    uint32_t pageCount;
+    uint32_t regionCount;
+};
+
+struct AtlasFileRegion
+{
+    uint32_t keyLength;
+    uint32_t page;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t padding, uint32_t extrude, uint32_t mipLevels)
+: m_PageSize(pageSize), m_Padding(padding), m_Extrude(extrude), m_MipLevels(mipLevels) {}
+
+TextureAtlas::Page* TextureAtlas::AddPage(uint32_t width, uint32_t height)
+{
+    if (m_Pages.size() >= MaxPages) return nullptr;
+    
+    m_Pages.emplace_back();
+    
+    Page& page = m_Pages.back();
+    page.width = width;
+    page.height = height;
+    page.packer.Reset(width, height);
+    
+    // Contents sit padding + 2 * extrude texels apart, and a texel of level n
+    // covers 2^n of level 0; level n is clean while that still fits.
+    uint32_t levels = m_MipLevels;
+    
+    if (levels == 0)
+        for (levels = 1; (2u << (levels - 1)) <= m_Padding + m_Extrude * 2; levels++) {}
+    
+    page.levelCount = std::min(levels, GetMipLevelCount(width, height));
+    page.pixels.assign(GetMipChainSize(width, height, page.levelCount), 0);
+    
+    return &page;
+}
+
+void TextureAtlas::MarkDirty(Page& page, const PackedRect& rect)
+{
+    if (!page.dirty)
+    {
+        page.dirty = true;
+        page.dirtyMinX = rect.x;
+        page.dirtyMinY = rect.y;
+        page.dirtyMaxX = rect.x + rect.width;
+        page.dirtyMaxY = rect.y + rect.height;
+        return;
+    }
+    
+    page.dirtyMinX = std::min(page.dirtyMinX, rect.x);
+    page.dirtyMinY = std::min(page.dirtyMinY, rect.y);
+    page.dirtyMaxX = std::max(page.dirtyMaxX, rect.x + rect.width);
+    page.dirtyMaxY = std::max(page.dirtyMaxY, rect.y + rect.height);
+}
+
+void TextureAtlas::Blit(Page& page, const PackedRect& rect, uint32_t width, uint32_t height, const uint8_t* pixels)
+{
+    // rect covers the image plus m_Extrude pixels on every side; the border
+    // repeats the outermost texels so linear filtering never picks up a neighbour.
+    const size_t rowBytes = size_t(width) * 4;
+    
+    for (uint32_t row = 0; row < rect.height; row++)
+    {
+        uint32_t srcRow = row < m_Extrude ? 0 : std::min(row - m_Extrude, height - 1);
+        
+        const uint8_t* src = pixels + size_t(srcRow) * rowBytes;
+        uint8_t* dst = &page.pixels[(size_t(rect.y + row) * page.width + rect.x) * 4];
+        
+        for (uint32_t e = 0; e < m_Extrude; e++)
+        {
+            std::memcpy(dst + size_t(e) * 4, src, 4);
+            std::memcpy(dst + (size_t(m_Extrude + width + e)) * 4, src + rowBytes - 4, 4);
+        }
+        
+        std::memcpy(dst + size_t(m_Extrude) * 4, src, rowBytes);
+    }
+    
+    MarkDirty(page, rect);
+}
+
+const AtlasRegion* TextureAtlas::Insert(const std::string& key, const Image& image)
+{
+    if (!image.IsValid()) return nullptr;
+    
+    return Insert(key, image.GetWidth(), image.GetHeight(), image.GetData());
+}
+
+const AtlasRegion* TextureAtlas::Insert(const std::string& key, uint32_t width, uint32_t height, const uint8_t* pixels)
+{
+    if (const AtlasRegion* existing = Find(key)) return existing;
+    
+    if (!pixels || width == 0 || height == 0) return nullptr;
+    
+    // Padding is only needed between neighbours, so each rect reserves it on
+    // its right and top edge.
+    const uint32_t paddedWidth = width + m_Extrude * 2 + m_Padding;
+    const uint32_t paddedHeight = height + m_Extrude * 2 + m_Padding;
+    
+    PackedRect rect;
+    Page* target = nullptr;
+    
+    if (paddedWidth > m_PageSize || paddedHeight > m_PageSize)
+    {
+        // Too big to share a page: give it a dedicated one of its own size.
+        target = AddPage(paddedWidth, paddedHeight);
+        if (target && !target->packer.Insert(paddedWidth, paddedHeight, rect)) target = nullptr;
+    }
+    else
+    {
+        for (Page& page : m_Pages)
+        {
+            if (page.packer.Insert(paddedWidth, paddedHeight, rect)) { target = &page; break; }
+        }
+        
+        if (!target)
+        {
+            target = AddPage(m_PageSize, m_PageSize);
+            if (target && !target->packer.Insert(paddedWidth, paddedHeight, rect)) target = nullptr;
+        }
+    }
+    
+    if (!target)
+    {
+        LOG_CORE_WARN("Texture atlas is full ({} pages), could not pack '{}'", MaxPages, key);
+        return nullptr;
+    }
+    
+    rect.width -= m_Padding;
+    rect.height -= m_Padding;
+    
+    Blit(*target, rect, width, height, pixels);
+    
+    AtlasRegion region;
+    region.page = static_cast<uint32_t>(target - m_Pages.data());
+    region.x = rect.x + m_Extrude;
+    region.y = rect.y + m_Extrude;
+    region.width = width;
+    region.height = height;
+    region.uvRect = Vec4{
+        float(region.x) / target->width,
+        float(region.y) / target->height,
+        float(region.x + width) / target->width,
+        float(region.y + height) / target->height
+    };
+    
+    return &(m_Regions[key] = region);
+}
+
+const AtlasRegion* TextureAtlas::Find(const std::string& key) const
+{
+    auto it = m_Regions.find(key);
+    return it != m_Regions.end() ? &it->second : nullptr;
+}
+
+void TextureAtlas::UploadDirtyLevels(RenderDevice* device, Page& page, JobSystem* jobSystem, std::vector<uint8_t>& staging)
+{
+    uint32_t width = page.width;
+    uint32_t height = page.height;
+    
+    uint32_t minX = page.dirtyMinX, minY = page.dirtyMinY;
+    uint32_t maxX = page.dirtyMaxX, maxY = page.dirtyMaxY;
+    
+    const uint8_t* source = page.pixels.data();
+    
+    for (uint32_t level = 1; level < page.levelCount; level++)
+    {
+        uint8_t* destination = const_cast<uint8_t*>(source) + size_t(width) * height * 4;
+        
+        // Every texel reads the 2x2 block above it, so the rect halves, rounding outwards.
+        minX /= 2;
+        minY /= 2;
+        maxX = (maxX + 1) / 2;
+        maxY = (maxY + 1) / 2;
+        
+        DownsampleRegion(source, width, height, destination, minX, minY, maxX, maxY, MipFilterOptions(), jobSystem);
+        
+        width = GetMipDimension(width, 1);
+        height = GetMipDimension(height, 1);
+        
+        maxX = std::min(std::max(maxX, minX + 1), width);
+        maxY = std::min(std::max(maxY, minY + 1), height);
+        
+        uint32_t rectWidth = maxX - minX;
+        uint32_t rectHeight = maxY - minY;
+        
+        staging.resize(size_t(rectWidth) * rectHeight * 4);
+        
+        for (uint32_t row = 0; row < rectHeight; row++)
+            std::memcpy(&staging[size_t(row) * rectWidth * 4], destination + (size_t(minY + row) * width + minX) * 4, size_t(rectWidth) * 4);
+        
+        device->UpdateTexture(page.texture, level, minX, minY, rectWidth, rectHeight, staging.data());
+        
+        source = destination;
+    }
+}
+
+void TextureAtlas::Upload(RenderDevice* device, JobSystem* jobSystem)
+{
+    if (!device) return;
+    
+    m_Device = device;
+    
+    std::vector<uint8_t> staging;
+    
+    for (Page& page : m_Pages)
+    {
+        if (!page.texture.IsValid())
+        {
+            TextureDesc desc;
+            desc.width = page.width;
+            desc.height = page.height;
+            desc.format = TextureFormat::RGBA8Unorm;
+            desc.mipLevelCount = page.levelCount;
+            
+            GenerateMipChain(page.pixels.data(), page.width, page.height, page.levelCount, MipFilterOptions(), jobSystem);
+            
+            page.texture = device->CreateTexture(desc, page.pixels.data());
+            page.dirty = false;
+            continue;
+        }
+        
+        if (!page.dirty) continue;
+        
+        // Only the bounding box of what changed goes up.
+        uint32_t width = page.dirtyMaxX - page.dirtyMinX;
+        uint32_t height = page.dirtyMaxY - page.dirtyMinY;
+        
+        staging.resize(size_t(width) * height * 4);
+        
+        for (uint32_t row = 0; row < height; row++)
+            std::memcpy(&staging[size_t(row) * width * 4], &page.pixels[(size_t(page.dirtyMinY + row) * page.width + page.dirtyMinX) * 4], size_t(width) * 4);
+        
+        device->UpdateTexture(page.texture, 0, page.dirtyMinX, page.dirtyMinY, width, height, staging.data());
+        
+        UploadDirtyLevels(device, page, jobSystem, staging);
+        
+        page.dirty = false;
+    }
+}
+
+std::string TextureAtlas::MakeKey(const std::string& path, const char* root)
+{
+    namespace fs = std::filesystem;
+    
+    if (path.empty()) return path;
+    
+    std::error_code error;
+    
+    fs::path canonical = fs::weakly_canonical(path, error);
+    if (error) return fs::path(path).lexically_normal().generic_string();
+    
+    fs::path rootPath = fs::weakly_canonical(root ? fs::path(root) : fs::current_path(error), error);
+    if (error) return canonical.generic_string();
+    
+    fs::path relative = canonical.lexically_relative(rootPath);
+    
+    if (relative.empty() || *relative.begin() == "..") return canonical.generic_string();
+    
+    return relative.generic_string();
+}
+
+bool TextureAtlas::Bake(const std::vector<std::string>& imagePaths, const char* outputPath,
+                        uint32_t pageSize, uint32_t padding, uint32_t extrude, const char* root)
+{
+    std::vector<std::unique_ptr<Image>> images;
+    images.reserve(imagePaths.size());
+    
+    for (const std::string& path : imagePaths)
+    {
+        images.push_back(std::make_unique<Image>(path.c_str()));
+        if (!images.back()->IsValid()) return false;
+    }
+    
+    // Placing the largest images first packs far tighter than input order.
+    std::vector<size_t> order(images.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        int sideA = std::max(images[a]->GetWidth(), images[a]->GetHeight());
+        int sideB = std::max(images[b]->GetWidth(), images[b]->GetHeight());
+        return sideA > sideB;
+    });
+    
+    TextureAtlas atlas(pageSize, padding, extrude);
+    
+    for (size_t i : order)
+    {
+        if (!atlas.Insert(MakeKey(imagePaths[i], root), *images[i]))
+        {
+            LOG_CORE_ERROR("Failed to bake '{}' into atlas {}", imagePaths[i], outputPath);
+            return false;
+        }
+    }
+    
+    return atlas.SaveToFile(outputPath);
+}
+
+bool TextureAtlas::SaveToFile(const char* path) const
+{
+    FILE* file = std::fopen(path, "wb");
+    if (!file) { LOG_CORE_ERROR("Failed to open atlas file for writing: {}", path); return false; }
+    
+    AtlasFileHeader header;
+    std::memcpy(header.magic, AtlasFileMagic, sizeof(header.magic));
+    header.version = AtlasFileVersion;
+    header.pageSize = m_PageSize;
+    header.padding = m_Padding;
+    header.extrude = m_Extrude;
+    header.pageCount = static_cast<uint32_t>(m_Pages.size());
+    header.regionCount = static_cast<uint32_t>(m_Regions.size());
+    
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    
+    for (const Page& page : m_Pages)
+    {
+        uint32_t size[2] = { page.width, page.height };
+        ok = ok && std::fwrite(size, sizeof(size), 1, file) == 1;
+    }
+    
+    // Sorted so baking the same inputs always produces the same file.
+    std::vector<const std::pair<const std::string, AtlasRegion>*> regions;
+    for (const auto& entry : m_Regions) regions.push_back(&entry);
+    
+    std::sort(regions.begin(), regions.end(), [](auto a, auto b) { return a->first < b->first; });
+    
+    for (const auto* entry : regions)
+    {
+        AtlasFileRegion region = {
+            static_cast<uint32_t>(entry->first.size()),
+            entry->second.page, entry->second.x, entry->second.y, entry->second.width, entry->second.height
+        };
+        
+        ok = ok && std::fwrite(&region, sizeof(region), 1, file) == 1;
+        ok = ok && std::fwrite(entry->first.data(), 1, entry->first.size(), file) == entry->first.size();
+    }
+    
+    for (const Page& page : m_Pages)
+    {
+        size_t levelSize = size_t(page.width) * page.height * 4;
+        ok = ok && std::fwrite(page.pixels.data(), 1, levelSize, file) == levelSize;
+    }
+    
+    std::fclose(file);
+    
+    if (!ok) LOG_CORE_ERROR("Failed to write atlas file: {}", path);
+    
+    return ok;
+}
+
+bool TextureAtlas::LoadFromFile(const char* path)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file) { LOG_CORE_ERROR("Failed to open atlas file: {}", path); return false; }
+    
+    AtlasFileHeader header;
+    
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, AtlasFileMagic, sizeof(header.magic)) != 0 ||
+        header.version != AtlasFileVersion || header.pageCount > MaxPages)
+    {
+        LOG_CORE_ERROR("Invalid atlas file: {}", path);
+        std::fclose(file);
+        return false;
+    }
+    
+    Clear();
+    
+    m_PageSize = header.pageSize;
+    m_Padding = header.padding;
+    m_Extrude = header.extrude;
+    
+    bool ok = true;
+    
+    for (uint32_t i = 0; ok && i < header.pageCount; i++)
+    {
+        uint32_t size[2];
+        ok = std::fread(size, sizeof(size), 1, file) == 1 && AddPage(size[0], size[1]);
+    }
+    
+    for (uint32_t i = 0; ok && i < header.regionCount; i++)
+    {
+        AtlasFileRegion fileRegion;
+        ok = std::fread(&fileRegion, sizeof(fileRegion), 1, file) == 1 && fileRegion.page < m_Pages.size();
+        if (!ok) break;
+        
+        std::string key(fileRegion.keyLength, '\0');
+        ok = std::fread(key.data(), 1, key.size(), file) == key.size();
+        if (!ok) break;
+        
+        Page& page = m_Pages[fileRegion.page];
+        
+        AtlasRegion region;
+        region.page = fileRegion.page;
+        region.x = fileRegion.x;
+        region.y = fileRegion.y;
+        region.width = fileRegion.width;
+        region.height = fileRegion.height;
+        region.uvRect = Vec4{
+            float(region.x) / page.width,
+            float(region.y) / page.height,
+            float(region.x + region.width) / page.width,
+            float(region.y + region.height) / page.height
+        };
+        
+        // Keep the packer in sync so runtime inserts don't overwrite baked images.
+        page.packer.Occupy({ region.x - m_Extrude, region.y - m_Extrude,
+                             region.width + m_Extrude * 2 + m_Padding, region.height + m_Extrude * 2 + m_Padding });
+        
+        m_Regions[key] = region;
+    }
+    
+    // The other levels are filtered again when the pages are uploaded.
+    for (Page& page : m_Pages)
+    {
+        size_t levelSize = size_t(page.width) * page.height * 4;
+        ok = ok && std::fread(page.pixels.data(), 1, levelSize, file) == levelSize;
+        page.dirty = false;
+    }
+    
+    std::fclose(file);
+    
+    if (!ok)
+    {
+        LOG_CORE_ERROR("Truncated or corrupt atlas file: {}", path);
+        Clear();
+    }
+    
+    return ok;
+}
+
+void TextureAtlas::Clear()
+{
+    if (m_Device)
+    {
+        for (Page& page : m_Pages)
+            if (page.texture.IsValid()) m_Device->DestroyTexture(page.texture);
+    }
+    
+    m_Pages.clear();
+    m_Regions.clear();
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Clear();
+}
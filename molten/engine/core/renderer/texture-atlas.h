@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "../maths/vector.h"
+#include "render-device.h"
+#include "../utils/rect-packer.h"
+
+class Image;
+class JobSystem;
+
+// Where a packed image ended up: the page it lives on, its pixel rect inside
+// that page (without padding/extrusion) and the matching UV rect (u0, v0, u1, v1).
+struct AtlasRegion
+{
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    Vec4 uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+};
+
+// Packs many images into a few large RGBA8 pages so sprites using different
+// images can share a draw call. Images can be added at runtime (only the
+// touched part of a page is re-uploaded) or baked offline into a file that is
+// loaded back as-is.
+//
+// Pages are mipmapped, but only as far as the gaps between images keep them
+// apart: every level halves the gap, and once a texel spans it neighbours
+// bleed into each other.
+class TextureAtlas
+{
+private:
+    
+    struct Page
+    {
+        RectPacker packer;
+        
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t levelCount = 1;
+        
+        // The whole mip chain; images are blitted into level 0 and the
+        // others are filtered from it on upload.
+        std::vector<uint8_t> pixels;
+        
+        TextureHandle texture;
+        
+        // Bounds of the pixels written since the last upload.
+        bool dirty = false;
+        uint32_t dirtyMinX = 0, dirtyMinY = 0, dirtyMaxX = 0, dirtyMaxY = 0;
+    };
+    
+    uint32_t m_PageSize;
+    uint32_t m_Padding;
+    uint32_t m_Extrude;
+    uint32_t m_MipLevels;
+    
+    std::vector<Page> m_Pages;
+    std::unordered_map<std::string, AtlasRegion> m_Regions;
+    
+    RenderDevice* m_Device = nullptr;
+    
+    Page* AddPage(uint32_t width, uint32_t height);
+    
+    void Blit(Page& page, const PackedRect& rect, uint32_t width, uint32_t height, const uint8_t* pixels);
+    
+    static void MarkDirty(Page& page, const PackedRect& rect);
+    
+    // Refilters the dirty rect of every level below 0 and uploads each.
+    void UploadDirtyLevels(RenderDevice* device, Page& page, JobSystem* jobSystem, std::vector<uint8_t>& staging);
+    
+public:
+    
+    // Pages the renderer binds at once; the sprite shader indexes them by VertexData2D::textureIndex.
+    static constexpr uint32_t MaxPages = 16;
+    
+    // mipLevels of 0 picks as many as padding and extrusion keep clean.
+    explicit TextureAtlas(uint32_t pageSize = 2048, uint32_t padding = 2, uint32_t extrude = 1, uint32_t mipLevels = 0);
+    
+    // Packs the image under key, or returns the existing region if the key is
+    // already packed. Returns nullptr when the atlas is out of pages.
+    const AtlasRegion* Insert(const std::string& key, const Image& image);
+    
+    const AtlasRegion* Insert(const std::string& key, uint32_t width, uint32_t height, const uint8_t* pixels);
+    
+    const AtlasRegion* Find(const std::string& key) const;
+    
+    // Key for an image file: its canonical path relative to root (the
+    // working directory by default, like mounted archives), with forward
+    // slashes, so a baked atlas matches the textures that load those files.
+    // Files outside the root keep their absolute path.
+    static std::string MakeKey(const std::string& path, const char* root = nullptr);
+    
+    // Creates page textures that don't exist yet and uploads the dirty part
+    // of the others, level by level; large pages are filtered on the job system.
+    void Upload(RenderDevice* device, JobSystem* jobSystem = nullptr);
+    
+    // Offline mode: decodes every image, packs them largest first and writes
+    // the pages plus region table to outputPath, keyed by MakeKey against
+    // root. Only level 0 is stored. molten.cook --atlas runs it.
+    static bool Bake(const std::vector<std::string>& imagePaths, const char* outputPath,
+                     uint32_t pageSize = 2048, uint32_t padding = 2, uint32_t extrude = 1, const char* root = nullptr);
+    
+    bool SaveToFile(const char* path) const;
+    
+    bool LoadFromFile(const char* path);
+    
+    // Destroys the page textures and forgets every region.
+    void Clear();
+    
+    inline size_t GetPageCount() const { return m_Pages.size(); }
+    
+    inline TextureHandle GetPageTexture(size_t page) const { return page < m_Pages.size() ? m_Pages[page].texture : TextureHandle(); }
+    
+    inline size_t GetRegionCount() const { return m_Regions.size(); }
+    
+    ~TextureAtlas();
+};
@@ -0,0 +1,240 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "texture-cache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <set>
+
+#include "texture-2D.h"
+#include "cooked-texture.h"
+#include "../assets/asset-archive.h"
+#include "../utils/image.h"
+#include "../utils/log-macros.h"
+
+std::mutex TextureCache::s_Mutex;
+std::unordered_map<std::string, std::weak_ptr<Texture2D>> TextureCache::s_ByPath;
+std::unordered_map<uint64_t, std::weak_ptr<Texture2D>> TextureCache::s_ByContent;
+
+static std::string NormalizePath(const char* filepath)
+{
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(filepath, error);
+    
+    return error ? std::string(filepath) : path.string();
+}
+
+uint64_t TextureCache::HashContents(const unsigned char* data, size_t size)
+{
+    // FNV-1a, 64 bit.
+    uint64_t hash = 14695981039346656037ull;
+    
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    
+    return hash;
+}
+
+std::shared_ptr<Texture2D> TextureCache::Load(const char* filepath)
+{
+    if (!filepath || *filepath == '\0') return nullptr;
+    
+    std::string path = NormalizePath(filepath);
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        auto it = s_ByPath.find(path);
+        if (it != s_ByPath.end())
+            if (auto texture = it->second.lock()) return texture;
+    }
+    
+    // A cooked file is only mapped, never read whole, so it's keyed by path alone.
+    if (CookedTexture* cooked = CookedTexture::OpenForSource(path))
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        auto it = s_ByPath.find(path);
+        if (it != s_ByPath.end())
+        {
+            if (auto texture = it->second.lock())
+            {
+                delete cooked;
+                return texture;
+            }
+        }
+        
+        std::shared_ptr<Texture2D> shared = Share(path, 0, new Texture2D(path, cooked));
+        s_ByPath[path] = shared;
+        
+        return shared;
+    }
+    
+    // Mapped, or read from a mounted archive, rather than copied out of the file.
+    AssetData encoded;
+    if (!AssetArchive::Load(path, encoded))
+    {
+        LOG_CORE_ERROR("Failed to read texture file: {}", filepath);
+        return nullptr;
+    }
+    
+    uint64_t contentHash = HashContents(encoded.GetData(), encoded.GetSize());
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        auto it = s_ByContent.find(contentHash);
+        if (it != s_ByContent.end())
+        {
+            if (auto texture = it->second.lock())
+            {
+                s_ByPath[path] = texture;
+                return texture;
+            }
+        }
+    }
+    
+    // Decode outside the lock so other threads can keep hitting the cache.
+    auto texture = new Texture2D(path, new Image(encoded.GetData(), encoded.GetSize(), path.c_str()));
+    
+    return Insert(path, contentHash, texture);
+}
+
+std::shared_ptr<Texture2D> TextureCache::LoadFromMemory(const unsigned char* encoded, size_t size, const char* name)
+{
+    if (!encoded || size == 0) return nullptr;
+    
+    uint64_t contentHash = HashContents(encoded, size);
+    
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        auto it = s_ByContent.find(contentHash);
+        if (it != s_ByContent.end())
+            if (auto texture = it->second.lock()) return texture;
+    }
+    
+    std::string key = name ? name : "";
+    
+    auto texture = new Texture2D(key, new Image(encoded, size, key.c_str()));
+    
+    // Names needn't be unique, or given at all; the contents tell images apart.
+    char atlasKey[32];
+    std::snprintf(atlasKey, sizeof(atlasKey), "memory/%016llx", static_cast<unsigned long long>(contentHash));
+    texture->SetAtlasKey(atlasKey);
+    
+    return Insert(std::string(), contentHash, texture);
+}
+
+std::shared_ptr<Texture2D> TextureCache::FindOrCreatePending(const char* filepath, bool& created)
+{
+    created = false;
+    
+    if (!filepath || *filepath == '\0') return nullptr;
+    
+    std::string path = NormalizePath(filepath);
+    
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    
+    auto it = s_ByPath.find(path);
+    if (it != s_ByPath.end())
+        if (auto texture = it->second.lock()) return texture;
+    
+    // The contents aren't read yet; Release only drops expired entries, so 0 is harmless.
+    std::shared_ptr<Texture2D> shared = Share(path, 0, Texture2D::CreatePending(path));
+    
+    s_ByPath[path] = shared;
+    created = true;
+    
+    return shared;
+}
+
+std::shared_ptr<Texture2D> TextureCache::Insert(const std::string& path, uint64_t contentHash, Texture2D* texture)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    
+    // Another thread may have finished decoding the same image first.
+    auto it = s_ByContent.find(contentHash);
+    if (it != s_ByContent.end())
+    {
+        if (auto existing = it->second.lock())
+        {
+            delete texture;
+            
+            if (!path.empty()) s_ByPath[path] = existing;
+            return existing;
+        }
+    }
+    
+    std::shared_ptr<Texture2D> shared = Share(path, contentHash, texture);
+    
+    s_ByContent[contentHash] = shared;
+    if (!path.empty()) s_ByPath[path] = shared;
+    
+    return shared;
+}
+
+std::shared_ptr<Texture2D> TextureCache::Share(const std::string& path, uint64_t contentHash, Texture2D* texture)
+{
+    return std::shared_ptr<Texture2D>(texture, [path, contentHash](Texture2D* texture)
+    {
+        Release(path, contentHash, texture);
+    });
+}
+
+void TextureCache::Release(const std::string& path, uint64_t contentHash, Texture2D* texture)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        
+        auto content = s_ByContent.find(contentHash);
+        if (content != s_ByContent.end() && content->second.expired()) s_ByContent.erase(content);
+        
+        // Aliases that reached this texture through other paths stay behind as
+        // expired entries; the next Load of those paths simply replaces them.
+        auto byPath = s_ByPath.find(path);
+        if (byPath != s_ByPath.end() && byPath->second.expired()) s_ByPath.erase(byPath);
+    }
+    
+    delete texture;
+}
+
+size_t TextureCache::GetLiveCount()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    
+    // Cooked and pending textures are only in the path map, decoded ones
+    // usually in both, under as many paths as reached them.
+    std::set<std::weak_ptr<Texture2D>, std::owner_less<std::weak_ptr<Texture2D>>> live;
+    
+    for (const auto& entry : s_ByContent)
+        if (!entry.second.expired()) live.insert(entry.second);
+    
+    for (const auto& entry : s_ByPath)
+        if (!entry.second.expired()) live.insert(entry.second);
+    
+    return live.size();
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+class Texture2D;
+
+// Shares one Texture2D between every user of the same image. Entries are
+// keyed both by path and by a hash of the encoded file contents, so the same
+// PNG reached through two paths is still decoded once. Images with an up to
+// date cooked file are mapped instead and keyed by path. The cache only holds
+// weak references: a texture is destroyed when its last handle goes away.
+class TextureCache
+{
+public:
+    
+    static std::shared_ptr<Texture2D> Load(const char* filepath);
+    
+    // Decodes an encoded image from memory, deduplicated by content only.
+    // The name is only for messages; the atlas key comes from the contents.
+    static std::shared_ptr<Texture2D> LoadFromMemory(const unsigned char* encoded, size_t size, const char* name);
+    
+    // Returns the texture cached for the path, or inserts a pending one (see
+    // Texture2D::CreatePending) for an asynchronous load to fill in; created
+    // tells which. Pending textures are only keyed by path, so the same image
+    // reached through two paths while loading is decoded twice.
+    static std::shared_ptr<Texture2D> FindOrCreatePending(const char* filepath, bool& created);
+    
+    // Number of textures currently alive through the cache, decoded, cooked
+    // or pending.
+    static size_t GetLiveCount();
+    
+    static uint64_t HashContents(const unsigned char* data, size_t size);
+
+private:
+    
+    static std::mutex s_Mutex;
+    
+    static std::unordered_map<std::string, std::weak_ptr<Texture2D>> s_ByPath;
+    static std::unordered_map<uint64_t, std::weak_ptr<Texture2D>> s_ByContent;
+    
+    static std::shared_ptr<Texture2D> Insert(const std::string& path, uint64_t contentHash, Texture2D* texture);
+    
+    // Wraps a texture so dropping its last reference releases its entries.
+    static std::shared_ptr<Texture2D> Share(const std::string& path, uint64_t contentHash, Texture2D* texture);
+    
+    static void Release(const std::string& path, uint64_t contentHash, Texture2D* texture);
+};
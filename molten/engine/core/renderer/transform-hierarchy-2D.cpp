@@ -0,0 +1,348 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "transform-hierarchy-2D.h"
+
+#include <type_traits>
+
+#include "../utils/profiler.h"
+
+// Replaces column with its elements gathered in the given order.
+template <typename T>
+static void Permute(std::vector<T>& column, const std::vector<uint32_t>& order)
+{
+    std::vector<T> permuted;
+    permuted.reserve(column.size());
+    
+    for (size_t i = 0; i < column.size(); i++)
+        permuted.push_back(std::move(column[order[i]]));
+    
+    column.swap(permuted);
+}
+
+TransformHandle TransformHierarchy2D::Create(TransformHandle parent, const Vec2& position, float rotation, const Vec2& scale)
+{
+    uint32_t slotIndex;
+    
+    if (!m_FreeSlots.empty())
+    {
+        slotIndex = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        slotIndex = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+    
+    uint32_t parentIndex = IndexOf(parent);
+    uint32_t count = static_cast<uint32_t>(Size());
+    
+    // Right after the parent's last descendant keeps its subtree contiguous.
+    uint32_t dense = parentIndex != InvalidIndex ? parentIndex + m_SubtreeSize[parentIndex] : count;
+    
+    ForEachColumn([&](auto& column)
+    {
+        column.insert(column.begin() + dense, typename std::decay_t<decltype(column)>::value_type());
+    });
+    
+    if (dense < count)
+    {
+        for (uint32_t i = 0; i <= count; i++)
+            if (i != dense && m_Parent[i] != InvalidIndex && m_Parent[i] >= dense) m_Parent[i]++;
+        
+        for (uint32_t i = dense + 1; i <= count; i++)
+            m_Slots[m_DenseToSlot[i]].dense = i;
+    }
+    
+    m_Slots[slotIndex].dense = dense;
+    
+    m_Parent[dense] = parentIndex;
+    m_SubtreeSize[dense] = 1;
+    m_Position[dense] = position;
+    m_Rotation[dense] = rotation;
+    m_Scale[dense] = scale;
+    m_DenseToSlot[dense] = slotIndex;
+    
+    if (parentIndex != InvalidIndex) AdjustSubtreeSizes(parentIndex, 1);
+    
+    MarkDirty(dense, LocalDirty | WorldDirty);
+    
+    return { slotIndex, m_Slots[slotIndex].generation };
+}
+
+bool TransformHierarchy2D::Destroy(TransformHandle handle)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return false;
+    
+    uint32_t count = m_SubtreeSize[index];
+    uint32_t end = index + count;
+    
+    for (uint32_t i = index; i < end; i++)
+    {
+        Slot& slot = m_Slots[m_DenseToSlot[i]];
+        slot.dense = InvalidIndex;
+        
+        // Generation 0 is reserved for invalid handles.
+        if (++slot.generation == 0) slot.generation = 1;
+        
+        m_FreeSlots.push_back(m_DenseToSlot[i]);
+    }
+    
+    if (m_Parent[index] != InvalidIndex) AdjustSubtreeSizes(m_Parent[index], -static_cast<int64_t>(count));
+    
+    ForEachColumn([&](auto& column) { column.erase(column.begin() + index, column.begin() + end); });
+    
+    // Nothing left can have a parent inside the erased range.
+    for (uint32_t i = 0; i < Size(); i++)
+        if (m_Parent[i] != InvalidIndex && m_Parent[i] >= end) m_Parent[i] -= count;
+    
+    for (uint32_t i = index; i < Size(); i++)
+        m_Slots[m_DenseToSlot[i]].dense = i;
+    
+    return true;
+}
+
+void TransformHierarchy2D::Clear()
+{
+    for (uint32_t i = 0; i < m_DenseToSlot.size(); i++)
+    {
+        Slot& slot = m_Slots[m_DenseToSlot[i]];
+        slot.dense = InvalidIndex;
+        
+        if (++slot.generation == 0) slot.generation = 1;
+        
+        m_FreeSlots.push_back(m_DenseToSlot[i]);
+    }
+    
+    ForEachColumn([](auto& column) { column.clear(); });
+    
+    m_AnyDirty = false;
+    m_UpdatedCount = 0;
+}
+
+bool TransformHierarchy2D::SetParent(TransformHandle handle, TransformHandle parent)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return false;
+    
+    uint32_t count = m_SubtreeSize[index];
+    uint32_t parentIndex = IndexOf(parent);
+    
+    if (parentIndex != InvalidIndex && parentIndex >= index && parentIndex < index + count) return false;
+    if (m_Parent[index] == parentIndex) return true;
+    
+    uint32_t size = static_cast<uint32_t>(Size());
+    uint32_t insertAt = parentIndex != InvalidIndex ? parentIndex + m_SubtreeSize[parentIndex] : size;
+    
+    if (m_Parent[index] != InvalidIndex) AdjustSubtreeSizes(m_Parent[index], -static_cast<int64_t>(count));
+    
+    // Everything else keeps its relative order; the subtree moves as a block
+    // to just after the new parent's last descendant.
+    m_PermuteScratch.clear();
+    
+    for (uint32_t i = 0; i <= size; i++)
+    {
+        if (i == insertAt)
+            for (uint32_t j = index; j < index + count; j++) m_PermuteScratch.push_back(j);
+        
+        if (i < size && (i < index || i >= index + count)) m_PermuteScratch.push_back(i);
+    }
+    
+    Reorder(m_PermuteScratch);
+    
+    index = IndexOf(handle);
+    parentIndex = IndexOf(parent);
+    
+    m_Parent[index] = parentIndex;
+    if (parentIndex != InvalidIndex) AdjustSubtreeSizes(parentIndex, count);
+    
+    MarkDirty(index, WorldDirty);
+    
+    return true;
+}
+
+void TransformHierarchy2D::AdjustSubtreeSizes(uint32_t index, int64_t delta)
+{
+    for (; index != InvalidIndex; index = m_Parent[index])
+        m_SubtreeSize[index] = static_cast<uint32_t>(m_SubtreeSize[index] + delta);
+}
+
+void TransformHierarchy2D::Reorder(const std::vector<uint32_t>& order)
+{
+    ForEachColumn([&](auto& column) { Permute(column, order); });
+    
+    // Parents still hold old indices.
+    std::vector<uint32_t> newIndex(order.size());
+    for (uint32_t i = 0; i < order.size(); i++) newIndex[order[i]] = i;
+    
+    for (uint32_t i = 0; i < Size(); i++)
+    {
+        if (m_Parent[i] != InvalidIndex) m_Parent[i] = newIndex[m_Parent[i]];
+        m_Slots[m_DenseToSlot[i]].dense = i;
+    }
+}
+
+void TransformHierarchy2D::SetPosition(TransformHandle handle, const Vec2& position)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Position[index] = position;
+    MarkDirty(index, LocalDirty | WorldDirty);
+}
+
+void TransformHierarchy2D::SetRotation(TransformHandle handle, float radians)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Rotation[index] = radians;
+    MarkDirty(index, LocalDirty | WorldDirty);
+}
+
+void TransformHierarchy2D::SetScale(TransformHandle handle, const Vec2& scale)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Scale[index] = scale;
+    MarkDirty(index, LocalDirty | WorldDirty);
+}
+
+void TransformHierarchy2D::Move(TransformHandle handle, const Vec2& offset)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Position[index] += offset;
+    MarkDirty(index, LocalDirty | WorldDirty);
+}
+
+void TransformHierarchy2D::Rotate(TransformHandle handle, float radians)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Rotation[index] += radians;
+    MarkDirty(index, LocalDirty | WorldDirty);
+}
+
+TransformHandle TransformHierarchy2D::GetParent(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex && m_Parent[index] != InvalidIndex ? HandleAt(m_Parent[index]) : TransformHandle();
+}
+
+Vec2 TransformHierarchy2D::GetPosition(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Position[index] : Vec2{0.0f, 0.0f};
+}
+
+float TransformHierarchy2D::GetRotation(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Rotation[index] : 0.0f;
+}
+
+Vec2 TransformHierarchy2D::GetScale(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Scale[index] : Vec2{1.0f, 1.0f};
+}
+
+Affine2D TransformHierarchy2D::GetWorld(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_World[index] : Affine2D();
+}
+
+void TransformHierarchy2D::AttachSprite(TransformHandle handle, SpriteHandle sprite, const Vec2& size)
+{
+    uint32_t index = IndexOf(handle);
+    if (index == InvalidIndex) return;
+    
+    m_Sprite[index] = sprite;
+    m_SpriteSize[index] = size;
+    
+    // The sprite takes the node's current world transform on the next Update.
+    if (sprite.IsValid()) MarkDirty(index, WorldDirty);
+}
+
+SpriteHandle TransformHierarchy2D::GetSprite(TransformHandle handle) const
+{
+    uint32_t index = IndexOf(handle);
+    return index != InvalidIndex ? m_Sprite[index] : SpriteHandle();
+}
+
+void TransformHierarchy2D::Update(SpriteStore* sprites)
+{
+    PROFILE_SCOPE("TransformHierarchy2D::Update");
+    
+    m_UpdatedCount = 0;
+    
+    if (!m_AnyDirty) return;
+    
+    m_AnyDirty = false;
+    
+    uint32_t count = static_cast<uint32_t>(Size());
+    
+    for (uint32_t i = 0; i < count;)
+    {
+        // A clean node with clean ancestors keeps last frame's world, and a
+        // dirty node's descendants are handled with it below.
+        if (!m_Flags[i]) { i++; continue; }
+        
+        uint32_t end = i + m_SubtreeSize[i];
+        
+        // Parents come first, so every parent world is final when its children read it.
+        for (uint32_t j = i; j < end; j++)
+        {
+            if (m_Flags[j] & LocalDirty)
+            {
+                float rotation = m_Rotation[j];
+                
+                m_Local[j] = rotation == 0.0f ? Affine2D::FromTRS(m_Position[j], 0.0f, 1.0f, m_Scale[j])
+                                              : Affine2D::FromTRS(m_Position[j], rotation, m_Scale[j]);
+            }
+            
+            uint32_t parent = m_Parent[j];
+            m_World[j] = parent != InvalidIndex ? m_World[parent] * m_Local[j] : m_Local[j];
+            m_Flags[j] = 0;
+            
+            if (sprites && m_Sprite[j].IsValid())
+            {
+                Vec2 position;
+                float rotation;
+                Vec2 scale;
+                
+                Decompose(m_World[j], position, rotation, scale);
+                sprites->SetTransform(m_Sprite[j], position, rotation, m_SpriteSize[j] * scale);
+            }
+        }
+        
+        m_UpdatedCount += end - i;
+        i = end;
+    }
+}
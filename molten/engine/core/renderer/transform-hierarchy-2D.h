@@ -0,0 +1,196 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "../maths/affine-2D.h"
+#include "sprite-store.h"
+
+// Stable reference to a node in a TransformHierarchy2D, generational like
+// SpriteHandle.
+struct TransformHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const TransformHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const TransformHandle& other) const { return !(*this == other); }
+};
+
+// Parent/child 2D transforms in dense struct-of-arrays columns, kept in
+// depth-first order: every node comes after its parent and its subtree is
+// the contiguous range [node, node + subtree size). Setters only flag the
+// node; Update walks the columns once and recomputes the world transform of
+// each flagged subtree, parents before children, skipping everything else.
+//
+// A node can drive a sprite. Its world transform is written into the sprite
+// store as position, rotation and size (the sprite's own size times the
+// world scale), so moving a root moves every attached sprite without any
+// per-sprite code.
+//
+// Handle lookups and setters are O(1). Creating a child, destroying a node
+// or reparenting moves the columns after it and is O(n): hierarchies are
+// built once and animated many times.
+class TransformHierarchy2D
+{
+private:
+    
+    struct Slot
+    {
+        uint32_t generation = 1;
+        uint32_t dense = InvalidIndex;
+    };
+    
+    enum Flags : uint8_t
+    {
+        LocalDirty = 1 << 0,
+        WorldDirty = 1 << 1
+    };
+    
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+    
+    // Dense columns, all the same length. Parents are dense indices.
+    std::vector<uint32_t> m_Parent;
+    std::vector<uint32_t> m_SubtreeSize;
+    std::vector<Vec2> m_Position;
+    std::vector<float> m_Rotation;
+    std::vector<Vec2> m_Scale;
+    std::vector<Affine2D> m_Local;
+    std::vector<Affine2D> m_World;
+    std::vector<uint8_t> m_Flags;
+    std::vector<SpriteHandle> m_Sprite;
+    std::vector<Vec2> m_SpriteSize;
+    std::vector<uint32_t> m_DenseToSlot;
+    
+    std::vector<uint32_t> m_PermuteScratch;
+    
+    bool m_AnyDirty = false;
+    
+    size_t m_UpdatedCount = 0;
+    
+    template <typename Function>
+    void ForEachColumn(Function&& function)
+    {
+        function(m_Parent);
+        function(m_SubtreeSize);
+        function(m_Position);
+        function(m_Rotation);
+        function(m_Scale);
+        function(m_Local);
+        function(m_World);
+        function(m_Flags);
+        function(m_Sprite);
+        function(m_SpriteSize);
+        function(m_DenseToSlot);
+    }
+    
+    inline void MarkDirty(uint32_t index, uint8_t flags)
+    {
+        m_Flags[index] |= flags;
+        m_AnyDirty = true;
+    }
+    
+    // Adds delta to the subtree size of the node at index and all its ancestors.
+    void AdjustSubtreeSizes(uint32_t index, int64_t delta);
+    
+    // Moves the node at dense index order[i] to index i, fixing up parents
+    // and slots; order must be a permutation of [0, Size()).
+    void Reorder(const std::vector<uint32_t>& order);
+    
+public:
+    
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+    
+    // Appends a node as the last child of parent, or as a root when parent
+    // isn't a live node.
+    TransformHandle Create(TransformHandle parent = TransformHandle(), const Vec2& position = {0.0f, 0.0f},
+                           float rotation = 0.0f, const Vec2& scale = {1.0f, 1.0f});
+    
+    // Destroys the node and its whole subtree. Attached sprites are left
+    // where they are.
+    bool Destroy(TransformHandle handle);
+    
+    void Clear();
+    
+    // Makes the node the last child of parent, or a root when parent isn't
+    // a live node. The local transform is kept, so the node moves with its
+    // new parent. Fails when parent is the node itself or one of its
+    // descendants.
+    bool SetParent(TransformHandle handle, TransformHandle parent);
+    
+    inline bool IsAlive(TransformHandle handle) const
+    {
+        return handle.index < m_Slots.size() && m_Slots[handle.index].generation == handle.generation &&
+               m_Slots[handle.index].dense != InvalidIndex;
+    }
+    
+    // Dense index of a live node, or InvalidIndex.
+    inline uint32_t IndexOf(TransformHandle handle) const { return IsAlive(handle) ? m_Slots[handle.index].dense : InvalidIndex; }
+    
+    inline TransformHandle HandleAt(uint32_t index) const { return { m_DenseToSlot[index], m_Slots[m_DenseToSlot[index]].generation }; }
+    
+    inline size_t Size() const { return m_Parent.size(); }
+    
+    // Local transform, relative to the parent. Setters ignore dead handles.
+    
+    void SetPosition(TransformHandle handle, const Vec2& position);
+    void SetRotation(TransformHandle handle, float radians);
+    void SetScale(TransformHandle handle, const Vec2& scale);
+    
+    void Move(TransformHandle handle, const Vec2& offset);
+    void Rotate(TransformHandle handle, float radians);
+    
+    TransformHandle GetParent(TransformHandle handle) const;
+    Vec2 GetPosition(TransformHandle handle) const;
+    float GetRotation(TransformHandle handle) const;
+    Vec2 GetScale(TransformHandle handle) const;
+    
+    // World transform as of the last Update.
+    Affine2D GetWorld(TransformHandle handle) const;
+    
+    // The node drives the sprite from the next Update on; size is the
+    // sprite's size at unit scale. An invalid handle detaches.
+    void AttachSprite(TransformHandle handle, SpriteHandle sprite, const Vec2& size);
+    
+    inline void DetachSprite(TransformHandle handle) { AttachSprite(handle, SpriteHandle(), {0.0f, 0.0f}); }
+    
+    SpriteHandle GetSprite(TransformHandle handle) const;
+    
+    // Recomputes the world transform of every node whose local transform or
+    // ancestry changed, and writes the ones driving sprites into sprites.
+    void Update(SpriteStore* sprites = nullptr);
+    
+    // Column access for systems that walk every node, valid after Update.
+    
+    inline const Affine2D* GetWorlds() const { return m_World.data(); }
+    inline const uint32_t* GetParents() const { return m_Parent.data(); }
+    inline const uint32_t* GetSubtreeSizes() const { return m_SubtreeSize.data(); }
+    
+    // Nodes the last Update recomputed.
+    inline size_t GetUpdatedCount() const { return m_UpdatedCount; }
+};
@@ -22,12 +22,43 @@
 
 #pragma once
 
-#include <simd/simd.h>
+#include <algorithm>
+#include <cstdint>
+
+#include "../maths/vector.h"
 
 struct VertexData2D
 {
-    simd::float3 position;
-    simd::float2 texCoord;
-    simd::float4 color;
+    Vec3 position;
+    Vec2 texCoord;
+    Vec4 color;
     float textureIndex;
 };
+
+// Quantized vertex for indexed quads: four of these per sprite take 80 bytes
+// where six VertexData2D take 384. Plain arrays keep it 4-byte aligned.
+struct PackedVertexData2D
+{
+    float position[2];
+    
+    // UShort2Normalized, clamped to [0, 1].
+    uint16_t texCoord[2];
+    
+    // RGBA8, read as UChar4Normalized.
+    uint8_t color[4];
+    
+    int16_t textureIndex;
+    uint16_t padding;
+};
+
+static_assert(sizeof(PackedVertexData2D) == 20, "PackedVertexData2D must match the packed vertex descriptor");
+
+inline uint8_t PackUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+inline uint16_t PackUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
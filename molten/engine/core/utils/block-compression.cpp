@@ -0,0 +1,282 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "block-compression.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+struct ColorBlock
+{
+    // RGBA of the 16 pixels of a tile, row by row.
+    uint8_t pixels[16][4];
+};
+
+static void LoadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, ColorBlock& block)
+{
+    for (uint32_t y = 0; y < 4; y++)
+    {
+        uint32_t sourceY = blockY * 4 + y < height ? blockY * 4 + y : height - 1;
+        
+        for (uint32_t x = 0; x < 4; x++)
+        {
+            uint32_t sourceX = blockX * 4 + x < width ? blockX * 4 + x : width - 1;
+            
+            std::memcpy(block.pixels[y * 4 + x], pixels + (size_t(sourceY) * width + sourceX) * 4, 4);
+        }
+    }
+}
+
+static uint16_t To565(const float color[3])
+{
+    auto quantize = [](float value, int levels)
+    {
+        int quantized = static_cast<int>(value / 255.0f * levels + 0.5f);
+        
+        return quantized < 0 ? 0 : (quantized > levels ? levels : quantized);
+    };
+    
+    return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+static void From565(uint16_t color, int out[3])
+{
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Writes the 8 byte color half of a block. With transparency the 3 color
+// mode is used and masked pixels get index 3; otherwise the 4 color mode.
+static void EncodeColor(const ColorBlock& block, bool transparency, uint8_t* output)
+{
+    bool masked[16];
+    int count = 0;
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    
+    for (int i = 0; i < 16; i++)
+    {
+        masked[i] = transparency && block.pixels[i][3] < 128;
+        if (masked[i]) continue;
+        
+        for (int c = 0; c < 3; c++) mean[c] += block.pixels[i][c];
+        count++;
+    }
+    
+    uint16_t color0 = 0, color1 = 0;
+    
+    if (count > 0)
+    {
+        for (int c = 0; c < 3; c++) mean[c] /= count;
+        
+        float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        
+        for (int i = 0; i < 16; i++)
+        {
+            if (masked[i]) continue;
+            
+            float r = block.pixels[i][0] - mean[0], g = block.pixels[i][1] - mean[1], b = block.pixels[i][2] - mean[2];
+            
+            covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+            covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+        }
+        
+        // Principal axis by power iteration; a few steps are plenty for 16 points.
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        
+        for (int step = 0; step < 8; step++)
+        {
+            float next[3] =
+            {
+                covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+            };
+            
+            float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+            if (length < 1e-6f) break;
+            
+            for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+        }
+        
+        float minProjection = 0.0f, maxProjection = 0.0f;
+        
+        for (int i = 0; i < 16; i++)
+        {
+            if (masked[i]) continue;
+            
+            float projection = (block.pixels[i][0] - mean[0]) * axis[0] +
+                               (block.pixels[i][1] - mean[1]) * axis[1] +
+                               (block.pixels[i][2] - mean[2]) * axis[2];
+            
+            if (projection < minProjection) minProjection = projection;
+            if (projection > maxProjection) maxProjection = projection;
+        }
+        
+        float high[3], low[3];
+        
+        for (int c = 0; c < 3; c++)
+        {
+            high[c] = mean[c] + axis[c] * maxProjection;
+            low[c] = mean[c] + axis[c] * minProjection;
+        }
+        
+        color0 = To565(high);
+        color1 = To565(low);
+    }
+    
+    // The order of the endpoints selects the mode.
+    if (transparency ? color0 > color1 : color0 < color1)
+    {
+        uint16_t swap = color0;
+        color0 = color1;
+        color1 = swap;
+    }
+    
+    int palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+    
+    int colors = transparency ? 3 : 4;
+    
+    for (int c = 0; c < 3; c++)
+    {
+        if (colors == 4)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    
+    uint32_t indices = 0;
+    
+    for (int i = 0; i < 16; i++)
+    {
+        uint32_t best = 3;
+        
+        if (!masked[i])
+        {
+            int bestDistance = 1 << 30;
+            
+            for (int p = 0; p < colors; p++)
+            {
+                int dr = block.pixels[i][0] - palette[p][0];
+                int dg = block.pixels[i][1] - palette[p][1];
+                int db = block.pixels[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                
+                if (distance < bestDistance) { bestDistance = distance; best = static_cast<uint32_t>(p); }
+            }
+        }
+        
+        indices |= best << (i * 2);
+    }
+    
+    output[0] = static_cast<uint8_t>(color0);
+    output[1] = static_cast<uint8_t>(color0 >> 8);
+    output[2] = static_cast<uint8_t>(color1);
+    output[3] = static_cast<uint8_t>(color1 >> 8);
+    
+    for (int i = 0; i < 4; i++) output[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+}
+
+// Writes the 8 byte alpha half of a BC3 block, in the 8 level mode.
+static void EncodeAlpha(const ColorBlock& block, uint8_t* output)
+{
+    int alpha0 = 0, alpha1 = 255;
+    
+    for (int i = 0; i < 16; i++)
+    {
+        if (block.pixels[i][3] > alpha0) alpha0 = block.pixels[i][3];
+        if (block.pixels[i][3] < alpha1) alpha1 = block.pixels[i][3];
+    }
+    
+    int palette[8] = { alpha0, alpha1 };
+    
+    for (int p = 1; p < 7; p++) palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+    
+    uint64_t indices = 0;
+    
+    for (int i = 0; i < 16; i++)
+    {
+        int best = 0, bestDistance = 256;
+        
+        for (int p = 0; p < 8; p++)
+        {
+            int distance = std::abs(block.pixels[i][3] - palette[p]);
+            if (distance < bestDistance) { bestDistance = distance; best = p; }
+        }
+        
+        indices |= static_cast<uint64_t>(best) << (i * 3);
+    }
+    
+    output[0] = static_cast<uint8_t>(alpha0);
+    output[1] = static_cast<uint8_t>(alpha1);
+    
+    for (int i = 0; i < 6; i++) output[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+}
+
+void CompressBC1(const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output)
+{
+    ColorBlock block;
+    
+    for (uint32_t y = 0; y < (height + 3) / 4; y++)
+    {
+        for (uint32_t x = 0; x < (width + 3) / 4; x++)
+        {
+            LoadBlock(pixels, width, height, x, y, block);
+            
+            bool transparency = false;
+            for (int i = 0; i < 16; i++) transparency |= block.pixels[i][3] < 128;
+            
+            EncodeColor(block, transparency, output);
+            output += 8;
+        }
+    }
+}
+
+void CompressBC3(const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output)
+{
+    ColorBlock block;
+    
+    for (uint32_t y = 0; y < (height + 3) / 4; y++)
+    {
+        for (uint32_t x = 0; x < (width + 3) / 4; x++)
+        {
+            LoadBlock(pixels, width, height, x, y, block);
+            
+            EncodeAlpha(block, output);
+            
+            // BC3 always decodes its color half in the 4 color mode.
+            EncodeColor(block, false, output + 8);
+            output += 16;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Encoders for the BC1 and BC3 block formats, for offline cooking. Both read
+// tightly packed RGBA8 pixels and write one block per 4x4 tile, row by row;
+// partial tiles at the right and bottom edges repeat their last pixels.
+// Colors are fitted along their principal axis, which is slower than a
+// bounding box but keeps gradients and antialiased edges clean.
+
+// 8 bytes per block. Pixels with alpha below 128 become fully transparent;
+// everything else is opaque.
+void CompressBC1(const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output);
+
+// 16 bytes per block: the color of BC1 plus 8 interpolated alpha levels.
+void CompressBC3(const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output);
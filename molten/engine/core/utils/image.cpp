@@ -26,12 +26,21 @@
 #include "../../third_party/stbi/stbi-image.h"
 
 #include "log-macros.h"
+#include "../assets/asset-archive.h"
 
-Image::Image(const char* filepath)
-: m_Filepath(filepath), m_Data(nullptr), m_Width(0), m_Height(0), m_Channels(0)
+Image::Image(const char* filepath, const ImageLoadOptions& options)
+: m_Filepath(filepath), m_Width(0), m_Height(0), m_Channels(0), m_Data(nullptr)
 {
-    stbi_set_flip_vertically_on_load(true);
-    m_Data = stbi_load(filepath, &m_Width, &m_Height, &m_Channels, STBI_rgb_alpha);
+    // Packed assets are decoded straight from the archive's mapping.
+    AssetData encoded;
+    
+    if (AssetArchive::Load(m_Filepath, encoded))
+    {
+        // The thread-local setting, not the global one, so concurrent decodes
+        // can't change each other's orientation.
+        stbi_set_flip_vertically_on_load_thread(options.flipVertically);
+        m_Data = stbi_load_from_memory(encoded.GetData(), static_cast<int>(encoded.GetSize()), &m_Width, &m_Height, &m_Channels, STBI_rgb_alpha);
+    }
 
     if (!m_Data)
     {
@@ -40,6 +49,19 @@ Image::Image(const char* filepath)
     }
 }
 
+Image::Image(const unsigned char* encoded, size_t size, const char* name, const ImageLoadOptions& options)
+: m_Filepath(name ? name : ""), m_Width(0), m_Height(0), m_Channels(0), m_Data(nullptr)
+{
+    stbi_set_flip_vertically_on_load_thread(options.flipVertically);
+    m_Data = stbi_load_from_memory(encoded, static_cast<int>(size), &m_Width, &m_Height, &m_Channels, STBI_rgb_alpha);
+
+    if (!m_Data)
+    {
+        LOG_CORE_ERROR("Failed to decode image: {}", m_Filepath);
+        m_Width = m_Height = m_Channels = 0;
+    }
+}
+
 Image::~Image()
 {
     stbi_image_free(m_Data);
@@ -20,11 +20,24 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// Per-call decode settings. They only apply to the decoding thread, so images
+// can be decoded on several threads at once with different options.
+struct ImageLoadOptions
+{
+    // Textures are sampled bottom-up, so images are flipped by default.
+    bool flipVertically = true;
+};
+
 class Image
 {
 private:
     
-    const char* m_Filepath;
+    std::string m_Filepath;
     
     int m_Width;
     int m_Height;
@@ -34,17 +47,25 @@ private:
     
 public:
     
-    Image(const char* filepath);
+    // Reads the file through the mounted asset archives, falling back to the loose file.
+    Image(const char* filepath, const ImageLoadOptions& options = ImageLoadOptions());
+    
+    // Decodes an encoded image (PNG, JPG, ...) already in memory; name is only used for logging.
+    Image(const unsigned char* encoded, size_t size, const char* name, const ImageLoadOptions& options = ImageLoadOptions());
+    
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
     
-    inline const char* GetFilepath() { return m_Filepath; }
+    inline const char* GetFilepath() const { return m_Filepath.c_str(); }
     
     bool IsValid() const { return m_Data != nullptr; }
     
-    inline int GetWidth() { return m_Width; }
-    inline int GetHeight() { return m_Height; }
-    inline int GetChannels() { return m_Channels; }
+    inline int GetWidth() const { return m_Width; }
+    inline int GetHeight() const { return m_Height; }
+    inline int GetChannels() const { return m_Channels; }
     
     inline unsigned char* GetData() { return m_Data; }
+    inline const unsigned char* GetData() const { return m_Data; }
     
     ~Image();
 };
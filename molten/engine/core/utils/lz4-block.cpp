@@ -0,0 +1,227 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lz4-block.h"
+
+#include <cstring>
+#include <vector>
+
+// A match is at least 4 bytes; the last 5 bytes of a block are always
+// literals and no match starts in its last 12.
+static constexpr size_t MinMatch = 4;
+static constexpr size_t LastLiterals = 5;
+static constexpr size_t MatchFindLimit = 12;
+
+static constexpr size_t MaxOffset = 65535;
+
+static constexpr uint32_t HashBits = 16;
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    
+    return value;
+}
+
+static inline uint32_t Hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+// Lengths of 15 and more continue in bytes of 255, ended by a smaller one.
+static inline uint8_t* WriteLength(uint8_t* out, size_t length)
+{
+    for (; length >= 255; length -= 255) *out++ = 255;
+    
+    *out++ = static_cast<uint8_t>(length);
+    
+    return out;
+}
+
+size_t GetLZ4CompressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+// Writes one sequence; a zero match length writes only literals, which ends the block.
+static uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    uint8_t* token = out++;
+    
+    *token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+    if (literalLength >= 15) out = WriteLength(out, literalLength - 15);
+    
+    std::memcpy(out, literals, literalLength);
+    out += literalLength;
+    
+    if (matchLength == 0) return out;
+    
+    *out++ = static_cast<uint8_t>(offset);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    
+    size_t length = matchLength - MinMatch;
+    
+    *token |= static_cast<uint8_t>(length < 15 ? length : 15);
+    if (length >= 15) out = WriteLength(out, length - 15);
+    
+    return out;
+}
+
+size_t CompressLZ4(const uint8_t* input, size_t size, uint8_t* output, size_t capacity)
+{
+    // Only bounded outputs are written to directly; tighter ones go through a scratch copy.
+    if (capacity < GetLZ4CompressBound(size))
+    {
+        std::vector<uint8_t> scratch(GetLZ4CompressBound(size));
+        
+        size_t compressed = CompressLZ4(input, size, scratch.data(), scratch.size());
+        if (compressed > capacity) return 0;
+        
+        std::memcpy(output, scratch.data(), compressed);
+        return compressed;
+    }
+    
+    uint8_t* out = output;
+    size_t anchor = 0;
+    
+    if (size > MatchFindLimit)
+    {
+        // Positions plus one, so zero means empty.
+        std::vector<uint32_t> table(size_t(1) << HashBits, 0);
+        
+        size_t matchLimit = size - LastLiterals;
+        size_t position = 0;
+        
+        while (position + MatchFindLimit <= size)
+        {
+            uint32_t sequence = Read32(input + position);
+            uint32_t& slot = table[Hash(sequence)];
+            
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(position + 1);
+            
+            if (candidate == 0 || position - (candidate - 1) > MaxOffset || Read32(input + candidate - 1) != sequence)
+            {
+                position++;
+                continue;
+            }
+            
+            candidate--;
+            
+            // Grow the match backwards over literals, then forwards.
+            while (position > anchor && candidate > 0 && input[position - 1] == input[candidate - 1])
+            {
+                position--;
+                candidate--;
+            }
+            
+            size_t length = MinMatch;
+            while (position + length < matchLimit && input[position + length] == input[candidate + length]) length++;
+            
+            out = WriteSequence(out, input + anchor, position - anchor, position - candidate, length);
+            
+            position += length;
+            anchor = position;
+            
+            // Index the start of the next sequence so tight repeats are found.
+            if (position >= 2 && position + MatchFindLimit <= size)
+                table[Hash(Read32(input + position - 2))] = static_cast<uint32_t>(position - 1);
+        }
+    }
+    
+    out = WriteSequence(out, input + anchor, size - anchor, 0, 0);
+    
+    return static_cast<size_t>(out - output);
+}
+
+bool DecompressLZ4(const uint8_t* input, size_t size, uint8_t* output, size_t outputSize)
+{
+    const uint8_t* in = input;
+    const uint8_t* inEnd = input + size;
+    
+    uint8_t* out = output;
+    uint8_t* outEnd = output + outputSize;
+    
+    auto readLength = [&](size_t& length) -> bool
+    {
+        uint8_t byte;
+        
+        do
+        {
+            if (in == inEnd) return false;
+            
+            byte = *in++;
+            length += byte;
+        }
+        while (byte == 255);
+        
+        return true;
+    };
+    
+    while (in < inEnd)
+    {
+        uint8_t token = *in++;
+        
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        
+        if (literalLength > size_t(inEnd - in) || literalLength > size_t(outEnd - out)) return false;
+        
+        std::memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+        
+        // The last sequence has no match.
+        if (in == inEnd) break;
+        
+        if (inEnd - in < 2) return false;
+        
+        size_t offset = size_t(in[0]) | size_t(in[1]) << 8;
+        in += 2;
+        
+        if (offset == 0 || offset > size_t(out - output)) return false;
+        
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        
+        matchLength += MinMatch;
+        
+        if (matchLength > size_t(outEnd - out)) return false;
+        
+        const uint8_t* match = out - offset;
+        
+        // Overlapping matches repeat what they've just written, so only
+        // distant ones can be copied in one go.
+        if (offset >= matchLength)
+        {
+            std::memcpy(out, match, matchLength);
+            out += matchLength;
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLength; i++) *out++ = match[i];
+        }
+    }
+    
+    return out == outEnd;
+}
@@ -0,0 +1,41 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// The LZ4 block format, without frames or checksums: fast enough to decode
+// that reading compressed assets beats reading them raw. Blocks written here
+// can be read by any LZ4 decoder and the other way round.
+
+// Largest output CompressLZ4 may write for an input of this size.
+size_t GetLZ4CompressBound(size_t size);
+
+// Greedy compression with a hash table of recent 4-byte sequences. Returns
+// the compressed size, or 0 if it doesn't fit in capacity.
+size_t CompressLZ4(const uint8_t* input, size_t size, uint8_t* output, size_t capacity);
+
+// Fails, rather than reading or writing out of bounds, on corrupt input or
+// when the block doesn't decode to exactly outputSize bytes.
+bool DecompressLZ4(const uint8_t* input, size_t size, uint8_t* output, size_t outputSize);
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mapped-file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log-macros.h"
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: m_Data(other.m_Data), m_Size(other.m_Size)
+{
+    other.m_Data = nullptr;
+    other.m_Size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+    }
+    
+    return *this;
+}
+
+bool MappedFile::Open(const char* path)
+{
+    Close();
+    
+    int file = ::open(path, O_RDONLY);
+    if (file < 0) return false;
+    
+    struct stat info;
+    
+    if (::fstat(file, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(file);
+        return false;
+    }
+    
+    void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    
+    // The mapping keeps its own reference to the file.
+    ::close(file);
+    
+    if (data == MAP_FAILED)
+    {
+        LOG_CORE_ERROR("Failed to map {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    
+    m_Data = static_cast<const uint8_t*>(data);
+    m_Size = static_cast<size_t>(info.st_size);
+    
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_Data) ::munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+    if (!m_Data || offset >= m_Size) return;
+    
+    if (size > m_Size - offset) size = m_Size - offset;
+    
+    Prefetch(m_Data + offset, size);
+}
+
+void MappedFile::Prefetch(const void* data, size_t size)
+{
+    if (!data || size == 0) return;
+    
+    // madvise wants a page aligned start; mappings begin on a page, so
+    // rounding down stays inside them.
+    uintptr_t page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    uintptr_t address = reinterpret_cast<uintptr_t>(data);
+    uintptr_t start = address & ~(page - 1);
+    
+    ::madvise(reinterpret_cast<void*>(start), size + (address - start), MADV_WILLNEED);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
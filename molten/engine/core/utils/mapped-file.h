@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// A whole file mapped read-only into memory. Pages are read in as they're
+// first touched, so opening costs the same whatever the file size, and the
+// data can be handed to the GPU upload path without a copy.
+class MappedFile
+{
+private:
+    
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    
+public:
+    
+    MappedFile() = default;
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    // Fails quietly if the file doesn't exist, so callers can probe for it.
+    bool Open(const char* path);
+    
+    void Close();
+    
+    // Asks the OS to start reading the range in the background.
+    void Prefetch(size_t offset, size_t size) const;
+    
+    // The same for a range anywhere inside some mapping, e.g. a view handed out by an archive.
+    static void Prefetch(const void* data, size_t size);
+    
+    inline bool IsOpen() const { return m_Data != nullptr; }
+    
+    inline const uint8_t* GetData() const { return m_Data; }
+    inline size_t GetSize() const { return m_Size; }
+    
+    ~MappedFile();
+};
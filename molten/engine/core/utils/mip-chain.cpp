@@ -0,0 +1,332 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mip-chain.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define MOLTEN_MIP_CHAIN_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MOLTEN_MIP_CHAIN_NEON 1
+#endif
+
+#include "../jobs/job-system.h"
+
+// Linear values are encoded through a table this fine, which resolves the
+// darkest sRGB steps (about 1 / 3300 apart) several times over.
+static constexpr uint32_t EncodeTableSize = 16384;
+
+// Below this many destination texels a rect is filtered on the calling thread.
+static constexpr size_t ParallelTexels = 256 * 256;
+static constexpr size_t TexelsPerJob = 16 * 1024;
+
+namespace
+{
+    // One RGBA texel in the four lanes of a vector.
+#if MOLTEN_MIP_CHAIN_X86
+    struct Texel
+    {
+        __m128 v;
+        
+        static Texel Set(float r, float g, float b, float a) { return { _mm_setr_ps(r, g, b, a) }; }
+        static Texel Set(float x) { return { _mm_set1_ps(x) }; }
+        
+        friend Texel operator+(Texel a, Texel b) { return { _mm_add_ps(a.v, b.v) }; }
+        friend Texel operator*(Texel a, Texel b) { return { _mm_mul_ps(a.v, b.v) }; }
+        
+        static Texel Clamp01(Texel a) { return { _mm_min_ps(_mm_max_ps(a.v, _mm_setzero_ps()), _mm_set1_ps(1.0f)) }; }
+        
+        float GetAlpha() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+        
+        // Truncates toward zero.
+        void StoreInt(int32_t out[4]) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvttps_epi32(v)); }
+    };
+#elif MOLTEN_MIP_CHAIN_NEON
+    struct Texel
+    {
+        float32x4_t v;
+        
+        static Texel Set(float r, float g, float b, float a) { float lanes[4] = { r, g, b, a }; return { vld1q_f32(lanes) }; }
+        static Texel Set(float x) { return { vdupq_n_f32(x) }; }
+        
+        friend Texel operator+(Texel a, Texel b) { return { vaddq_f32(a.v, b.v) }; }
+        friend Texel operator*(Texel a, Texel b) { return { vmulq_f32(a.v, b.v) }; }
+        
+        static Texel Clamp01(Texel a) { return { vminq_f32(vmaxq_f32(a.v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f)) }; }
+        
+        float GetAlpha() const { return vgetq_lane_f32(v, 3); }
+        
+        void StoreInt(int32_t out[4]) const { vst1q_s32(out, vcvtq_s32_f32(v)); }
+    };
+#else
+    struct Texel
+    {
+        float v[4];
+        
+        static Texel Set(float r, float g, float b, float a) { return { { r, g, b, a } }; }
+        static Texel Set(float x) { return { { x, x, x, x } }; }
+        
+        friend Texel operator+(Texel a, Texel b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+        friend Texel operator*(Texel a, Texel b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+        
+        static Texel Clamp01(Texel a)
+        {
+            for (float& x : a.v) x = std::min(std::max(x, 0.0f), 1.0f);
+            return a;
+        }
+        
+        float GetAlpha() const { return v[3]; }
+        
+        void StoreInt(int32_t out[4]) const { for (int i = 0; i < 4; i++) out[i] = static_cast<int32_t>(v[i]); }
+    };
+#endif
+    
+    // Byte to linear value, and linear value to byte.
+    struct TransferTables
+    {
+        float decode[256];
+        uint8_t encode[EncodeTableSize];
+    };
+    
+    const TransferTables& GetTables(bool gammaCorrect)
+    {
+        static const TransferTables* tables = []
+        {
+            static TransferTables result[2];
+            
+            for (int srgb = 0; srgb < 2; srgb++)
+            {
+                for (int i = 0; i < 256; i++)
+                {
+                    float c = i / 255.0f;
+                    result[srgb].decode[i] = !srgb ? c : c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                
+                for (uint32_t i = 0; i < EncodeTableSize; i++)
+                {
+                    float l = float(i) / (EncodeTableSize - 1);
+                    float c = !srgb ? l : l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                    
+                    result[srgb].encode[i] = static_cast<uint8_t>(std::min(std::max(c * 255.0f + 0.5f, 0.0f), 255.0f));
+                }
+            }
+            
+            return result;
+        }();
+        
+        return tables[gammaCorrect ? 1 : 0];
+    }
+    
+    inline Texel Decode(const uint8_t* texel, const TransferTables& tables, bool premultiply)
+    {
+        float a = texel[3] * (1.0f / 255.0f);
+        Texel t = Texel::Set(tables.decode[texel[0]], tables.decode[texel[1]], tables.decode[texel[2]], a);
+        
+        return premultiply ? t * Texel::Set(a, a, a, 1.0f) : t;
+    }
+    
+    inline void Encode(Texel t, const TransferTables& tables, bool premultiply, uint8_t* texel)
+    {
+        if (premultiply)
+        {
+            float a = t.GetAlpha();
+            float inverse = a > 0.0f ? 1.0f / a : 0.0f;
+            
+            t = t * Texel::Set(inverse, inverse, inverse, 1.0f);
+        }
+        
+        // Color indexes the encode table; alpha is stored as is.
+        const float scale = EncodeTableSize - 1;
+        
+        int32_t index[4];
+        (Texel::Clamp01(t) * Texel::Set(scale, scale, scale, 255.0f) + Texel::Set(0.5f)).StoreInt(index);
+        
+        texel[0] = tables.encode[index[0]];
+        texel[1] = tables.encode[index[1]];
+        texel[2] = tables.encode[index[2]];
+        texel[3] = static_cast<uint8_t>(index[3]);
+    }
+    
+    // Source texels one destination texel covers along an axis, and how much of each.
+    struct Taps
+    {
+        uint32_t index[3];
+        float weight[3];
+        uint32_t count;
+    };
+    
+    inline Taps GetTaps(uint32_t i, uint32_t sourceSize)
+    {
+        if (sourceSize == 1) return { { 0, 0, 0 }, { 1.0f, 0.0f, 0.0f }, 1 };
+        if (sourceSize % 2 == 0) return { { i * 2, i * 2 + 1, 0 }, { 0.5f, 0.5f, 0.0f }, 2 };
+        
+        // n texels share 2n + 1, so each covers two and a half: the middle
+        // one whole and the outer two in proportions that slide along the row.
+        float n = static_cast<float>(sourceSize / 2);
+        float inverse = 1.0f / static_cast<float>(sourceSize);
+        
+        return { { i * 2, i * 2 + 1, i * 2 + 2 }, { (n - i) * inverse, n * inverse, (i + 1) * inverse }, 3 };
+    }
+    
+    void DownsampleRows(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination,
+                        uint32_t destinationWidth, uint32_t x0, uint32_t x1, uint32_t y0, uint32_t y1,
+                        const TransferTables& tables, bool premultiply)
+    {
+        bool oddWidth = sourceWidth > 1 && sourceWidth % 2 != 0;
+        bool oddHeight = sourceHeight > 1 && sourceHeight % 2 != 0;
+        
+        // Even sizes (and 1) are a plain 2x2 box; only odd ones need the wider filter.
+        if (!oddWidth && !oddHeight)
+        {
+            const Texel quarter = Texel::Set(0.25f);
+            
+            for (uint32_t y = y0; y < y1; y++)
+            {
+                const uint8_t* row0 = source + size_t(std::min(y * 2, sourceHeight - 1)) * sourceWidth * 4;
+                const uint8_t* row1 = source + size_t(std::min(y * 2 + 1, sourceHeight - 1)) * sourceWidth * 4;
+                
+                uint8_t* out = destination + (size_t(y) * destinationWidth + x0) * 4;
+                
+                for (uint32_t x = x0; x < x1; x++, out += 4)
+                {
+                    size_t left = size_t(std::min(x * 2, sourceWidth - 1)) * 4;
+                    size_t right = size_t(std::min(x * 2 + 1, sourceWidth - 1)) * 4;
+                    
+                    Texel sum = Decode(row0 + left, tables, premultiply) + Decode(row0 + right, tables, premultiply) +
+                                Decode(row1 + left, tables, premultiply) + Decode(row1 + right, tables, premultiply);
+                    
+                    Encode(sum * quarter, tables, premultiply, out);
+                }
+            }
+            
+            return;
+        }
+        
+        for (uint32_t y = y0; y < y1; y++)
+        {
+            Taps rows = GetTaps(y, sourceHeight);
+            
+            uint8_t* out = destination + (size_t(y) * destinationWidth + x0) * 4;
+            
+            for (uint32_t x = x0; x < x1; x++, out += 4)
+            {
+                Taps columns = GetTaps(x, sourceWidth);
+                Texel sum = Texel::Set(0.0f);
+                
+                for (uint32_t r = 0; r < rows.count; r++)
+                {
+                    const uint8_t* row = source + size_t(rows.index[r]) * sourceWidth * 4;
+                    Texel rowSum = Texel::Set(0.0f);
+                    
+                    for (uint32_t c = 0; c < columns.count; c++)
+                        rowSum = rowSum + Decode(row + size_t(columns.index[c]) * 4, tables, premultiply) * Texel::Set(columns.weight[c]);
+                    
+                    sum = sum + rowSum * Texel::Set(rows.weight[r]);
+                }
+                
+                Encode(sum, tables, premultiply, out);
+            }
+        }
+    }
+}
+
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+{
+    uint32_t levels = 1;
+    
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) levels++;
+    
+    return levels;
+}
+
+static inline uint32_t HalfDimension(uint32_t size)
+{
+    return size > 1 ? size / 2 : 1;
+}
+
+size_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t levelCount)
+{
+    size_t size = 0;
+    
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        size += size_t(width) * height * 4;
+        
+        width = HalfDimension(width);
+        height = HalfDimension(height);
+    }
+    
+    return size;
+}
+
+void DownsampleRegion(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination,
+                      uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, const MipFilterOptions& options, JobSystem* jobSystem)
+{
+    uint32_t width = HalfDimension(sourceWidth);
+    uint32_t height = HalfDimension(sourceHeight);
+    
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+    
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    const TransferTables& tables = GetTables(options.gammaCorrect);
+    bool premultiply = options.premultipliedAlpha;
+    
+    size_t rows = y1 - y0;
+    size_t texels = rows * (x1 - x0);
+    
+    if (!jobSystem || jobSystem->GetWorkerCount() == 0 || texels < ParallelTexels)
+    {
+        DownsampleRows(source, sourceWidth, sourceHeight, destination, width, x0, x1, y0, y1, tables, premultiply);
+        return;
+    }
+    
+    size_t grain = std::max<size_t>(1, TexelsPerJob / (x1 - x0));
+    
+    jobSystem->ParallelFor(rows, grain, [&](size_t begin, size_t end)
+    {
+        DownsampleRows(source, sourceWidth, sourceHeight, destination, width, x0, x1,
+                       y0 + static_cast<uint32_t>(begin), y0 + static_cast<uint32_t>(end), tables, premultiply);
+    });
+}
+
+void GenerateMipChain(uint8_t* chain, uint32_t width, uint32_t height, uint32_t levelCount,
+                      const MipFilterOptions& options, JobSystem* jobSystem)
+{
+    uint8_t* level = chain;
+    
+    for (uint32_t i = 1; i < levelCount; i++)
+    {
+        uint8_t* next = level + size_t(width) * height * 4;
+        
+        DownsampleRegion(level, width, height, next, 0, 0, HalfDimension(width), HalfDimension(height), options, jobSystem);
+        
+        level = next;
+        width = HalfDimension(width);
+        height = HalfDimension(height);
+    }
+}
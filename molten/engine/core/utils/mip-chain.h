@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class JobSystem;
+
+struct MipFilterOptions
+{
+    // Color is averaged in linear light and stored back as sRGB, so
+    // minified sprites don't come out darker than they are. Turn it off for
+    // data that isn't color, such as masks or normal maps.
+    bool gammaCorrect = true;
+    
+    // Color is weighted by alpha, so the garbage color of transparent
+    // texels doesn't bleed into the edges of opaque ones.
+    bool premultipliedAlpha = true;
+};
+
+// Levels in a full chain, down to 1x1.
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+// Bytes in a chain of tightly packed RGBA8 levels, largest first.
+size_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t levelCount);
+
+// Box filters the rect [x0, x1) x [y0, y1) of a level from the level above
+// it, which is sourceWidth x sourceHeight; the destination is half that,
+// rounded down but at least 1. Along an odd side each texel spans three
+// source texels, weighted by coverage, so none is dropped. Each texel
+// is filtered as one SIMD vector (SSE or NEON, scalar elsewhere). With a job
+// system large rects are split by rows across the workers.
+void DownsampleRegion(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination,
+                      uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+                      const MipFilterOptions& options = MipFilterOptions(), JobSystem* jobSystem = nullptr);
+
+// Fills levels 1 to levelCount - 1 of an RGBA8 chain whose level 0 is
+// already at its start. The chain holds GetMipChainSize bytes, in the
+// layout RenderDevice::CreateTexture takes.
+void GenerateMipChain(uint8_t* chain, uint32_t width, uint32_t height, uint32_t levelCount,
+                      const MipFilterOptions& options = MipFilterOptions(), JobSystem* jobSystem = nullptr);
@@ -0,0 +1,244 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "spsc-queue.h"
+#include "log-macros.h"
+
+// Drained every frame, so this only has to hold one frame of one thread.
+static constexpr size_t RingCapacity = 1 << 14;
+
+struct ThreadRecorder
+{
+    SpscQueue<ProfileEvent, RingCapacity> ring;
+    std::atomic<uint64_t> dropped{0};
+    uint32_t id = 0;
+    
+    // Guarded by s_RecordersMutex.
+    std::string name;
+};
+
+struct CapturedEvent
+{
+    ProfileEvent event;
+    uint32_t thread;
+};
+
+std::atomic<bool> Profiler::s_Capturing{false};
+
+static const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+
+// Recorders live until exit, so events from threads that already ended can
+// still be collected.
+static std::mutex s_RecordersMutex;
+static std::vector<std::unique_ptr<ThreadRecorder>> s_Recorders;
+static thread_local ThreadRecorder* t_Recorder = nullptr;
+
+// Main thread only.
+static std::vector<CapturedEvent> s_Events;
+static uint32_t s_CapturedFrames = 0;
+static uint32_t s_FrameLimit = 0;
+static uint64_t s_LastFrame = 0;
+
+static ThreadRecorder* GetRecorder()
+{
+    if (t_Recorder) return t_Recorder;
+    
+    std::lock_guard<std::mutex> lock(s_RecordersMutex);
+    
+    s_Recorders.push_back(std::make_unique<ThreadRecorder>());
+    t_Recorder = s_Recorders.back().get();
+    t_Recorder->id = static_cast<uint32_t>(s_Recorders.size());
+    t_Recorder->name = "Thread " + std::to_string(t_Recorder->id);
+    
+    return t_Recorder;
+}
+
+uint64_t Profiler::Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count());
+}
+
+void Profiler::Record(const ProfileEvent& event)
+{
+    ThreadRecorder* recorder = GetRecorder();
+    
+    if (!recorder->ring.Push(event)) recorder->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadRecorder* recorder = GetRecorder();
+    
+    std::lock_guard<std::mutex> lock(s_RecordersMutex);
+    recorder->name = name;
+}
+
+void Profiler::StartCapture(uint32_t frameCount)
+{
+    // Leftovers from an earlier capture don't belong to this one.
+    Collect();
+    s_Events.clear();
+    
+    {
+        std::lock_guard<std::mutex> lock(s_RecordersMutex);
+        
+        for (const std::unique_ptr<ThreadRecorder>& recorder : s_Recorders)
+            recorder->dropped.store(0, std::memory_order_relaxed);
+    }
+    
+    s_CapturedFrames = 0;
+    s_FrameLimit = frameCount;
+    s_LastFrame = Now();
+    
+    s_Capturing.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::StopCapture()
+{
+    s_Capturing.store(false, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::GetCapturedFrames()
+{
+    return s_CapturedFrames;
+}
+
+uint64_t Profiler::GetDroppedEvents()
+{
+    std::lock_guard<std::mutex> lock(s_RecordersMutex);
+    
+    uint64_t dropped = 0;
+    
+    for (const std::unique_ptr<ThreadRecorder>& recorder : s_Recorders)
+        dropped += recorder->dropped.load(std::memory_order_relaxed);
+    
+    return dropped;
+}
+
+void Profiler::MarkFrame()
+{
+    if (IsCapturing())
+    {
+        uint64_t now = Now();
+        
+        Record({ "Frame", s_LastFrame, static_cast<double>(now - s_LastFrame), ProfileEventType::Frame });
+        s_LastFrame = now;
+        
+        if (++s_CapturedFrames == s_FrameLimit) StopCapture();
+    }
+    
+    // Even outside a capture, so scopes that straddled its end don't sit in
+    // the rings until the next one.
+    Collect();
+}
+
+void Profiler::Collect()
+{
+    std::lock_guard<std::mutex> lock(s_RecordersMutex);
+    
+    ProfileEvent event;
+    
+    for (const std::unique_ptr<ThreadRecorder>& recorder : s_Recorders)
+        while (recorder->ring.Pop(event)) s_Events.push_back({ event, recorder->id });
+}
+
+static void WriteJsonString(FILE* file, const char* text)
+{
+    std::fputc('"', file);
+    
+    for (const char* c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\') std::fprintf(file, "\\%c", *c);
+        else if (static_cast<unsigned char>(*c) < 0x20) std::fprintf(file, "\\u%04x", *c);
+        else std::fputc(*c, file);
+    }
+    
+    std::fputc('"', file);
+}
+
+bool Profiler::WriteChromeTrace(const char* path)
+{
+    Collect();
+    
+    FILE* file = std::fopen(path, "wb");
+    if (!file) { LOG_CORE_ERROR("Failed to open profiler trace for writing: {}", path); return false; }
+    
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    
+    bool first = true;
+    
+    {
+        std::lock_guard<std::mutex> lock(s_RecordersMutex);
+        
+        for (const std::unique_ptr<ThreadRecorder>& recorder : s_Recorders)
+        {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         first ? "" : ",\n", recorder->id);
+            WriteJsonString(file, recorder->name.c_str());
+            std::fprintf(file, "}}");
+            first = false;
+        }
+    }
+    
+    // Timestamps are in microseconds.
+    for (const CapturedEvent& captured : s_Events)
+    {
+        const ProfileEvent& event = captured.event;
+        
+        std::fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+        WriteJsonString(file, event.name);
+        
+        if (event.type == ProfileEventType::Counter)
+        {
+            std::fprintf(file, ",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+                         captured.thread, event.start / 1000.0, event.value);
+        }
+        else
+        {
+            std::fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.type == ProfileEventType::Frame ? "frame" : "scope", captured.thread,
+                         event.start / 1000.0, event.value / 1000.0);
+        }
+        
+        first = false;
+    }
+    
+    std::fprintf(file, "\n]}\n");
+    
+    bool ok = !std::ferror(file);
+    ok = std::fclose(file) == 0 && ok;
+    
+    if (!ok) { LOG_CORE_ERROR("Failed to write profiler trace: {}", path); return false; }
+    
+    LOG_CORE_INFO("Wrote {} profiler events over {} frames to {}", s_Events.size(), s_CapturedFrames, path);
+    
+    return true;
+}
@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Scopes, counters and frame marks for Profiler. Compiled in by default,
+// out of NDEBUG builds; define MOLTEN_PROFILE to 1 or 0 to override.
+#ifndef MOLTEN_PROFILE
+    #ifdef NDEBUG
+        #define MOLTEN_PROFILE 0
+    #else
+        #define MOLTEN_PROFILE 1
+    #endif
+#endif
+
+enum class ProfileEventType : uint8_t
+{
+    Scope,
+    Counter,
+    Frame
+};
+
+// Names must outlive the capture: string literals or __func__.
+struct ProfileEvent
+{
+    const char* name;
+    uint64_t start;
+    
+    // Nanoseconds for scopes and frames, the value for counters.
+    double value;
+    
+    ProfileEventType type;
+};
+
+// In-process frame profiler. Each thread records into its own lock-free
+// ring, so instrumented code never takes a lock; MarkFrame, called once per
+// frame by the main thread, drains every ring into the capture. Outside a
+// capture scopes cost one relaxed load and record nothing.
+//
+// Captures export to the Chrome trace event format, which chrome://tracing
+// and Perfetto (ui.perfetto.dev) open.
+class Profiler
+{
+private:
+    
+    static std::atomic<bool> s_Capturing;
+    
+    static void Record(const ProfileEvent& event);
+    
+public:
+    
+    // Nanoseconds since the profiler's epoch.
+    static uint64_t Now();
+    
+    // Names the calling thread in exported traces.
+    static void SetThreadName(const char* name);
+    
+    // Starts recording. With a frame count the capture stops by itself
+    // after that many frames; 0 records until StopCapture. Clears any
+    // previous capture.
+    static void StartCapture(uint32_t frameCount = 0);
+    
+    static void StopCapture();
+    
+    static inline bool IsCapturing() { return s_Capturing.load(std::memory_order_relaxed); }
+    
+    // Frames marked since the capture started.
+    static uint32_t GetCapturedFrames();
+    
+    // Events that didn't fit in their thread's ring and were lost.
+    static uint64_t GetDroppedEvents();
+    
+    // Ends the current frame. The main thread calls this, and only that
+    // thread may call it, Collect or WriteChromeTrace.
+    static void MarkFrame();
+    
+    // Moves the events every thread recorded so far into the capture.
+    static void Collect();
+    
+    // Writes the capture as Chrome trace JSON. Returns false if the file
+    // can't be written.
+    static bool WriteChromeTrace(const char* path);
+    
+    static inline void Scope(const char* name, uint64_t start, uint64_t end)
+    {
+        Record({ name, start, static_cast<double>(end - start), ProfileEventType::Scope });
+    }
+    
+    static inline void Counter(const char* name, double value)
+    {
+        if (IsCapturing()) Record({ name, Now(), value, ProfileEventType::Counter });
+    }
+};
+
+// Records the time between construction and destruction as one event.
+class ProfileScope
+{
+private:
+    
+    const char* m_Name;
+    uint64_t m_Start = 0;
+    
+public:
+    
+    explicit ProfileScope(const char* name) : m_Name(Profiler::IsCapturing() ? name : nullptr)
+    {
+        if (m_Name) m_Start = Profiler::Now();
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    
+    ~ProfileScope()
+    {
+        if (m_Name) Profiler::Scope(m_Name, m_Start, Profiler::Now());
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if MOLTEN_PROFILE
+    #define PROFILE_SCOPE(name)          ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+    #define PROFILE_FUNCTION()           PROFILE_SCOPE(__func__)
+    #define PROFILE_COUNTER(name, value) Profiler::Counter(name, static_cast<double>(value))
+    #define PROFILE_FRAME()              Profiler::MarkFrame()
+    #define PROFILE_THREAD(name)         Profiler::SetThreadName(name)
+#else
+    #define PROFILE_SCOPE(name)          (void)0
+    #define PROFILE_FUNCTION()           (void)0
+    #define PROFILE_COUNTER(name, value) (void)sizeof(value)
+    #define PROFILE_FRAME()              (void)0
+    #define PROFILE_THREAD(name)         (void)0
+#endif
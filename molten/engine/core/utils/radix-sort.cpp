@@ -0,0 +1,77 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "radix-sort.h"
+
+#include <utility>
+
+void RadixSort(std::vector<SortKey>& items, std::vector<SortKey>& scratch)
+{
+    const size_t count = items.size();
+    if (count < 2) return;
+    
+    scratch.resize(count);
+    
+    // One histogram per byte, all filled in a single read of the keys.
+    uint32_t histograms[8][256] = {};
+    
+    for (const SortKey& item : items)
+        for (int pass = 0; pass < 8; pass++)
+            histograms[pass][(item.key >> (pass * 8)) & 0xFF]++;
+    
+    SortKey* source = items.data();
+    SortKey* destination = scratch.data();
+    
+    for (int pass = 0; pass < 8; pass++)
+    {
+        uint32_t* histogram = histograms[pass];
+        
+        const uint32_t shift = pass * 8;
+        
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) continue;
+        
+        uint32_t offsets[256];
+        uint32_t total = 0;
+        
+        for (int digit = 0; digit < 256; digit++)
+        {
+            offsets[digit] = total;
+            total += histogram[digit];
+        }
+        
+        for (size_t i = 0; i < count; i++)
+            destination[offsets[(source[i].key >> shift) & 0xFF]++] = source[i];
+        
+        std::swap(source, destination);
+    }
+    
+    // An odd number of passes leaves the result in the scratch buffer.
+    if (source != items.data()) items.swap(scratch);
+}
+
+bool IsSorted(const std::vector<SortKey>& items)
+{
+    for (size_t i = 1; i < items.size(); i++)
+        if (items[i].key < items[i - 1].key) return false;
+    
+    return true;
+}
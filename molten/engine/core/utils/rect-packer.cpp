@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "rect-packer.h"
+
+#include <limits>
+#include <algorithm>
+
+static bool Contains(const PackedRect& outer, const PackedRect& inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+RectPacker::RectPacker(uint32_t width, uint32_t height) { Reset(width, height); }
+
+void RectPacker::Reset(uint32_t width, uint32_t height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_UsedArea = 0;
+    
+    m_FreeRects.clear();
+    m_FreeRects.push_back({ 0, 0, width, height });
+}
+
+bool RectPacker::FindPosition(uint32_t width, uint32_t height, PackedRect& out) const
+{
+    uint32_t bestShortSide = std::numeric_limits<uint32_t>::max();
+    uint32_t bestLongSide = std::numeric_limits<uint32_t>::max();
+    bool found = false;
+    
+    for (const PackedRect& free : m_FreeRects)
+    {
+        if (free.width < width || free.height < height) continue;
+        
+        uint32_t leftoverX = free.width - width;
+        uint32_t leftoverY = free.height - height;
+        
+        uint32_t shortSide = std::min(leftoverX, leftoverY);
+        uint32_t longSide = std::max(leftoverX, leftoverY);
+        
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+        {
+            out = { free.x, free.y, width, height };
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            found = true;
+        }
+    }
+    
+    return found;
+}
+
+bool RectPacker::Insert(uint32_t width, uint32_t height, PackedRect& out)
+{
+    if (width == 0 || height == 0) return false;
+    
+    if (!FindPosition(width, height, out)) return false;
+    
+    SplitFreeRects(out);
+    PruneFreeRects();
+    
+    m_UsedArea += uint64_t(width) * height;
+    
+    return true;
+}
+
+void RectPacker::Occupy(const PackedRect& rect)
+{
+    if (rect.width == 0 || rect.height == 0) return;
+    
+    SplitFreeRects(rect);
+    PruneFreeRects();
+    
+    m_UsedArea += uint64_t(rect.width) * rect.height;
+}
+
+void RectPacker::SplitFreeRects(const PackedRect& used)
+{
+    // Every free rect overlapping the placed one is replaced by up to four
+    // maximal rects covering what's left of it.
+    size_t count = m_FreeRects.size();
+    
+    for (size_t i = 0; i < count;)
+    {
+        PackedRect free = m_FreeRects[i];
+        
+        bool overlaps = used.x < free.x + free.width && used.x + used.width > free.x &&
+                        used.y < free.y + free.height && used.y + used.height > free.y;
+        
+        if (!overlaps) { i++; continue; }
+        
+        if (used.x > free.x)
+            m_FreeRects.push_back({ free.x, free.y, used.x - free.x, free.height });
+        
+        if (used.x + used.width < free.x + free.width)
+            m_FreeRects.push_back({ used.x + used.width, free.y, free.x + free.width - (used.x + used.width), free.height });
+        
+        if (used.y > free.y)
+            m_FreeRects.push_back({ free.x, free.y, free.width, used.y - free.y });
+        
+        if (used.y + used.height < free.y + free.height)
+            m_FreeRects.push_back({ free.x, used.y + used.height, free.width, free.y + free.height - (used.y + used.height) });
+        
+        m_FreeRects[i] = m_FreeRects[count - 1];
+        m_FreeRects[count - 1] = m_FreeRects.back();
+        m_FreeRects.pop_back();
+        count--;
+    }
+}
+
+void RectPacker::PruneFreeRects()
+{
+    // Drop free rects fully contained in another one.
+    for (size_t i = 0; i < m_FreeRects.size(); i++)
+    {
+        for (size_t j = i + 1; j < m_FreeRects.size();)
+        {
+            if (Contains(m_FreeRects[j], m_FreeRects[i]))
+            {
+                m_FreeRects.erase(m_FreeRects.begin() + i);
+                i--;
+                break;
+            }
+            
+            if (Contains(m_FreeRects[i], m_FreeRects[j]))
+            {
+                m_FreeRects.erase(m_FreeRects.begin() + j);
+                continue;
+            }
+            
+            j++;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+struct PackedRect
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// MaxRects bin packer using the best-short-side-fit heuristic. Rectangles are
+// never rotated, so a packed rect is always exactly the requested size.
+class RectPacker
+{
+private:
+    
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    
+    uint64_t m_UsedArea = 0;
+    
+    std::vector<PackedRect> m_FreeRects;
+    
+    bool FindPosition(uint32_t width, uint32_t height, PackedRect& out) const;
+    
+    void SplitFreeRects(const PackedRect& used);
+    
+    void PruneFreeRects();
+    
+public:
+    
+    RectPacker() = default;
+    
+    explicit RectPacker(uint32_t width, uint32_t height);
+    
+    void Reset(uint32_t width, uint32_t height);
+    
+    // Returns false when the rect doesn't fit anywhere in the remaining space.
+    bool Insert(uint32_t width, uint32_t height, PackedRect& out);
+    
+    // Marks an already placed rect as used, e.g. when restoring a baked layout.
+    void Occupy(const PackedRect& rect);
+    
+    inline uint32_t GetWidth() const { return m_Width; }
+    inline uint32_t GetHeight() const { return m_Height; }
+    
+    // Fraction of the bin covered by packed rects.
+    inline float GetOccupancy() const { return m_Width && m_Height ? float(double(m_UsedArea) / (double(m_Width) * m_Height)) : 0.0f; }
+};
@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Items are copied in and out, so T should be small and trivially
+// copyable.
+template <typename T, size_t Capacity = 1024>
+class SpscQueue
+{
+private:
+    
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+    static constexpr size_t Mask = Capacity - 1;
+    
+    // Each index is written by one side only; keeping them on separate
+    // cache lines stops the two threads from fighting over one.
+    alignas(64) std::atomic<size_t> m_Head{0};
+    alignas(64) std::atomic<size_t> m_Tail{0};
+    
+    T m_Items[Capacity];
+    
+public:
+    
+    // Producer only. Fails when the queue is full.
+    bool Push(const T& item)
+    {
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        
+        if (tail - m_Head.load(std::memory_order_acquire) >= Capacity) return false;
+        
+        m_Items[tail & Mask] = item;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        
+        return true;
+    }
+    
+    // Consumer only. Returns false when the queue is empty.
+    bool Pop(T& item)
+    {
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        
+        if (head == m_Tail.load(std::memory_order_acquire)) return false;
+        
+        item = m_Items[head & Mask];
+        m_Head.store(head + 1, std::memory_order_release);
+        
+        return true;
+    }
+    
+    bool IsEmpty() const
+    {
+        return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2025 Gabriele Vierti
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "../engine/core/utils/logger.h"
+#include "../engine/core/jobs/job-system.h"
+#include "../engine/core/assets/asset-archive.h"
+#include "../engine/core/renderer/cooked-texture.h"
+
+namespace fs = std::filesystem;
+
+static void PrintUsage()
+{
+    std::printf("usage: molten.pack -o <archive.mpak> [options] <file or directory>...\n");
+    std::printf("  Packs files into one archive. Entries are named by their path\n");
+    std::printf("  relative to the root, which the game mounts the archive at.\n");
+    std::printf("  -C <dir>          root directory, the working directory by default\n");
+    std::printf("  --no-compress     store every entry raw\n");
+    std::printf("  --strip-sources   leave out images that have a cooked .mtex twin\n");
+}
+
+// Images cooked by molten.cook are loaded from their .mtex, so shipping the source too is dead weight.
+static bool HasCookedTwin(const fs::path& path)
+{
+    std::error_code error;
+    
+    return path.extension() != CookedTexture::Extension && fs::is_regular_file(CookedTexture::GetCookedPath(path.string()), error);
+}
+
+int main(int argc, char** argv)
+{
+    Logger::Init();
+    
+    PackOptions options;
+    fs::path outputPath;
+    fs::path root = fs::current_path();
+    bool stripSources = false;
+    
+    std::vector<fs::path> files;
+    
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputPath = argv[++i];
+        else if (std::strcmp(argv[i], "-C") == 0 && i + 1 < argc) root = argv[++i];
+        else if (std::strcmp(argv[i], "--no-compress") == 0) options.compress = false;
+        else if (std::strcmp(argv[i], "--strip-sources") == 0) stripSources = true;
+        else if (argv[i][0] == '-') { PrintUsage(); return 1; }
+        else
+        {
+            fs::path input = argv[i];
+            std::error_code error;
+            
+            if (fs::is_directory(input, error))
+            {
+                for (const auto& entry : fs::recursive_directory_iterator(input, error))
+                    if (entry.is_regular_file()) files.push_back(entry.path());
+            }
+            else if (fs::is_regular_file(input, error))
+            {
+                files.push_back(input);
+            }
+            else
+            {
+                std::fprintf(stderr, "No such file or directory: %s\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+    
+    if (files.empty() || outputPath.empty()) { PrintUsage(); return 1; }
+    
+    std::error_code error;
+    fs::path canonicalRoot = fs::weakly_canonical(root, error);
+    
+    std::vector<PackInput> inputs;
+    uint32_t stripped = 0;
+    
+    for (const fs::path& file : files)
+    {
+        // Never pack an archive into itself, or into another one.
+        if (file.extension() == AssetArchive::Extension) continue;
+        
+        if (stripSources && HasCookedTwin(file)) { stripped++; continue; }
+        
+        fs::path relative = fs::weakly_canonical(file, error).lexically_relative(canonicalRoot);
+        
+        if (relative.empty() || *relative.begin() == "..")
+        {
+            std::fprintf(stderr, "%s is outside the root %s\n", file.string().c_str(), canonicalRoot.string().c_str());
+            return 1;
+        }
+        
+        inputs.push_back({ relative.generic_string(), file.string() });
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    JobSystem jobSystem;
+    
+    if (!AssetArchive::Pack(inputs, outputPath.string().c_str(), options, &jobSystem)) return 1;
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    uintmax_t size = fs::file_size(outputPath, error);
+    
+    std::printf("packed %zu files (%u sources stripped) into %s, %ju bytes in %.2f s\n",
+                inputs.size(), stripped, outputPath.string().c_str(), error ? 0 : size, seconds);
+    
+    return 0;
+}